@@ -65,6 +65,14 @@
 // If no argument is passed to this function, then the second option   //
 // is used.                                                            //
 //                                                                     //
+// For large multi-dimensional response matrices, the unfolding can be //
+// run on flat arrays instead of THnSparse bin accesses, calling       //
+// ::UseDenseEngine. The response, efficiency and measured spectra are //
+// then converted once into compressed sparse row arrays, and the      //
+// randomized replicas of the error calculation are unfolded in        //
+// parallel, one replica per thread at a time. The THnSparse outputs   //
+// are the same.                                                       //
+//                                                                     //
 // IMPORTANT:                                                          //
 //-----------                                                          //
 // With this approach, the efficiency map must be calculated           //
@@ -92,6 +100,11 @@
 #include "TH2D.h"
 #include "TH3D.h"
 #include "TRandom3.h"
+#include <algorithm>
+#include <vector>
+#if __cplusplus >= 201103L
+#include <thread>
+#endif
 
 
 ClassImp(AliCFUnfolding)
@@ -130,7 +143,22 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fUseDenseEngine(kFALSE),
+  fNThreads(0),
+  fDenseBuilt(kFALSE),
+  fDenseNT(0),
+  fDenseNM(0),
+  fDenseKeyT(),
+  fDenseKeyM(),
+  fDenseRowOffset(),
+  fDenseColT(),
+  fDenseCond(),
+  fDenseSparseBin(),
+  fDenseEffIndex(),
+  fDenseMeasIndex(),
+  fDensePriorOrig(),
+  fDensePriorMask()
 {
   //
   // default constructor
@@ -174,7 +202,22 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fUseDenseEngine(kFALSE),
+  fNThreads(0),
+  fDenseBuilt(kFALSE),
+  fDenseNT(0),
+  fDenseNM(0),
+  fDenseKeyT(),
+  fDenseKeyM(),
+  fDenseRowOffset(),
+  fDenseColT(),
+  fDenseCond(),
+  fDenseSparseBin(),
+  fDenseEffIndex(),
+  fDenseMeasIndex(),
+  fDensePriorOrig(),
+  fDensePriorMask()
 {
   //
   // named constructor
@@ -350,6 +393,11 @@ void AliCFUnfolding::Unfold() {
   // several iterations are performed until a reasonable chi2 or convergence criterion is reached
   //
 
+  if (fUseDenseEngine && !fUseSmoothing && fNCalcCorrErrors == 0) {
+    UnfoldDense();
+    return;
+  }
+
   Int_t iIterBayes     = 0 ;
   Double_t convergence = 0.;
 
@@ -862,3 +910,428 @@ void AliCFUnfolding::CreateFlatPrior() {
   delete [] bin;
   delete [] bins;
 }
+
+//______________________________________________________________
+
+Long64_t AliCFUnfolding::GetLinearCoordinate(const Int_t* coord, Bool_t trueSpace) const {
+  //
+  // returns the linear index of a cell of the true (or measured) space, under/overflow bins included
+  //
+  const THnSparse* ref = (trueSpace ? fPriorOrig : fMeasuredOrig) ;
+  Long64_t key = 0 ;
+  for (Int_t iVar=fNVariables-1; iVar>=0; iVar--) key = key * (ref->GetAxis(iVar)->GetNbins()+2) + coord[iVar] ;
+  return key;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::GetCellCoordinates(Long64_t key, Bool_t trueSpace, Int_t* coord) const {
+  //
+  // fills the coordinates of the cell whose linear index is "key"
+  //
+  const THnSparse* ref = (trueSpace ? fPriorOrig : fMeasuredOrig) ;
+  for (Int_t iVar=0; iVar<fNVariables; iVar++) {
+    Int_t nCells = ref->GetAxis(iVar)->GetNbins()+2 ;
+    coord[iVar] = key % nCells ;
+    key /= nCells ;
+  }
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfolding::FindDenseCell(const TArrayL64& keys, Long64_t key) const {
+  //
+  // returns the index of the cell "key" in the engine arrays, -1 if not found
+  //
+  const Long64_t* first = keys.GetArray();
+  const Long64_t* last  = first + keys.GetSize();
+  const Long64_t* found = std::lower_bound(first,last,key);
+  if (found==last || *found!=key) return -1;
+  return found-first;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::BuildDenseEngine() {
+  //
+  // Converts once the conditional matrix and the input spectra into flat arrays :
+  //  - every cell of the true (T) and measured (M) spaces gets a compact index
+  //  - the conditional matrix P(M|T) is stored in compressed sparse row format (one row per M cell),
+  //    keeping the order of the THnSparse bins inside each row
+  //  - each CSR entry keeps its bin index in fConditional, to write back fInverseResponse
+  //
+
+  const Long64_t nEntries = fConditional->GetNbins();
+  std::vector<Long64_t> entryKeyT(nEntries), entryKeyM(nEntries);
+  std::vector<Long64_t> keysT, keysM;
+  keysT.reserve(nEntries);
+  keysM.reserve(nEntries);
+
+  for (Long64_t iBin=0; iBin<nEntries; iBin++) {
+    fConditional->GetBinContent(iBin,fCoordinates2N);
+    entryKeyM[iBin] = GetLinearCoordinate(fCoordinates2N,kFALSE);
+    entryKeyT[iBin] = GetLinearCoordinate(fCoordinates2N+fNVariables,kTRUE);
+    keysM.push_back(entryKeyM[iBin]);
+    keysT.push_back(entryKeyT[iBin]);
+  }
+  for (Long64_t iBin=0; iBin<fPriorOrig->GetNbins(); iBin++) {
+    fPriorOrig->GetBinContent(iBin,fCoordinatesN_T);
+    keysT.push_back(GetLinearCoordinate(fCoordinatesN_T,kTRUE));
+  }
+  for (Long64_t iBin=0; iBin<fEfficiencyOrig->GetNbins(); iBin++) {
+    fEfficiencyOrig->GetBinContent(iBin,fCoordinatesN_T);
+    keysT.push_back(GetLinearCoordinate(fCoordinatesN_T,kTRUE));
+  }
+  for (Long64_t iBin=0; iBin<fMeasuredOrig->GetNbins(); iBin++) {
+    fMeasuredOrig->GetBinContent(iBin,fCoordinatesN_M);
+    keysM.push_back(GetLinearCoordinate(fCoordinatesN_M,kFALSE));
+  }
+
+  std::sort(keysT.begin(),keysT.end());
+  keysT.erase(std::unique(keysT.begin(),keysT.end()),keysT.end());
+  std::sort(keysM.begin(),keysM.end());
+  keysM.erase(std::unique(keysM.begin(),keysM.end()),keysM.end());
+
+  fDenseNT = keysT.size();
+  fDenseNM = keysM.size();
+  fDenseKeyT.Set(fDenseNT,(fDenseNT>0 ? &keysT[0] : 0x0));
+  fDenseKeyM.Set(fDenseNM,(fDenseNM>0 ? &keysM[0] : 0x0));
+
+  // count the entries of each row, then place them keeping the bin order
+  fDenseRowOffset.Set(fDenseNM+1);
+  fDenseRowOffset.Reset();
+  std::vector<Int_t> entryM(nEntries), entryT(nEntries);
+  for (Long64_t iBin=0; iBin<nEntries; iBin++) {
+    entryM[iBin] = FindDenseCell(fDenseKeyM,entryKeyM[iBin]);
+    entryT[iBin] = FindDenseCell(fDenseKeyT,entryKeyT[iBin]);
+    fDenseRowOffset[entryM[iBin]+1]++;
+  }
+  for (Int_t iM=0; iM<fDenseNM; iM++) fDenseRowOffset[iM+1] += fDenseRowOffset[iM];
+
+  fDenseColT     .Set(nEntries);
+  fDenseCond     .Set(nEntries);
+  fDenseSparseBin.Set(nEntries);
+  std::vector<Int_t> position(fDenseRowOffset.GetArray(),fDenseRowOffset.GetArray()+fDenseNM);
+  for (Long64_t iBin=0; iBin<nEntries; iBin++) {
+    Int_t iE = position[entryM[iBin]]++ ;
+    fDenseColT[iE]      = entryT[iBin];
+    fDenseCond[iE]      = fConditional->GetBinContent(iBin);
+    fDenseSparseBin[iE] = iBin;
+  }
+
+  // mapping of the input spectra bins, used to randomize them
+  fDenseEffIndex.Set(fEfficiencyOrig->GetNbins());
+  for (Long64_t iBin=0; iBin<fEfficiencyOrig->GetNbins(); iBin++) {
+    fEfficiencyOrig->GetBinContent(iBin,fCoordinatesN_T);
+    fDenseEffIndex[iBin] = FindDenseCell(fDenseKeyT,GetLinearCoordinate(fCoordinatesN_T,kTRUE));
+  }
+  fDenseMeasIndex.Set(fMeasuredOrig->GetNbins());
+  for (Long64_t iBin=0; iBin<fMeasuredOrig->GetNbins(); iBin++) {
+    fMeasuredOrig->GetBinContent(iBin,fCoordinatesN_M);
+    fDenseMeasIndex[iBin] = FindDenseCell(fDenseKeyM,GetLinearCoordinate(fCoordinatesN_M,kFALSE));
+  }
+
+  fDensePriorOrig.Set(fDenseNT);
+  fDensePriorMask.Set(fDenseNT);
+  FillDenseVector(fPriorOrig,kTRUE,fDensePriorOrig.GetArray(),fDensePriorMask.GetArray());
+
+  fDenseBuilt = kTRUE;
+  AliInfo(Form("Dense engine : %d true cells, %d measured cells, %lld conditional entries",fDenseNT,fDenseNM,nEntries));
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::FillDenseVector(const THnSparse* h, Bool_t trueSpace, Double_t* values, Char_t* mask) const {
+  //
+  // copies the content of the N-dim spectrum "h" into "values" (true or measured space)
+  // "mask" (if non null) flags the filled bins of "h"
+  //
+  const TArrayL64& keys = (trueSpace ? fDenseKeyT : fDenseKeyM) ;
+  const Int_t nCells = keys.GetSize();
+  std::fill(values,values+nCells,0.);
+  if (mask) std::fill(mask,mask+nCells,0);
+
+  Int_t* coord = new Int_t[fNVariables];
+  for (Long64_t iBin=0; iBin<h->GetNbins(); iBin++) {
+    Double_t content = h->GetBinContent(iBin,coord);
+    Int_t iCell = FindDenseCell(keys,GetLinearCoordinate(coord,trueSpace));
+    if (iCell<0) continue;
+    values[iCell] = content;
+    if (mask) mask[iCell] = 1;
+  }
+  delete [] coord;
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfolding::RunDenseBayes(const Double_t* eff, const Double_t* meas, Bool_t useConvergence,
+				    Double_t* prior, Char_t* priorMask, Double_t* unfolded, Double_t* est, Double_t* inv,
+				    Double_t& convergence, Int_t& nBadPrior) const {
+  //
+  // Bayes iterations on the CSR arrays : same steps as CreateEstMeasured(), CreateInvResponse(),
+  // CreateUnfolded() and GetConvergence(), the prior being updated in place.
+  // If "inv" is non null, it receives the inverse response of the last iteration (one value per CSR entry).
+  // Returns the iteration at which the loop stopped.
+  // The object is not modified, so that several replicas can run in parallel.
+  //
+
+  const Int_t*    rowOffset = fDenseRowOffset.GetArray();
+  const Int_t*    colT      = fDenseColT.GetArray();
+  const Double_t* cond      = fDenseCond.GetArray();
+  Double_t* priorTimesEff = new Double_t[fDenseNT];
+
+  Int_t iIterBayes = 0;
+  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) {
+
+    for (Int_t iT=0; iT<fDenseNT; iT++) {
+      priorTimesEff[iT] = prior[iT] * eff[iT] ;
+      unfolded[iT] = 0. ;
+    }
+
+    for (Int_t iM=0; iM<fDenseNM; iM++) {
+      // measured estimate : M(i) = SUM_k { COND(i,k) * T(k) * E (k)}
+      Double_t estValue = 0.;
+      for (Int_t iE=rowOffset[iM]; iE<rowOffset[iM+1]; iE++) {
+	Double_t fill = cond[iE] * priorTimesEff[colT[iE]] ;
+	if (fill>0.) estValue += fill ;
+      }
+      est[iM] = estValue;
+
+      // inverse response INV(i,j) = COND(i,j) * T(j) * E(j) / M(i), and unfolded T(j) += INV(i,j) * M(i) / E(j)
+      for (Int_t iE=rowOffset[iM]; iE<rowOffset[iM+1]; iE++) {
+	Int_t iT = colT[iE];
+	Double_t invValue = (estValue>0. ? cond[iE] * priorTimesEff[iT] / estValue : 0.) ;
+	if (inv) inv[iE] = invValue;
+	Double_t fill = (eff[iT]>0. ? invValue * meas[iM] / eff[iT] : 0.) ;
+	if (fill>0.) unfolded[iT] += fill ;
+      }
+    }
+
+    convergence = 0.;
+    for (Int_t iT=0; iT<fDenseNT; iT++) {
+      if (!priorMask[iT]) continue;
+      if (prior[iT] > 0.) convergence += ((prior[iT]-unfolded[iT])/prior[iT])*((prior[iT]-unfolded[iT])/prior[iT]);
+      else nBadPrior++;
+    }
+
+    if (useConvergence && fMaxConvergence>0. && convergence<fMaxConvergence) break;
+
+    // update the prior distribution
+    for (Int_t iT=0; iT<fDenseNT; iT++) {
+      prior[iT]     = unfolded[iT] ;
+      priorMask[iT] = (unfolded[iT]>0.) ;
+    }
+  }
+
+  delete [] priorTimesEff;
+  return iIterBayes;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::RunDenseReplicas(Int_t first, Int_t step, Int_t nChunk, Int_t firstReplica, Int_t nReplicas,
+				      const Double_t* replicaEff, const Double_t* replicaMeas, Double_t* replicaUnfolded,
+				      Double_t* lastPrior, Char_t* lastPriorMask, Double_t* lastEst, Double_t* lastInv, Int_t* nBadPrior) const {
+  //
+  // unfolds the randomized replicas first, first+step, ... of a chunk of nChunk replicas (one thread)
+  // the chunk starts at replica "firstReplica" ; the state of the last replica is kept to fill the THnSparse outputs
+  //
+
+  Double_t* prior     = new Double_t[fDenseNT];
+  Char_t*   priorMask = new Char_t  [fDenseNT];
+  Double_t* est       = new Double_t[fDenseNM];
+
+  for (Int_t iRep=first; iRep<nChunk; iRep+=step) {
+    Bool_t isLast = (firstReplica+iRep == nReplicas-1) ;
+    Double_t* repPrior = (isLast ? lastPrior     : prior    ) ;
+    Char_t*   repMask  = (isLast ? lastPriorMask : priorMask) ;
+    std::copy(fDensePriorOrig.GetArray(),fDensePriorOrig.GetArray()+fDenseNT,repPrior);
+    std::copy(fDensePriorMask.GetArray(),fDensePriorMask.GetArray()+fDenseNT,repMask);
+    Double_t convergence = 0.;
+    RunDenseBayes(replicaEff+(Long64_t)iRep*fDenseNT,replicaMeas+(Long64_t)iRep*fDenseNM,kFALSE,
+		  repPrior,repMask,replicaUnfolded+(Long64_t)iRep*fDenseNT,(isLast ? lastEst : est),(isLast ? lastInv : 0x0),
+		  convergence,*nBadPrior);
+  }
+
+  delete [] prior;
+  delete [] priorMask;
+  delete [] est;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::StoreDenseSpectrum(THnSparse* h, Bool_t trueSpace, const Double_t* values, const Char_t* mask) const {
+  //
+  // resets "h" and fills it with "values" in the cells flagged by "mask" (in the positive cells if mask is null)
+  // errors are set to 0, as done in the THnSparse implementation
+  //
+  const TArrayL64& keys = (trueSpace ? fDenseKeyT : fDenseKeyM) ;
+  Int_t* coord = new Int_t[fNVariables];
+  h->Reset();
+  for (Int_t iCell=0; iCell<keys.GetSize(); iCell++) {
+    if (mask ? !mask[iCell] : !(values[iCell]>0.)) continue;
+    GetCellCoordinates(keys[iCell],trueSpace,coord);
+    h->SetBinContent(coord,values[iCell]);
+    h->SetBinError  (coord,0.);
+  }
+  delete [] coord;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::UnfoldDense() {
+  //
+  // Same as Unfold() followed by CalculateCorrelatedErrors(), running on the arrays built by BuildDenseEngine().
+  // The randomized spectra are drawn sequentially from fRandom3 (same random sequence as the THnSparse implementation),
+  // then the replicas are unfolded in parallel. The THnSparse outputs are filled at the end.
+  //
+
+  if (!fDenseBuilt) BuildDenseEngine();
+
+  const Int_t nT = fDenseNT;
+  const Int_t nM = fDenseNM;
+  const Int_t nEntries = fDenseCond.GetSize();
+
+  TArrayD eff(nT), meas(nM), prior(nT), unfolded(nT), est(nM), inv(nEntries);
+  TArrayC priorMask(nT);
+  FillDenseVector(fEfficiency,kTRUE ,eff.GetArray());
+  FillDenseVector(fMeasured  ,kFALSE,meas.GetArray());
+  FillDenseVector(fPrior     ,kTRUE ,prior.GetArray(),priorMask.GetArray());
+
+  Double_t convergence = 0.;
+  Int_t    nBadPrior   = 0;
+  Int_t iIterBayes = RunDenseBayes(eff.GetArray(),meas.GetArray(),kTRUE,prior.GetArray(),priorMask.GetArray(),
+				   unfolded.GetArray(),est.GetArray(),inv.GetArray(),convergence,nBadPrior);
+  AliDebug(0,Form("convergence at iteration %d is %e",iIterBayes,convergence));
+  if (iIterBayes < fMaxNumIterations) {
+    fNRandomIterations = iIterBayes;
+    AliDebug(0,Form("convergence is met at iteration %d",iIterBayes));
+  }
+  Bool_t priorUpdated = (iIterBayes > 0) ;
+
+  TArrayD unfoldedFinal(unfolded);
+  StoreDenseSpectrum(fUnfolded,kTRUE,unfoldedFinal.GetArray(),0x0);
+  fUnfoldedFinal = (THnSparse*) fUnfolded->Clone() ;
+
+  AliInfo("\n================================================\nFinished bayes iteration, now calculating errors...\n================================================\n");
+  fNCalcCorrErrors = 1;
+
+  const Int_t nReplicas = TMath::Max(fNRandomIterations,0);
+  if (nReplicas > 0) {
+    Int_t nThreads = 1;
+#if __cplusplus >= 201103L
+    nThreads = (fNThreads>0 ? fNThreads : (Int_t)std::thread::hardware_concurrency()) ;
+    nThreads = TMath::Max(1,TMath::Min(nThreads,nReplicas));
+    if (nThreads > 1) AliInfo(Form("Unfolding %d randomized replicas with %d threads",nReplicas,nThreads));
+#endif
+    // the replicas are processed by chunks of one replica per thread, so that the memory does not grow with their number
+    const Int_t nChunkMax = nThreads;
+    TArrayD replicaEff     ((Long64_t)nChunkMax*nT);
+    TArrayD replicaMeas    ((Long64_t)nChunkMax*nM);
+    TArrayD replicaUnfolded((Long64_t)nChunkMax*nT);
+    TArrayD deltaMean(nT), deltaMeanx2(nT);
+    std::vector<Int_t> nBadPriorThread(nThreads,0);
+
+    for (Int_t firstReplica=0; firstReplica<nReplicas; firstReplica+=nChunkMax) {
+      const Int_t nChunk = TMath::Min(nChunkMax,nReplicas-firstReplica);
+
+      // draw the randomized spectra in the same order as CreateRandomizedDist()
+      replicaEff .Reset();
+      replicaMeas.Reset();
+      for (Int_t iRep=0; iRep<nChunk; iRep++) {
+	// the randomized response is not used by the unfolding (the conditional matrix is created once),
+	// but the numbers are drawn to keep the random sequence
+	for (Long64_t iBin=0; iBin<fResponseOrig->GetNbins(); iBin++) 
+	  fRandom3->Gaus(fResponseOrig->GetBinContent(iBin),fResponseOrig->GetBinError(iBin));
+	for (Long64_t iBin=0; iBin<fEfficiencyOrig->GetNbins(); iBin++) {
+	  Double_t ran = fRandom3->Gaus(fEfficiencyOrig->GetBinContent(iBin),fEfficiencyOrig->GetBinError(iBin));
+	  if (fDenseEffIndex[iBin]>=0) replicaEff[(Long64_t)iRep*nT+fDenseEffIndex[iBin]] = ran;
+	}
+	for (Long64_t iBin=0; iBin<fMeasuredOrig->GetNbins(); iBin++) {
+	  Double_t ran = fRandom3->Gaus(fMeasuredOrig->GetBinContent(iBin),fMeasuredOrig->GetBinError(iBin));
+	  if (fDenseMeasIndex[iBin]>=0) replicaMeas[(Long64_t)iRep*nM+fDenseMeasIndex[iBin]] = ran;
+	}
+      }
+
+      // unfold the replicas of the chunk
+      if (nThreads == 1) {
+	RunDenseReplicas(0,1,nChunk,firstReplica,nReplicas,replicaEff.GetArray(),replicaMeas.GetArray(),replicaUnfolded.GetArray(),
+			 prior.GetArray(),priorMask.GetArray(),est.GetArray(),inv.GetArray(),&nBadPriorThread[0]);
+      }
+#if __cplusplus >= 201103L
+      else {
+	std::vector<std::thread> workers;
+	for (Int_t iThread=0; iThread<nThreads; iThread++) {
+	  workers.push_back(std::thread(&AliCFUnfolding::RunDenseReplicas,this,iThread,nThreads,nChunk,firstReplica,nReplicas,
+					replicaEff.GetArray(),replicaMeas.GetArray(),replicaUnfolded.GetArray(),
+					prior.GetArray(),priorMask.GetArray(),est.GetArray(),inv.GetArray(),&nBadPriorThread[iThread]));
+	}
+	for (Int_t iThread=0; iThread<nThreads; iThread++) workers[iThread].join();
+      }
+#endif
+
+      // running mean of the deltas, updated in the replica order as in FillDeltaUnfoldedProfile()
+      for (Int_t iRep=0; iRep<nChunk; iRep++) {
+	const Int_t     nPrevious = firstReplica+iRep;
+	const Double_t* repUnfolded = replicaUnfolded.GetArray()+(Long64_t)iRep*nT;
+	for (Int_t iT=0; iT<nT; iT++) {
+	  if (!(unfoldedFinal[iT]>0.)) continue;
+	  Double_t deltaInBin = unfoldedFinal[iT] - repUnfolded[iT];
+	  deltaMean  [iT] *= nPrevious ; deltaMean  [iT] += deltaInBin            ; deltaMean  [iT] /= (nPrevious+1) ;
+	  deltaMeanx2[iT] *= nPrevious ; deltaMeanx2[iT] += deltaInBin*deltaInBin ; deltaMeanx2[iT] /= (nPrevious+1) ;
+	}
+      }
+
+      // spectrum of the last replica
+      if (firstReplica+nChunk == nReplicas) 
+	StoreDenseSpectrum(fUnfolded,kTRUE,replicaUnfolded.GetArray()+(Long64_t)(nChunk-1)*nT,0x0);
+    }
+    for (Int_t iThread=0; iThread<nThreads; iThread++) nBadPrior += nBadPriorThread[iThread];
+    priorUpdated = (fMaxNumIterations > 0) ;
+
+    fDeltaUnfoldedP->Reset();
+    fDeltaUnfoldedN->Reset();
+    Int_t* coord = new Int_t[fNVariables];
+    for (Int_t iT=0; iT<nT; iT++) {
+      if (!(unfoldedFinal[iT]>0.)) continue;
+      Double_t mean   = deltaMean  [iT];
+      Double_t meanx2 = deltaMeanx2[iT];
+      GetCellCoordinates(fDenseKeyT[iT],kTRUE,coord);
+      fDeltaUnfoldedP->SetBinError  (coord,meanx2);
+      fDeltaUnfoldedP->SetBinContent(coord,mean);
+      fDeltaUnfoldedN->SetBinContent(coord,nReplicas);
+      Double_t sigma = (nReplicas > 1 ? TMath::Sqrt((nReplicas/(nReplicas-1.))*TMath::Abs(meanx2-mean*mean)) : 0.) ;
+      fUnfoldedFinal->SetBinError(coord,sigma);
+    }
+    delete [] coord;
+  }
+  else {
+    // no replica : errors are set to 0
+    for (Long64_t iBin=0; iBin<fUnfoldedFinal->GetNbins(); iBin++) fUnfoldedFinal->SetBinError(iBin,0.);
+  }
+
+  if (nBadPrior > 0) AliWarning(Form("%d prior values <= 0 found in the iterations. Adding 0 to convergence criterion.",nBadPrior));
+
+  // state of the last unfolding
+  StoreDenseSpectrum(fMeasuredEstimate,kFALSE,est.GetArray(),0x0);
+  if (priorUpdated) {
+    StoreDenseSpectrum(fPrior,kTRUE,prior.GetArray(),priorMask.GetArray());
+    fPrior->SetTitle("Prior");
+  }
+  else if (nReplicas > 0) {
+    if (fPrior) delete fPrior ;
+    fPrior = (THnSparse*) fPriorOrig->Clone();
+  }
+  if (fMaxNumIterations > 0) {
+    for (Int_t iE=0; iE<nEntries; iE++) {
+      Long64_t bin = fDenseSparseBin[iE];
+      if (inv[iE]>0. || fInverseResponse->GetBinContent(bin)>0.) {
+	fInverseResponse->SetBinContent(bin,inv[iE]);
+	fInverseResponse->SetBinError  (bin,0.);
+      }
+    }
+  }
+
+  fNCalcCorrErrors = 2;
+  AliInfo(Form("\n\n=======================\nFinished at iteration %d : convergence is %e and you required it to be < %e\n=======================\n\n",iIterBayes,convergence,fMaxConvergence));
+}
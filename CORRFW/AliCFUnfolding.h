@@ -12,6 +12,10 @@
 
 #include "TNamed.h"
 #include "THnSparse.h"
+#include "TArrayC.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
+#include "TArrayL64.h"
 #include "AliLog.h"
 
 class TF1;
@@ -37,6 +41,11 @@ class AliCFUnfolding : public TNamed {
 
   void SetNRandomIterations(Int_t n = 100) {fNRandomIterations = n;};
 
+  void UseDenseEngine(Bool_t b=kTRUE, Int_t nThreads=0) { // unfold with compressed sparse row arrays instead of THnSparse bin access
+    fUseDenseEngine=b;                                     // nThreads is the number of threads used for the randomized error replicas
+    fNThreads=nThreads;                                    // (0 = all available cores) ; not used together with smoothing
+  }
+
   void UseSmoothing(TF1* fcn=0x0, Option_t* opt="iremn") { // if fcn=0x0 then smooth using neighbouring bins 
     fUseSmoothing=kTRUE;                                   // this function must NOT be used if fNVariables > 3
     fSmoothFunction=fcn;                                   // the option "opt" is used if "fcn" is specified
@@ -112,6 +121,23 @@ class AliCFUnfolding : public TNamed {
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
 
+  /* dense engine */
+  Bool_t         fUseDenseEngine;    // Use the compressed sparse row engine in Unfold()
+  Int_t          fNThreads;          // Number of threads for the randomized replicas (0 = all cores)
+  Bool_t         fDenseBuilt;        //! Flag telling whether the arrays below are filled
+  Int_t          fDenseNT;           //! Number of cells in true space used by the engine
+  Int_t          fDenseNM;           //! Number of cells in measured space used by the engine
+  TArrayL64      fDenseKeyT;         //! Sorted linear coordinates of the true space cells
+  TArrayL64      fDenseKeyM;         //! Sorted linear coordinates of the measured space cells
+  TArrayI        fDenseRowOffset;    //! CSR row offsets (rows = measured cells)
+  TArrayI        fDenseColT;         //! CSR column index (true cell) of each conditional entry
+  TArrayD        fDenseCond;         //! CSR conditional probability P(M|T) of each entry
+  TArrayL64      fDenseSparseBin;    //! Bin index of each entry in fConditional/fInverseResponse
+  TArrayI        fDenseEffIndex;     //! True cell of each bin of fEfficiencyOrig
+  TArrayI        fDenseMeasIndex;    //! Measured cell of each bin of fMeasuredOrig
+  TArrayD        fDensePriorOrig;    //! Original prior in true space
+  TArrayC        fDensePriorMask;    //! Cells filled in the original prior
+
 
   // functions
   void     Init();                  // initialisation of the internal settings
@@ -132,7 +158,22 @@ class AliCFUnfolding : public TNamed {
   void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
   void     SetMaxConvergencePerDOF (Double_t val);
 
-  ClassDef(AliCFUnfolding,1);
+  /* dense engine */
+  void     UnfoldDense();               // Unfold() and CalculateCorrelatedErrors() using the CSR arrays
+  void     BuildDenseEngine();          // converts the conditional matrix and the inputs into CSR arrays
+  Long64_t GetLinearCoordinate(const Int_t* coord, Bool_t trueSpace) const; // linear index of a cell in true or measured space
+  void     GetCellCoordinates(Long64_t key, Bool_t trueSpace, Int_t* coord) const; // inverse of GetLinearCoordinate
+  Int_t    FindDenseCell(const TArrayL64& keys, Long64_t key) const;           // index of a cell in the engine, -1 if absent
+  void     FillDenseVector(const THnSparse* h, Bool_t trueSpace, Double_t* values, Char_t* mask=0x0) const;
+  Int_t    RunDenseBayes(const Double_t* eff, const Double_t* meas, Bool_t useConvergence,
+			 Double_t* prior, Char_t* priorMask, Double_t* unfolded, Double_t* est, Double_t* inv,
+			 Double_t& convergence, Int_t& nBadPrior) const; // Bayes iterations on the CSR arrays, returns the last iteration
+  void     RunDenseReplicas(Int_t first, Int_t step, Int_t nChunk, Int_t firstReplica, Int_t nReplicas,
+			    const Double_t* replicaEff, const Double_t* replicaMeas, Double_t* replicaUnfolded,
+			    Double_t* lastPrior, Char_t* lastPriorMask, Double_t* lastEst, Double_t* lastInv, Int_t* nBadPrior) const;
+  void     StoreDenseSpectrum(THnSparse* h, Bool_t trueSpace, const Double_t* values, const Char_t* mask) const; // writes back a spectrum
+
+  ClassDef(AliCFUnfolding,2);
 };
 
 #endif
@@ -80,6 +80,10 @@ void AliAnalysisTaskMixInfo::UserCreateOutputObjects()
    }
    if (fMixInfo) fOutputList->Add(fMixInfo);
 
+   // the mixed events themselves are read only for the debug printout,
+   // so they can be skipped when the other mixing tasks use snapshots
+   if (fInputEHMix && AliLog::GetDebugLevel("", IsA()->GetName()) <= AliLog::kDebug) fInputEHMix->AddSnapshotTask(this);
+
    // Post output data.
    PostData(1, fOutputList);
 }
@@ -11,6 +11,7 @@
 #include <TChain.h>
 #include <TChainElement.h>
 #include <TSystem.h>
+#include <TMethod.h>
 
 #include "AliLog.h"
 #include "AliAnalysisManager.h"
@@ -43,12 +44,23 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fCurrentBinIndex(-1),
    fOfflineTriggerMask(0),
    fCurrentMixEntry(),
-   fCurrentEntryMainTree(0)
+   fCurrentEntryMainTree(0),
+   fSnapshotCacheSize(0),
+   fMixFromSnapshots(kFALSE),
+   fSnapshotEntryMain(-1),
+   fSnapshotClock(0),
+   fSnapshotTasksOnly(-1),
+   fSnapshotTasks(),
+   fSnapshots(),
+   fSnapshotEntries(),
+   fSnapshotLastUse(),
+   fSnapshotSlots()
 {
    //
    // Default constructor.
    //
    AliDebug(AliLog::kDebug + 10, "<-");
+   fSnapshots.SetOwner(kTRUE);
    SetMixNumber(mixNum);
    AliDebug(AliLog::kDebug + 10, "->");
 }
@@ -59,6 +71,7 @@ AliMixInputEventHandler::~AliMixInputEventHandler() {
    // Destructor
    //
    fMixTrees.Clear();
+   fSnapshots.Delete();
 }
 
 //_____________________________________________________________________________
@@ -192,6 +205,9 @@ Bool_t AliMixInputEventHandler::GetEntry()
    //
    AliDebug(AliLog::kDebug + 5, Form("<-"));
 
+   // set by the mixing methods for selected events
+   fSnapshotEntryMain = -1;
+
    if (!fEventPool) {
       MixStd();
    }
@@ -228,6 +244,7 @@ Bool_t AliMixInputEventHandler::MixStd()
 
    // check for PhysSelection
    if (!IsEventCurrentSelected()) return kFALSE;
+   fSnapshotEntryMain = fEntryCounter;
 
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
@@ -258,7 +275,7 @@ Bool_t AliMixInputEventHandler::MixStd()
       if (!te) {
          AliError("te is null. this is error. tell to developer (#1)");
       } else {
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
+         if (fDoMixEventGetEntryAuto && !HasAllSnapshots(entryMixReal)) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
          // runs UserExecMix for all tasks
          fNumberMixed++;
          UserExecMixAllTasks(fEntryCounter, 1, fEntryCounter, entryMixReal, fNumberMixed);
@@ -297,6 +314,7 @@ Bool_t AliMixInputEventHandler::MixBuffer()
    Long64_t zeroChainEntries = fMixIntupHandlerInfoTmp->GetChain()->GetEntries() - inEvHMain->GetTree()->GetTree()->GetEntries();
    // fill entry
    Long64_t currentMainEntry = inEvHMain->GetTree()->GetTree()->GetReadEntry() + zeroChainEntries;
+   fSnapshotEntryMain = currentMainEntry;
    // fills entry
    if (fEventPool && inEvHMain) fEventPool->AddEntry(currentMainEntry, inEvHMain->GetEvent());
    // start of
@@ -355,7 +373,7 @@ Bool_t AliMixInputEventHandler::MixBuffer()
       } else {
          fCurrentMixEntry.Enter(entryMixReal);
          AliDebug(AliLog::kDebug + 3, Form("Preparing InputEventHandler(%d)", counter));
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(counter), fAnalysisType);
+         if (fDoMixEventGetEntryAuto && !HasAllSnapshots(entryMixReal)) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(counter), fAnalysisType);
          fNumberMixed++;
       }
       counter++;
@@ -398,6 +416,7 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    Long64_t zeroChainEntries = fMixIntupHandlerInfoTmp->GetChain()->GetEntries() - inEvHMain->GetTree()->GetTree()->GetEntries();
    // fill entry
    Long64_t currentMainEntry = inEvHMain->GetTree()->GetTree()->GetReadEntry() + zeroChainEntries;
+   fSnapshotEntryMain = currentMainEntry;
    if (fEventPool && inEvHMain) fEventPool->AddEntry(currentMainEntry, inEvHMain->GetEvent());
    // start of
    AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
@@ -471,7 +490,7 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
          AliError("te is null. this is error. tell to developer (#2)");
       } else {
          fCurrentMixEntry.Enter(entryMixReal);
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
+         if (fDoMixEventGetEntryAuto && !HasAllSnapshots(entryMixReal)) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
          // runs UserExecMix for all tasks
          fNumberMixed++;
          UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, entryMixReal, fNumberMixed);
@@ -625,3 +644,139 @@ Bool_t AliMixInputEventHandler::GetEntryMixedEvent(Int_t id) {
 
    return kTRUE;
 }
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::AddSnapshotTask(const AliAnalysisTaskSE *task)
+{
+   //
+   // Declares that task reads in UserExecMix only its snapshots (GetSnapshot) and not the
+   // mixed event, except when GetSnapshot returns 0 (to be called in UserCreateOutputObjects)
+   //
+   if (!task || fSnapshotTasks.IndexOf(task) >= 0) return;
+   fSnapshotTasks.Add((TObject *)task);
+   fSnapshotTasksOnly = -1;
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::AddSnapshot(const AliAnalysisTaskSE *task, TObject *snapshot)
+{
+   //
+   // Stores the snapshot of the current main event made by task (to be called in UserExec).
+   // The handler takes ownership; the snapshot is deleted when its entry leaves the cache.
+   // Snapshots are kept only for tasks declared with AddSnapshotTask
+   //
+   if (!snapshot) return;
+   Int_t iTask = fSnapshotTasks.IndexOf(task);
+   if (fSnapshotEntryMain < 0 || fSnapshotCacheSize <= 0 || iTask < 0) {
+      delete snapshot;
+      return;
+   }
+   TObjArray *snaps = (TObjArray *) fSnapshots.UncheckedAt(SnapshotSlot(fSnapshotEntryMain, kTRUE));
+   TObject *old = iTask < snaps->GetEntriesFast() ? snaps->UncheckedAt(iTask) : 0;
+   snaps->AddAtAndExpand(snapshot, iTask);
+   delete old;
+}
+
+//_____________________________________________________________________________
+TObject *AliMixInputEventHandler::GetSnapshot(const AliAnalysisTaskSE *task, Int_t id)
+{
+   //
+   // Returns the snapshot made by task of the mixed event (to be called in UserExecMix).
+   // id is the input handler in buffer mixing (same as GetEntryMixedEvent), it is ignored
+   // by the other mixing methods. Returns 0 when the entry is not in the cache
+   //
+   Long64_t entry = fCurrentEntryMix;
+   if (id >= 0 && fEventPool && fBufferSize > 1) entry = fCurrentMixEntry.GetEntry(fCurrentMixEntry.GetN() - id - 1);
+   Int_t iTask = fSnapshotTasks.IndexOf(task);
+   if (entry < 0 || iTask < 0) return 0;
+   Int_t slot = SnapshotSlot(entry, kFALSE);
+   if (slot < 0) return 0;
+   TObjArray *snaps = (TObjArray *) fSnapshots.UncheckedAt(slot);
+   return iTask < snaps->GetEntriesFast() ? snaps->UncheckedAt(iTask) : 0;
+}
+
+//_____________________________________________________________________________
+Int_t AliMixInputEventHandler::SnapshotSlot(Long64_t entry, Bool_t create)
+{
+   //
+   // Returns the cache slot of entry, -1 if not cached. With create the least
+   // recently used slot is recycled for entry
+   //
+   Int_t slot = (Int_t) fSnapshotSlots.GetValue(entry) - 1;
+   if (slot >= 0) {
+      fSnapshotLastUse[slot] = ++fSnapshotClock;
+      return slot;
+   }
+   if (!create) return -1;
+
+   if (!fSnapshotEntries.GetSize()) {
+      fSnapshotEntries.Set(fSnapshotCacheSize);
+      fSnapshotEntries.Reset(-1);
+      fSnapshotLastUse.Set(fSnapshotCacheSize);
+      fSnapshotLastUse.Reset(0);
+   }
+   slot = 0;
+   for (Int_t i = 1; i < fSnapshotLastUse.GetSize(); i++) {
+      if (fSnapshotLastUse[i] < fSnapshotLastUse[slot]) slot = i;
+   }
+   if (fSnapshotEntries[slot] >= 0) fSnapshotSlots.Remove(fSnapshotEntries[slot]);
+
+   TObjArray *snaps = (TObjArray *) fSnapshots.At(slot);
+   if (!snaps) {
+      snaps = new TObjArray();
+      snaps->SetOwner(kTRUE);
+      fSnapshots.AddAtAndExpand(snaps, slot);
+   } else {
+      snaps->Delete();
+   }
+   fSnapshotEntries[slot] = entry;
+   fSnapshotLastUse[slot] = ++fSnapshotClock;
+   fSnapshotSlots.Add(entry, slot + 1);
+   return slot;
+}
+
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::HasAllSnapshots(Long64_t entry)
+{
+   //
+   // Returns kTRUE when mixing from snapshots, every task running UserExecMix
+   // uses snapshots and each of them has one for entry, i.e. entry does not
+   // have to be read
+   //
+   if (!fMixFromSnapshots || !fSnapshotTasks.GetEntriesFast()) return kFALSE;
+   if (!AllMixingTasksUseSnapshots()) return kFALSE;
+   Int_t slot = SnapshotSlot(entry, kFALSE);
+   if (slot < 0) return kFALSE;
+   TObjArray *snaps = (TObjArray *) fSnapshots.UncheckedAt(slot);
+   if (snaps->GetEntriesFast() < fSnapshotTasks.GetEntriesFast()) return kFALSE;
+   for (Int_t i = 0; i < fSnapshotTasks.GetEntriesFast(); i++) {
+      if (!snaps->UncheckedAt(i)) return kFALSE;
+   }
+   return kTRUE;
+}
+
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::AllMixingTasksUseSnapshots()
+{
+   //
+   // Returns kTRUE when every task implementing UserExecMix was declared with
+   // AddSnapshotTask. Any other task reads the mixed event in UserExecMix, so
+   // it has to be prepared. The list of tasks is fixed during the processing,
+   // the result is checked once
+   //
+   if (fSnapshotTasksOnly >= 0) return fSnapshotTasksOnly;
+   AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+   if (!mgr) return kFALSE;
+   fSnapshotTasksOnly = 1;
+   AliAnalysisTaskSE *mixTask = 0;
+   TObjArrayIter next(mgr->GetTasks());
+   while ((mixTask = dynamic_cast<AliAnalysisTaskSE *>(next()))) {
+      if (fSnapshotTasks.IndexOf(mixTask) >= 0) continue;
+      TMethod *userExecMix = mixTask->IsA()->GetMethodAllAny("UserExecMix");
+      if (userExecMix && userExecMix->GetClass() == AliAnalysisTaskSE::Class()) continue;
+      AliInfo(Form("Task %s reads the mixed events, mixed entries are read also when snapshots exist", mixTask->GetName()));
+      fSnapshotTasksOnly = 0;
+      break;
+   }
+   return fSnapshotTasksOnly;
+}
@@ -13,6 +13,8 @@
 #include <TObjArray.h>
 #include <TEntryList.h>
 #include <TArrayI.h>
+#include <TArrayL64.h>
+#include <TExMap.h>
 
 #include <AliVEvent.h>
 
@@ -23,6 +25,7 @@ class TChainElement;
 class AliMixEventPool;
 class AliMixInputHandlerInfo;
 class AliInputEventHandler;
+class AliAnalysisTaskSE;
 class AliMixInputEventHandler : public AliMultiInputEventHandler {
 
 public:
@@ -73,6 +76,15 @@ public:
 
    Bool_t                  GetEntryMainEvent();
    Bool_t                  GetEntryMixedEvent(Int_t idHandler=0);
+
+   // per task snapshots of the events, kept for the last fSnapshotCacheSize entries
+   void                    SetSnapshotCacheSize(Int_t size) { fSnapshotCacheSize = size; }
+   void                    SetMixFromSnapshots(Bool_t b = kTRUE) { fMixFromSnapshots = b; }
+   Int_t                   SnapshotCacheSize() const { return fSnapshotCacheSize; }
+   Bool_t                  IsMixingFromSnapshots() const { return fMixFromSnapshots; }
+   void                    AddSnapshotTask(const AliAnalysisTaskSE *task);
+   void                    AddSnapshot(const AliAnalysisTaskSE *task, TObject *snapshot);
+   TObject                *GetSnapshot(const AliAnalysisTaskSE *task, Int_t idHandler = -1);
 protected:
 
    TObjArray               fMixTrees;              // buffer of input handlers
@@ -100,17 +112,33 @@ private:
    TEntryList fCurrentMixEntry;    //! array of mix entries currently used (user should touch)
    Long64_t fCurrentEntryMainTree; //! current entry in current tree (main event)
 
+   // snapshot cache
+   Int_t      fSnapshotCacheSize;  //  max. number of entries with snapshots (0 = no cache)
+   Bool_t     fMixFromSnapshots;   //  skip reading mixed entries having snapshots of all tasks
+   Long64_t   fSnapshotEntryMain;  //! chain entry of the main event (-1 when not to be cached)
+   Long64_t   fSnapshotClock;      //! last use counter
+   Int_t      fSnapshotTasksOnly;  //! 1 when all tasks with UserExecMix use snapshots (-1 not checked)
+   TObjArray  fSnapshotTasks;      //! tasks using snapshots in UserExecMix (not owned)
+   TObjArray  fSnapshots;          //! snapshots of each cache slot, TObjArray indexed as fSnapshotTasks
+   TArrayL64  fSnapshotEntries;    //! chain entry of each cache slot (-1 when free)
+   TArrayL64  fSnapshotLastUse;    //! last use of each cache slot
+   TExMap     fSnapshotSlots;      //! chain entry -> cache slot + 1
+
    virtual Bool_t          MixStd();
    virtual Bool_t          MixBuffer();
    virtual Bool_t          MixEventsMoreTimesWithOneEvent();
    virtual Bool_t          MixEventsMoreTimesWithBuffer();
 
+   Int_t                   SnapshotSlot(Long64_t entry, Bool_t create);
+   Bool_t                  HasAllSnapshots(Long64_t entry);
+   Bool_t                  AllMixingTasksUseSnapshots();
+
    void                    UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed);
 
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 7)
 };
 
 #endif
@@ -207,6 +207,7 @@ Bool_t AliCaloTrackMCReader::FillInputEvent(Int_t iEntry,
                                             const char * /*currentFileName*/)
 {  
   fEventNumber     = iEntry;
+  fNFilledEvents++;
   //fCurrentFileName = TString(currentFileName);
   
   for(Int_t iptCut = 0; iptCut < fTrackMultNPtCut; iptCut++ )
@@ -132,7 +132,8 @@ fAcceptEventsWithBit(0),     fRejectEventsWithBit(0),         fRejectEMCalTrigge
 fMomentum(),                 fOutputContainer(0x0),           
 fhEMCALClusterEtaPhi(0),     fhEMCALClusterTimeE(0),
 fEnergyHistogramNbins(0),
-fhNEventsAfterCut(0),        fNMCGenerToAccept(0),            fMCGenerEventHeaderToAccept("")
+fhNEventsAfterCut(0),        fNMCGenerToAccept(0),            fMCGenerEventHeaderToAccept(""),
+fNFilledEvents(0)
 {
   for(Int_t i = 0; i < 8; i++) fhEMCALClusterCutsE [i]= 0x0 ;    
   for(Int_t i = 0; i < 7; i++) fhPHOSClusterCutsE  [i]= 0x0 ;  
@@ -1253,6 +1254,7 @@ Bool_t AliCaloTrackReader::IsPileUpFromNotSPDAndNotEMCal() const
 Bool_t AliCaloTrackReader::FillInputEvent(Int_t iEntry, const char * /*curFileName*/)
 {  
   fEventNumber         = iEntry;
+  fNFilledEvents++;
   fTriggerClusterIndex = -1;
   fTriggerClusterId    = -1;
   fIsTriggerMatch      = kFALSE;
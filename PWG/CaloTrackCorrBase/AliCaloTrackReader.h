@@ -84,6 +84,7 @@ public:
   virtual void    SetDataType(Int_t data )                 { fDataType = data              ; }
 
   virtual Int_t   GetEventNumber()                   const { return fEventNumber           ; }
+  Int_t           GetNFilledEvents()                 const { return fNFilledEvents         ; }
 	
   virtual TObjString *  GetListOfParameters() ;
   
@@ -966,6 +967,8 @@ public:
   Int_t            fMCGenerIndexToAccept[5];       ///<  List with index of generators that should not be included
 
   TString          fMCGenerEventHeaderToAccept;    ///<  Accept events that contain at least this event header name
+
+  Int_t            fNFilledEvents;                 //!<! Number of calls to FillInputEvent, identifies the content of the track and cluster lists
   
   /// Copy constructor not implemented.
   AliCaloTrackReader(              const AliCaloTrackReader & r) ; 
@@ -974,7 +977,7 @@ public:
   AliCaloTrackReader & operator = (const AliCaloTrackReader & r) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliCaloTrackReader,77) ;
+  ClassDef(AliCaloTrackReader,78) ;
   /// \endcond
 
 } ;
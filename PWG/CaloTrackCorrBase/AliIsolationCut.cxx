@@ -16,6 +16,8 @@
 // --- ROOT system ---
 #include <TObjArray.h>
 
+#include <algorithm>
+
 // --- AliRoot system ---
 #include "AliAODPWG4ParticleCorrelation.h"
 #include "AliEMCALGeometry.h"
@@ -36,6 +38,29 @@
 ClassImp(AliIsolationCut) ;
 /// \endcond
 
+namespace
+{
+  // Eta-phi cells of the track and cluster index, the first and last eta bins also hold the overflows
+  const Int_t    kIdxNEta     = 20;
+  const Double_t kIdxEtaMin   = -1.;
+  const Double_t kIdxEtaWidth = 0.1;
+  const Int_t    kIdxNPhi     = 64;
+  const Double_t kIdxPhiWidth = TMath::TwoPi()/kIdxNPhi;
+  const Double_t kIdxMargin   = 1.e-4; // Cells closer than this to a cut are checked particle by particle
+
+  // EMCal (col,row) accepted in the cell density
+  const Int_t    kBadCellNCols = 2*AliEMCALGeoParams::fgkEMCALCols+1;
+  const Int_t    kBadCellNRows = int(AliEMCALGeoParams::fgkEMCALRows*16./3)+1;
+
+  Int_t IndexBin(Double_t value, Double_t min, Double_t width, Int_t nBins)
+  {
+    Double_t x = (value-min)/width;
+    if ( !(x >= 0) ) return 0;
+    if ( x >= nBins ) return nBins-1;
+    return Int_t(x);
+  }
+}
+
 //____________________________________
 /// Default constructor. Initialize parameters
 //____________________________________
@@ -54,11 +79,388 @@ fFracIsThresh(1),
 fIsTMClusterInConeRejected(1),
 fDistMinToTrigger(-1.),
 fMomentum(),
-fTrackVector()
+fTrackVector(),
+fIdxList(),
+fIdxFillId(),
+fIdxNEntries(),
+fIdxCell(),
+fIdxCellStart(),
+fIdxItem(),
+fIdxPt(),
+fIdxEta(),
+fIdxPhi(),
+fIdxNextSameID(),
+fIdxIDMap(),
+fIdxExcluded(),
+fIdxEtaBinPt(),
+fIdxPhiBinPt(),
+fIdxInCone(),
+fBadCellRowFilled(),
+fBadCellRowSum(),
+fBadCellRun(-1)
 {
+  for(Int_t type = 0; type < 2; type++)
+  {
+    fIdxList    [type] = 0x0;
+    fIdxFillId  [type] = -1;
+    fIdxNEntries[type] = 0;
+  }
+
   InitParameters();
 }
 
+//_________________________________________________________________________________________________________
+/// Fill the eta-phi index of the tracks (type 0) or clusters (type 1) in the list:
+/// kinematics of each entry, entries sorted by cell, pT sums per eta and phi bin,
+/// and track/cluster ID lookup to remove the candidate and its daughters.
+/// The lists of the reader are indexed once per event, other lists (mixed events) each time.
+/// Same selection of the entries as the loops of MakeIsolationCut before the cone checks.
+//_________________________________________________________________________________________________________
+void AliIsolationCut::BuildParticleIndex(Int_t type, TObjArray * list, AliCaloTrackReader * reader, AliCaloPID * pid)
+{
+  Int_t fillId = -1;
+  if ( list == reader->GetCTSTracks() || list == reader->GetEMCALClusters() || list == reader->GetPHOSClusters() )
+    fillId = reader->GetNFilledEvents();
+
+  Int_t nEntries = list->GetEntries();
+
+  if ( fillId >= 0 && list == fIdxList[type] && fillId == fIdxFillId[type] && nEntries == fIdxNEntries[type] ) return;
+
+  fIdxList    [type] = list;
+  fIdxFillId  [type] = fillId;
+  fIdxNEntries[type] = nEntries;
+
+  if ( fIdxCell[type].GetSize() < nEntries )
+  {
+    fIdxCell      [type].Set(nEntries);
+    fIdxItem      [type].Set(nEntries);
+    fIdxPt        [type].Set(nEntries);
+    fIdxEta       [type].Set(nEntries);
+    fIdxPhi       [type].Set(nEntries);
+    fIdxNextSameID[type].Set(nEntries);
+    fIdxExcluded  [type].Set(nEntries); // new entries set to 0, the others are unset after each candidate
+  }
+
+  fIdxCellStart[type].Set(kIdxNEta*kIdxNPhi+1);
+  fIdxEtaBinPt [type].Set(kIdxNEta+1);
+  fIdxPhiBinPt [type].Set(kIdxNPhi+1);
+  fIdxCellStart[type].Reset();
+  fIdxEtaBinPt [type].Reset();
+  fIdxPhiBinPt [type].Reset();
+  fIdxIDMap    [type].Delete();
+
+  Int_t    * cell   = fIdxCell      [type].GetArray();
+  Int_t    * start  = fIdxCellStart [type].GetArray();
+  Int_t    * next   = fIdxNextSameID[type].GetArray();
+  Double_t * etaPt  = fIdxEtaBinPt  [type].GetArray();
+  Double_t * phiPt  = fIdxPhiBinPt  [type].GetArray();
+
+  for(Int_t ipr = 0; ipr < nEntries; ipr++)
+  {
+    cell[ipr] = -1;
+    next[ipr] = -1;
+
+    Float_t  pt    = 0;
+    Float_t  eta   = 0;
+    Float_t  phi   = 0;
+    Bool_t   hasID = kFALSE;
+    Long64_t id    = 0;
+
+    if ( type == 0 )
+    {
+      AliVTrack* track = dynamic_cast<AliVTrack*>(list->At(ipr)) ;
+
+      if(track)
+      {
+        id    = reader->GetTrackID(track) ; // needed instead of track->GetID() since AOD needs some manipulations
+        hasID = kTRUE;
+
+        fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+        pt  = fTrackVector.Pt();
+        eta = fTrackVector.Eta();
+        phi = fTrackVector.Phi() ;
+      }
+      else
+      {// Mixed event stored in AliAODPWG4Particles
+        AliAODPWG4Particle * trackmix = dynamic_cast<AliAODPWG4Particle*>(list->At(ipr)) ;
+        if(!trackmix)
+        {
+          AliWarning("Wrong track data type, continue");
+          continue;
+        }
+
+        pt  = trackmix->Pt();
+        eta = trackmix->Eta();
+        phi = trackmix->Phi() ;
+      }
+    }
+    else
+    {
+      AliVCluster * calo = dynamic_cast<AliVCluster *>(list->At(ipr)) ;
+
+      if(calo)
+      {
+        // Get the index where the cluster comes, to retrieve the corresponding vertex
+        Int_t evtIndex = 0 ;
+        if (reader->GetMixedEvent())
+          evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+
+        // Skip matched clusters with tracks in case of neutral+charged analysis
+        if(fIsTMClusterInConeRejected)
+        {
+          if( fPartInCone == kNeutralAndCharged &&
+             pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent()) ) continue ;
+        }
+
+        id    = calo->GetID();
+        hasID = kTRUE;
+
+        // Assume that come from vertex in straight line
+        calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+
+        pt  = fMomentum.Pt()  ;
+        eta = fMomentum.Eta() ;
+        phi = fMomentum.Phi() ;
+      }
+      else
+      {// Mixed event stored in AliAODPWG4Particles
+        AliAODPWG4Particle * calomix = dynamic_cast<AliAODPWG4Particle*>(list->At(ipr)) ;
+        if(!calomix)
+        {
+          AliWarning("Wrong calo data type, continue");
+          continue;
+        }
+
+        pt  = calomix->Pt();
+        eta = calomix->Eta();
+        phi = calomix->Phi() ;
+      }
+    }
+
+    if ( phi < 0 ) phi+=TMath::TwoPi();
+
+    fIdxPt [type][ipr] = pt;
+    fIdxEta[type][ipr] = eta;
+    fIdxPhi[type][ipr] = phi;
+
+    Int_t ieta = IndexBin(eta, kIdxEtaMin, kIdxEtaWidth, kIdxNEta);
+    Int_t iphi = IndexBin(phi, 0.        , kIdxPhiWidth, kIdxNPhi);
+
+    cell[ipr] = ieta*kIdxNPhi+iphi;
+    start[cell[ipr]+1]++;
+    etaPt[ieta+1] += pt;
+    phiPt[iphi+1] += pt;
+
+    if ( hasID )
+    {
+      Long64_t & first = fIdxIDMap[type](id);
+      next[ipr] = Int_t(first)-1;
+      first     = ipr+1;
+    }
+  }
+
+  for(Int_t ieta = 0; ieta < kIdxNEta; ieta++) etaPt[ieta+1] += etaPt[ieta];
+  for(Int_t iphi = 0; iphi < kIdxNPhi; iphi++) phiPt[iphi+1] += phiPt[iphi];
+
+  // Counting sort of the entries by cell, start[c] is used as insertion
+  // point of cell c and afterwards shifted back by one cell
+  Int_t nCells = kIdxNEta*kIdxNPhi;
+  for(Int_t icell = 0; icell < nCells; icell++) start[icell+1] += start[icell];
+
+  Int_t * item = fIdxItem[type].GetArray();
+  for(Int_t ipr = 0; ipr < nEntries; ipr++)
+  {
+    if ( cell[ipr] >= 0 ) item[start[cell[ipr]]++] = ipr;
+  }
+
+  for(Int_t icell = nCells; icell > 0; icell--) start[icell] = start[icell-1];
+  start[0] = 0;
+}
+
+//_________________________________________________________________________________________________________
+/// Sum of pT of the indexed entries with eta (or phi) in ]min,max[.
+/// Cells fully inside the stripe are taken from the pT sums per bin,
+/// the entries in the cells at the stripe limits are checked one by one.
+//_________________________________________________________________________________________________________
+Double_t AliIsolationCut::StripePtSum(Int_t type, Bool_t etaStripe, Float_t min, Float_t max) const
+{
+  const Int_t    * start = fIdxCellStart[type].GetArray();
+  const Int_t    * item  = fIdxItem    [type].GetArray();
+  const Float_t  * pt    = fIdxPt      [type].GetArray();
+  const Float_t  * value = etaStripe ? fIdxEta[type].GetArray() : fIdxPhi[type].GetArray();
+  const Double_t * binPt = etaStripe ? fIdxEtaBinPt[type].GetArray() : fIdxPhiBinPt[type].GetArray();
+
+  Int_t    nBins    = etaStripe ? kIdxNEta     : kIdxNPhi;
+  Double_t binMin   = etaStripe ? kIdxEtaMin   : 0.;
+  Double_t binWidth = etaStripe ? kIdxEtaWidth : kIdxPhiWidth;
+
+  Int_t firstBin = IndexBin(min-kIdxMargin, binMin, binWidth, nBins);
+  Int_t lastBin  = IndexBin(max+kIdxMargin, binMin, binWidth, nBins);
+
+  Double_t sum      = 0.;
+  Int_t    firstFull = -1;
+  Int_t    lastFull  = -2;
+
+  for(Int_t ibin = firstBin; ibin <= lastBin; ibin++)
+  {
+    Double_t low = binMin + ibin*binWidth;
+
+    Bool_t full = (low-kIdxMargin > min && low+binWidth+kIdxMargin < max);
+    if ( etaStripe && (ibin == 0 || ibin == nBins-1) ) full = kFALSE; // overflows
+
+    if ( full )
+    {
+      if ( firstFull < 0 ) firstFull = ibin;
+      lastFull = ibin;
+      continue;
+    }
+
+    // The cells of an eta bin are consecutive, the ones of a phi bin one eta bin apart
+    Int_t nCells    = etaStripe ? kIdxNPhi     : kIdxNEta;
+    Int_t cellStep  = etaStripe ? 1            : kIdxNPhi;
+    Int_t firstCell = etaStripe ? ibin*kIdxNPhi : ibin;
+
+    for(Int_t icell = 0; icell < nCells; icell++)
+    {
+      Int_t c = firstCell + icell*cellStep;
+      for(Int_t j = start[c]; j < start[c+1]; j++)
+      {
+        Int_t ipr = item[j];
+        if ( value[ipr] > min && value[ipr] < max ) sum += pt[ipr];
+      }
+    }
+  }
+
+  if ( lastFull >= firstFull ) sum += binPt[lastFull+1] - binPt[firstFull];
+
+  return sum;
+}
+
+//_________________________________________________________________________________________________________
+/// Find the indexed entries in the cone of the candidate and the pT sums in the eta and phi bands,
+/// with the same selection as the per particle loops they replace: the candidate and its daughters
+/// are not counted, nor the entries closer than fDistMinToTrigger, the bands do not include the cone.
+/// The bands are the full stripes corrected by the entries around the candidate.
+/// \return number of entries in cone, their list positions are in fIdxInCone in list order.
+//_________________________________________________________________________________________________________
+Int_t AliIsolationCut::FindParticlesInCone(Int_t type, AliAODPWG4ParticleCorrelation * pCandidate, Float_t etaC, Float_t phiC,
+                                           Float_t & etaBandPtSum, Float_t & phiBandPtSum)
+{
+  const Int_t   * start    = fIdxCellStart [type].GetArray();
+  const Int_t   * item     = fIdxItem      [type].GetArray();
+  const Int_t   * next     = fIdxNextSameID[type].GetArray();
+  const Float_t * ptArr    = fIdxPt        [type].GetArray();
+  const Float_t * etaArr   = fIdxEta       [type].GetArray();
+  const Float_t * phiArr   = fIdxPhi       [type].GetArray();
+  Char_t        * excluded = fIdxExcluded  [type].GetArray();
+
+  if ( fIdxInCone.GetSize() < fIdxNEntries[type] ) fIdxInCone.Set(fIdxNEntries[type]);
+  Int_t * inCone = fIdxInCone.GetArray();
+
+  Double_t phiBand = StripePtSum(type, kTRUE , etaC-fConeSize, etaC+fConeSize);
+  Double_t etaBand = StripePtSum(type, kFALSE, phiC-fConeSize, phiC+fConeSize);
+
+  // In case of isolation of single tracks or conversion photon (2 tracks) or pi0 (4 tracks),
+  // or of photon and pi0 clusters, do not count the candidate or the daughters of the candidate
+  Int_t nLabels = 0;
+  Int_t labels[4];
+  if ( type == 0 )
+  {
+    if ( pCandidate->GetDetectorTag() == AliFiducialCut::kCTS ) // make sure conversions are tagged as kCTS!!!
+    {
+      for(Int_t i = 0; i < 4; i++) labels[nLabels++] = pCandidate->GetTrackLabel(i);
+    }
+  }
+  else
+  {
+    labels[nLabels++] = pCandidate->GetCaloLabel(0);
+    labels[nLabels++] = pCandidate->GetCaloLabel(1);
+  }
+
+  for(Int_t i = 0; i < nLabels; i++)
+  {
+    for(Int_t ipr = Int_t(fIdxIDMap[type].GetValue(labels[i]))-1; ipr >= 0; ipr = next[ipr])
+    {
+      if ( excluded[ipr] ) continue ;
+      excluded[ipr] = 1;
+
+      Float_t eta = etaArr[ipr];
+      Float_t phi = phiArr[ipr];
+      if(eta > (etaC-fConeSize) && eta < (etaC+fConeSize)) phiBand -= ptArr[ipr];
+      if(phi > (phiC-fConeSize) && phi < (phiC+fConeSize)) etaBand -= ptArr[ipr];
+    }
+  }
+
+  // Only entries closer than the cone size or fDistMinToTrigger can be in the cone
+  // or be removed from the bands, check the cells around the candidate
+  Float_t rMax = fConeSize;
+  if ( fDistMinToTrigger > rMax ) rMax = fDistMinToTrigger;
+
+  Int_t firstEta = IndexBin(etaC-rMax-kIdxMargin, kIdxEtaMin, kIdxEtaWidth, kIdxNEta);
+  Int_t lastEta  = IndexBin(etaC+rMax+kIdxMargin, kIdxEtaMin, kIdxEtaWidth, kIdxNEta);
+
+  Int_t firstPhi = 0;
+  Int_t nPhi     = kIdxNPhi;
+  if ( rMax+kIdxMargin < TMath::Pi() )
+  {
+    firstPhi     = Int_t(TMath::Floor((phiC-rMax-kIdxMargin)/kIdxPhiWidth));
+    Int_t lastPhi = Int_t(TMath::Floor((phiC+rMax+kIdxMargin)/kIdxPhiWidth));
+    nPhi         = TMath::Min(lastPhi-firstPhi+1, kIdxNPhi);
+  }
+
+  Int_t n = 0;
+  for(Int_t ieta = firstEta; ieta <= lastEta; ieta++)
+  {
+    for(Int_t i = 0; i < nPhi; i++)
+    {
+      Int_t iphi = ((firstPhi+i)%kIdxNPhi + kIdxNPhi)%kIdxNPhi;
+      Int_t c    = ieta*kIdxNPhi+iphi;
+
+      for(Int_t j = start[c]; j < start[c+1]; j++)
+      {
+        Int_t ipr = item[j];
+        if ( excluded[ipr] ) continue ;
+
+        Float_t pt  = ptArr [ipr];
+        Float_t eta = etaArr[ipr];
+        Float_t phi = phiArr[ipr];
+
+        Float_t rad = Radius(etaC, phiC, eta, phi);
+
+        Bool_t inPhiBand = (eta > (etaC-fConeSize) && eta < (etaC+fConeSize));
+        Bool_t inEtaBand = (phi > (phiC-fConeSize) && phi < (phiC+fConeSize));
+
+        // Exclude particles too close to the candidate, inactive by default,
+        // and the cone from the background
+        if ( rad < fDistMinToTrigger || !(rad > fConeSize) )
+        {
+          if ( inPhiBand ) phiBand -= pt;
+          if ( inEtaBand ) etaBand -= pt;
+        }
+
+        if ( rad < fDistMinToTrigger ) continue ;
+
+        // Only loop the particle at the same side of candidate
+        if ( TMath::Abs(phi-phiC) > TMath::PiOver2() ) continue ;
+
+        if ( rad < fConeSize ) inCone[n++] = ipr;
+      }
+    }
+  }
+
+  for(Int_t i = 0; i < nLabels; i++)
+  {
+    for(Int_t ipr = Int_t(fIdxIDMap[type].GetValue(labels[i]))-1; ipr >= 0; ipr = next[ipr]) excluded[ipr] = 0;
+  }
+
+  std::sort(inCone, inCone+n);
+
+  etaBandPtSum = etaBand;
+  phiBandPtSum = phiBand;
+
+  return n;
+}
+
 //_________________________________________________________________________________________________________________________________
 /// Get normalization of cluster background band.
 //_________________________________________________________________________________________________________________________________
@@ -195,45 +597,31 @@ Float_t AliIsolationCut::GetCellDensity(AliAODPWG4ParticleCorrelation * pCandida
       Int_t rowC = iPhi + AliEMCALGeoParams::fgkEMCALRows*int(nSupMod/2);
 
       Int_t sqrSize = int(fConeSize/0.0143) ; // Size of cell in radians
-      //loop on cells in a square of side fConeSize to check cells in cone
-      for(Int_t icol = colC-sqrSize; icol < colC+sqrSize;icol++)
+      //loop on rows in a square of side fConeSize, the cells in cone of a row are
+      //the columns closer to the candidate than a given width
+      for(Int_t irow = rowC-sqrSize; irow < rowC+sqrSize; irow++)
       {
-        for(Int_t irow = rowC-sqrSize; irow < rowC+sqrSize; irow++)
+        Int_t width = ConeHalfWidth(colC, rowC, irow, sqrSize);
+        if ( width < 0 ) continue ;
+
+        Int_t colMin = colC-width;
+        Int_t colMax = colC+width;
+        coneCells += colMax-colMin+1;
+
+        //Count as bad "cells" out of EMCAL acceptance
+        Int_t accMin = TMath::Max(colMin, 0);
+        Int_t accMax = TMath::Min(colMax, AliEMCALGeoParams::fgkEMCALCols*2);
+        if(accMin > accMax || irow < 0 || irow > AliEMCALGeoParams::fgkEMCALRows*16./3) //5*nRows+1/3*nRows
         {
-          if (Radius(colC, rowC, icol, irow) < sqrSize)
-          {
-            coneCells += 1.;
-
-            Int_t cellSM  = -999;
-            Int_t cellEta = -999;
-            Int_t cellPhi = -999;
-            if(icol > AliEMCALGeoParams::fgkEMCALCols-1)
-            {
-              cellSM = 0+int(irow/AliEMCALGeoParams::fgkEMCALRows)*2;
-              cellEta = icol-AliEMCALGeoParams::fgkEMCALCols;
-              cellPhi = irow-AliEMCALGeoParams::fgkEMCALRows*int(cellSM/2);
-            }
-            if(icol < AliEMCALGeoParams::fgkEMCALCols)
-            {
-              cellSM = 1+int(irow/AliEMCALGeoParams::fgkEMCALRows)*2;
-              cellEta = icol;
-              cellPhi = irow-AliEMCALGeoParams::fgkEMCALRows*int(cellSM/2);
-            }
-
-            //Count as bad "cells" out of EMCAL acceptance
-            if(icol < 0 || icol > AliEMCALGeoParams::fgkEMCALCols*2 ||
-               irow < 0 || irow > AliEMCALGeoParams::fgkEMCALRows*16./3) //5*nRows+1/3*nRows
-            {
-              coneCellsBad += 1.;
-            }
-            //Count as bad "cells" marked as bad in the DataBase
-            else if (cu->GetEMCALChannelStatus(cellSM,cellEta,cellPhi)==1)
-            {
-              coneCellsBad += 1. ;
-            }
-          }
+          coneCellsBad += colMax-colMin+1;
+          continue;
         }
-      }//end of cells loop
+
+        coneCellsBad += (colMax-colMin) - (accMax-accMin);
+
+        //Count as bad "cells" marked as bad in the DataBase
+        coneCellsBad += CountBadCells(reader, irow, accMin, accMax);
+      }//end of rows loop
     }
     else AliWarning("Cluster with bad (eta,phi) in EMCal for energy density calculation");
 
@@ -247,6 +635,66 @@ Float_t AliIsolationCut::GetCellDensity(AliAODPWG4ParticleCorrelation * pCandida
   return cellDensity;
 }
 
+//_________________________________________________________________________________
+/// Cells of the row irow in the cone of the cell (colC,rowC), see GetCellDensity.
+/// \return w, the cells in cone are the columns colC-w to colC+w, -1 if none.
+//_________________________________________________________________________________
+Int_t AliIsolationCut::ConeHalfWidth(Int_t colC, Int_t rowC, Int_t irow, Int_t sqrSize) const
+{
+  Int_t width = -1;
+  while ( width+1 < sqrSize && Radius(colC, rowC, colC+width+1, irow) < sqrSize ) width++;
+  return width;
+}
+
+//_________________________________________________________________________________
+/// Number of EMCal cells marked as bad in the DataBase in the row irow, columns colMin to colMax.
+/// The bad cells of a row are counted once per run.
+//_________________________________________________________________________________
+Int_t AliIsolationCut::CountBadCells(AliCaloTrackReader * reader, Int_t irow, Int_t colMin, Int_t colMax) const
+{
+  Int_t run = reader->GetInputEvent()->GetRunNumber();
+  if ( run != fBadCellRun )
+  {
+    fBadCellRun = run;
+    fBadCellRowFilled.Set(kBadCellNRows);
+    fBadCellRowFilled.Reset();
+    fBadCellRowSum.Set(kBadCellNRows*(kBadCellNCols+1));
+  }
+
+  Int_t * sum = fBadCellRowSum.GetArray() + irow*(kBadCellNCols+1);
+
+  if ( !fBadCellRowFilled[irow] )
+  {
+    AliCalorimeterUtils *cu = reader->GetCaloUtils();
+
+    sum[0] = 0;
+    for(Int_t icol = 0; icol < kBadCellNCols; icol++)
+    {
+      Int_t cellSM  = -999;
+      Int_t cellEta = -999;
+      Int_t cellPhi = -999;
+      if(icol > AliEMCALGeoParams::fgkEMCALCols-1)
+      {
+        cellSM = 0+int(irow/AliEMCALGeoParams::fgkEMCALRows)*2;
+        cellEta = icol-AliEMCALGeoParams::fgkEMCALCols;
+        cellPhi = irow-AliEMCALGeoParams::fgkEMCALRows*int(cellSM/2);
+      }
+      if(icol < AliEMCALGeoParams::fgkEMCALCols)
+      {
+        cellSM = 1+int(irow/AliEMCALGeoParams::fgkEMCALRows)*2;
+        cellEta = icol;
+        cellPhi = irow-AliEMCALGeoParams::fgkEMCALRows*int(cellSM/2);
+      }
+
+      sum[icol+1] = sum[icol] + (cu->GetEMCALChannelStatus(cellSM,cellEta,cellPhi)==1 ? 1 : 0);
+    }
+
+    fBadCellRowFilled[irow] = 1;
+  }
+
+  return sum[colMax+1] - sum[colMin];
+}
+
 //___________________________________________________________________________________
 /// Get good cell density (number of active cells over all cells in cone).
 //___________________________________________________________________________________
@@ -282,41 +730,44 @@ void AliIsolationCut::GetCoeffNormBadCell(AliAODPWG4ParticleCorrelation * pCandi
       Int_t rowC = iPhi + AliEMCALGeoParams::fgkEMCALRows*int(nSupMod/2);
 
       Int_t sqrSize = int(fConeSize/0.0143) ; // Size of cell in radians
-      for(Int_t icol = 0; icol < 2*AliEMCALGeoParams::fgkEMCALCols-1;icol++)
+      Int_t lastCol = 2*AliEMCALGeoParams::fgkEMCALCols-2;
+      Int_t lastRow = 5*AliEMCALGeoParams::fgkEMCALRows-2;
+      //in each row the cone is a range of columns around the candidate, the phi band
+      //the other columns closer than sqrSize, the eta band the rest of the row if the row is closer than sqrSize
+      for(Int_t irow = 0; irow <= lastRow; irow++)
       {
-        for(Int_t irow = 0; irow < 5*AliEMCALGeoParams::fgkEMCALRows -1; irow++)
+        Int_t width   = ConeHalfWidth(colC, rowC, irow, sqrSize);
+        Int_t coneMin = TMath::Max(colC-width, 0);
+        Int_t coneMax = TMath::Min(colC+width, lastCol);
+        Int_t nCone   = 0;
+        Int_t badCone = 0;
+        if ( width >= 0 && coneMin <= coneMax )
+        {
+          nCone   = coneMax-coneMin+1;
+          badCone = CountBadCells(reader, irow, coneMin, coneMax);
+        }
+
+        Int_t bandMin = TMath::Max(colC-sqrSize+1, 0);
+        Int_t bandMax = TMath::Min(colC+sqrSize-1, lastCol);
+        Int_t nBand   = 0;
+        Int_t badBand = 0;
+        if ( bandMin <= bandMax )
+        {
+          nBand   = bandMax-bandMin+1 - nCone;
+          badBand = CountBadCells(reader, irow, bandMin, bandMax) - badCone;
+        }
+
+        coneCells            += nCone;
+        coneBadCellsCoeff    += badCone;
+        phiBandCells         += nBand;
+        phiBandBadCellsCoeff += badBand;
+
+        if( irow>rowC-sqrSize  &&  irow<rowC+sqrSize )
         {
-          //loop on cells in a square of side fConeSize to check cells in cone
-          if     ( Radius(colC, rowC, icol, irow) < sqrSize ) { coneCells    += 1.; }
-          else if( icol>colC-sqrSize  &&  icol<colC+sqrSize ) { phiBandCells += 1 ; }
-          else if( irow>rowC-sqrSize  &&  irow<rowC+sqrSize ) { etaBandCells += 1 ; }
-
-          Int_t cellSM  = -999;
-          Int_t cellEta = -999;
-          Int_t cellPhi = -999;
-          if(icol > AliEMCALGeoParams::fgkEMCALCols-1)
-          {
-            cellSM = 0+int(irow/AliEMCALGeoParams::fgkEMCALRows)*2;
-            cellEta = icol-AliEMCALGeoParams::fgkEMCALCols;
-            cellPhi = irow-AliEMCALGeoParams::fgkEMCALRows*int(cellSM/2);
-          }
-          if(icol < AliEMCALGeoParams::fgkEMCALCols)
-          {
-            cellSM = 1+int(irow/AliEMCALGeoParams::fgkEMCALRows)*2;
-            cellEta = icol;
-            cellPhi = irow-AliEMCALGeoParams::fgkEMCALRows*int(cellSM/2);
-          }
-
-          if( (icol < 0 || icol > AliEMCALGeoParams::fgkEMCALCols*2-1 ||
-               irow < 0 || irow > AliEMCALGeoParams::fgkEMCALRows*5 - 1) //5*nRows+1/3*nRows //Count as bad "cells" out of EMCAL acceptance
-             || (cu->GetEMCALChannelStatus(cellSM,cellEta,cellPhi)==1))  //Count as bad "cells" marked as bad in the DataBase
-          {
-            if     ( Radius(colC, rowC, icol, irow) < sqrSize ) coneBadCellsCoeff    += 1.;
-            else if( icol>colC-sqrSize  &&  icol<colC+sqrSize ) phiBandBadCellsCoeff += 1 ;
-	          else if( irow>rowC-sqrSize  &&  irow<rowC+sqrSize ) etaBandBadCellsCoeff += 1 ;
-          }
+          etaBandCells         += lastCol+1 - nCone - nBand;
+          etaBandBadCellsCoeff += CountBadCells(reader, irow, 0, lastCol) - badCone - badBand;
         }
-      }//end of cells loop
+      }//end of rows loop
     }
     else AliWarning("Cluster with bad (eta,phi) in EMCal for energy density coeff calculation");
 
@@ -428,9 +879,6 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   Float_t etaC  = pCandidate->Eta() ;
   
   Float_t pt     = -100. ;
-  Float_t eta    = -100. ;
-  Float_t phi    = -100. ;
-  Float_t rad    = -100. ;
   
   Float_t coneptsumCluster = 0;
   Float_t coneptsumTrack   = 0;
@@ -460,141 +908,39 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   if(plCTS &&
      (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged))
   {
-    for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
+    // The tracks are indexed in eta-phi cells once per event, only
+    // the cells around the candidate and the band limits are checked
+    BuildParticleIndex(0, plCTS, reader, pid);
+
+    Int_t nInCone = FindParticlesInCone(0, pCandidate, etaC, phiC, etaBandPtSumTrack, phiBandPtSumTrack);
+
+    for(Int_t i = 0; i < nInCone; i++)
     {
-      AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
-      
-      if(track)
+      Int_t ipr = fIdxInCone[i];
+      pt = fIdxPt[0][ipr];
+
+      AliDebug(2,Form("\t Track %d, pT %2.2f, eta %1.2f, phi %2.2f, inside candidate cone", ipr,pt,fIdxEta[0][ipr],fIdxPhi[0][ipr]));
+
+      if(bFillAOD)
       {
-        // In case of isolation of single tracks or conversion photon (2 tracks) or pi0 (4 tracks),
-        // do not count the candidate or the daughters of the candidate
-        // in the isolation conte
-        if ( pCandidate->GetDetectorTag() == AliFiducialCut::kCTS ) // make sure conversions are tagged as kCTS!!!
-        {
-          Int_t  trackID   = reader->GetTrackID(track) ; // needed instead of track->GetID() since AOD needs some manipulations
-          Bool_t contained = kFALSE;
-          
-          for(Int_t i = 0; i < 4; i++) 
-          {
-            if( trackID == pCandidate->GetTrackLabel(i) ) contained = kTRUE;
-          }
-          
-          if ( contained ) continue ;
-        }
-        
-        fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
-        pt  = fTrackVector.Pt();
-        eta = fTrackVector.Eta();
-        phi = fTrackVector.Phi() ;
-      }
-      else
-      {// Mixed event stored in AliAODPWG4Particles
-        AliAODPWG4Particle * trackmix = dynamic_cast<AliAODPWG4Particle*>(plCTS->At(ipr)) ;
-        if(!trackmix)
+        ntrackrefs++;
+        if(ntrackrefs == 1)
         {
-          AliWarning("Wrong track data type, continue");
-          continue;
+          reftracks = new TObjArray(0);
+          //reftracks->SetName(Form("Tracks%s",aodArrayRefName.Data()));
+          TString tempo(aodArrayRefName)  ;
+          tempo += "Tracks" ;
+          reftracks->SetName(tempo);
+          reftracks->SetOwner(kFALSE);
         }
-        
-        pt  = trackmix->Pt();
-        eta = trackmix->Eta();
-        phi = trackmix->Phi() ;
-      }
-      
-      // ** Calculate distance between candidate and tracks **
-      
-      if ( phi < 0 ) phi+=TMath::TwoPi();
-      
-      rad = Radius(etaC, phiC, eta, phi);
-      
-      // ** Exclude tracks too close to the candidate, inactive by default **
-      
-      if(rad < fDistMinToTrigger) continue ;
-      
-      // ** For the background out of cone **
-      
-      if(rad > fConeSize)
-      {
-        if(eta > (etaC-fConeSize) && eta < (etaC+fConeSize)) phiBandPtSumTrack += pt;
-        if(phi > (phiC-fConeSize) && phi < (phiC+fConeSize)) etaBandPtSumTrack += pt;
+        reftracks->Add(dynamic_cast<AliVTrack*>(plCTS->At(ipr)));
       }
-      
-      // ** For the isolated particle **
-      
-      // Only loop the particle at the same side of candidate
-      if(TMath::Abs(phi-phiC) > TMath::PiOver2()) continue ;
-      
-//      // If at the same side has particle larger than candidate,
-//      // then candidate can not be the leading, skip such events
-//      if(pt > ptC)
-//      {
-//        n         = -1;
-//        nfrac     = -1;
-//        coneptsumTrack = -1;
-//        isolated  = kFALSE;
-//
-//        pCandidate->SetLeadingParticle(kFALSE);
-//
-//        if(bFillAOD && reftracks)
-//        {
-//          reftracks->Clear();
-//          delete reftracks;
-//        }
-//
-//        return ;
-//      }
-      
-      AliDebug(2,Form("\t Track %d, pT %2.2f, eta %1.2f, phi %2.2f, R candidate %2.2f", ipr,pt,eta,phi,rad));
-      
-      //
-      // Select tracks inside the isolation radius
-      //
-      if(rad < fConeSize)
-      {
-        AliDebug(2,"Inside candidate cone");
-        
-        if(bFillAOD)
-        {
-          ntrackrefs++;
-          if(ntrackrefs == 1)
-          {
-            reftracks = new TObjArray(0);
-            //reftracks->SetName(Form("Tracks%s",aodArrayRefName.Data()));
-            TString tempo(aodArrayRefName)  ;
-            tempo += "Tracks" ;
-            reftracks->SetName(tempo);
-            reftracks->SetOwner(kFALSE);
-          }
-          reftracks->Add(track);
-        }
-        
-        coneptsumTrack+=pt;
-        
-        if( ptLead < pt ) ptLead = pt;
-        
-//        // *Before*, count particles in cone
-//        if(pt > fPtThreshold && pt < fPtThresholdMax)  n++;
-//
-//        //if fPtFraction*ptC<fPtThreshold then consider the fPtThreshold directly
-//        if(fFracIsThresh)
-//        {
-//          if( fPtFraction*ptC < fPtThreshold )
-//          {
-//            if( pt > fPtThreshold )    nfrac++ ;
-//          }
-//          else
-//          {
-//            if( pt > fPtFraction*ptC ) nfrac++;
-//          }
-//        }
-//        else
-//        {
-//          if( pt > fPtFraction*ptC ) nfrac++;
-//        }
-        
-      } // Inside cone
-      
-    }// charged particle loop
+
+      coneptsumTrack+=pt;
+
+      if( ptLead < pt ) ptLead = pt;
+
+    }// charged particle in cone loop
     
   }//Tracks
   
@@ -606,152 +952,38 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
      (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged))
   {
     
-    for(Int_t ipr = 0;ipr < plNe->GetEntries() ; ipr ++ )
+    // Same for the clusters, matched clusters are not indexed if rejected
+    BuildParticleIndex(1, plNe, reader, pid);
+
+    Int_t nInCone = FindParticlesInCone(1, pCandidate, etaC, phiC, etaBandPtSumCluster, phiBandPtSumCluster);
+
+    for(Int_t i = 0; i < nInCone; i++)
     {
-      AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
-      
-      if(calo)
+      Int_t ipr = fIdxInCone[i];
+      pt = fIdxPt[1][ipr];
+
+      AliDebug(2,Form("\t Cluster %d, pT %2.2f, eta %1.2f, phi %2.2f, inside candidate cone", ipr,pt,fIdxEta[1][ipr],fIdxPhi[1][ipr]));
+
+      if(bFillAOD)
       {
-        // Get the index where the cluster comes, to retrieve the corresponding vertex
-        Int_t evtIndex = 0 ;
-        if (reader->GetMixedEvent())
-          evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
-        
-        
-        // Do not count the candidate (photon or pi0) or the daughters of the candidate
-        if(calo->GetID() == pCandidate->GetCaloLabel(0) ||
-           calo->GetID() == pCandidate->GetCaloLabel(1)   ) continue ;
-        
-        // Skip matched clusters with tracks in case of neutral+charged analysis
-        if(fIsTMClusterInConeRejected)
-        {
-          if( fPartInCone == kNeutralAndCharged &&
-             pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent()) ) continue ;
-        }
-        
-        // Assume that come from vertex in straight line
-        calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
-        
-        pt  = fMomentum.Pt()  ;
-        eta = fMomentum.Eta() ;
-        phi = fMomentum.Phi() ;
-      }
-      else
-      {// Mixed event stored in AliAODPWG4Particles
-        AliAODPWG4Particle * calomix = dynamic_cast<AliAODPWG4Particle*>(plNe->At(ipr)) ;
-        if(!calomix)
+        nclusterrefs++;
+        if(nclusterrefs==1)
         {
-          AliWarning("Wrong calo data type, continue");
-          continue;
+          refclusters = new TObjArray(0);
+          //refclusters->SetName(Form("Clusters%s",aodArrayRefName.Data()));
+          TString tempo(aodArrayRefName)  ;
+          tempo += "Clusters" ;
+          refclusters->SetName(tempo);
+          refclusters->SetOwner(kFALSE);
         }
-        
-        pt  = calomix->Pt();
-        eta = calomix->Eta();
-        phi = calomix->Phi() ;
+        refclusters->Add(dynamic_cast<AliVCluster *>(plNe->At(ipr)));
       }
-      
-      // ** Calculate distance between candidate and tracks **
-      
-      if( phi < 0 ) phi+=TMath::TwoPi();
-      
-      rad = Radius(etaC, phiC, eta, phi);
-      
-      // ** Exclude clusters too close to the candidate, inactive by default **
-      
-      if(rad < fDistMinToTrigger) continue ;
-      
-      // ** For the background out of cone **
-      
-      if(rad > fConeSize)
-      {
-        if(eta > (etaC-fConeSize) && eta < (etaC+fConeSize)) phiBandPtSumCluster += pt;
-        if(phi > (phiC-fConeSize) && phi < (phiC+fConeSize)) etaBandPtSumCluster += pt;
-      }
-      
-      // ** For the isolated particle **
-      
-      // Only loop the particle at the same side of candidate
-      if(TMath::Abs(phi-phiC)>TMath::PiOver2()) continue ;
-      
-//      // If at the same side has particle larger than candidate,
-//      // then candidate can not be the leading, skip such events
-//      if(pt > ptC)
-//      {
-//        n         = -1;
-//        nfrac     = -1;
-//        coneptsumCluster = -1;
-//        isolated  = kFALSE;
-//
-//        pCandidate->SetLeadingParticle(kFALSE);
-//
-//        if(bFillAOD)
-//        {
-//          if(reftracks)
-//          {
-//            reftracks  ->Clear();
-//            delete reftracks;
-//          }
-//
-//          if(refclusters)
-//          {
-//            refclusters->Clear();
-//            delete refclusters;
-//          }
-//        }
-//        return ;
-//      }
-      
-      AliDebug(2,Form("\t Cluster %d, pT %2.2f, eta %1.2f, phi %2.2f, R candidate %2.2f", ipr,pt,eta,phi,rad));
-      
-      //
-      // Select calorimeter clusters inside the isolation radius 
-      //
-      if(rad < fConeSize)
-      {
-        AliDebug(2,"Inside candidate cone");
-        
-        if(bFillAOD)
-        {
-          nclusterrefs++;
-          if(nclusterrefs==1)
-          {
-            refclusters = new TObjArray(0);
-            //refclusters->SetName(Form("Clusters%s",aodArrayRefName.Data()));
-            TString tempo(aodArrayRefName)  ;
-            tempo += "Clusters" ;
-            refclusters->SetName(tempo);
-            refclusters->SetOwner(kFALSE);
-          }
-          refclusters->Add(calo);
-        }
-        
-        coneptsumCluster+=pt;
-        
-        if( ptLead < pt ) ptLead = pt;
-        
-//        // *Before*, count particles in cone
-//        if(pt > fPtThreshold && pt < fPtThresholdMax)  n++;
-//
-//        //if fPtFraction*ptC<fPtThreshold then consider the fPtThreshold directly
-//        if(fFracIsThresh)
-//        {
-//          if( fPtFraction*ptC < fPtThreshold )
-//          {
-//            if( pt > fPtThreshold )    nfrac++ ;
-//          }
-//          else
-//          {
-//            if( pt > fPtFraction*ptC ) nfrac++;
-//          }
-//        }
-//        else
-//        {
-//          if( pt > fPtFraction*ptC ) nfrac++;
-//        }
-        
-      }//in cone
-      
-    }// neutral particle loop
+
+      coneptsumCluster+=pt;
+
+      if( ptLead < pt ) ptLead = pt;
+
+    }// neutral particle in cone loop
     
   }//neutrals
   
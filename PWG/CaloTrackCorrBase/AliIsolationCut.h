@@ -22,6 +22,11 @@
 #include <TObject.h>
 class TObjArray ;
 #include <TLorentzVector.h>
+#include <TArrayC.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
+#include <TArrayI.h>
+#include <TExMap.h>
 
 // --- ANALYSIS system ---
 class AliAODPWG4ParticleCorrelation ;
@@ -112,6 +117,21 @@ class AliIsolationCut : public TObject {
     
  private:
 
+  // Eta-phi index of the tracks and clusters, see MakeIsolationCut
+
+  void       BuildParticleIndex(Int_t type, TObjArray * list, AliCaloTrackReader * reader, AliCaloPID * pid) ;
+
+  Int_t      FindParticlesInCone(Int_t type, AliAODPWG4ParticleCorrelation * pCandidate, Float_t etaC, Float_t phiC,
+                                 Float_t & etaBandPtSum, Float_t & phiBandPtSum) ;
+
+  Double_t   StripePtSum(Int_t type, Bool_t etaStripe, Float_t min, Float_t max) const ;
+
+  // EMCal bad cells, see GetCellDensity
+
+  Int_t      ConeHalfWidth(Int_t colC, Int_t rowC, Int_t irow, Int_t sqrSize) const ;
+
+  Int_t      CountBadCells(AliCaloTrackReader * reader, Int_t irow, Int_t colMin, Int_t colMax) const ;
+
   Float_t    fConeSize ;         ///< Size of the isolation cone
 
   Float_t    fPtThreshold ;      ///< Minimum pt of the particles in the cone or sum in cone (UE pt mean in the forward region cone)
@@ -140,6 +160,42 @@ class AliIsolationCut : public TObject {
 
   TVector3   fTrackVector;       //!<! Track moment, temporal object.
 
+  TObjArray * fIdxList[2];       //!<! Track (0) and cluster (1) lists in the index.
+
+  Int_t      fIdxFillId[2];      //!<! Reader fill counter when the lists were indexed, -1 if not a list of the reader.
+
+  Int_t      fIdxNEntries[2];    //!<! Entries of the indexed lists.
+
+  TArrayI    fIdxCell[2];        //!<! Eta-phi cell of each list entry, -1 if not indexed.
+
+  TArrayI    fIdxCellStart[2];   //!<! First entry of each cell in fIdxItem, one more value for the end.
+
+  TArrayI    fIdxItem[2];        //!<! List positions of the indexed entries, sorted by cell.
+
+  TArrayF    fIdxPt[2];          //!<! pT of each list entry.
+
+  TArrayF    fIdxEta[2];         //!<! Eta of each list entry.
+
+  TArrayF    fIdxPhi[2];         //!<! Phi of each list entry, in [0,2pi].
+
+  TArrayI    fIdxNextSameID[2];  //!<! Next list entry with the same track/cluster ID, -1 if none.
+
+  TExMap     fIdxIDMap[2];       //!<! Track/cluster ID -> first list entry with this ID + 1, not for mixed event particles.
+
+  TArrayC    fIdxExcluded[2];    //!<! List entries belonging to the current candidate.
+
+  TArrayD    fIdxEtaBinPt[2];    //!<! Prefix sums of the pT of the indexed entries over the eta bins.
+
+  TArrayD    fIdxPhiBinPt[2];    //!<! Prefix sums of the pT of the indexed entries over the phi bins.
+
+  TArrayI    fIdxInCone;         //!<! List positions of the entries in the cone of the current candidate.
+
+  mutable TArrayC fBadCellRowFilled; //!<! EMCal (col,row) bad cell table filled for this row.
+
+  mutable TArrayI fBadCellRowSum;    //!<! Per row, number of bad cells in the columns before each column.
+
+  mutable Int_t   fBadCellRun;       //!<! Run of the bad cell table.
+
   /// Copy constructor not implemented.
   AliIsolationCut(              const AliIsolationCut & g) ;
 
@@ -147,7 +203,7 @@ class AliIsolationCut : public TObject {
   AliIsolationCut & operator = (const AliIsolationCut & g) ; 
 
   /// \cond CLASSIMP
-  ClassDef(AliIsolationCut,11) ;
+  ClassDef(AliIsolationCut,12) ;
   /// \endcond
 
 } ;
@@ -23,9 +23,12 @@
 #include <TH1F.h>
 #include <TProfile.h>
 #include <TSystem.h>
+#include <TMethod.h>
 #include <TFile.h>
 #include <TChain.h>
 #include <TKey.h>
+#include <TBufferFile.h>
+#include <TMD5.h>
 
 #include "AliAnalysisTaskEmcal.h"
 #include "AliAnalysisUtils.h"
@@ -35,8 +38,10 @@
 #include "AliAnalysisManager.h"
 #include "AliCentrality.h"
 #include "AliEmcalDownscaleFactorsOCDB.h"
+#include "AliEmcalEventSkim.h"
 #include "AliEMCALGeometry.h"
 #include "AliEmcalPythiaInfo.h"
+#include "AliEmcalTrackSelectionService.h"
 #include "AliEMCALTriggerPatchInfo.h"
 #include "AliESDEvent.h"
 #include "AliAODInputHandler.h"
@@ -116,6 +121,7 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal() :
   fPtHardAndJetPtFactor(0.),
   fPtHardAndClusterPtFactor(0.),
   fPtHardAndTrackPtFactor(0.),
+  fEventSkimDirectory(),
   fRunNumber(-1),
   fAliAnalysisUtils(nullptr),
   fIsEsd(kFALSE),
@@ -143,6 +149,9 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal() :
   fNTrials(0),
   fXsection(0),
   fPythiaInfo(nullptr),
+  fEventSkim(nullptr),
+  fSharedObjects(nullptr),
+  fOwnSharedObjects(kFALSE),
   fOutput(nullptr),
   fHistEventCount(nullptr),
   fHistTrialsAfterSel(nullptr),
@@ -227,6 +236,7 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal(const char *name, Bool_t histo) :
   fPtHardAndJetPtFactor(0.),
   fPtHardAndClusterPtFactor(0.),
   fPtHardAndTrackPtFactor(0.),
+  fEventSkimDirectory(),
   fRunNumber(-1),
   fAliAnalysisUtils(nullptr),
   fIsEsd(kFALSE),
@@ -254,6 +264,9 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal(const char *name, Bool_t histo) :
   fNTrials(0),
   fXsection(0),
   fPythiaInfo(0),
+  fEventSkim(nullptr),
+  fSharedObjects(nullptr),
+  fOwnSharedObjects(kFALSE),
   fOutput(nullptr),
   fHistEventCount(nullptr),
   fHistTrialsAfterSel(nullptr),
@@ -289,6 +302,8 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal(const char *name, Bool_t histo) :
 
 AliAnalysisTaskEmcal::~AliAnalysisTaskEmcal()
 {
+  delete fEventSkim;
+  if (fOwnSharedObjects) delete fSharedObjects;
 }
 
 void AliAnalysisTaskEmcal::SetClusPtCut(Double_t cut, Int_t c)
@@ -571,10 +586,35 @@ void AliAnalysisTaskEmcal::UserExec(Option_t *option)
     return;
 
   if(fFileChanged){
+    if (!fEventSkimDirectory.IsNull()) {
+      if (!fEventSkim) {
+        if (IsEventSkimKeyComplete()) {
+          fEventSkim = new AliEmcalEventSkim(fEventSkimDirectory, GetEventSkimKey());
+        }
+        else {
+          AliWarning(Form("%s: %s overrides IsEventSelected but not GetEventSkimKey, event selection cache disabled.", GetName(), ClassName()));
+          fEventSkimDirectory = "";
+        }
+      }
+      if (fEventSkim) fEventSkim->FileChanged(AliAnalysisManager::GetAnalysisManager()->GetTree());
+    }
     FileChanged();
     fFileChanged = kFALSE;
   }
 
+  // Events rejected in a previous pass with the same configuration are skipped
+  // before any event object is retrieved. Not possible when the cross section
+  // has to be taken from the event header, as it is filled for every event.
+  Char_t skimDecision = fEventSkim ? fEventSkim->GetDecision() : Char_t(AliEmcalEventSkim::kUnknown);
+  if (skimDecision >= AliEmcalEventSkim::kRejected && !(fIsPythia && fUseXsecFromHeader)) {
+    if (fGeneralHistograms) {
+      fHistEventCount->Fill("Rejected",1);
+      if (skimDecision > AliEmcalEventSkim::kRejected)
+        fHistEventRejection->Fill(fHistEventRejection->GetXaxis()->GetBinCenter(skimDecision - AliEmcalEventSkim::kRejected));
+    }
+    return;
+  }
+
   if (!RetrieveEventObjects())
     return;
 
@@ -601,7 +641,12 @@ void AliAnalysisTaskEmcal::UserExec(Option_t *option)
     fHistXsection->Fill(pthardbin, fPythiaHeader->GetXsection());
   }
 
-  if (IsEventSelected()) {
+  Bool_t recordDecision = fEventSkim && skimDecision == AliEmcalEventSkim::kUnknown;
+  if (recordDecision) fEventSkim->PrepareDecision(fHistEventRejection);
+  Bool_t selected = IsEventSelected();
+  if (recordDecision) fEventSkim->SetDecision(selected, fHistEventRejection);
+
+  if (selected) {
     if (fGeneralHistograms) fHistEventCount->Fill("Accepted",1);
   }
   else {
@@ -818,6 +863,10 @@ Bool_t AliAnalysisTaskEmcal::UserNotify(){
   return kTRUE;
 }
 
+void AliAnalysisTaskEmcal::FinishTaskOutput(){
+  if (fEventSkim) fEventSkim->Close();
+}
+
 Bool_t AliAnalysisTaskEmcal::FileChanged(){
   if (!fIsPythia || !fGeneralHistograms || !fCreateHisto)
     return kTRUE;
@@ -906,6 +955,8 @@ void AliAnalysisTaskEmcal::ExecOnce()
   //Load all requested track branches - each container knows name already
   for (Int_t i =0; i<fParticleCollArray.GetEntriesFast(); i++) {
     AliParticleContainer *cont = static_cast<AliParticleContainer*>(fParticleCollArray.At(i));
+    AliTrackContainer *trackCont = dynamic_cast<AliTrackContainer*>(cont);
+    if (trackCont) trackCont->SetTrackSelectionService(AliEmcalTrackSelectionService::Request(GetSharedObjects()));
     cont->SetArray(InputEvent());
   }
 
@@ -1254,6 +1305,72 @@ Bool_t AliAnalysisTaskEmcal::IsEventSelected()
   return kTRUE;
 }
 
+TString AliAnalysisTaskEmcal::GetEventSkimKey() const
+{
+  TString key = TString::Format("%s:%s;", ClassName(), GetName());
+  key += TString::Format("trg:%u,%s,%d,%d,%s;", fOffTrigger, fTrigClass.Data(), fTriggerTypeSel, fEMCalTriggerMode, fCaloTriggerPatchInfoName.Data());
+  key += TString::Format("cent:%s,%d,%d,%d,%g,%g;", fCentEst.Data(), fUseNewCentralityEstimation, fNcentBins, fForceBeamType, fMinCent, fMaxCent);
+  key += TString::Format("vtx:%d,%d,%d,%g,%g,%g;", fUseAliAnaUtils, fRejectPileup, fTklVsClusSPDCut, fMinVz, fMaxVz, fZvertexDiff);
+  key += TString::Format("trk:%g,%d,%g,%d;", fTrackPtCut, fMinNTrack, fMinPtTrackInEmcal, fNeedEmcalGeom);
+  key += TString::Format("ep:%g,%g,%g;", fEventPlaneVsEmcal, fMinEventPlane, fMaxEventPlane);
+  key += TString::Format("mc:%d,%d,%d,%d,%d,%g,%g,%g", fIsPythia, fIsHerwig, fSelectPtHardBin, fNPtHardBins, fMCRejectFilter,
+      fPtHardAndJetPtFactor, fPtHardAndClusterPtFactor, fPtHardAndTrackPtFactor);
+  for (Int_t ib = 0; ib < fPtHardBinning.GetSize(); ib++) key += TString::Format(",%d", fPtHardBinning[ib]);
+  key += ";";
+
+  // Physics selection, centrality and trigger information depend on the OADB and software version
+  const char *version = gSystem->Getenv("ALIPHYSICS_VERSION");
+  key += TString::Format("oadb:%s,%s;", AliAnalysisManager::GetOADBPath(), version ? version : "");
+
+  // The streamed state of a container contains all its cut settings
+  const TObjArray *conts[2] = {&fParticleCollArray, &fClusterCollArray};
+  for (Int_t i = 0; i < 2; i++) {
+    TIter next(conts[i]);
+    TObject *cont = 0;
+    while ((cont = next())) {
+      TBufferFile buf(TBuffer::kWrite);
+      cont->Streamer(buf);
+      TMD5 md5;
+      md5.Update(reinterpret_cast<UChar_t*>(buf.Buffer()), buf.Length());
+      md5.Final();
+      key += TString::Format("%s_%s;", cont->ClassName(), md5.AsString());
+    }
+  }
+  return key;
+}
+
+Bool_t AliAnalysisTaskEmcal::IsEventSkimKeyComplete() const
+{
+  // GetMethodAllAny returns the implementation of the most derived class
+  TMethod *selection = IsA()->GetMethodAllAny("IsEventSelected");
+  TMethod *key = IsA()->GetMethodAllAny("GetEventSkimKey");
+  if (!selection || !key) return kFALSE;
+  return key->GetClass()->InheritsFrom(selection->GetClass());
+}
+
+TObjArray *AliAnalysisTaskEmcal::GetSharedObjects()
+{
+  if (fSharedObjects) return fSharedObjects;
+
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if (mgr && mgr->GetTasks()) {
+    TIter next(mgr->GetTasks());
+    TObject *obj = 0;
+    while ((obj = next())) {
+      AliAnalysisTaskEmcal *task = dynamic_cast<AliAnalysisTaskEmcal*>(obj);
+      if (task && task != this && task->fSharedObjects) {
+        fSharedObjects = task->fSharedObjects;
+        return fSharedObjects;
+      }
+    }
+  }
+
+  fSharedObjects = new TObjArray;
+  fSharedObjects->SetOwner(kTRUE);
+  fOwnSharedObjects = kTRUE;
+  return fSharedObjects;
+}
+
 Bool_t AliAnalysisTaskEmcal::CheckMCOutliers()
 {
   if (!fPythiaHeader || !fMCRejectFilter) return kTRUE;
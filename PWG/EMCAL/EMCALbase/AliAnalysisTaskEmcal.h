@@ -20,6 +20,7 @@ class AliAnalysisUtils;
 class AliEMCALTriggerPatchInfo;
 class AliAODTrack;
 class AliEmcalPythiaInfo;
+class AliEmcalEventSkim;
 class AliAODInputHandler;
 class AliESDInputHandler;
 
@@ -282,6 +283,17 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   void                        SetCountDownscaleCorrectedEvents(Bool_t d)            { fCountDownscaleCorrectedEvents =  d                 ; }
   void                        SetOffTrigger(UInt_t t)                               { fOffTrigger        = t                              ; }
 
+  /**
+   * @brief Cache the event selection decisions in the given directory
+   *
+   * One cache file is written per input file and task configuration (see
+   * AliEmcalEventSkim). When the same configuration runs again over the same
+   * input, events rejected before are skipped before the event objects are
+   * retrieved from the event.
+   * @param[in] dir Directory of the cache files (empty: no caching)
+   */
+  void                        SetEventSkimDirectory(const char *dir)                { fEventSkimDirectory = dir                           ; }
+
   /**
    * @brief Apply cut on the pseudorapidity \f$ \eta \f$ of the all tracks in the
    * track container with index c
@@ -604,6 +616,13 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
    */
   Bool_t                      UserNotify();
 
+  /**
+   * @brief Steps to be executed at the end of the processing
+   *
+   * Writes the event skim of the last input file.
+   */
+  void                        FinishTaskOutput();
+
   /**
    * @brief  Steps to be executed when a few file is loaded into the
    * input handler
@@ -685,6 +704,41 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
    */
   virtual Bool_t              IsEventSelected();
 
+  /**
+   * @brief Description of the configuration relevant for the event selection
+   *
+   * Used as key of the event skim: two tasks with the same key must take the
+   * same event selection decision for each event. Contains the class and the
+   * name of the task, the event selection settings, the settings of the
+   * attached containers and the OADB path and software version. Tasks which
+   * extend IsEventSelected with settings of their own must override this
+   * function and add them to the key, otherwise the event skim is not used
+   * (see IsEventSkimKeyComplete).
+   * @return Key of the event selection configuration
+   */
+  virtual TString             GetEventSkimKey() const;
+
+  /**
+   * @brief Check whether GetEventSkimKey covers the event selection of the task
+   *
+   * True if GetEventSkimKey is implemented in the class implementing
+   * IsEventSelected, or in a class derived from it.
+   * @return False if the task has event selection cuts which are not in the key
+   */
+  Bool_t                      IsEventSkimKeyComplete() const;
+
+  /**
+   * @brief List of objects shared by the EMCal tasks of the analysis manager
+   *
+   * The list is created by the first task asking for it and found by the
+   * other tasks in the list of tasks of the analysis manager, so that its
+   * lifetime is bound to the train and not to the process. It hosts the
+   * services evaluating common inputs once per event for all wagons (e.g.
+   * the shared track selections).
+   * @return List of shared objects
+   */
+  TObjArray                  *GetSharedObjects();
+
   /**
    * @brief Retrieve common objects from event.
    *
@@ -860,6 +914,7 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   Float_t                     fPtHardAndJetPtFactor;       ///< Factor between ptHard and jet pT to reject/accept event.
   Float_t                     fPtHardAndClusterPtFactor;   ///< Factor between ptHard and cluster pT to reject/accept event.
   Float_t                     fPtHardAndTrackPtFactor;     ///< Factor between ptHard and track pT to reject/accept event.
+  TString                     fEventSkimDirectory;         ///< Directory of the event selection cache (empty: no caching)
 
   // Service fields
   Int_t                       fRunNumber;                  //!<!run number (triggering RunChanged()
@@ -891,6 +946,9 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   Int_t                       fNTrials;                    //!<!event trials
   Float_t                     fXsection;                   //!<!x-section from pythia header
   AliEmcalPythiaInfo         *fPythiaInfo;                 //!<!event parton info
+  AliEmcalEventSkim          *fEventSkim;                  //!<!event selection cache
+  TObjArray                  *fSharedObjects;              //!<!objects shared with the other EMCal tasks of the analysis manager
+  Bool_t                      fOwnSharedObjects;           //!<!whether the task owns the list of shared objects
 
   // Output
   AliEmcalList               *fOutput;                     //!<!output list
@@ -917,7 +975,7 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcal &operator=(const AliAnalysisTaskEmcal&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcal, 16) // EMCAL base analysis task
+  ClassDef(AliAnalysisTaskEmcal, 18) // EMCAL base analysis task
   /// \endcond
 };
 
@@ -54,8 +54,6 @@
 ClassImp(AliAnalysisTaskEmcalEmbeddingHelper);
 /// \endcond
 
-AliAnalysisTaskEmcalEmbeddingHelper* AliAnalysisTaskEmcalEmbeddingHelper::fgInstance = 0;
-
 /**
  * Default constructor. Needed by ROOT I/O
  */
@@ -102,12 +100,6 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fHistManager(),
   fOutput(nullptr)
 {
-  if (fgInstance != 0) {
-    AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
-    delete fgInstance;
-  }
-
-  fgInstance = this;
 }
 
 /**
@@ -158,26 +150,39 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fHistManager(name),
   fOutput(nullptr)
 {
-  if (fgInstance != 0) {
-    AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
-    delete fgInstance;
+  if (fCreateHisto) {
+    DefineOutput(1, AliEmcalList::Class());
   }
+}
 
-  fgInstance = this;
+/**
+ * Get the embedding helper of the current analysis manager. The helper is looked up
+ * in the task list of the manager (see AddTaskEmcalEmbeddingHelper, which adds at most
+ * one helper per manager), so it belongs to the train and no process-wide state is kept.
+ *
+ * @return Embedding helper of the current analysis manager, NULL if none was added
+ */
+const AliAnalysisTaskEmcalEmbeddingHelper* AliAnalysisTaskEmcalEmbeddingHelper::GetInstance()
+{
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if (!mgr || !mgr->GetTasks()) return 0;
 
-  if (fCreateHisto) {
-    DefineOutput(1, AliEmcalList::Class());
+  TIter next(mgr->GetTasks());
+  TObject *obj = 0;
+  while ((obj = next())) {
+    AliAnalysisTaskEmcalEmbeddingHelper *helper = dynamic_cast<AliAnalysisTaskEmcalEmbeddingHelper*>(obj);
+    if (helper) return helper;
   }
+  return 0;
 }
 
 /**
  * Destructor
  *
- * Deletes the singleton instance and ensures that any open file is closed.
+ * Ensures that any open file is closed.
  */
 AliAnalysisTaskEmcalEmbeddingHelper::~AliAnalysisTaskEmcalEmbeddingHelper()
 {
-  if (fgInstance == this) fgInstance = 0;
   if (fExternalEvent) delete fExternalEvent;
   if (fExternalFile) {
     fExternalFile->Close();
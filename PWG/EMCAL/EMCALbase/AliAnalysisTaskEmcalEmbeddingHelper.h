@@ -48,7 +48,8 @@ class AliEmcalList;
  * - Provide a public method GetExternalEvent() that allows to retrieve a pointer to
  *   the external event.
  *
- * Note that only one instance of this class is allowed in each train (singleton class).
+ * Note that only one instance of this class is allowed in each train. GetInstance()
+ * returns the instance added to the current analysis manager.
  *
  * For the user, most of these details are handled by AliEmcalContainer derived tasks.
  * To access the embedded input objects, the user simply needs to set
@@ -75,7 +76,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void      UserCreateOutputObjects()                            ;
   void      Terminate(Option_t *option)                          ;
 
-  static const AliAnalysisTaskEmcalEmbeddingHelper* GetInstance() { return fgInstance       ; }
+  static const AliAnalysisTaskEmcalEmbeddingHelper* GetInstance();
 
   AliVEvent* GetExternalEvent()                             const { return fExternalEvent   ; }
 
@@ -246,14 +247,12 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   double                                        fPythiaCrossSectionFromFile; //!<! Average pythia cross section extracted from a xsec file.
   double                                        fPythiaPtHard     ; //!<! Pt hard of the current event (extracted from the pythia header).
 
-  static AliAnalysisTaskEmcalEmbeddingHelper   *fgInstance        ; //!<! Global instance of this class
-
  private:
   AliAnalysisTaskEmcalEmbeddingHelper(const AliAnalysisTaskEmcalEmbeddingHelper&)           ; // not implemented
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 5);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 6);
   /// \endcond
 };
 #endif
@@ -0,0 +1,155 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <iostream>
+#include <memory>
+
+#include <TChain.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TMD5.h>
+#include <TSystem.h>
+#include <TTree.h>
+#include <TUUID.h>
+
+#include "AliLog.h"
+
+#include "AliEmcalEventSkim.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalEventSkim)
+/// \endcond
+
+AliEmcalEventSkim::AliEmcalEventSkim() :
+  TObject(),
+  fDirectory(),
+  fKey(),
+  fCacheFile(),
+  fTree(nullptr),
+  fDecisions(),
+  fModified(kFALSE),
+  fRejectionContents()
+{
+}
+
+AliEmcalEventSkim::AliEmcalEventSkim(const char *directory, const char *key) :
+  TObject(),
+  fDirectory(directory),
+  fKey(key),
+  fCacheFile(),
+  fTree(nullptr),
+  fDecisions(),
+  fModified(kFALSE),
+  fRejectionContents()
+{
+}
+
+AliEmcalEventSkim::~AliEmcalEventSkim(){
+  Close();
+}
+
+TString AliEmcalEventSkim::GetCacheFileName(TFile *inputfile, Long64_t nentries) const {
+  TString id = TString::Format("%s;%s;%lld", fKey.Data(), inputfile->GetUUID().AsString(), nentries);
+  TMD5 md5;
+  md5.Update(reinterpret_cast<const UChar_t *>(id.Data()), id.Length());
+  md5.Final();
+  return TString::Format("%s/emcalskim_%s.root", fDirectory.Data(), md5.AsString());
+}
+
+Bool_t AliEmcalEventSkim::FileChanged(TTree *tree){
+  Close();
+  fTree = nullptr;
+  fDecisions.Set(0);
+  fCacheFile = "";
+
+  if(!tree) return kFALSE;
+  TChain *chain = dynamic_cast<TChain *>(tree);
+  if(chain) tree = chain->GetTree();
+  TFile *inputfile = tree ? tree->GetCurrentFile() : nullptr;
+  if(!inputfile) return kFALSE;
+
+  Long64_t nentries = tree->GetEntries();
+  fTree = tree;
+  fCacheFile = GetCacheFileName(inputfile, nentries);
+  fDecisions.Set(nentries);
+  fDecisions.Reset(kUnknown);
+
+  if(!gSystem->AccessPathName(fCacheFile)){
+    std::unique_ptr<TFile> cache(TFile::Open(fCacheFile, "READ"));
+    TArrayC *decisions = cache && !cache->IsZombie() ? static_cast<TArrayC *>(cache->GetObjectChecked("decisions", TArrayC::Class())) : nullptr;
+    if(decisions && decisions->GetSize() == nentries) {
+      fDecisions = *decisions;
+      AliInfoStream() << "Using event skim " << fCacheFile << " for " << inputfile->GetName() << std::endl;
+    } else {
+      AliWarningStream() << "Ignoring inconsistent event skim " << fCacheFile << std::endl;
+    }
+    delete decisions;
+  }
+  return kTRUE;
+}
+
+void AliEmcalEventSkim::Close(){
+  if(!fModified || fCacheFile.IsNull()) return;
+  fModified = kFALSE;
+
+  // Write to a temporary file first, so that jobs running in parallel never see a partial cache
+  gSystem->mkdir(fDirectory, kTRUE);
+  TString tmpname = TString::Format("%s.%d.tmp", fCacheFile.Data(), gSystem->GetPid());
+  std::unique_ptr<TFile> cache(TFile::Open(tmpname, "RECREATE"));
+  if(!cache || cache->IsZombie()) {
+    AliErrorStream() << "Cannot write event skim " << tmpname << std::endl;
+    return;
+  }
+  cache->WriteObjectAny(&fDecisions, TArrayC::Class(), "decisions");
+  cache->Close();
+  gSystem->Rename(tmpname, fCacheFile);
+}
+
+Long64_t AliEmcalEventSkim::GetCurrentEntry() const {
+  return fTree ? fTree->GetReadEntry() : -1;
+}
+
+Char_t AliEmcalEventSkim::GetDecision() const {
+  Long64_t entry = GetCurrentEntry();
+  if(entry < 0 || entry >= fDecisions.GetSize()) return kUnknown;
+  return fDecisions[entry];
+}
+
+void AliEmcalEventSkim::PrepareDecision(const TH1 *rejection){
+  if(!rejection) return;
+  Int_t nbins = rejection->GetNbinsX() + 2;
+  fRejectionContents.Set(nbins);
+  for(Int_t ib = 0; ib < nbins; ib++) fRejectionContents[ib] = rejection->GetBinContent(ib);
+}
+
+void AliEmcalEventSkim::SetDecision(Bool_t accepted, const TH1 *rejection){
+  Long64_t entry = GetCurrentEntry();
+  if(entry < 0 || entry >= fDecisions.GetSize()) return;
+
+  Char_t decision = kAccepted;
+  if(!accepted) {
+    decision = kRejected;
+    if(rejection && fRejectionContents.GetSize() == rejection->GetNbinsX() + 2) {
+      // Only the first filled bin is kept, the event selection stops at the first failing cut
+      for(Int_t ib = 1; ib <= rejection->GetNbinsX() && ib < 127 - kRejected; ib++) {
+        if(rejection->GetBinContent(ib) != fRejectionContents[ib]) {
+          decision = kRejected + ib;
+          break;
+        }
+      }
+    }
+  }
+  fDecisions[entry] = decision;
+  fModified = kTRUE;
+}
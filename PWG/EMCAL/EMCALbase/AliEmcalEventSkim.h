@@ -0,0 +1,127 @@
+#ifndef ALIEMCALEVENTSKIM_H
+#define ALIEMCALEVENTSKIM_H
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <TArrayC.h>
+#include <TArrayD.h>
+#include <TObject.h>
+#include <TString.h>
+
+class TFile;
+class TH1;
+class TTree;
+
+/**
+ * @class AliEmcalEventSkim
+ * @brief Persistent cache of the event selection decisions of a task, per input file
+ * @ingroup EMCALCOREFW
+ *
+ * Trains are often rerun with the same configuration over the same input files.
+ * The event selection of AliAnalysisTaskEmcal only depends on the configuration of
+ * the task and on the event, so the decision can be stored once and reused.
+ *
+ * For each input file a small ROOT file is kept in the skim directory, named after
+ * a checksum of the task configuration (see AliAnalysisTaskEmcal::GetEventSkimKey),
+ * the UUID of the input file and the number of entries of its tree. It contains one
+ * byte per entry of the input tree:
+ * - kUnknown: the event was not processed yet
+ * - kAccepted: the event was accepted
+ * - kRejected: the event was rejected, reason unknown
+ * - kRejected + bin: the event was rejected, bin of the rejection histogram
+ *
+ * Entries with unknown decision are evaluated normally and added to the cache, which
+ * is written when the input file changes or the task finishes.
+ *
+ * ~~~{.cxx}
+ * task->SetEventSkimDirectory("/tmp/emcalskim");
+ * ~~~
+ */
+class AliEmcalEventSkim : public TObject {
+public:
+  /**
+   * @enum Decision_t
+   * @brief Decision codes stored per event
+   */
+  enum Decision_t {
+    kUnknown = -1,     ///< Event not yet evaluated
+    kAccepted = 0,     ///< Event accepted
+    kRejected = 1      ///< Event rejected (values above: rejection histogram bin + 1)
+  };
+
+  AliEmcalEventSkim();
+
+  /**
+   * Constructor
+   * @param[in] directory Directory in which the cache files are kept
+   * @param[in] key Description of the task configuration
+   */
+  AliEmcalEventSkim(const char *directory, const char *key);
+
+  /**
+   * Destructor, writes the cache of the current file
+   */
+  virtual ~AliEmcalEventSkim();
+
+  /**
+   * Switch to the current file of the input tree. The cache of the previous
+   * file is written, the one of the new file is read if it exists.
+   * @param[in] tree Input tree (chain) of the analysis manager
+   * @return True if the cache is usable for the new file
+   */
+  Bool_t FileChanged(TTree *tree);
+
+  /**
+   * Write the cache of the current file if new decisions were added
+   */
+  void Close();
+
+  /**
+   * Get the decision for the current entry of the input tree
+   * @return Decision code, kUnknown if not yet evaluated
+   */
+  Char_t GetDecision() const;
+
+  /**
+   * Remember the contents of the rejection histogram before the event selection
+   * @param[in] rejection Rejection histogram (may be null)
+   */
+  void PrepareDecision(const TH1 *rejection);
+
+  /**
+   * Store the decision for the current entry of the input tree. The rejection
+   * reason is the bin of the rejection histogram which was filled since PrepareDecision.
+   * @param[in] accepted Result of the event selection
+   * @param[in] rejection Rejection histogram (may be null)
+   */
+  void SetDecision(Bool_t accepted, const TH1 *rejection);
+
+  /**
+   * Get the entry of the current tree (not of the chain) being processed
+   * @return Entry, -1 if no tree is available
+   */
+  Long64_t GetCurrentEntry() const;
+
+  const char *GetKey() const { return fKey.Data(); }
+
+protected:
+  TString GetCacheFileName(TFile *inputfile, Long64_t nentries) const;
+
+  TString                     fDirectory;                  ///< Directory of the cache files
+  TString                     fKey;                        ///< Description of the task configuration
+  TString                     fCacheFile;                  //!<! Cache file of the current input file
+  TTree                      *fTree;                       //!<! Input tree of the current file
+  TArrayC                     fDecisions;                  //!<! Decisions per entry of the current file
+  Bool_t                      fModified;                   //!<! New decisions were added
+  TArrayD                     fRejectionContents;          //!<! Contents of the rejection histogram before the event selection
+
+private:
+  AliEmcalEventSkim(const AliEmcalEventSkim &);
+  AliEmcalEventSkim &operator=(const AliEmcalEventSkim &);
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalEventSkim, 1);
+  /// \endcond
+};
+
+#endif /* ALIEMCALEVENTSKIM_H */
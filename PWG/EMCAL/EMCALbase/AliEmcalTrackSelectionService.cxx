@@ -0,0 +1,116 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <iostream>
+
+#include <TClonesArray.h>
+#include <TObjArray.h>
+
+#include "AliAnalysisManager.h"
+#include "AliESDtrack.h"
+#include "AliLog.h"
+#include "AliVTrack.h"
+
+#include "AliTrackContainer.h"
+#include "AliEmcalTrackSelectionService.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalTrackSelectionService)
+/// \endcond
+
+AliEmcalTrackSelectionService::AliEmcalTrackSelectionService() :
+  TObject(),
+  fNSelections(0)
+{
+  for (Int_t i = 0; i < kMaxSelections; i++) {
+    fSelections[i] = nullptr;
+    fFilterTypes[i] = AliEmcalTrackSelection::kNoTrackFilter;
+    fIsESD[i] = kFALSE;
+    fArrays[i] = nullptr;
+    fProcessedEvent[i] = -1;
+    fFilteredTracks[i] = nullptr;
+  }
+}
+
+AliEmcalTrackSelectionService::~AliEmcalTrackSelectionService()
+{
+  for (Int_t i = 0; i < fNSelections; i++) delete fSelections[i];
+}
+
+AliEmcalTrackSelectionService *AliEmcalTrackSelectionService::Request(TObjArray *sharedObjects){
+  if (!sharedObjects) return nullptr;
+  AliEmcalTrackSelectionService *service = static_cast<AliEmcalTrackSelectionService *>(sharedObjects->FindObject(Class()->GetName()));
+  if (!service) {
+    service = new AliEmcalTrackSelectionService;
+    sharedObjects->Add(service);
+  }
+  return service;
+}
+
+Int_t AliEmcalTrackSelectionService::FindSelection(const TString &key, const TClonesArray *tracks) const {
+  for (Int_t i = 0; i < fNSelections; i++) {
+    if (fKeys[i] == key && fArrays[i] == tracks) return i;
+  }
+  return -1;
+}
+
+Int_t AliEmcalTrackSelectionService::AddSelection(const TString &key, const TClonesArray *tracks, AliEmcalTrackSelection *selection, AliEmcalTrackSelection::ETrackFilterType_t filterType, Bool_t isESD){
+  if (!selection) return -1;
+  if (fNSelections >= kMaxSelections) {
+    AliWarningStream() << "Maximum number of shared track selections reached, selection " << key << " will not be shared" << std::endl;
+    return -1;
+  }
+  Int_t id = fNSelections++;
+  fKeys[id] = key;
+  fArrays[id] = tracks;
+  fSelections[id] = selection;
+  fFilterTypes[id] = filterType;
+  fIsESD[id] = isESD;
+  AliInfoStream() << "Registered shared track selection " << id << ": " << key << std::endl;
+  return id;
+}
+
+void AliEmcalTrackSelectionService::Process(Int_t id){
+  if (id < 0 || id >= fNSelections) return;
+
+  // The number of calls of the analysis manager identifies the event (the tree entry
+  // restarts with each file). Without analysis manager the selection is always evaluated
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t event = mgr ? mgr->GetNcalls() : -1;
+  if (event > 0 && event == fProcessedEvent[id]) return;
+  fProcessedEvent[id] = event;
+
+  fFilteredTracks[id] = fSelections[id]->GetAcceptedTracks(fArrays[id]);
+  AliTrackContainer::FillTrackTypes(fFilteredTracks[id], fSelections[id]->GetAcceptedTrackBitmaps(), fFilterTypes[id], fTrackTypes[id]);
+
+  const Int_t ntracks = fFilteredTracks[id]->GetEntriesFast();
+  TBits &mask = fAcceptedMask[id];
+  mask.ResetAllBits();
+  if (fMomenta[id].GetSize() < 3 * ntracks) fMomenta[id].Set(3 * ntracks);
+  Double_t *mom = fMomenta[id].GetArray();
+  const Bool_t checkConstrained = fIsESD[id] && fFilterTypes[id] == AliEmcalTrackSelection::kHybridTracks;
+  for (Int_t i = 0; i < ntracks; i++) {
+    const AliVTrack *track = static_cast<const AliVTrack *>(fFilteredTracks[id]->UncheckedAt(i));
+    if (!track) continue;
+    mask.SetBitNumber(i);
+    Char_t type = fTrackTypes[id][i];
+    if (checkConstrained && (type == AliTrackContainer::kHybridConstrained || type == AliTrackContainer::kHybridConstrainedNoITSrefit)) {
+      const AliExternalTrackParam *par = static_cast<const AliESDtrack *>(track)->GetConstrainedParam();
+      mom[3*i] = par->Pt(); mom[3*i+1] = par->Eta(); mom[3*i+2] = par->Phi();
+    }
+    else {
+      mom[3*i] = track->Pt(); mom[3*i+1] = track->Eta(); mom[3*i+2] = track->Phi();
+    }
+  }
+}
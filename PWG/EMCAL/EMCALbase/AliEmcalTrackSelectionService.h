@@ -0,0 +1,128 @@
+#ifndef ALIEMCALTRACKSELECTIONSERVICE_H
+#define ALIEMCALTRACKSELECTIONSERVICE_H
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <TArrayC.h>
+#include <TArrayD.h>
+#include <TBits.h>
+#include <TObject.h>
+#include <TString.h>
+
+#include "AliEmcalTrackSelection.h"
+
+class TClonesArray;
+class TObjArray;
+
+/**
+ * @class AliEmcalTrackSelectionService
+ * @brief Track selection shared among the track containers of all wagons in a train
+ * @ingroup EMCALCOREFW
+ * @since June 2017
+ *
+ * In jet trains many wagons configure track containers with the same track selection
+ * (hybrid tracks, TPC-only tracks or AOD filter bits) on the same track array. The
+ * service evaluates every distinct pair of selection and track array only once per event.
+ * For each of them it publishes
+ * - the array of selected tracks (rejected tracks are NULL),
+ * - a bitmask of the accepted track indices,
+ * - the track types (hybrid global / constrained),
+ * - the track momenta (\f$ p_{t} \f$, \f$ \eta \f$, \f$ \phi \f$), using the constrained parameters where needed.
+ *
+ * Track containers register their selection in AliTrackContainer::SetArray and read
+ * the results in AliTrackContainer::NextEvent. Selections with user-defined cut
+ * objects are not shared.
+ *
+ * The service lives in the list of objects shared by the EMCal
+ * tasks of an analysis manager (see AliAnalysisTaskEmcal::GetSharedObjects), which
+ * passes it to its track containers. The results are reused within one call of the
+ * analysis manager, identified by AliAnalysisManager::GetNcalls.
+ */
+class AliEmcalTrackSelectionService : public TObject {
+public:
+  enum { kMaxSelections = 64 };
+
+  AliEmcalTrackSelectionService();
+
+  /**
+   * Get the track selection service of a list of shared objects. If the
+   * list does not contain a service yet a new one is created and added
+   * @param[in] sharedObjects List of shared objects (owner of the service)
+   * @return Track selection service, NULL if no list is provided
+   */
+  static AliEmcalTrackSelectionService *Request(TObjArray *sharedObjects);
+
+  /**
+   * Destructor, deletes the track selections
+   */
+  virtual ~AliEmcalTrackSelectionService();
+
+  /**
+   * Find a selection registered with the given key on the given track array
+   * @param[in] key Key describing the selection configuration
+   * @param[in] tracks Track array
+   * @return Id of the selection, -1 if not registered
+   */
+  Int_t FindSelection(const TString &key, const TClonesArray *tracks) const;
+
+  /**
+   * Register a new selection on a track array. The service takes ownership over the selection object.
+   * @param[in] key Key describing the selection configuration
+   * @param[in] tracks Track array the selection runs on
+   * @param[in] selection Track selection object
+   * @param[in] filterType Track filter type (needed for hybrid track types)
+   * @param[in] isESD True if the selection runs on ESD tracks
+   * @return Id of the selection, -1 if no more selections can be registered (the selection is not adopted then)
+   */
+  Int_t AddSelection(const TString &key, const TClonesArray *tracks, AliEmcalTrackSelection *selection, AliEmcalTrackSelection::ETrackFilterType_t filterType, Bool_t isESD);
+
+  /**
+   * Run the selection on its track array, unless it was already done for the
+   * current event of the analysis manager
+   * @param[in] id Id of the selection
+   */
+  void Process(Int_t id);
+
+  TObjArray      *GetFilteredTracks(Int_t id)        const { return fFilteredTracks[id]; }
+  const TBits    &GetAcceptedTrackMask(Int_t id)     const { return fAcceptedMask[id]  ; }
+  const TArrayC  &GetTrackTypes(Int_t id)            const { return fTrackTypes[id]    ; }
+  Int_t           GetNumberOfSelections()            const { return fNSelections       ; }
+
+  /**
+   * Get the cached momentum of a track
+   * @param[in] id Id of the selection
+   * @param[in] i Index of the track in the track array
+   * @param[out] pt Transverse momentum
+   * @param[out] eta Pseudorapidity
+   * @param[out] phi Azimuthal angle
+   * @return True if the track is accepted by the selection, false otherwise
+   */
+  Bool_t GetMomentum(Int_t id, Int_t i, Double_t &pt, Double_t &eta, Double_t &phi) const {
+    if (i < 0 || !fAcceptedMask[id].TestBitNumber(i)) return kFALSE;
+    const Double_t *mom = fMomenta[id].GetArray() + 3*i;
+    pt = mom[0]; eta = mom[1]; phi = mom[2];
+    return kTRUE;
+  }
+
+private:
+  Int_t                                        fNSelections;                       //!<! Number of registered selections
+  TString                                      fKeys[kMaxSelections];              //!<! Keys of the selections
+  AliEmcalTrackSelection                      *fSelections[kMaxSelections];        //!<! Track selection objects
+  AliEmcalTrackSelection::ETrackFilterType_t   fFilterTypes[kMaxSelections];       //!<! Track filter types
+  Bool_t                                       fIsESD[kMaxSelections];             //!<! Selection runs on ESD tracks
+  const TClonesArray                          *fArrays[kMaxSelections];            //!<! Track arrays of the selections
+  Long64_t                                     fProcessedEvent[kMaxSelections];    //!<! Call of the analysis manager processed last
+  TObjArray                                   *fFilteredTracks[kMaxSelections];    //!<! Selected tracks (owned by the selection objects)
+  TBits                                        fAcceptedMask[kMaxSelections];      //!<! Bitmask of accepted tracks
+  TArrayC                                      fTrackTypes[kMaxSelections];        //!<! Track types
+  TArrayD                                      fMomenta[kMaxSelections];           //!<! Track momenta (pt, eta, phi) of accepted tracks
+
+  AliEmcalTrackSelectionService(const AliEmcalTrackSelectionService &);
+  AliEmcalTrackSelectionService &operator=(const AliEmcalTrackSelectionService &);
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalTrackSelectionService, 2);
+  /// \endcond
+};
+
+#endif /* ALIEMCALTRACKSELECTIONSERVICE_H */
@@ -24,6 +24,7 @@
 #include "AliTLorentzVector.h"
 #include "AliEmcalTrackSelectionAOD.h"
 #include "AliEmcalTrackSelectionESD.h"
+#include "AliEmcalTrackSelectionService.h"
 #include "AliTrackContainer.h"
 
 /// \cond CLASSIMP
@@ -44,7 +45,10 @@ AliTrackContainer::AliTrackContainer():
   fTrackCutsPeriod(),
   fEmcalTrackSelection(0),
   fFilteredTracks(0),
-  fTrackTypes(5000)
+  fTrackTypes(5000),
+  fUseSharedSelection(kTRUE),
+  fSharedSelectionId(-1),
+  fSelectionService(0)
 {
   fBaseClassName = "AliVTrack";
   SetClassName("AliVTrack");
@@ -65,7 +69,10 @@ AliTrackContainer::AliTrackContainer(const char *name, const char *period):
   fTrackCutsPeriod(period),
   fEmcalTrackSelection(0),
   fFilteredTracks(0),
-  fTrackTypes(5000)
+  fTrackTypes(5000),
+  fUseSharedSelection(kTRUE),
+  fSharedSelectionId(-1),
+  fSelectionService(0)
 {
   fBaseClassName = "AliVTrack";
   SetClassName("AliVTrack");
@@ -87,6 +94,8 @@ void AliTrackContainer::SetArray(const AliVEvent *event)
 {
   AliParticleContainer::SetArray(event);
 
+  fSharedSelectionId = -1;
+
   if (fTrackFilterType == AliEmcalTrackSelection::kNoTrackFilter) {
     if (fEmcalTrackSelection) delete fEmcalTrackSelection;
     fEmcalTrackSelection = 0;
@@ -141,9 +150,43 @@ void AliTrackContainer::SetArray(const AliVEvent *event)
         AliWarning(Form("Objects are of type %s: no track filtering will be done!!", fLoadedClass->GetName()));
       }
     }
+
+    // Selections without user-defined cut objects are evaluated once per event
+    // for all containers using the same configuration on the same track array
+    TString key = GetSharedSelectionKey();
+    if (fEmcalTrackSelection && fSelectionService && !key.IsNull()) {
+      fSharedSelectionId = fSelectionService->FindSelection(key, fClArray);
+      if (fSharedSelectionId >= 0) {
+        delete fEmcalTrackSelection;
+      }
+      else {
+        fSharedSelectionId = fSelectionService->AddSelection(key, fClArray, fEmcalTrackSelection, fTrackFilterType, fLoadedClass->InheritsFrom("AliESDtrack"));
+      }
+      if (fSharedSelectionId >= 0) {
+        AliInfo(Form("Using shared track selection %d (%s)", fSharedSelectionId, key.Data()));
+        fEmcalTrackSelection = 0;
+      }
+    }
   }
 }
 
+/**
+ * The key contains all the settings defining the track selection
+ * and the name of the track array. Selections using cut objects
+ * provided by the user are not shared.
+ * @return Key of the track selection, empty string if the selection cannot be shared
+ */
+TString AliTrackContainer::GetSharedSelectionKey() const
+{
+  TString key;
+  if (!fUseSharedSelection || !fLoadedClass) return key;
+  if (fTrackFilterType == AliEmcalTrackSelection::kCustomTrackFilter && fListOfCuts && fListOfCuts->GetEntries() > 0) return key;
+
+  key = Form("%s_%s_%d_%s_%u_%d", fClArrayName.Data(), fLoadedClass->GetName(), fTrackFilterType, fTrackCutsPeriod.Data(),
+      fTrackFilterType == AliEmcalTrackSelection::kCustomTrackFilter ? fAODFilterBits : 0, fSelectionModeAny);
+  return key;
+}
+
 /**
  * Preparation for the next event: Run the track
  * selection of all bit and store the pointers to
@@ -151,38 +194,57 @@ void AliTrackContainer::SetArray(const AliVEvent *event)
  */
 void AliTrackContainer::NextEvent()
 {
-  fTrackTypes.Reset(kUndefined);
-  if (fEmcalTrackSelection) {
+  if (fSharedSelectionId >= 0) {
+    fSelectionService->Process(fSharedSelectionId);
+    fFilteredTracks = fSelectionService->GetFilteredTracks(fSharedSelectionId);
+    fTrackTypes = fSelectionService->GetTrackTypes(fSharedSelectionId);
+  }
+  else if (fEmcalTrackSelection) {
     fFilteredTracks = fEmcalTrackSelection->GetAcceptedTracks(fClArray);
+    FillTrackTypes(fFilteredTracks, fEmcalTrackSelection->GetAcceptedTrackBitmaps(), fTrackFilterType, fTrackTypes);
+  }
+  else {
+    fTrackTypes.Reset(kUndefined);
+    fFilteredTracks = fClArray;
+  }
+}
 
-    const TClonesArray* trackBitmaps = fEmcalTrackSelection->GetAcceptedTrackBitmaps();
-    TIter nextBitmap(trackBitmaps);
-    TBits* bits = 0;
-    Int_t i = 0;
-    while ((bits = static_cast<TBits*>(nextBitmap()))) {
-      if (i >= fTrackTypes.GetSize()) fTrackTypes.Set((i+1)*2);
-      AliVTrack* vTrack = static_cast<AliVTrack*>(fFilteredTracks->At(i));
-      if (!vTrack) {
-        fTrackTypes[i] = kRejected;
+/**
+ * Evaluates the track type of each track from the track cuts
+ * it fulfilled. Hybrid tracks selected with the first cut are
+ * global tracks, the ones selected with the second cut are
+ * constrained tracks.
+ * @param[in] filteredTracks Tracks selected by the track selection (rejected tracks are NULL)
+ * @param[in] trackBitmaps Bitmaps of the track cuts fulfilled by each track
+ * @param[in] filterType Track filter type
+ * @param[out] trackTypes Track types
+ */
+void AliTrackContainer::FillTrackTypes(const TObjArray *filteredTracks, const TClonesArray *trackBitmaps, ETrackFilterType_t filterType, TArrayC &trackTypes)
+{
+  trackTypes.Reset(kUndefined);
+  TIter nextBitmap(trackBitmaps);
+  TBits* bits = 0;
+  Int_t i = 0;
+  while ((bits = static_cast<TBits*>(nextBitmap()))) {
+    if (i >= trackTypes.GetSize()) trackTypes.Set((i+1)*2);
+    AliVTrack* vTrack = static_cast<AliVTrack*>(filteredTracks->At(i));
+    if (!vTrack) {
+      trackTypes[i] = kRejected;
+    }
+    else if (filterType == AliEmcalTrackSelection::kHybridTracks) {
+      if (bits->FirstSetBit() == 0) {
+        trackTypes[i] = kHybridGlobal;
       }
-      else if (fTrackFilterType == AliEmcalTrackSelection::kHybridTracks) {
-        if (bits->FirstSetBit() == 0) {
-          fTrackTypes[i] = kHybridGlobal;
+      else if (bits->FirstSetBit() == 1) {
+        if ((vTrack->GetStatus()&AliVTrack::kITSrefit) != 0) {
+          trackTypes[i] = kHybridConstrained;
         }
-        else if (bits->FirstSetBit() == 1) {
-          if ((vTrack->GetStatus()&AliVTrack::kITSrefit) != 0) {
-            fTrackTypes[i] = kHybridConstrained;
-          }
-          else {
-            fTrackTypes[i] = kHybridConstrainedNoITSrefit;
-          }
+        else {
+          trackTypes[i] = kHybridConstrainedNoITSrefit;
         }
       }
-     i++;
     }
-  }
-  else {
-    fFilteredTracks = fClArray;
+    i++;
   }
 }
 
@@ -334,6 +396,8 @@ Bool_t AliTrackContainer::GetMomentum(TLorentzVector &mom, Int_t i) const
   Double_t mass = fMassHypothesis;
 
   if (i == -1) i = fCurrentID;
+  if (fSharedSelectionId >= 0) return GetSharedMomentum(mom, i);
+
   AliVTrack *vp = GetTrack(i);
   if (vp) {
     if (mass < 0) mass = vp->M();
@@ -354,6 +418,26 @@ Bool_t AliTrackContainer::GetMomentum(TLorentzVector &mom, Int_t i) const
   }
 }
 
+/**
+ * Fills a TLorentzVector with the momentum of the \f$ i^{th} \f$ track
+ * cached by the shared track selection, using a global mass hypothesis.
+ * @param[out] mom Momentum vector of the \f$ i^{th} \f$ track in the array
+ * @param[in] i Index of the track
+ * @return True if the track is selected, false otherwise
+ */
+Bool_t AliTrackContainer::GetSharedMomentum(TLorentzVector &mom, Int_t i) const
+{
+  Double_t pt = 0, eta = 0, phi = 0;
+  if (!fSelectionService->GetMomentum(fSharedSelectionId, i, pt, eta, phi)) {
+    mom.SetPtEtaPhiM(0, 0, 0, 0);
+    return kFALSE;
+  }
+  Double_t mass = fMassHypothesis;
+  if (mass < 0) mass = GetTrack(i)->M();
+  mom.SetPtEtaPhiM(pt, eta, phi, mass);
+  return kTRUE;
+}
+
 /**
  * Fills a TLorentzVector with the momentum information of the
  * next particle in the container, using a global mass hypothesis.
@@ -403,6 +487,13 @@ Bool_t AliTrackContainer::GetAcceptMomentum(TLorentzVector &mom, Int_t i) const
   Double_t mass = fMassHypothesis;
 
   if (i == -1) i = fCurrentID;
+  if (fSharedSelectionId >= 0) {
+    UInt_t rejectionReason = 0;
+    if (AcceptTrack(i, rejectionReason)) return GetSharedMomentum(mom, i);
+    mom.SetPtEtaPhiM(0, 0, 0, 0);
+    return kFALSE;
+  }
+
   AliVTrack *vp = GetAcceptTrack(i);
   if (vp) {
     if (mass < 0) mass = vp->M();
@@ -7,6 +7,7 @@ class AliVEvent;
 class AliVParticle;
 class AliVCuts;
 class AliTLorentzVector;
+class AliEmcalTrackSelectionService;
 
 #include <TArrayC.h>
 
@@ -91,11 +92,24 @@ class AliTrackContainer : public AliParticleContainer {
   void SetSelectionModeAny() { fSelectionModeAny = kTRUE ; }
   void SetSelectionModeAll() { fSelectionModeAny = kFALSE; }
 
+  void                        SetUseSharedTrackSelection(Bool_t b)              { fUseSharedSelection = b; }
+  void                        SetTrackSelectionService(AliEmcalTrackSelectionService *s) { fSelectionService = s; }
+  Bool_t                      IsUsingSharedTrackSelection()               const { return fSharedSelectionId >= 0; }
+
   void                        NextEvent();
 
   static void                 SetDefTrackCutsPeriod(const char* period)       { fgDefTrackCutsPeriod = period; }
   static TString              GetDefTrackCutsPeriod()                         { return fgDefTrackCutsPeriod  ; }
 
+  /**
+   * Fill the track types from the result of a track selection
+   * @param[in] filteredTracks Tracks selected by the track selection (rejected tracks are NULL)
+   * @param[in] trackBitmaps Bitmaps of the track cuts fulfilled by each track
+   * @param[in] filterType Track filter type
+   * @param[out] trackTypes Track types
+   */
+  static void                 FillTrackTypes(const TObjArray *filteredTracks, const TClonesArray *trackBitmaps, ETrackFilterType_t filterType, TArrayC &trackTypes);
+
   const char*                 GetTitle() const;
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
@@ -117,6 +131,21 @@ class AliTrackContainer : public AliParticleContainer {
    */
   virtual TString             GetDefaultArrayName(const AliVEvent * const ev) const;
 
+  /**
+   * Get the momentum of the \f$ i^{th} \f$ track from the shared track selection
+   * @param[out] mom Momentum vector of the track
+   * @param[in] i Index of the track
+   * @return True if the track is accepted by the track selection, false otherwise
+   */
+  Bool_t                      GetSharedMomentum(TLorentzVector &mom, Int_t i) const;
+
+  /**
+   * Create the key identifying the track selection configuration
+   * in the shared track selection service
+   * @return Key of the track selection, empty string if the selection cannot be shared
+   */
+  TString                     GetSharedSelectionKey() const;
+
   static TString              fgDefTrackCutsPeriod;           //!<! default period string used to generate track cuts
 
   ETrackFilterType_t          fTrackFilterType;               ///< track filter type
@@ -127,13 +156,16 @@ class AliTrackContainer : public AliParticleContainer {
   AliEmcalTrackSelection     *fEmcalTrackSelection;           //!<! track selection object
   TObjArray                  *fFilteredTracks;                //!<! tracks filtered using fEmcalTrackSelection
   TArrayC                     fTrackTypes;                    //!<! track types
+  Bool_t                      fUseSharedSelection;            ///< share the track selection with containers of other tasks using the same selection
+  Int_t                       fSharedSelectionId;             //!<! id of the track selection in the shared track selection service
+  AliEmcalTrackSelectionService *fSelectionService;           //!<! shared track selection service
 
  private:
   AliTrackContainer(const AliTrackContainer& obj); // copy constructor
   AliTrackContainer& operator=(const AliTrackContainer& other); // assignment
 
   /// \cond CLASSIMP
-  ClassDef(AliTrackContainer,1);
+  ClassDef(AliTrackContainer,2);
   /// \endcond
 };
 
@@ -42,6 +42,7 @@
 #include "TCanvas.h"
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowQVectorMoments.h"
 #include "AliFlowAnalysisWithQCumulants.h"
 #include "TArrayD.h"
 #include "TRandom.h"
@@ -379,6 +380,18 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
  AliFlowTrackSimple *aftsTrack = NULL;
  Int_t n = fHarmonic; // shortcut for the harmonic 
+ // Q_{m*n,k} and S_{p,k} are taken from the Q-vector moments shared by all methods running on this event
+ // (not possible when the number of RPs is truncated to fExactNoRPs):
+ const AliFlowQVectorMoments *qMoments = NULL;
+ if(fExactNoRPs <= 0)
+ {
+  AliFlowQVectorMoments request(n,12,9);
+  if(fUsePhiWeights && fPhiWeights && fnBinsPhi){request.SetPhiWeights(fPhiWeights,fnBinsPhi);}
+  if(fUsePtWeights && fPtWeights && fnBinsPt){request.SetPtWeights(fPtWeights,fPtMin,fPtBinWidth);}
+  if(fUseEtaWeights && fEtaWeights && fEtaBinWidth){request.SetEtaWeights(fEtaWeights,fEtaMin,fEtaBinWidth);}
+  request.SetUseTrackWeights(fUseTrackWeights);
+  qMoments = anEvent->GetQVectorMoments(request);
+ }
  for(Int_t i=0;i<nPrim;i++) 
  { 
   if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
@@ -409,23 +422,26 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     {
      wTrack = aftsTrack->Weight(); 
     }
-    // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-    for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
+    if(!qMoments)
     {
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+     // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
+     for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
      {
-      (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
-     } 
-    }
-    // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-    for(Int_t p=0;p<8;p++)
-    {
-     for(Int_t k=0;k<9;k++)
-     {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
+      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+      {
+       (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
+       (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
+      } 
      }
-    } 
+     // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
+     for(Int_t p=0;p<8;p++)
+     {
+      for(Int_t k=0;k<9;k++)
+      {     
+       (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
+      }
+     } 
+    } // end of if(!qMoments)
     // Differential flow:
     if(fCalculateDiffFlow || fCalculate2DDiffFlow)
     {
@@ -547,6 +563,21 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
      printf("\n WARNING (QC): No particle (i.e. aftsTrack is a NULL pointer in AFAWQC::Make())!!!!\n\n");
     }
  } // end of for(Int_t i=0;i<nPrim;i++) 
+ if(qMoments)
+ {
+  for(Int_t k=0;k<9;k++)
+  {
+   for(Int_t m=0;m<12;m++)
+   {
+    (*fReQ)(m,k) = qMoments->ReQ(m+1,k);
+    (*fImQ)(m,k) = qMoments->ImQ(m+1,k);
+   }
+   for(Int_t p=0;p<8;p++)
+   {
+    (*fSpk)(p,k) = qMoments->SumOfWeights(k);
+   }
+  }
+ } // end of if(qMoments)
 
  // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
  for(Int_t p=0;p<8;p++)
@@ -42,6 +42,7 @@
 #include "AliFlowTrackSimple.h"
 #include "AliFlowTrackSimpleCuts.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowQVectorMoments.h"
 #include "TRandom.h"
 
 using std::cout;
@@ -83,6 +84,7 @@ AliFlowEventSimple::AliFlowEventSimple():
   fZNCM(0.),
   fZNAM(0.),
   fAbsOrbit(0),
+  fQVectorMoments(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(NULL)
 {
@@ -138,6 +140,7 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   fZNCM(0.),
   fZNAM(0.),
   fAbsOrbit(0),
+  fQVectorMoments(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -197,6 +200,7 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
   fZNCM(anEvent.fZNCM),
   fZNAM(anEvent.fZNAM),
   fAbsOrbit(anEvent.fAbsOrbit),
+  fQVectorMoments(NULL),
   fNumberOfPOItypes(anEvent.fNumberOfPOItypes),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -290,6 +294,7 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
     fV0A[i] = anEvent.fV0A[i];
   }
   delete [] fShuffledIndexes;
+  InvalidateQVectorMoments();
   return *this;
 }
 
@@ -306,6 +311,7 @@ AliFlowEventSimple::~AliFlowEventSimple()
   delete fShuffledIndexes;
   delete fMothersCollection;
   delete [] fNumberOfPOIs;
+  delete fQVectorMoments;
 }
 
 //-----------------------------------------------------------------------
@@ -456,6 +462,7 @@ void AliFlowEventSimple::TrackAdded()
     delete [] fShuffledIndexes;
     fShuffledIndexes=NULL;  
   }
+  InvalidateQVectorMoments();
 }
 
 //-----------------------------------------------------------------------
@@ -477,19 +484,11 @@ AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
                                         Bool_t useEtaWeights )
 {
   // calculate Q-vector in harmonic n without weights (default harmonic n=2)
-  Double_t dQX = 0.;
-  Double_t dQY = 0.;
+  // the sums over the RPs are taken from the Q-vector moments of the event
   AliFlowVector vQ;
   vQ.Set(0.,0.);
 
   Int_t iOrder = n;
-  Double_t sumOfWeights = 0.;
-  Double_t dPhi = 0.;
-  Double_t dPt = 0.;
-  Double_t dEta = 0.;
-  Double_t dWeight = 1.;
-
-  AliFlowTrackSimple* pTrack = NULL;
 
   Int_t nBinsPhi = 0;
   Double_t dBinWidthPt = 0.;
@@ -497,10 +496,6 @@ AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
   Double_t dBinWidthEta = 0.;
   Double_t dEtaMin = 0.;
 
-  Double_t wPhi = 1.; // weight Phi
-  Double_t wPt = 1.;  // weight Pt
-  Double_t wEta = 1.; // weight Eta
-
   TH1F *phiWeights = NULL;
   TH1D *ptWeights  = NULL;
   TH1D *etaWeights = NULL;
@@ -532,52 +527,15 @@ AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
     }
   } // end of if(weightsList)
 
-  // loop over tracks
-  for(Int_t i=0; i<fNumberOfTracks; i++)
-  {
-    pTrack = (AliFlowTrackSimple*)fTrackCollection->At(i);
-    if(pTrack)
-    {
-      if(pTrack->InRPSelection())
-      {
-        dPhi = pTrack->Phi();
-        dPt  = pTrack->Pt();
-        dEta = pTrack->Eta();
-	      dWeight = pTrack->Weight();
-
-        // determine Phi weight: (to be improved, I should here only access it + the treatment of gaps in the if statement)
-        if(phiWeights && nBinsPhi)
-        {
-          wPhi = phiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*nBinsPhi/TMath::TwoPi())));
-        }
-        // determine v'(pt) weight:
-        if(ptWeights && dBinWidthPt)
-        {
-          wPt=ptWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-dPtMin)/dBinWidthPt)));
-        }
-        // determine v'(eta) weight:
-        if(etaWeights && dBinWidthEta)
-        {
-          wEta=etaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-dEtaMin)/dBinWidthEta)));
-        }
-
-        // building up the weighted Q-vector:
-        dQX += dWeight*wPhi*wPt*wEta*TMath::Cos(iOrder*dPhi);
-        dQY += dWeight*wPhi*wPt*wEta*TMath::Sin(iOrder*dPhi);
-
-        // weighted multiplicity:
-        sumOfWeights += dWeight*wPhi*wPt*wEta;
-
-      } // end of if (pTrack->InRPSelection())
-    } // end of if (pTrack)
-    else
-    {
-      cerr << "no particle!!!"<<endl;
-    }
-  } // loop over particles
+  // weighted Q-vector and weighted multiplicity (first power of the weights):
+  AliFlowQVectorMoments request(iOrder,1,2);
+  request.SetPhiWeights(phiWeights,nBinsPhi);
+  request.SetPtWeights(ptWeights,dPtMin,dBinWidthPt);
+  request.SetEtaWeights(etaWeights,dEtaMin,dBinWidthEta);
+  const AliFlowQVectorMoments* moments = GetQVectorMoments(request);
 
-  vQ.Set(dQX,dQY);
-  vQ.SetMult(sumOfWeights);
+  vQ.Set(moments->ReQ(1,1),moments->ImQ(1,1));
+  vQ.SetMult(moments->SumOfWeights(1));
   vQ.SetHarmonic(iOrder);
   vQ.SetPOItype(AliFlowTrackSimple::kRP);
   vQ.SetSubeventNumber(-1);
@@ -596,31 +554,16 @@ void AliFlowEventSimple::Get2Qsub( AliFlowVector* Qarray,
 {
 
   // calculate Q-vector in harmonic n without weights (default harmonic n=2)
-  Double_t dQX = 0.;
-  Double_t dQY = 0.;
-
+  // the sums over the RPs of each subevent are taken from the Q-vector moments of the event
   Int_t iOrder = n;
-  Double_t sumOfWeights = 0.;
-  Double_t dPhi = 0.;
-  Double_t dPt  = 0.;
-  Double_t dEta = 0.;
-  Double_t dWeight = 1.;
-
-  AliFlowTrackSimple* pTrack = NULL;
 
-  Int_t    iNbinsPhiSub0 = 0;
-  Int_t    iNbinsPhiSub1 = 0;
+  Int_t    iNbinsPhiSub[2] = {0,0};
   Double_t dBinWidthPt = 0.;
   Double_t dPtMin      = 0.;
   Double_t dBinWidthEta= 0.;
   Double_t dEtaMin     = 0.;
 
-  Double_t dWphi = 1.;  // weight Phi
-  Double_t dWpt  = 1.;  // weight Pt
-  Double_t dWeta = 1.;  // weight Eta
-
-  TH1F* phiWeightsSub0 = NULL;
-  TH1F* phiWeightsSub1 = NULL;
+  TH1F* phiWeightsSub[2] = {NULL,NULL};
   TH1D* ptWeights  = NULL;
   TH1D* etaWeights = NULL;
 
@@ -628,13 +571,13 @@ void AliFlowEventSimple::Get2Qsub( AliFlowVector* Qarray,
   {
     if(usePhiWeights)
     {
-      phiWeightsSub0 = dynamic_cast<TH1F *>(weightsList->FindObject("phi_weights_sub0"));
-      if(phiWeightsSub0) {
-	iNbinsPhiSub0 = phiWeightsSub0->GetNbinsX();
+      phiWeightsSub[0] = dynamic_cast<TH1F *>(weightsList->FindObject("phi_weights_sub0"));
+      if(phiWeightsSub[0]) {
+	iNbinsPhiSub[0] = phiWeightsSub[0]->GetNbinsX();
       }
-      phiWeightsSub1 = dynamic_cast<TH1F *>(weightsList->FindObject("phi_weights_sub1"));
-      if(phiWeightsSub1) {
-	iNbinsPhiSub1 = phiWeightsSub1->GetNbinsX();
+      phiWeightsSub[1] = dynamic_cast<TH1F *>(weightsList->FindObject("phi_weights_sub1"));
+      if(phiWeightsSub[1]) {
+	iNbinsPhiSub[1] = phiWeightsSub[1]->GetNbinsX();
       }
     }
     if(usePtWeights)
@@ -660,76 +603,64 @@ void AliFlowEventSimple::Get2Qsub( AliFlowVector* Qarray,
   //loop over the two subevents
   for (Int_t s=0; s<2; s++)
   {
-    // loop over tracks
-    for(Int_t i=0; i<fNumberOfTracks; i++)
-    {
-      pTrack = (AliFlowTrackSimple*)fTrackCollection->At(i);
-      if(!pTrack)
-      {
-        cerr << "no particle!!!"<<endl;
-        continue;
-      }
-      if(pTrack->InRPSelection() && (pTrack->InSubevent(s)))
-      {
-        dPhi    = pTrack->Phi();
-        dPt     = pTrack->Pt();
-        dEta    = pTrack->Eta();
-        dWeight = pTrack->Weight();
-
-        // determine Phi weight: (to be improved, I should here only access it + the treatment of gaps in the if statement)
-        //subevent 0
-        if(s == 0)  { 
-          if(phiWeightsSub0 && iNbinsPhiSub0)  {
-            Int_t phiBin = 1+(Int_t)(TMath::Floor(dPhi*iNbinsPhiSub0/TMath::TwoPi()));
-            //use the phi value at the center of the bin
-            dPhi  = phiWeightsSub0->GetBinCenter(phiBin);
-            dWphi = phiWeightsSub0->GetBinContent(phiBin);
-          }
-        } 
-        //subevent 1
-        else if (s == 1) { 
-          if(phiWeightsSub1 && iNbinsPhiSub1) {
-            Int_t phiBin = 1+(Int_t)(TMath::Floor(dPhi*iNbinsPhiSub1/TMath::TwoPi()));
-            //use the phi value at the center of the bin
-            dPhi  = phiWeightsSub1->GetBinCenter(phiBin);
-            dWphi = phiWeightsSub1->GetBinContent(phiBin);
-          } 
-        }
-
-        // determine v'(pt) weight:
-        if(ptWeights && dBinWidthPt)
-        {
-          dWpt=ptWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-dPtMin)/dBinWidthPt)));
-        }
-
-        // determine v'(eta) weight:
-        if(etaWeights && dBinWidthEta)
-        {
-          dWeta=etaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-dEtaMin)/dBinWidthEta)));
-        }
-
-        // building up the weighted Q-vector:
-        dQX += dWeight*dWphi*dWpt*dWeta*TMath::Cos(iOrder*dPhi);
-        dQY += dWeight*dWphi*dWpt*dWeta*TMath::Sin(iOrder*dPhi);
-
-        // weighted multiplicity:
-        sumOfWeights+=dWeight*dWphi*dWpt*dWeta;
-
-      } // end of if (pTrack->InRPSelection())
-    } // loop over particles
-    
-    Qarray[s].Set(dQX,dQY);
-    Qarray[s].SetMult(sumOfWeights);
+    // with phi weights the phi value at the center of the bin is used
+    AliFlowQVectorMoments request(iOrder,1,2);
+    request.SetSubevent(s);
+    request.SetPhiWeights(phiWeightsSub[s],iNbinsPhiSub[s],kTRUE);
+    request.SetPtWeights(ptWeights,dPtMin,dBinWidthPt);
+    request.SetEtaWeights(etaWeights,dEtaMin,dBinWidthEta);
+    const AliFlowQVectorMoments* moments = GetQVectorMoments(request);
+
+    Qarray[s].Set(moments->ReQ(1,1),moments->ImQ(1,1));
+    Qarray[s].SetMult(moments->SumOfWeights(1));
     Qarray[s].SetHarmonic(iOrder);
     Qarray[s].SetPOItype(AliFlowTrackSimple::kRP);
     Qarray[s].SetSubeventNumber(s);
+  }
+
+}
 
-    //reset
-    sumOfWeights = 0.;
-    dQX = 0.;
-    dQY = 0.;
+//-----------------------------------------------------------------------
+const AliFlowQVectorMoments* AliFlowEventSimple::GetQVectorMoments(const AliFlowQVectorMoments& request)
+{
+  //get the Q-vector moments for the requested harmonic, weights and subevent
+  //the moments are computed on the first request in an event and then served
+  //to all methods (wagons) running on the same event; they are recomputed
+  //whenever tracks are added, (re)tagged or modified via this class
+  if (!fQVectorMoments)
+  {
+    fQVectorMoments = new TObjArray();
+    fQVectorMoments->SetOwner(kTRUE);
+  }
+  Int_t nRPs = GetNumberOfRPs();
+  AliFlowQVectorMoments* moments = NULL;
+  for (Int_t i=0; i<fQVectorMoments->GetEntriesFast(); i++)
+  {
+    AliFlowQVectorMoments* m = static_cast<AliFlowQVectorMoments*>(fQVectorMoments->UncheckedAt(i));
+    if (!m->Serves(request)) continue;
+    moments = m;
+    if (m->IsValid(fNumberOfTracks,nRPs)) return m;
   }
+  if (!moments)
+  {
+    //keep the store small, configurations are fixed per task
+    if (fQVectorMoments->GetEntriesFast() >= 32) fQVectorMoments->Delete();
+    moments = new AliFlowQVectorMoments(request);
+    fQVectorMoments->Add(moments);
+  }
+  moments->Fill(fTrackCollection,fNumberOfTracks,nRPs);
+  return moments;
+}
 
+//-----------------------------------------------------------------------
+void AliFlowEventSimple::InvalidateQVectorMoments()
+{
+  //mark the Q-vector moments as outdated, the allocated objects are kept for the next event
+  if (!fQVectorMoments) return;
+  for (Int_t i=0; i<fQVectorMoments->GetEntriesFast(); i++)
+  {
+    static_cast<AliFlowQVectorMoments*>(fQVectorMoments->UncheckedAt(i))->Invalidate();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -873,6 +804,7 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
   fZNCM(0.),
   fZNAM(0.),
   fAbsOrbit(0),
+  fQVectorMoments(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -978,6 +910,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
     if (eta >= etaMinA && eta <= etaMaxA) track->SetForSubevent(0);
     if (eta >= etaMinB && eta <= etaMaxB) track->SetForSubevent(1);
   }
+  InvalidateQVectorMoments();
 }
 
 //_____________________________________________________________________________
@@ -993,6 +926,7 @@ void AliFlowEventSimple::TagSubeventsByCharge()
     if (charge<0) track->SetForSubevent(0);
     if (charge>0) track->SetForSubevent(1);
   }
+  InvalidateQVectorMoments();
 }
 
 //_____________________________________________________________________________
@@ -1153,6 +1087,7 @@ void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
     }
     track->SetForRPSelection(pass);
   }
+  InvalidateQVectorMoments();
 }
 
 //_____________________________________________________________________________
@@ -1175,6 +1110,7 @@ void AliFlowEventSimple::TagPOI( const AliFlowTrackSimpleCuts* cuts, Int_t poiTy
     }
     track->Tag(poiType,pass);
   }
+  InvalidateQVectorMoments();
 }
 
 //_____________________________________________________________________________
@@ -1207,6 +1143,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
       track->ResetPOItype();
     }
   }
+  InvalidateQVectorMoments();
 }
 
 //_____________________________________________________________________________
@@ -1224,6 +1161,7 @@ Int_t AliFlowEventSimple::CleanUpDeadTracks()
   fTrackCollection->Compress(); //clean up empty slots
   fNumberOfTracks-=ncleaned; //update number of tracks
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  InvalidateQVectorMoments();
   return ncleaned;
 }
 
@@ -1263,4 +1201,5 @@ void AliFlowEventSimple::ClearFast()
   fAfterBurnerPrecision = 0.001;
   fUserModified = kFALSE;
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  InvalidateQVectorMoments();
 }
@@ -0,0 +1,219 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include "AliFlowQVectorMoments.h"
+#include "AliFlowTrackSimple.h"
+#include "TObjArray.h"
+#include "TH1.h"
+#include "TMath.h"
+
+//********************************************************************
+// AliFlowQVectorMoments:                                            *
+// Weighted Q-vector moments of the reference particles of an event, *
+// shared by the flow methods through AliFlowEventSimple.            *
+//********************************************************************
+
+ClassImp(AliFlowQVectorMoments)
+
+//________________________________________________________________________
+
+AliFlowQVectorMoments::AliFlowQVectorMoments():
+  TObject(),
+  fHarmonic(2),
+  fNHarmonics(1),
+  fNPowers(2),
+  fSubevent(-1),
+  fPhiWeights(NULL),
+  fNBinsPhi(0),
+  fPhiAtBinCenter(kFALSE),
+  fPtWeights(NULL),
+  fPtMin(0.),
+  fPtBinWidth(0.),
+  fEtaWeights(NULL),
+  fEtaMin(0.),
+  fEtaBinWidth(0.),
+  fUseTrackWeights(kTRUE),
+  fValid(kFALSE),
+  fNumberOfTracks(0),
+  fNumberOfRPs(0),
+  fMoments()
+{
+  // default constructor
+}
+
+//________________________________________________________________________
+
+AliFlowQVectorMoments::AliFlowQVectorMoments(Int_t harmonic, Int_t nHarmonics, Int_t nPowers):
+  TObject(),
+  fHarmonic(harmonic),
+  fNHarmonics(nHarmonics),
+  fNPowers(nPowers),
+  fSubevent(-1),
+  fPhiWeights(NULL),
+  fNBinsPhi(0),
+  fPhiAtBinCenter(kFALSE),
+  fPtWeights(NULL),
+  fPtMin(0.),
+  fPtBinWidth(0.),
+  fEtaWeights(NULL),
+  fEtaMin(0.),
+  fEtaBinWidth(0.),
+  fUseTrackWeights(kTRUE),
+  fValid(kFALSE),
+  fNumberOfTracks(0),
+  fNumberOfRPs(0),
+  fMoments()
+{
+  // constructor: moments Q_{m*harmonic,k} for m = 0..nHarmonics and k = 0..nPowers-1
+  // without any weights
+}
+
+//________________________________________________________________________
+
+AliFlowQVectorMoments::AliFlowQVectorMoments(const AliFlowQVectorMoments& moments):
+  TObject(moments),
+  fHarmonic(moments.fHarmonic),
+  fNHarmonics(moments.fNHarmonics),
+  fNPowers(moments.fNPowers),
+  fSubevent(moments.fSubevent),
+  fPhiWeights(moments.fPhiWeights),
+  fNBinsPhi(moments.fNBinsPhi),
+  fPhiAtBinCenter(moments.fPhiAtBinCenter),
+  fPtWeights(moments.fPtWeights),
+  fPtMin(moments.fPtMin),
+  fPtBinWidth(moments.fPtBinWidth),
+  fEtaWeights(moments.fEtaWeights),
+  fEtaMin(moments.fEtaMin),
+  fEtaBinWidth(moments.fEtaBinWidth),
+  fUseTrackWeights(moments.fUseTrackWeights),
+  fValid(moments.fValid),
+  fNumberOfTracks(moments.fNumberOfTracks),
+  fNumberOfRPs(moments.fNumberOfRPs),
+  fMoments(moments.fMoments)
+{
+  // copy constructor
+}
+
+//________________________________________________________________________
+
+AliFlowQVectorMoments& AliFlowQVectorMoments::operator=(const AliFlowQVectorMoments& moments)
+{
+  // assignment operator
+  if (&moments==this) return *this;
+  TObject::operator=(moments);
+  fHarmonic = moments.fHarmonic;
+  fNHarmonics = moments.fNHarmonics;
+  fNPowers = moments.fNPowers;
+  fSubevent = moments.fSubevent;
+  fPhiWeights = moments.fPhiWeights;
+  fNBinsPhi = moments.fNBinsPhi;
+  fPhiAtBinCenter = moments.fPhiAtBinCenter;
+  fPtWeights = moments.fPtWeights;
+  fPtMin = moments.fPtMin;
+  fPtBinWidth = moments.fPtBinWidth;
+  fEtaWeights = moments.fEtaWeights;
+  fEtaMin = moments.fEtaMin;
+  fEtaBinWidth = moments.fEtaBinWidth;
+  fUseTrackWeights = moments.fUseTrackWeights;
+  fValid = moments.fValid;
+  fNumberOfTracks = moments.fNumberOfTracks;
+  fNumberOfRPs = moments.fNumberOfRPs;
+  fMoments = moments.fMoments;
+  return *this;
+}
+
+//________________________________________________________________________
+
+Bool_t AliFlowQVectorMoments::Serves(const AliFlowQVectorMoments& request) const
+{
+  // can these moments be used for the request?
+  // the configuration has to be the same, the number of harmonics and powers at least as large
+  if (fHarmonic != request.fHarmonic) return kFALSE;
+  if (fNHarmonics < request.fNHarmonics || fNPowers < request.fNPowers) return kFALSE;
+  if (fSubevent != request.fSubevent) return kFALSE;
+  if (fUseTrackWeights != request.fUseTrackWeights) return kFALSE;
+  if (fPhiWeights != request.fPhiWeights) return kFALSE;
+  if (fPhiWeights && (fNBinsPhi != request.fNBinsPhi || fPhiAtBinCenter != request.fPhiAtBinCenter)) return kFALSE;
+  if (fPtWeights != request.fPtWeights) return kFALSE;
+  if (fPtWeights && (fPtMin != request.fPtMin || fPtBinWidth != request.fPtBinWidth)) return kFALSE;
+  if (fEtaWeights != request.fEtaWeights) return kFALSE;
+  if (fEtaWeights && (fEtaMin != request.fEtaMin || fEtaBinWidth != request.fEtaBinWidth)) return kFALSE;
+  return kTRUE;
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorMoments::Fill(const TObjArray* tracks, Int_t nTracks, Int_t nRPs)
+{
+  // one pass over the RPs (of the subevent): the multiples m*n of the angle are obtained by
+  // rotation and the powers of the weight by multiplication, so the cost per track is one
+  // sin/cos pair instead of one per (m,k)
+  fMoments.Set(2*(fNHarmonics+1)*fNPowers);
+  fMoments.Reset();
+  Double_t* q = fMoments.GetArray();
+
+  Bool_t usePhiWeights = (fPhiWeights && fNBinsPhi);
+  Bool_t usePtWeights  = (fPtWeights && fPtBinWidth);
+  Bool_t useEtaWeights = (fEtaWeights && fEtaBinWidth);
+
+  for (Int_t i=0; i<nTracks; i++)
+  {
+    AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(tracks->At(i));
+    if (!track) continue;
+    if (!track->InRPSelection()) continue;
+    if (fSubevent>=0 && !track->InSubevent(fSubevent)) continue;
+
+    Double_t phi = track->Phi();
+    Double_t weight = 1.;
+    if (usePhiWeights)
+    {
+      Int_t phiBin = 1+(Int_t)(TMath::Floor(phi*fNBinsPhi/TMath::TwoPi()));
+      weight *= fPhiWeights->GetBinContent(phiBin);
+      if (fPhiAtBinCenter) phi = fPhiWeights->GetBinCenter(phiBin);
+    }
+    if (usePtWeights)
+    {
+      weight *= fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((track->Pt()-fPtMin)/fPtBinWidth)));
+    }
+    if (useEtaWeights)
+    {
+      weight *= fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((track->Eta()-fEtaMin)/fEtaBinWidth)));
+    }
+    if (fUseTrackWeights) weight *= track->Weight();
+
+    Double_t cosN = TMath::Cos(fHarmonic*phi);
+    Double_t sinN = TMath::Sin(fHarmonic*phi);
+    Double_t cosMN = 1.;
+    Double_t sinMN = 0.;
+    for (Int_t m=0; m<=fNHarmonics; m++)
+    {
+      Double_t* row = q+2*m*fNPowers;
+      Double_t wk = 1.;
+      for (Int_t k=0; k<fNPowers; k++)
+      {
+        row[2*k]   += wk*cosMN;
+        row[2*k+1] += wk*sinMN;
+        wk *= weight;
+      }
+      Double_t c = cosMN*cosN-sinMN*sinN;
+      sinMN = sinMN*cosN+cosMN*sinN;
+      cosMN = c;
+    }
+  }
+
+  fNumberOfTracks = nTracks;
+  fNumberOfRPs = nRPs;
+  fValid = kTRUE;
+}
@@ -0,0 +1,78 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWQVECTORMOMENTS_H
+#define ALIFLOWQVECTORMOMENTS_H
+
+#include "TObject.h"
+#include "TArrayD.h"
+
+class TH1;
+class TObjArray;
+
+//********************************************************************
+// AliFlowQVectorMoments:                                            *
+// Weighted Q-vector moments of the reference particles of an event  *
+//   Q_{m*n,k} = sum_i w_i^k exp(i*m*n*phi_i)                        *
+// for m = 0..nHarmonics and k = 0..nPowers-1 (m = 0 gives S_{1,k}). *
+// The moments are computed in one pass over the tracks and kept by  *
+// AliFlowEventSimple, keyed by harmonic, weights and subevent, so   *
+// all flow methods running on the same event share them.            *
+//********************************************************************
+
+class AliFlowQVectorMoments: public TObject {
+ public:
+  AliFlowQVectorMoments();
+  AliFlowQVectorMoments(Int_t harmonic, Int_t nHarmonics=1, Int_t nPowers=2);
+  AliFlowQVectorMoments(const AliFlowQVectorMoments& moments);
+  AliFlowQVectorMoments& operator=(const AliFlowQVectorMoments& moments);
+  virtual ~AliFlowQVectorMoments() {}
+
+  // configuration (the key of the moments)
+  void SetSubevent(Int_t s)                         { fSubevent = s; }
+  void SetPhiWeights(const TH1* h, Int_t nBins, Bool_t useBinCenter=kFALSE) { fPhiWeights = h; fNBinsPhi = nBins; fPhiAtBinCenter = useBinCenter; }
+  void SetPtWeights(const TH1* h, Double_t min, Double_t binWidth)  { fPtWeights = h; fPtMin = min; fPtBinWidth = binWidth; }
+  void SetEtaWeights(const TH1* h, Double_t min, Double_t binWidth) { fEtaWeights = h; fEtaMin = min; fEtaBinWidth = binWidth; }
+  void SetUseTrackWeights(Bool_t b)                 { fUseTrackWeights = b; }
+
+  Int_t GetHarmonic() const                         { return fHarmonic; }
+  Int_t GetNHarmonics() const                       { return fNHarmonics; }
+  Int_t GetNPowers() const                          { return fNPowers; }
+  Int_t GetSubevent() const                         { return fSubevent; }
+
+  Bool_t Serves(const AliFlowQVectorMoments& request) const;
+  void   Fill(const TObjArray* tracks, Int_t nTracks, Int_t nRPs);
+  Bool_t IsValid(Int_t nTracks, Int_t nRPs) const   { return fValid && fNumberOfTracks==nTracks && fNumberOfRPs==nRPs; }
+  void   Invalidate()                               { fValid = kFALSE; }
+
+  // Re and Im of Q_{m*n,k}, m = 0..nHarmonics, k = 0..nPowers-1
+  Double_t ReQ(Int_t m, Int_t k) const              { return fMoments.GetArray()[2*(m*fNPowers+k)]; }
+  Double_t ImQ(Int_t m, Int_t k) const              { return fMoments.GetArray()[2*(m*fNPowers+k)+1]; }
+  // S_{1,k} = sum_i w_i^k
+  Double_t SumOfWeights(Int_t k) const              { return ReQ(0,k); }
+
+ private:
+  Int_t       fHarmonic;        // harmonic n
+  Int_t       fNHarmonics;      // highest multiple m of the harmonic
+  Int_t       fNPowers;         // number of powers k of the weights
+  Int_t       fSubevent;        // subevent of the RPs (-1 = all RPs)
+  const TH1*  fPhiWeights;      //! phi weights
+  Int_t       fNBinsPhi;        // number of phi bins used for the phi weights
+  Bool_t      fPhiAtBinCenter;  // use the phi at the center of the phi weight bin
+  const TH1*  fPtWeights;       //! pt weights
+  Double_t    fPtMin;           // lower edge of the pt weights
+  Double_t    fPtBinWidth;      // bin width of the pt weights
+  const TH1*  fEtaWeights;      //! eta weights
+  Double_t    fEtaMin;          // lower edge of the eta weights
+  Double_t    fEtaBinWidth;     // bin width of the eta weights
+  Bool_t      fUseTrackWeights; // multiply by the track weights
+  Bool_t      fValid;           // moments are up to date
+  Int_t       fNumberOfTracks;  // number of tracks when the moments were filled
+  Int_t       fNumberOfRPs;     // number of RPs when the moments were filled
+  TArrayD     fMoments;         // Re and Im of Q_{m*n,k}
+
+  ClassDef(AliFlowQVectorMoments,1)
+};
+
+#endif
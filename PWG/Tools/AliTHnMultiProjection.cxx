@@ -0,0 +1,334 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// Projects a THnBase into many 1D/2D histograms in a single pass over its filled bins
+//
+// Usage:
+//   AliTHnMultiProjection proj(container->GetGrid(step)->GetGrid());
+//   for (Int_t bin=1; bin<=nBins; bin++) {
+//     Int_t id = proj.AddProjection(1, 2);
+//     proj.SetRange(id, 0, bin, bin);
+//   }
+//   proj.Process();
+//   TH2D* hist = (TH2D*) proj.GetProjection(id);
+//
+// When a projection is added, it takes over the ranges which are currently set on the axes of the
+// source (like THnBase::Projection does), SetRange overwrites them for single axes.
+// The result of each projection is identical to the one of THnBase::Projection with the same ranges:
+// the axes of the histogram are restricted to the selected range of the projected axis, under- and
+// overflow bins are kept for axes without range and errors are propagated if the source has them.
+//
+// The projections are owned by this object unless they are taken with ReleaseProjection.
+
+#include "AliTHnMultiProjection.h"
+#include "THnBase.h"
+#include "TAxis.h"
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TArrayD.h"
+#include "TMath.h"
+#include "AliLog.h"
+
+ClassImp(AliTHnMultiProjection)
+
+AliTHnMultiProjection::AliTHnMultiProjection() :
+  TObject(),
+  fSource(0),
+  fNDims(0),
+  fNProjections(0),
+  fAxisX(),
+  fAxisY(),
+  fFirstBin(),
+  fLastBin(),
+  fMasks(),
+  fOutputs()
+{
+  // Constructor
+
+  fOutputs.SetOwner(kTRUE);
+}
+
+AliTHnMultiProjection::AliTHnMultiProjection(const THnBase* source) :
+  TObject(),
+  fSource(0),
+  fNDims(0),
+  fNProjections(0),
+  fAxisX(),
+  fAxisY(),
+  fFirstBin(),
+  fLastBin(),
+  fMasks(),
+  fOutputs()
+{
+  // Constructor
+
+  fOutputs.SetOwner(kTRUE);
+  SetSource(source);
+}
+
+AliTHnMultiProjection::~AliTHnMultiProjection()
+{
+  // Destructor, deletes the projections which have not been released
+
+  fOutputs.Delete();
+}
+
+void AliTHnMultiProjection::SetSource(const THnBase* source)
+{
+  // sets the container to be projected and removes all previously requested projections
+
+  fOutputs.Delete();
+  fSource = source;
+  fNDims = (source) ? source->GetNdimensions() : 0;
+  fNProjections = 0;
+}
+
+Int_t AliTHnMultiProjection::AddProjection(Int_t axisX, Int_t axisY)
+{
+  // requests a projection on axisX (and axisY for a 2D histogram)
+  // the ranges currently set on the axes of the source are used for this projection
+  // returns the id of the projection, -1 in case of error
+
+  if (!fSource)
+  {
+    AliError("No source set");
+    return -1;
+  }
+  if (axisX < 0 || axisX >= fNDims || axisY >= fNDims || axisX == axisY)
+  {
+    AliError(Form("Invalid projection axes %d %d for %d dimensions", axisX, axisY, fNDims));
+    return -1;
+  }
+
+  Int_t id = fNProjections++;
+  fAxisX.Set(fNProjections);
+  fAxisY.Set(fNProjections);
+  fFirstBin.Set(fNProjections * fNDims);
+  fLastBin.Set(fNProjections * fNDims);
+
+  fAxisX[id] = axisX;
+  fAxisY[id] = (axisY < 0) ? -1 : axisY;
+
+  for (Int_t i=0; i<fNDims; i++)
+  {
+    TAxis* axis = fSource->GetAxis(i);
+    if (axis->TestBit(TAxis::kAxisRange))
+    {
+      fFirstBin[id * fNDims + i] = axis->GetFirst();
+      fLastBin[id * fNDims + i] = axis->GetLast();
+    }
+    else
+    {
+      fFirstBin[id * fNDims + i] = 0;
+      fLastBin[id * fNDims + i] = axis->GetNbins() + 1;
+    }
+  }
+
+  return id;
+}
+
+void AliTHnMultiProjection::SetRange(Int_t projection, Int_t axis, Int_t firstBin, Int_t lastBin)
+{
+  // restricts the projection to the bins firstBin to lastBin (inclusive) of the given axis
+
+  if (projection < 0 || projection >= fNProjections || axis < 0 || axis >= fNDims)
+  {
+    AliError(Form("Invalid projection %d or axis %d", projection, axis));
+    return;
+  }
+
+  Int_t nBins = fSource->GetAxis(axis)->GetNbins();
+  fFirstBin[projection * fNDims + axis] = TMath::Max(firstBin, 0);
+  fLastBin[projection * fNDims + axis] = TMath::Min(lastBin, nBins + 1);
+}
+
+TH1* AliTHnMultiProjection::CreateOutput(Int_t projection) const
+{
+  // creates the (empty) histogram for the given projection
+  // the binning of the source axes is kept (fixed binning is needed for consistent bin limits in Add/Divide)
+
+  Int_t axes[2] = { fAxisX[projection], fAxisY[projection] };
+  Int_t nAxes = (axes[1] < 0) ? 1 : 2;
+  Int_t nBins[2] = { 1, 1 };
+  Bool_t variable = kFALSE;
+  TArrayD edges[2];
+
+  for (Int_t i=0; i<nAxes; i++)
+  {
+    TAxis* axis = fSource->GetAxis(axes[i]);
+    Int_t first = TMath::Max(fFirstBin[projection * fNDims + axes[i]], 1);
+    Int_t last = TMath::Max(TMath::Min(fLastBin[projection * fNDims + axes[i]], axis->GetNbins()), first);
+    nBins[i] = last - first + 1;
+
+    edges[i].Set(nBins[i] + 1);
+    for (Int_t bin=first; bin<=last; bin++)
+      edges[i][bin - first] = axis->GetBinLowEdge(bin);
+    edges[i][nBins[i]] = axis->GetBinUpEdge(last);
+
+    if (axis->GetXbins()->GetSize() > 0)
+      variable = kTRUE;
+  }
+
+  TString name;
+  name.Form("%s_proj_%d", fSource->GetName(), projection);
+
+  Bool_t addStatus = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(kFALSE);
+
+  TH1* hist = 0;
+  if (nAxes == 1)
+  {
+    if (variable)
+      hist = new TH1D(name, fSource->GetTitle(), nBins[0], edges[0].GetArray());
+    else
+      hist = new TH1D(name, fSource->GetTitle(), nBins[0], edges[0][0], edges[0][nBins[0]]);
+  }
+  else
+  {
+    if (variable)
+      hist = new TH2D(name, fSource->GetTitle(), nBins[0], edges[0].GetArray(), nBins[1], edges[1].GetArray());
+    else
+      hist = new TH2D(name, fSource->GetTitle(), nBins[0], edges[0][0], edges[0][nBins[0]], nBins[1], edges[1][0], edges[1][nBins[1]]);
+    hist->GetYaxis()->SetTitle(fSource->GetAxis(axes[1])->GetTitle());
+  }
+  hist->GetXaxis()->SetTitle(fSource->GetAxis(axes[0])->GetTitle());
+
+  TH1::AddDirectory(addStatus);
+
+  if (fSource->GetCalculateErrors())
+    hist->Sumw2();
+
+  return hist;
+}
+
+void AliTHnMultiProjection::Process()
+{
+  // fills all requested projections in one loop over the filled bins of the source
+
+  if (!fSource || fNProjections == 0)
+    return;
+
+  fOutputs.Delete();
+  fOutputs.Expand(fNProjections);
+  for (Int_t p=0; p<fNProjections; p++)
+    fOutputs.AddAt(CreateOutput(p), p);
+
+  // bin offsets of the projected axes (see THnBase::ProjectionAny)
+  TArrayI offsetX(fNProjections);
+  TArrayI offsetY(fNProjections);
+  for (Int_t p=0; p<fNProjections; p++)
+  {
+    offsetX[p] = TMath::Max(fFirstBin[p * fNDims + fAxisX[p]] - 1, 0);
+    offsetY[p] = (fAxisY[p] < 0) ? 0 : TMath::Max(fFirstBin[p * fNDims + fAxisY[p]] - 1, 0);
+  }
+
+  // one bit mask per bin of each axis on which at least one projection has a range
+  // (bit p set = projection p accepts this bin)
+  const Int_t nWords = (fNProjections + 63) / 64;
+  TArrayI activeAxes(fNDims);
+  TArrayI maskOffsets(fNDims);
+  Int_t nActive = 0;
+  Int_t maskSize = 0;
+  for (Int_t i=0; i<fNDims; i++)
+  {
+    Int_t nBins = fSource->GetAxis(i)->GetNbins();
+    Bool_t restricted = kFALSE;
+    for (Int_t p=0; p<fNProjections && !restricted; p++)
+      if (fFirstBin[p * fNDims + i] > 0 || fLastBin[p * fNDims + i] < nBins + 1)
+        restricted = kTRUE;
+    if (!restricted)
+      continue;
+    activeAxes[nActive] = i;
+    maskOffsets[nActive] = maskSize;
+    maskSize += (nBins + 2) * nWords;
+    nActive++;
+  }
+
+  fMasks.Set(maskSize);
+  fMasks.Reset();
+  for (Int_t a=0; a<nActive; a++)
+  {
+    Int_t i = activeAxes[a];
+    for (Int_t p=0; p<fNProjections; p++)
+    {
+      Long64_t bit = (Long64_t) (((ULong64_t) 1) << (p % 64));
+      for (Int_t bin=fFirstBin[p * fNDims + i]; bin<=fLastBin[p * fNDims + i]; bin++)
+        fMasks[maskOffsets[a] + bin * nWords + p / 64] |= bit;
+    }
+  }
+
+  Long64_t* accepted = new Long64_t[nWords];
+  Int_t* coord = new Int_t[fNDims];
+  TArrayL64 entries(fNProjections);
+  Bool_t errors = fSource->GetCalculateErrors();
+  const Long64_t* masks = fMasks.GetArray();
+
+  for (Long64_t i=0; i<fSource->GetNbins(); i++)
+  {
+    Double_t content = fSource->GetBinContent(i, coord);
+    Double_t error2 = (errors) ? fSource->GetBinError2(i) : 0;
+    if (content == 0 && error2 == 0)
+      continue;
+
+    Bool_t any = kFALSE;
+    if (nActive == 0)
+    {
+      for (Int_t w=0; w<nWords; w++)
+        accepted[w] = -1;
+      any = kTRUE;
+    }
+    else
+    {
+      const Long64_t* mask = masks + maskOffsets[0] + coord[activeAxes[0]] * nWords;
+      for (Int_t w=0; w<nWords; w++)
+        accepted[w] = mask[w];
+      for (Int_t a=1; a<nActive; a++)
+      {
+        mask = masks + maskOffsets[a] + coord[activeAxes[a]] * nWords;
+        for (Int_t w=0; w<nWords; w++)
+          accepted[w] &= mask[w];
+      }
+      for (Int_t w=0; w<nWords && !any; w++)
+        if (accepted[w] != 0)
+          any = kTRUE;
+    }
+    if (!any)
+      continue;
+
+    for (Int_t w=0; w<nWords; w++)
+    {
+      ULong64_t word = (ULong64_t) accepted[w];
+      for (Int_t p=w*64; word != 0 && p<fNProjections; p++, word >>= 1)
+      {
+        if ((word & 1) == 0)
+          continue;
+
+        TH1* hist = (TH1*) fOutputs.UncheckedAt(p);
+        Int_t binX = coord[fAxisX[p]] - offsetX[p];
+        Int_t bin = (fAxisY[p] < 0) ? binX : hist->GetBin(binX, coord[fAxisY[p]] - offsetY[p]);
+        hist->AddBinContent(bin, content);
+        if (errors)
+          hist->GetSumw2()->fArray[bin] += error2;
+        entries[p]++;
+      }
+    }
+  }
+
+  for (Int_t p=0; p<fNProjections; p++)
+    ((TH1*) fOutputs.UncheckedAt(p))->SetEntries(entries[p]);
+
+  delete[] accepted;
+  delete[] coord;
+}
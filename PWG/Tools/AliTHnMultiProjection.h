@@ -0,0 +1,58 @@
+#ifndef AliTHnMultiProjection_H
+#define AliTHnMultiProjection_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+// Projects a THnBase (e.g. the grid of an AliTHn / AliCFContainer step) into many
+// histograms in a single pass over its filled bins
+//
+// Each projection is a 1D or 2D histogram with its own bin range on every axis of the source.
+// Use it instead of a loop of SetRange + Projection calls when the same container has to be
+// projected for many bins of one or more axes (e.g. centrality and vertex bins)
+
+#include "TObject.h"
+#include "TArrayI.h"
+#include "TArrayL64.h"
+#include "TObjArray.h"
+
+class THnBase;
+class TH1;
+
+class AliTHnMultiProjection : public TObject
+{
+ public:
+  AliTHnMultiProjection();
+  AliTHnMultiProjection(const THnBase* source);
+  virtual ~AliTHnMultiProjection();
+
+  void  SetSource(const THnBase* source);
+  Int_t AddProjection(Int_t axisX, Int_t axisY = -1);
+  void  SetRange(Int_t projection, Int_t axis, Int_t firstBin, Int_t lastBin);
+  void  Process();
+
+  Int_t GetNProjections() const { return fNProjections; }
+  TH1*  GetProjection(Int_t projection) const { return (TH1*) fOutputs.At(projection); }
+  TH1*  ReleaseProjection(Int_t projection) { return (TH1*) fOutputs.RemoveAt(projection); }
+
+ protected:
+  TH1*  CreateOutput(Int_t projection) const;
+
+  const THnBase* fSource;   //! container which is projected
+  Int_t     fNDims;         //! number of dimensions of the source
+  Int_t     fNProjections;  //! number of requested projections
+  TArrayI   fAxisX;         //! x axis of each projection
+  TArrayI   fAxisY;         //! y axis of each projection (-1 for 1D)
+  TArrayI   fFirstBin;      //! first accepted bin per projection and axis (fNDims entries per projection)
+  TArrayI   fLastBin;       //! last accepted bin per projection and axis
+  TArrayL64 fMasks;         //! bit masks of the projections accepting a given bin of a given axis
+  TObjArray fOutputs;       //! the projections
+
+ private:
+  AliTHnMultiProjection(const AliTHnMultiProjection&);
+  AliTHnMultiProjection& operator=(const AliTHnMultiProjection&);
+
+  ClassDef(AliTHnMultiProjection, 1) // single-pass multi-projection of a THnBase
+};
+
+#endif
@@ -19,6 +19,7 @@
 #pragma link C++ class AliTHnBase+;
 #pragma link C++ class AliTHnT<TArrayF, Float_t>+;
 #pragma link C++ class AliTHnT<TArrayD, Double_t>+;
+#pragma link C++ class AliTHnMultiProjection+;
 #pragma link C++ class THistManager+;
 #pragma link C++ class AliJSONReader+;
 #pragma link C++ class AliJSONData+;
@@ -14,6 +14,7 @@
 #include "AliMFTAnalysisTools.h"
 #include "TRandom.h"
 #include "TList.h"
+#include "TVectorD.h"
 
 ClassImp(AliAnalysisTaskDimuonBackground)
 
@@ -172,6 +173,9 @@ void AliAnalysisTaskDimuonBackground::UserCreateOutputObjects() {
   SetMainInputHandler(mgr);
   if (fMainInputHandler) SetMixingInputHandler(fMainInputHandler);
 
+  // UserExecMix reads the mixed events from the snapshots, when they are available
+  if (fMixingInputHandler) fMixingInputHandler->AddSnapshotTask(this);
+
   PostData(1, fHistogramList);
 
 }
@@ -287,6 +291,10 @@ void AliAnalysisTaskDimuonBackground::UserExec(Option_t *) {
   }   // end of loop on 1st muon
 
   //--------------------------------------------------------------------------------
+
+  // Keeping the muons of this event for the mixing with the next events
+
+  if (fMixingInputHandler && fMixingInputHandler->SnapshotCacheSize() > 0) fMixingInputHandler->AddSnapshot(this, MakeMixingSnapshot(aodEv));
   
   PostData(1, fHistogramList);
 
@@ -333,23 +341,28 @@ void AliAnalysisTaskDimuonBackground::UserExecMix(Option_t *) {
 
   for (Int_t iBuffer=0; iBuffer<bufferSize; iBuffer++) {
 
-    AliAODEvent *aodEvMix = dynamic_cast<AliAODEvent *>(GetMixedEvent(iBuffer));
-    if (!aodEvMix) continue;
+    // The mixed event is read only when the mixing handler has no snapshot of it
+
+    TObjArray *snapshot = (TObjArray*) fMixingInputHandler->GetSnapshot(this, iBuffer);
+    TObjArray *mixEv = snapshot;
+    if (!mixEv) {
+      AliAODEvent *aodEvMix = dynamic_cast<AliAODEvent *>(GetMixedEvent(iBuffer));
+      if (!aodEvMix) continue;
+      mixEv = MakeMixingSnapshot(aodEvMix);
+    }
+    const TVectorD &vertexMixEv = *((TVectorD*) mixEv->At(kSnapshotVertices));
+    TClonesArray *muonsMixEv = (TClonesArray*) mixEv->At(kSnapshotMuons);
 
     // Getting primary vertex, either from the generation or from the reconstruction -------------------
     
-    AliAODMCHeader *mcHeaderMixEv = (AliAODMCHeader*) (aodEvMix->GetList()->FindObject(AliAODMCHeader::StdBranchName()));
-    mcHeaderMixEv->GetVertex(fPrimaryVertexMixEvTrue);
+    for (Int_t i=0; i<3; i++) fPrimaryVertexMixEvTrue[i] = vertexMixEv[i];
  
     if (fVertexMode == kGenerated) {
-      mcHeaderMixEv->GetVertex(fPrimaryVertexMixEv);
-      for (Int_t i=0; i<3; i++) fPrimaryVertexMixEv[i] = gRandom->Gaus(fPrimaryVertexMixEv[i], fVtxResolutionITS[i]);
+      for (Int_t i=0; i<3; i++) fPrimaryVertexMixEv[i] = gRandom->Gaus(fPrimaryVertexMixEvTrue[i], fVtxResolutionITS[i]);
     }
     else if (fVertexMode == kReconstructed) {
-      aodEvMix->GetPrimaryVertex()->GetXYZ(fPrimaryVertexMixEv);
+      for (Int_t i=0; i<3; i++) fPrimaryVertexMixEv[i] = vertexMixEv[3+i];
     }
-
-    TClonesArray *stackMCMixEv = (TClonesArray*) (aodEvMix->GetList()->FindObject(AliAODMCParticle::StdBranchName()));
   
     // Loop over MUON+MFT muons of 1st and 2nd events
     
@@ -362,12 +375,9 @@ void AliAnalysisTaskDimuonBackground::UserExecMix(Option_t *) {
       if (AliMFTAnalysisTools::IsTrackInjected(recMuon[0], mcHeader, stackMC)) continue;    // Only HIJING tracks are considered to build the background
       if (!IsSingleMuonCutPassed(recMuon[0]))                                  continue;
 
-      for (Int_t jTrack=0; jTrack<aodEvMix->GetNumberOfTracks(); jTrack++) { 
+      for (Int_t jTrack=0; jTrack<muonsMixEv->GetEntriesFast(); jTrack++) { 
 
-	recMuon[1] = (AliAODTrack*) aodEvMix->GetTrack(jTrack);
-	if (!(recMuon[1]->IsMuonGlobalTrack()))                                            continue;
-	if (AliMFTAnalysisTools::IsTrackInjected(recMuon[1], mcHeaderMixEv, stackMCMixEv)) continue;    // Only HIJING tracks are considered to build the background
-	if (!IsSingleMuonCutPassed(recMuon[1]))                                            continue;
+	recMuon[1] = (AliAODTrack*) muonsMixEv->At(jTrack);    // Global muons from HIJING passing the single muon cuts
 
 	// ----------- Translating muons to a common primary vertex (the origin). Preserve original tracks in case one wants to use them
 
@@ -422,6 +432,8 @@ void AliAnalysisTaskDimuonBackground::UserExecMix(Option_t *) {
     }   // end of loop on 1st muon
     
     //--------------------------------------------------------------------------------------------------
+
+    if (mixEv != snapshot) delete mixEv;
    
   }   // end of loop on events in buffer
 
@@ -440,6 +452,43 @@ void AliAnalysisTaskDimuonBackground::Terminate(Option_t *) {
 
 //====================================================================================================================================================
 
+TObjArray *AliAnalysisTaskDimuonBackground::MakeMixingSnapshot(AliAODEvent *aodEv) {
+
+  // Content of an event used for the mixing: generated and reconstructed primary vertex,
+  // and the global muons from HIJING passing the single muon cuts
+
+  AliAODMCHeader *mcHeader = (AliAODMCHeader*) (aodEv->GetList()->FindObject(AliAODMCHeader::StdBranchName()));
+  TClonesArray *stackMC = (TClonesArray*) (aodEv->GetList()->FindObject(AliAODMCParticle::StdBranchName()));
+
+  Double_t vertex[3] = {0};
+  TVectorD *vertices = new TVectorD(6);
+  mcHeader->GetVertex(vertex);
+  for (Int_t i=0; i<3; i++) (*vertices)[i] = vertex[i];
+  if (aodEv->GetPrimaryVertex()) {
+    aodEv->GetPrimaryVertex()->GetXYZ(vertex);
+    for (Int_t i=0; i<3; i++) (*vertices)[3+i] = vertex[i];
+  }
+
+  TClonesArray *muons = new TClonesArray("AliAODTrack");
+  for (Int_t iTrack=0; iTrack<aodEv->GetNumberOfTracks(); iTrack++) { 
+    AliAODTrack *recMuon = (AliAODTrack*) aodEv->GetTrack(iTrack);
+    if (!(recMuon->IsMuonGlobalTrack()))                                  continue;
+    if (AliMFTAnalysisTools::IsTrackInjected(recMuon, mcHeader, stackMC)) continue;
+    if (!IsSingleMuonCutPassed(recMuon))                                  continue;
+    new ((*muons)[muons->GetEntriesFast()]) AliAODTrack(*recMuon);
+  }
+
+  TObjArray *snapshot = new TObjArray(2);
+  snapshot -> SetOwner(kTRUE);
+  snapshot -> AddAt(vertices, kSnapshotVertices);
+  snapshot -> AddAt(muons, kSnapshotMuons);
+
+  return snapshot;
+
+}
+
+//====================================================================================================================================================
+
 AliVEvent *AliAnalysisTaskDimuonBackground::GetMainEvent() {
 
   // Access to MainEvent
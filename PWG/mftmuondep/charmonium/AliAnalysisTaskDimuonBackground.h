@@ -10,6 +10,8 @@
 #include "AliAODTrack.h"
 #include "THnSparse.h"
 
+class AliAODEvent;
+
 //====================================================================================================================================================
 
 class  AliAnalysisTaskDimuonBackground : public AliAnalysisTaskSE {
@@ -18,6 +20,7 @@ public:
 
   enum {kGenerated, kReconstructed};
   enum {kSingleEvents, kMixedEvents};
+  enum {kSnapshotVertices, kSnapshotMuons};
  
   AliAnalysisTaskDimuonBackground();
   AliAnalysisTaskDimuonBackground(const char *name);
@@ -51,6 +54,8 @@ public:
 
   Bool_t IsSingleMuonCutPassed(AliAODTrack *mu);
 
+  TObjArray* MakeMixingSnapshot(AliAODEvent *aodEv);
+
 private:
 
   Double_t fMassJpsi;
@@ -35,6 +35,9 @@
 #include "TCanvas.h"
 #include "TF1.h"
 #include "AliTHn.h"
+#include "AliTHnMultiProjection.h"
+#include "TArrayL64.h"
+#include "TObjArray.h"
 #include "THn.h"
 
 ClassImp(AliUEHist)
@@ -1358,12 +1361,108 @@ TH2* AliUEHist::GetPtDistInPhiRegion(AliUEHist* mixed, AliUEHist::CFStep step, A
   //   mixed: AliUEHist containing mixed event corresponding to this object
 */
 
+//____________________________________________________________________
+void AliUEHist::GetUEHistsMultVertex(AliUEHist::CFStep step, AliUEHist::Region region, Float_t ptLeadMin, Float_t ptLeadMax, Int_t multBinBegin, Int_t multBinEnd, TAxis* vertexBins, Bool_t etaNorm, TObjArray& tracks, TArrayL64& nEvents)
+{
+  // Extracts the same 2D histograms as GetUEHist(step, region, ptLeadMin, ptLeadMax, multBin, multBin, 1, etaNorm, &nEvents)
+  // for each multiplicity bin multBin from multBinBegin to multBinEnd (if multBinEnd < multBinBegin: full multiplicity range)
+  // and for each bin of vertexBins (if 0: z vtx range set with SetZVtxRange).
+  // All histograms are projected in one pass over the track and the event container.
+  //
+  // The histogram of vertex bin iVertex (starting at 0) and multiplicity bin iMult (starting at 0) is stored at
+  // iVertex * nMult + iMult in tracks (which owns them), the number of events/trigger particles at the same index in nEvents
+  
+  THnBase* trackGrid = fTrackHist[region]->GetGrid(step)->GetGrid();
+  THnBase* eventGrid = fEventHist->GetGrid(step)->GetGrid();
+
+  // unzoom all axes
+  ResetBinLimits(trackGrid);
+  ResetBinLimits(eventGrid);
+  
+  SetBinLimits(trackGrid);
+  
+  // z vtx (when not binned)
+  if (!vertexBins && fZVtxMax > fZVtxMin)
+  {
+    Printf("Using z-vtx range %f --> %f", fZVtxMin, fZVtxMax);
+    trackGrid->GetAxis(5)->SetRangeUser(fZVtxMin, fZVtxMax);
+    eventGrid->GetAxis(2)->SetRangeUser(fZVtxMin, fZVtxMax);
+  }
+  
+  Int_t firstBin = trackGrid->GetAxis(2)->FindBin(ptLeadMin);
+  Int_t lastBin = trackGrid->GetAxis(2)->FindBin(ptLeadMax);
+  Printf("Using leading pT range %d --> %d", firstBin, lastBin);
+  trackGrid->GetAxis(2)->SetRange(firstBin, lastBin);
+  
+  Int_t nVertex = (vertexBins) ? vertexBins->GetNbins() : 1;
+  Int_t nMult = (multBinEnd >= multBinBegin) ? multBinEnd - multBinBegin + 1 : 1;
+  
+  // the projections take over the ranges set above
+  AliTHnMultiProjection trackProjection(trackGrid);
+  AliTHnMultiProjection eventProjection(eventGrid);
+  for (Int_t iVertex=0; iVertex<nVertex; iVertex++)
+  {
+    for (Int_t iMult=0; iMult<nMult; iMult++)
+    {
+      Int_t id = trackProjection.AddProjection(4, 0);
+      eventProjection.AddProjection(0);
+      
+      if (vertexBins)
+      {
+        Float_t zVtxMin = vertexBins->GetBinLowEdge(iVertex+1) + 0.01;
+        Float_t zVtxMax = vertexBins->GetBinUpEdge(iVertex+1) - 0.01;
+        trackProjection.SetRange(id, 5, trackGrid->GetAxis(5)->FindBin(zVtxMin), trackGrid->GetAxis(5)->FindBin(zVtxMax));
+        eventProjection.SetRange(id, 2, eventGrid->GetAxis(2)->FindBin(zVtxMin), eventGrid->GetAxis(2)->FindBin(zVtxMax));
+      }
+      
+      if (multBinEnd >= multBinBegin)
+      {
+        trackProjection.SetRange(id, 3, multBinBegin + iMult, multBinBegin + iMult);
+        eventProjection.SetRange(id, 1, multBinBegin + iMult, multBinBegin + iMult);
+      }
+    }
+  }
+  trackProjection.Process();
+  eventProjection.Process();
+  
+  // normalize to get a density (deta dphi)
+  Float_t normalization = trackGrid->GetAxis(4)->GetBinWidth(1);
+  if (etaNorm)
+  {
+    TAxis* axis = trackGrid->GetAxis(0);
+    if (strcmp(axis->GetTitle(), "#eta") == 0)
+      normalization *= axis->GetBinUpEdge(axis->GetLast()) - axis->GetBinLowEdge(axis->GetFirst());
+    else
+      normalization *= 0.8 * 2;
+  }
+  
+  tracks.SetOwner(kTRUE);
+  tracks.Expand(trackProjection.GetNProjections());
+  nEvents.Set(trackProjection.GetNProjections());
+  for (Int_t id=0; id<trackProjection.GetNProjections(); id++)
+  {
+    TH1* hist = trackProjection.ReleaseProjection(id);
+    hist->Scale(1.0 / normalization);
+    
+    // NOTE the event histogram contains the number of trigger particles for the azimuthal correlation analysis
+    nEvents[id] = (Long64_t) eventProjection.GetProjection(id)->Integral(firstBin, lastBin);
+    if (nEvents[id] > 0)
+      hist->Scale(1.0 / nEvents[id]);
+    
+    tracks.AddAt(hist, id);
+  }
+  
+  ResetBinLimits(trackGrid);
+  ResetBinLimits(eventGrid);
+}
+
 //____________________________________________________________________
 TH2* AliUEHist::GetSumOfRatios(AliUEHist* mixed, AliUEHist::CFStep step, AliUEHist::Region region, Float_t ptLeadMin, Float_t ptLeadMax, Int_t multBinBegin, Int_t multBinEnd, Bool_t etaNorm, Bool_t useVertexBins)
 {
   // Calls GetUEHist(...) for *each* multiplicity bin and performs a sum of ratios:
   // 1_N [ (same/mixed)_1 + (same/mixed)_2 + (same/mixed)_3 + ... ]
   // where N is the total number of events/trigger particles and the subscript is the multiplicity bin
+  // The histograms of all multiplicity (and vertex) bins are extracted in one pass with GetUEHistsMultVertex
   //
   // Can only be used for the 2D histogram at present
   //
@@ -1374,7 +1473,6 @@ TH2* AliUEHist::GetSumOfRatios(AliUEHist* mixed, AliUEHist::CFStep step, AliUEHi
   TH2* totalTracks = 0;
   Int_t totalEvents = 0;
   
-  Int_t vertexBin = 1;
   TAxis* vertexAxis = fTrackHist[kToward]->GetGrid(0)->GetGrid()->GetAxis(5);
   if (useVertexBins && !vertexAxis)
   {
@@ -1382,73 +1480,31 @@ TH2* AliUEHist::GetSumOfRatios(AliUEHist* mixed, AliUEHist::CFStep step, AliUEHi
     return 0;
   }
   
-  // vertex bin loop
-  while (1)
+  TObjArray sameList;
+  TObjArray mixedList;
+  TArrayL64 sameEvents;
+  TArrayL64 mixedEvents;
+  GetUEHistsMultVertex(step, region, ptLeadMin, ptLeadMax, multBinBegin, multBinEnd, (useVertexBins) ? vertexAxis : 0, etaNorm, sameList, sameEvents);
+  mixed->GetUEHistsMultVertex(step, region, ptLeadMin, ptLeadMax, multBinBegin, multBinEnd, (useVertexBins) ? vertexAxis : 0, etaNorm, mixedList, mixedEvents);
+  
+  // vertex and multiplicity bin loop
+  for (Int_t i=0; i<sameList.GetEntriesFast(); i++)
   {
-    if (useVertexBins)
-    {
-      SetZVtxRange(vertexAxis->GetBinLowEdge(vertexBin) + 0.01, vertexAxis->GetBinUpEdge(vertexBin) - 0.01);
-      mixed->SetZVtxRange(vertexAxis->GetBinLowEdge(vertexBin) + 0.01, vertexAxis->GetBinUpEdge(vertexBin) - 0.01);
-      vertexBin++;
-    }
+    TH2* tracks = (TH2*) sameList.At(i);
+    TH2* mixedTwoD = (TH2*) mixedList.At(i);
     
-    // multiplicity loop
-    Int_t multIter = multBinBegin;
-    while (1)
-    {
-      Int_t multBinBeginLocal = multBinBegin;
-      Int_t multBinEndLocal = multBinEnd;
-      
-      if (multBinEnd >= multBinBegin)
-      {
-	multBinBeginLocal = multIter;
-	multBinEndLocal = multIter;
-	multIter++;
-      }
-	
-      Long64_t nEvents = 0;
-      TH2* tracks = (TH2*) GetUEHist(step, region, ptLeadMin, ptLeadMax, multBinBeginLocal, multBinEndLocal, 1, etaNorm, &nEvents);
-      // undo normalization
-      tracks->Scale(nEvents);
-      totalEvents += nEvents;
-      
-      TH2* mixedTwoD = (TH2*) mixed->GetUEHist(step, region, ptLeadMin, ptLeadMax, multBinBeginLocal, multBinEndLocal, 1, etaNorm);
-      
-      // asssume flat in dphi, gain in statistics
-  //     TH1* histMixedproj = mixedTwoD->ProjectionY();
-  //     histMixedproj->Scale(1.0 / mixedTwoD->GetNbinsX());
-  //     
-  //     for (Int_t x=1; x<=mixedTwoD->GetNbinsX(); x++)
-  //       for (Int_t y=1; y<=mixedTwoD->GetNbinsY(); y++)
-  // 	mixedTwoD->SetBinContent(x, y, histMixedproj->GetBinContent(y));
-
-  //       delete histMixedproj;
-  
-      // get mixed event normalization by assuming full acceptance at deta of 0 (only works for flat dphi)
-/*      Double_t mixedNorm = mixedTwoD->Integral(1, mixedTwoD->GetNbinsX(), mixedTwoD->GetYaxis()->FindBin(-0.01), mixedTwoD->GetYaxis()->FindBin(0.01));
-      mixedNorm /= mixedTwoD->GetNbinsX() * (mixedTwoD->GetYaxis()->FindBin(0.01) - mixedTwoD->GetYaxis()->FindBin(-0.01) + 1);
-      tracks->Scale(mixedNorm);*/
-      
-      tracks->Scale(mixedTwoD->Integral() / tracks->Integral());
-
-      tracks->Divide(mixedTwoD);
-      
-      delete mixedTwoD;
-      
-      if (!totalTracks)
-	totalTracks = tracks;
-      else
-      {
-	totalTracks->Add(tracks);
-	delete tracks;
-      }
+    // undo normalization
+    tracks->Scale(sameEvents[i]);
+    totalEvents += sameEvents[i];
+    
+    tracks->Scale(mixedTwoD->Integral() / tracks->Integral());
 
-      if (multIter > multBinEnd)
-	break;
-    }
+    tracks->Divide(mixedTwoD);
     
-    if (!useVertexBins || vertexBin > vertexAxis->GetNbins())
-      break;
+    if (!totalTracks)
+      totalTracks = (TH2*) sameList.RemoveAt(i);
+    else
+      totalTracks->Add(tracks);
   }
 
   if (useVertexBins)
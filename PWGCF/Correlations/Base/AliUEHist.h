@@ -23,6 +23,9 @@ class TCollection;
 class AliCFGridSparse;
 class THnSparse;
 class THnBase;
+class TAxis;
+class TObjArray;
+class TArrayL64;
 
 class AliUEHist : public TObject
 {
@@ -146,6 +149,7 @@ protected:
   void SetStepNames(AliCFContainer* container);
   void WeightHistogram(TH3* hist1, TH1* hist2);
   void MultiplyHistograms(THnSparse* grid, THnSparse* target, TH1* histogram, Int_t var1, Int_t var2);
+  void GetUEHistsMultVertex(CFStep step, Region region, Float_t ptLeadMin, Float_t ptLeadMax, Int_t multBinBegin, Int_t multBinEnd, TAxis* vertexBins, Bool_t etaNorm, TObjArray& tracks, TArrayL64& nEvents);
 
   AliCFContainer* fTrackHist[4];      // container for track level distributions in four regions (toward, away, min, max) and at all analysis steps
   AliCFContainer* fEventHist;         // container for event level distribution at all analysis steps
@@ -189,6 +189,16 @@ __n2_12_vsEtaPhi(0),
 __s2ptpt_12_vsEtaPhi(0),
 __s2PtN_12_vsEtaPhi(0),
 __s2NPt_12_vsEtaPhi(0),
+__n1Evt_1_vsEtaPhi(0),
+__s1ptEvt_1_vsEtaPhi(0),
+__n1Evt_1_vsPt(0),
+_evtEtaPhi_1(0),
+_evtEtaPhiPos_1(0),
+__n1Evt_2_vsEtaPhi(0),
+__s1ptEvt_2_vsEtaPhi(0),
+__n1Evt_2_vsPt(0),
+_evtEtaPhi_2(0),
+_evtEtaPhiPos_2(0),
 _weight_1      ( 0    ),
 _weight_2      ( 0    ),
 _eventAccounting ( 0),
@@ -474,6 +484,16 @@ __n2_12_vsEtaPhi(0),
 __s2ptpt_12_vsEtaPhi(0),
 __s2PtN_12_vsEtaPhi(0),
 __s2NPt_12_vsEtaPhi(0),
+__n1Evt_1_vsEtaPhi(0),
+__s1ptEvt_1_vsEtaPhi(0),
+__n1Evt_1_vsPt(0),
+_evtEtaPhi_1(0),
+_evtEtaPhiPos_1(0),
+__n1Evt_2_vsEtaPhi(0),
+__s1ptEvt_2_vsEtaPhi(0),
+__n1Evt_2_vsPt(0),
+_evtEtaPhi_2(0),
+_evtEtaPhiPos_2(0),
 _weight_1        ( 0    ),
 _weight_2        ( 0    ),
 _eventAccounting ( 0),
@@ -712,6 +732,18 @@ void AliAnalysisTaskDptDptCorrelations::UserCreateOutputObjects()
     __s1pt_2_vsEtaPhi        = getDoubleArray(_nBins_etaPhi_2,    0.);
     __n1_2_vsZEtaPhiPt       = getFloatArray(_nBins_zEtaPhiPt_2, 0.);
     
+    __n1Evt_1_vsEtaPhi       = getDoubleArray(_nBins_etaPhi_1,    0.);
+    __s1ptEvt_1_vsEtaPhi     = getDoubleArray(_nBins_etaPhi_1,    0.);
+    __n1Evt_1_vsPt           = getDoubleArray(_nBins_pt_1,        0.);
+    _evtEtaPhi_1             = new int[_nBins_etaPhi_1];
+    _evtEtaPhiPos_1          = new int[_nBins_etaPhi_1];
+    __n1Evt_2_vsEtaPhi       = getDoubleArray(_nBins_etaPhi_2,    0.);
+    __s1ptEvt_2_vsEtaPhi     = getDoubleArray(_nBins_etaPhi_2,    0.);
+    __n1Evt_2_vsPt           = getDoubleArray(_nBins_pt_2,        0.);
+    _evtEtaPhi_2             = new int[_nBins_etaPhi_2];
+    _evtEtaPhiPos_2          = new int[_nBins_etaPhi_2];
+    for (int i=0; i<_nBins_etaPhi_1; i++) _evtEtaPhiPos_1[i] = 0;
+    for (int i=0; i<_nBins_etaPhi_2; i++) _evtEtaPhiPos_2[i] = 0;
     }
   
   __n2_12_vsPtPt           = getDoubleArray(_nBins_pt_1*_nBins_pt_2,0.);
@@ -1522,78 +1554,135 @@ void  AliAnalysisTaskDptDptCorrelations::UserExec(Option_t */*option*/)
 	  _s1pt_2_vsM->Fill(centrality,    __s1pt_2);
 	  _n1Nw_2_vsM->Fill(centrality,    __n1Nw_2);
 	  _s1ptNw_2_vsM->Fill(centrality,  __s1ptNw_2);
-	  // reset pair counters
-	  __n2_12   = __s2ptpt_12   = __s2NPt_12    = __s2PtN_12    = 0;
-	  __n2Nw_12 = __s2ptptNw_12 = __s2NPtNw_12  = __s2PtNNw_12  = 0;
+	  // Without pair cut the pair sums are products of the single particle sums of the event:
+	  // sum the particles 1 and 2 per etaPhi and pt bin and multiply the filled bins.
+	  // The two filters select opposite charges, so there is no auto correlation to remove.
+	  int nEvtEtaPhi_1 = 0;
+	  int nEvtEtaPhi_2 = 0;
 	  for (int i1=0; i1<k1; i1++)
 	    {
-	      ////cout << "         i1:" << i1 << endl;
-	      id_1      = _id_1[i1];           ////cout << "       id_1:" << id_1 << endl;
-	      q_1       = _charge_1[i1];       ////cout << "        q_1:" << q_1 << endl;
-	      iEtaPhi_1 = _iEtaPhi_1[i1];      ////cout << "  iEtaPhi_1:" << iEtaPhi_1 << endl;
-	      iPt_1     = _iPt_1[i1];          ////cout << "      iPt_1:" << iPt_1 << endl;
-	      corr_1    = _correction_1[i1];   ////cout << "     corr_1:" << corr_1 << endl;
-	      pt_1      = _pt_1[i1];           ////cout << "       pt_1:" << pt_1 << endl;
-	      px_1      = _px_1[i1];          ////cout << "      px_1:" << px_1 << endl;
-	      py_1      = _py_1[i1];          ////cout << "      py_1:" << py_1 << endl;
-	      pz_1      = _pz_1[i1];          ////cout << "      pz_1:" << pz_1 << endl;
-	      dedx_1    = _dedx_1[i1];        ////cout << "     dedx_1:" << dedx_1 << endl;
-	      
-	      //1 and 2
-	      for (int i2=0; i2<k2; i2++)
-		{        
-		  ////cout << "         i2:" << i2 << endl;
-		  id_2   = _id_2[i2];              ////cout << "       id_2:" << id_2 << endl;
-		  if (id_1!=id_2)  // exclude auto correlation
+	      iEtaPhi_1 = _iEtaPhi_1[i1];
+	      if (!_evtEtaPhiPos_1[iEtaPhi_1])
+		{
+		  _evtEtaPhi_1[nEvtEtaPhi_1++] = iEtaPhi_1;
+		  _evtEtaPhiPos_1[iEtaPhi_1]   = nEvtEtaPhi_1;
+		}
+	      __n1Evt_1_vsEtaPhi[iEtaPhi_1]   += _correction_1[i1];
+	      __s1ptEvt_1_vsEtaPhi[iEtaPhi_1] += _correction_1[i1]*_pt_1[i1];
+	      __n1Evt_1_vsPt[_iPt_1[i1]]      += _correction_1[i1];
+	    }
+	  for (int i2=0; i2<k2; i2++)
+	    {
+	      iEtaPhi_2 = _iEtaPhi_2[i2];
+	      if (!_evtEtaPhiPos_2[iEtaPhi_2])
+		{
+		  _evtEtaPhi_2[nEvtEtaPhi_2++] = iEtaPhi_2;
+		  _evtEtaPhiPos_2[iEtaPhi_2]   = nEvtEtaPhi_2;
+		}
+	      __n1Evt_2_vsEtaPhi[iEtaPhi_2]   += _correction_2[i2];
+	      __s1ptEvt_2_vsEtaPhi[iEtaPhi_2] += _correction_2[i2]*_pt_2[i2];
+	      __n1Evt_2_vsPt[_iPt_2[i2]]      += _correction_2[i2];
+	    }
+	  
+	  for (int j1=0; j1<nEvtEtaPhi_1; j1++)
+	    {
+	      iEtaPhi_1     = _evtEtaPhi_1[j1];
+	      double n1_1   = __n1Evt_1_vsEtaPhi[iEtaPhi_1];
+	      double s1pt_1 = __s1ptEvt_1_vsEtaPhi[iEtaPhi_1];
+	      for (int j2=0; j2<nEvtEtaPhi_2; j2++)
+		{
+		  iEtaPhi_2     = _evtEtaPhi_2[j2];
+		  double n1_2   = __n1Evt_2_vsEtaPhi[iEtaPhi_2];
+		  double s1pt_2 = __s1ptEvt_2_vsEtaPhi[iEtaPhi_2];
+		  ij            = iEtaPhi_1*_nBins_etaPhi_1 + iEtaPhi_2;
+		  __n2_12_vsEtaPhi[ij]     += n1_1*n1_2;
+		  __s2ptpt_12_vsEtaPhi[ij] += s1pt_1*s1pt_2;
+		  __s2PtN_12_vsEtaPhi[ij]  += s1pt_1*n1_2;
+		  __s2NPt_12_vsEtaPhi[ij]  += n1_1*s1pt_2;
+		}
+	    }
+	  for (iPt_1=0; iPt_1<_nBins_pt_1; iPt_1++)
+	    {
+	      for (iPt_2=0; iPt_2<_nBins_pt_2; iPt_2++)
+		__n2_12_vsPtPt[iPt_1*_nBins_pt_2 + iPt_2] += __n1Evt_1_vsPt[iPt_1]*__n1Evt_2_vsPt[iPt_2];
+	    }
+	  
+	  __n2_12      = __n1_1*__n1_2;
+	  __s2ptpt_12  = __s1pt_1*__s1pt_2;
+	  __s2PtN_12   = __s1pt_1*__n1_2;
+	  __s2NPt_12   = __n1_1*__s1pt_2;
+	  __n2Nw_12    = __n1Nw_1*__n1Nw_2;
+	  __s2ptptNw_12 = __s1ptNw_1*__s1ptNw_2;
+	  __s2PtNNw_12 = __s1ptNw_1*__n1Nw_2;
+	  __s2NPtNw_12 = __n1Nw_1*__s1ptNw_2;
+	  
+	  // reset the event sums
+	  for (int j1=0; j1<nEvtEtaPhi_1; j1++)
+	    {
+	      iEtaPhi_1 = _evtEtaPhi_1[j1];
+	      __n1Evt_1_vsEtaPhi[iEtaPhi_1] = __s1ptEvt_1_vsEtaPhi[iEtaPhi_1] = 0;
+	      _evtEtaPhiPos_1[iEtaPhi_1] = 0;
+	    }
+	  for (int j2=0; j2<nEvtEtaPhi_2; j2++)
+	    {
+	      iEtaPhi_2 = _evtEtaPhi_2[j2];
+	      __n1Evt_2_vsEtaPhi[iEtaPhi_2] = __s1ptEvt_2_vsEtaPhi[iEtaPhi_2] = 0;
+	      _evtEtaPhiPos_2[iEtaPhi_2] = 0;
+	    }
+	  for (iPt_1=0; iPt_1<_nBins_pt_1; iPt_1++) __n1Evt_1_vsPt[iPt_1] = 0;
+	  for (iPt_2=0; iPt_2<_nBins_pt_2; iPt_2++) __n1Evt_2_vsPt[iPt_2] = 0;
+	  
+	  // Pairs rejected as conversions are removed from the products, the mass
+	  // spectrum still needs all the pairs
+	  if (_rejectPairConversion)
+	    {
+	      for (int i1=0; i1<k1; i1++)
+		{
+		  iEtaPhi_1 = _iEtaPhi_1[i1];
+		  iPt_1     = _iPt_1[i1];
+		  corr_1    = _correction_1[i1];
+		  pt_1      = _pt_1[i1];
+		  px_1      = _px_1[i1];
+		  py_1      = _py_1[i1];
+		  pz_1      = _pz_1[i1];
+		  dedx_1    = _dedx_1[i1];
+		  for (int i2=0; i2<k2; i2++)
 		    {
-		      q_2       = _charge_2[i2];     ////cout << "        q_2:" << q_2 << endl;
-		      iEtaPhi_2 = _iEtaPhi_2[i2];    ////cout << "  iEtaPhi_2:" << iEtaPhi_2 << endl;
-		      iPt_2     = _iPt_2[i2];        ////cout << "      iPt_2:" << iPt_2 << endl;
-		      corr_2    = _correction_2[i2]; ////cout << "     corr_2:" << corr_2 << endl;
-		      pt_2      = _pt_2[i2];         ////cout << "       pt_2:" << pt_2 << endl;
-		      px_2      = _px_2[i2];          ////cout << "      px_2:" << px_2 << endl;
-		      py_2      = _py_2[i2];          ////cout << "      py_2:" << py_2 << endl;
-		      pz_2      = _pz_2[i2];          ////cout << "      pz_2:" << pz_2 << endl;
-		      dedx_2    = _dedx_2[i2];        ////cout << "     dedx_2:" << dedx_2 << endl;
+		      pt_2      = _pt_2[i2];
+		      px_2      = _px_2[i2];
+		      py_2      = _py_2[i2];
+		      pz_2      = _pz_2[i2];
+		      dedx_2    = _dedx_2[i2];
 		      
+		      float e1Sq = massElecSq + pt_1*pt_1 + pz_1*pz_1;
+		      float e2Sq = massElecSq + pt_2*pt_2 + pz_2*pz_2;
+		      float mInvSq = 2*(massElecSq + sqrt(e1Sq*e2Sq) - px_1*px_2 - py_1*py_2 - pz_1*pz_2 );
+		      float mInv = sqrt(mInvSq);
+		      _invMass->Fill(mInv);
+		      if (!(mInv<0.05 && dedx_1>75. && dedx_2>75.)) continue;
 		      
-		      if (_rejectPairConversion)
-			{
-			  float e1Sq = massElecSq + pt_1*pt_1 + pz_1*pz_1;
-			  float e2Sq = massElecSq + pt_2*pt_2 + pz_2*pz_2;
-			  float mInvSq = 2*(massElecSq + sqrt(e1Sq*e2Sq) - px_1*px_2 - py_1*py_2 - pz_1*pz_2 );
-			  float mInv = sqrt(mInvSq);
-			  _invMass->Fill(mInv);
-			  if (mInv<0.51)
-			    {
-			      if (dedx_1>75. && dedx_2>75.)
-				{
-				  //_invMassElec->Fill(mInv);
-				  if (mInv<0.05) continue;
-				}
-			    }
-			}
-		      
+		      iEtaPhi_2 = _iEtaPhi_2[i2];
+		      iPt_2     = _iPt_2[i2];
+		      corr_2    = _correction_2[i2];
 		      corr      = corr_1*corr_2;
-		      ij        = iEtaPhi_1*_nBins_etaPhi_1 + iEtaPhi_2;   ////cout << " ij:" << ij<< endl;
-		      __n2_12                  += corr;
-		      __n2_12_vsEtaPhi[ij]     += corr;
+		      ij        = iEtaPhi_1*_nBins_etaPhi_1 + iEtaPhi_2;
+		      __n2_12                  -= corr;
+		      __n2_12_vsEtaPhi[ij]     -= corr;
 		      ptpt                     = pt_1*pt_2;
-		      __s2ptpt_12              += corr*ptpt;
-		      __s2PtN_12               += corr*pt_1;
-		      __s2NPt_12               += corr*pt_2;
-		      __s2ptpt_12_vsEtaPhi[ij] += corr*ptpt;
-		      __s2PtN_12_vsEtaPhi[ij]  += corr*pt_1;
-		      __s2NPt_12_vsEtaPhi[ij]  += corr*pt_2;
-		      __n2_12_vsPtPt[iPt_1*_nBins_pt_2 + iPt_2] += corr;         
-		      __n2Nw_12                  += 1;
-		      __s2ptptNw_12              += ptpt;
-		      __s2PtNNw_12               += pt_1;
-		      __s2NPtNw_12               += pt_2;
-		      
-		    }
-		} //i2       
-	    } //i1         
+		      __s2ptpt_12              -= corr*ptpt;
+		      __s2PtN_12               -= corr*pt_1;
+		      __s2NPt_12               -= corr*pt_2;
+		      __s2ptpt_12_vsEtaPhi[ij] -= corr*ptpt;
+		      __s2PtN_12_vsEtaPhi[ij]  -= corr*pt_1;
+		      __s2NPt_12_vsEtaPhi[ij]  -= corr*pt_2;
+		      __n2_12_vsPtPt[iPt_1*_nBins_pt_2 + iPt_2] -= corr;
+		      __n2Nw_12                  -= 1;
+		      __s2ptptNw_12              -= ptpt;
+		      __s2PtNNw_12               -= pt_1;
+		      __s2NPtNw_12               -= pt_2;
+		    } //i2
+		} //i1
+	    }
 	}
       
       _n2_12_vsM->Fill(centrality,     __n2_12);
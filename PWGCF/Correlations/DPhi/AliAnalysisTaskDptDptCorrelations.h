@@ -298,6 +298,18 @@ protected:
   float  * __s2PtN_12_vsEtaPhi;   //!
   float  * __s2NPt_12_vsEtaPhi;   //!
   
+  // single particle sums of the current event, the pair sums of different filters are their products
+  double * __n1Evt_1_vsEtaPhi;   //!
+  double * __s1ptEvt_1_vsEtaPhi;   //!
+  double * __n1Evt_1_vsPt;   //!
+  int    * _evtEtaPhi_1;   //! etaPhi bins filled in the event
+  int    * _evtEtaPhiPos_1;   //! position+1 of the bins in _evtEtaPhi_1, 0 if not filled
+  double * __n1Evt_2_vsEtaPhi;   //!
+  double * __s1ptEvt_2_vsEtaPhi;   //!
+  double * __n1Evt_2_vsPt;   //!
+  int    * _evtEtaPhi_2;   //!
+  int    * _evtEtaPhiPos_2;   //!
+  
   TH3F * _weight_1;
   TH3F * _weight_2;
   TH1D * _eventAccounting;
@@ -468,7 +480,7 @@ protected:
   TString vsPtVsPt;
 
   
-  ClassDef(AliAnalysisTaskDptDptCorrelations,1)
+  ClassDef(AliAnalysisTaskDptDptCorrelations,2)
 }; 
 
 
@@ -664,6 +664,11 @@ void AliJCORRAN::UserExec(){
 	if(fbLPpairCorrel && !lpPairCounter->Exists()) return;
 	AliJBaseTrack *triggTr = NULL;
 
+	// associated tracks grouped by associated pT bin, consecutive pairs then share the histogram bins
+	vector<AliJBaseTrack*> assocSorted;
+	vector<int> assocBucketOffsets;
+	AliJEventPool::SortByAssocBin(fassocList, assocSorted, assocBucketOffsets);
+
 	for(int ii=0;ii<noTriggTracs;ii++){ // trigger loop 
 		if (fbTriggCorrel)  triggTr = (AliJBaseTrack*)ftriggList->At(ii);
 		if (fbLPCorrel)     triggTr = (AliJBaseTrack*)ftriggList->At(lpTrackCounter->GetIndex());
@@ -681,8 +686,8 @@ void AliJCORRAN::UserExec(){
 
 		if(triggTr->GetIsIsolated()>0) fhistos->fhTriggPtBinIsolTrigg[kReal][cBin][iptt]->Fill(ptt, effCorr);
 
-		for(int jj=0;jj<noAssocs;jj++){ // assoc loop
-			AliJBaseTrack  *assocTr = (AliJBaseTrack*)fassocList->At(jj);
+		for(int jj=0;jj<int(assocSorted.size());jj++){ // assoc loop
+			AliJBaseTrack  *assocTr = assocSorted[jj];
 			//assocTr->PrintOut("assoc track");
 			if(fbLPpairCorrel && 
 					(assocTr->GetID()==lpPairCounter->GetPairTrackID(0) || 
@@ -71,7 +71,16 @@ AliJCorrelations::AliJCorrelations( AliJCard *cardIn, AliJHistos *histosIn) :
   fXlongBin(0),
   fIsLikeSign(false),
   fGeometricAcceptanceCorrection(1),
-  fGeometricAcceptanceCorrection3D(1)
+  fGeometricAcceptanceCorrection3D(1),
+  fhDphiAssocResolved(),
+  fhDEtaNearResolved(),
+  fhDetaNearMixAcceptanceResolved(0x0),
+  fhDphiDetaPtaResolved(0x0),
+  fhDphiAssocIsolTriggResolved(0x0),
+  fhAssocPtBinResolved(0x0),
+  fhMeanPtAssocResolved(0x0),
+  fhMeanZtAssocResolved(0x0),
+  fhDphiAssoc2DIAAResolved(0x0)
 {
   // constructor
   
@@ -99,6 +108,7 @@ AliJCorrelations::AliJCorrelations( AliJCard *cardIn, AliJHistos *histosIn) :
   frandom = new TRandom3(); //FK// frandom generator for jt flow UE
   frandom->SetSeed(0); //FK//
   
+  ClearResolvedHistos();
 }
 
 AliJCorrelations::AliJCorrelations() :
@@ -140,9 +150,19 @@ AliJCorrelations::AliJCorrelations() :
   fXlongBin(0),
   fIsLikeSign(false),
   fGeometricAcceptanceCorrection(1),
-  fGeometricAcceptanceCorrection3D(1)
+  fGeometricAcceptanceCorrection3D(1),
+  fhDphiAssocResolved(),
+  fhDEtaNearResolved(),
+  fhDetaNearMixAcceptanceResolved(0x0),
+  fhDphiDetaPtaResolved(0x0),
+  fhDphiAssocIsolTriggResolved(0x0),
+  fhAssocPtBinResolved(0x0),
+  fhMeanPtAssocResolved(0x0),
+  fhMeanZtAssocResolved(0x0),
+  fhDphiAssoc2DIAAResolved(0x0)
 {
   // default constructor
+  ClearResolvedHistos();
 }
 
 AliJCorrelations::AliJCorrelations(const AliJCorrelations& in) :
@@ -183,7 +203,16 @@ AliJCorrelations::AliJCorrelations(const AliJCorrelations& in) :
   fXlongBin(in.fXlongBin),
   fIsLikeSign(in.fIsLikeSign),
   fGeometricAcceptanceCorrection(in.fGeometricAcceptanceCorrection),
-  fGeometricAcceptanceCorrection3D(in.fGeometricAcceptanceCorrection3D)
+  fGeometricAcceptanceCorrection3D(in.fGeometricAcceptanceCorrection3D),
+  fhDphiAssocResolved(),
+  fhDEtaNearResolved(),
+  fhDetaNearMixAcceptanceResolved(0x0),
+  fhDphiDetaPtaResolved(0x0),
+  fhDphiAssocIsolTriggResolved(0x0),
+  fhAssocPtBinResolved(0x0),
+  fhMeanPtAssocResolved(0x0),
+  fhMeanZtAssocResolved(0x0),
+  fhDphiAssoc2DIAAResolved(0x0)
 {
   // The pointers to card and histos are just copied. I think this is safe, since they are not created by
   // AliJCorrelations and thus should not disappear if the AliJCorrelation managing them is destroyed.
@@ -197,6 +226,9 @@ AliJCorrelations::AliJCorrelations(const AliJCorrelations& in) :
   
   frandom = new TRandom3(); // frandom generator for jt flow UE
   frandom->SetSeed(0);
+  
+  // The resolved histograms are not copied, they are looked up again at the first fill
+  ClearResolvedHistos();
 }
 
 AliJCorrelations& AliJCorrelations::operator=(const AliJCorrelations& in){
@@ -255,6 +287,8 @@ AliJCorrelations& AliJCorrelations::operator=(const AliJCorrelations& in){
   frandom = new TRandom3(); // frandom generator for jt flow UE
   frandom->SetSeed(0);
   
+  ClearResolvedHistos();
+  
   return *this;
   // copy constructor
 }
@@ -267,6 +301,43 @@ void AliJCorrelations::FillHisto(corrFillType cFTyp, fillType fTyp, int cBin, in
   
 }
 
+//=============================================================================================
+void AliJCorrelations::ClearResolvedHistos()
+//=============================================================================================
+{
+  // Forget all resolved histogram pointers
+  for(int i=0; i<5; i++) fResolvedBins[i] = -1;
+  int nGapBins = fcard ? fcard->GetNoOfBins(kEtaGapType) : 0;
+  fhDphiAssocResolved.assign( nGapBins, (TH1D*)0x0 );
+  fhDEtaNearResolved.assign( nGapBins, (TH1D*)0x0 );
+  fhDetaNearMixAcceptanceResolved = 0x0;
+  fhDphiDetaPtaResolved = 0x0;
+  fhDphiAssocIsolTriggResolved = 0x0;
+  fhAssocPtBinResolved = 0x0;
+  fhMeanPtAssocResolved = 0x0;
+  fhMeanZtAssocResolved = 0x0;
+  for(int i=0; i<3; i++) fhxEPtBinResolved[i] = 0x0;
+  fhDphiAssoc2DIAAResolved = 0x0;
+}
+
+//=============================================================================================
+void AliJCorrelations::ResolveHistos(fillType fTyp, int zBin)
+//=============================================================================================
+{
+  // The histograms indexed by the pair bins are resolved at most once per
+  // (fill type, centrality, z-vertex, pTt, pTa) combination. Consecutive pairs
+  // share these bins, so the multi-level array lookup is done outside of the pair loop.
+  // Pointers are resolved lazily to avoid booking histograms which are never filled.
+  if( fResolvedBins[0] == fTyp && fResolvedBins[1] == fCentralityBin && fResolvedBins[2] == zBin &&
+      fResolvedBins[3] == fpttBin && fResolvedBins[4] == fptaBin ) return;
+  ClearResolvedHistos();
+  fResolvedBins[0] = fTyp;
+  fResolvedBins[1] = fCentralityBin;
+  fResolvedBins[2] = zBin;
+  fResolvedBins[3] = fpttBin;
+  fResolvedBins[4] = fptaBin;
+}
+
 //=============================================================================================
 void AliJCorrelations::FillAzimuthHistos(fillType fTyp, int CentBin, int ZBin, AliJBaseTrack *ftk1, AliJBaseTrack *ftk2)
 //=============================================================================================
@@ -336,6 +407,8 @@ void AliJCorrelations::FillAzimuthHistos(fillType fTyp, int CentBin, int ZBin, A
     //return;
   }
   
+  ResolveHistos(fTyp, ZBin);
+  
   if(fDeltaPhi==0) cout <<" fdphi=0; fptt="<<  fptt<<"   fpta="<<fpta<<"  TID="<<ftk1->GetID()<<"  AID="<<ftk2->GetID() <<" tphi="<< fPhiTrigger <<" aphi="<< fPhiAssoc << endl;
   
   // ===================================================================
@@ -424,11 +497,11 @@ void AliJCorrelations::FillXeHistograms(fillType fTyp)
   double xe = -fpta*cos(fPhiTrigger-fPhiAssoc)/fptt;
   
   if( fTyp == kReal ) {
-    fhistos->fhxEPtBin[0][fpttBin][fptaBin]->Fill(fXlong, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
+    Resolved(fhxEPtBinResolved[0], fhistos->fhxEPtBin, 0, fpttBin, fptaBin)->Fill(fXlong, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
     if( fNearSide ) {
-      fhistos->fhxEPtBin[1][fpttBin][fptaBin]->Fill(fXlong, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
+      Resolved(fhxEPtBinResolved[1], fhistos->fhxEPtBin, 1, fpttBin, fptaBin)->Fill(fXlong, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
     } else {
-      fhistos->fhxEPtBin[2][fpttBin][fptaBin]->Fill(fXlong, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
+      Resolved(fhxEPtBinResolved[2], fhistos->fhxEPtBin, 2, fpttBin, fptaBin)->Fill(fXlong, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
     }
   }
   
@@ -446,10 +519,10 @@ void AliJCorrelations::FillDeltaEtaHistograms(fillType fTyp, int ZBin)
   
   if( fNearSide ){ //one could check the phiGapBin, but in the pi/2 <1.6 and thus phiGap is always>-1
     if( fTyp == 0 ) {
-      fhistos->fhDEtaNear[fCentralityBin][ZBin][fPhiGapBinNear][fpttBin][fptaBin]->Fill( fDeltaEta , fGeometricAcceptanceCorrection * fTrackPairEfficiency );
+      ResolvedGap(fhDEtaNearResolved, fPhiGapBinNear, fhistos->fhDEtaNear, fCentralityBin, ZBin, fPhiGapBinNear, fpttBin, fptaBin)->Fill( fDeltaEta , fGeometricAcceptanceCorrection * fTrackPairEfficiency );
     } else {
-      fhistos->fhDEtaNearM[fCentralityBin][ZBin][fPhiGapBinNear][fpttBin][fptaBin]->Fill( fDeltaEta , fGeometricAcceptanceCorrection * fTrackPairEfficiency );
-      fhistos->fhDetaNearMixAcceptance[fCentralityBin][fpttBin][fptaBin]->Fill( fDeltaEta, fTrackPairEfficiency);
+      ResolvedGap(fhDEtaNearResolved, fPhiGapBinNear, fhistos->fhDEtaNearM, fCentralityBin, ZBin, fPhiGapBinNear, fpttBin, fptaBin)->Fill( fDeltaEta , fGeometricAcceptanceCorrection * fTrackPairEfficiency );
+      Resolved(fhDetaNearMixAcceptanceResolved, fhistos->fhDetaNearMixAcceptance, fCentralityBin, fpttBin, fptaBin)->Fill( fDeltaEta, fTrackPairEfficiency);
     }
   } else {
     if(fPhiGapBinAway<=3) fhistos->fhDEtaFar[fTyp][fCentralityBin][fpttBin]->Fill( fDeltaEta, fGeometricAcceptanceCorrection * fTrackPairEfficiency );
@@ -475,10 +548,10 @@ void AliJCorrelations::FillDeltaPhiHistograms(fillType fTyp)
   // When hists are filled for thresholds they are not properly normalized and need to be subtracted
   // This induced improper errors - subtraction of not-independent entries
   
-  fhistos->fhDphiAssoc[fTyp][fCentralityBin][fEtaGapBin][fpttBin][fptaBin]->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection * fTrackPairEfficiency);
+  ResolvedGap(fhDphiAssocResolved, fEtaGapBin, fhistos->fhDphiAssoc, fTyp, fCentralityBin, fEtaGapBin, fpttBin, fptaBin)->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection * fTrackPairEfficiency);
   if(fXlongBin>=0 && fNearSide3D) fhistos->fhDphiAssocXEbin[fTyp][fCentralityBin][fEtaGapBin][fpttBin][fXlongBin]->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection3D * fTrackPairEfficiency);
   
-  if(fIsIsolatedTrigger) fhistos->fhDphiAssocIsolTrigg[fTyp][fCentralityBin][fpttBin][fptaBin]->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection * fTrackPairEfficiency); //FK//
+  if(fIsIsolatedTrigger) Resolved(fhDphiAssocIsolTriggResolved, fhistos->fhDphiAssocIsolTrigg, fTyp, fCentralityBin, fpttBin, fptaBin)->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection * fTrackPairEfficiency); //FK//
 }
 
 void AliJCorrelations::FillDeltaEtaDeltaPhiHistograms(fillType fTyp, int zBin)
@@ -488,7 +561,7 @@ void AliJCorrelations::FillDeltaEtaDeltaPhiHistograms(fillType fTyp, int zBin)
   
   // Fill the histogram in pTa bins
   if(fNearSide){
-    fhistos->fhDphiDetaPta[fTyp][fCentralityBin][zBin][fpttBin][fptaBin]->Fill(fDeltaEta, fDeltaPhiPiPi, fTrackPairEfficiency);
+    Resolved(fhDphiDetaPtaResolved, fhistos->fhDphiDetaPta, fTyp, fCentralityBin, zBin, fpttBin, fptaBin)->Fill(fDeltaEta, fDeltaPhiPiPi, fTrackPairEfficiency);
   }
   
   // Fill the histogram in xlong bins
@@ -504,15 +577,15 @@ void AliJCorrelations::FillPtaHistograms(fillType fTyp)
   
   if ( fTyp == kReal ) {
     //must be here, not in main, to avoid counting triggers
-    fhistos->fhAssocPtBin[fCentralityBin][fpttBin][fptaBin]->Fill(fpta ); //I think It should not be weighted by Eff
+    Resolved(fhAssocPtBinResolved, fhistos->fhAssocPtBin, fCentralityBin, fpttBin, fptaBin)->Fill(fpta ); //I think It should not be weighted by Eff
     
     //++++++++++++++++++++++++++++++++++++++++++++++++++
     // in order to get mean pTa in the jet peak one has
     // to fill fhMeanPtAssoc in |DeltaEta|<0.4
     // +++++++++++++++++++++++++++++++++++++++++++++++++
     if(fEtaGapBin>=0 && fEtaGapBin<2){
-      fhistos->fhMeanPtAssoc[fCentralityBin][fpttBin][fptaBin]->Fill( fDeltaPhi/kJPi , fpta );
-      fhistos->fhMeanZtAssoc[fCentralityBin][fpttBin][fptaBin]->Fill( fDeltaPhi/kJPi , fpta/fptt);
+      Resolved(fhMeanPtAssocResolved, fhistos->fhMeanPtAssoc, fCentralityBin, fpttBin, fptaBin)->Fill( fDeltaPhi/kJPi , fpta );
+      Resolved(fhMeanZtAssocResolved, fhistos->fhMeanZtAssoc, fCentralityBin, fpttBin, fptaBin)->Fill( fDeltaPhi/kJPi , fpta/fptt);
     }
     
     //UE distribution
@@ -536,7 +609,7 @@ void AliJCorrelations::FillIAAAndMoonHistograms(fillType fTyp, int ZBin)
 {
   // This method fills the I_AA and moon histograms
   
-  if(fhistos->Is2DHistosEnabled()) fhistos->fhDphiAssoc2DIAA[fTyp][fCentralityBin][ZBin][fpttBin][fptaBin]->Fill( fDeltaEta, fDeltaPhi/kJPi, fTrackPairEfficiency);
+  if(fhistos->Is2DHistosEnabled()) Resolved(fhDphiAssoc2DIAAResolved, fhistos->fhDphiAssoc2DIAA, fTyp, fCentralityBin, ZBin, fpttBin, fptaBin)->Fill( fDeltaEta, fDeltaPhi/kJPi, fTrackPairEfficiency);
   
   if(fRGapBinNear>=0){
     if(fRGapBinNear <= fRSignalBin) fhistos->fhDRNearPt[fTyp][fCentralityBin][ZBin][fRGapBinNear][fpttBin]->Fill( fpta, fGeometricAcceptanceCorrection * fTrackPairEfficiency );
@@ -16,6 +16,7 @@
 #include <fstream>
 #include <stdlib.h>
 #include <stdio.h>
+#include <vector>
 #include <TRandom3.h>  //FK//
 
 #include "AliJHistos.h"
@@ -108,8 +109,35 @@ protected:
   double fGeometricAcceptanceCorrection;   // Acceptance correction due to the detector geometry
   double fGeometricAcceptanceCorrection3D; // Acceptance correction due to the detector geometry for 3D near side
   
+  // Histograms of the current (fill type, centrality, z-vertex, pTt, pTa) bin, resolved when first filled
+  int fResolvedBins[5];  // Bins the resolved histograms below belong to, -1 when nothing is resolved
+  vector<TH1D*> fhDphiAssocResolved;  // fhDphiAssoc in eta gap bins
+  vector<TH1D*> fhDEtaNearResolved;  // fhDEtaNear (fhDEtaNearM for mixed events) in phi gap bins
+  TH1D *fhDetaNearMixAcceptanceResolved;  // fhDetaNearMixAcceptance
+  TH2D *fhDphiDetaPtaResolved;  // fhDphiDetaPta
+  TH1D *fhDphiAssocIsolTriggResolved;  // fhDphiAssocIsolTrigg
+  TH1D *fhAssocPtBinResolved;  // fhAssocPtBin
+  TProfile *fhMeanPtAssocResolved;  // fhMeanPtAssoc
+  TProfile *fhMeanZtAssocResolved;  // fhMeanZtAssoc
+  TH1D *fhxEPtBinResolved[3];  // fhxEPtBin for all, near and far side
+  TH2D *fhDphiAssoc2DIAAResolved;  // fhDphiAssoc2DIAA
+  
 private:
   
+  void ResolveHistos(fillType fTyp, int zBin);
+  void ClearResolvedHistos();
+  
+  // Histogram pointer of a bin, looked up only the first time it is needed for the current bins
+  template<typename T> T* Resolved( T *&resolved, AliJTH1Derived<T> &histo, int i0, int i1, int i2=-1, int i3=-1, int i4=-1 ){
+    if( !resolved ) resolved = histo.At( i0, i1, i2, i3, i4 );
+    return resolved;
+  }
+  // The same for histograms with an additional gap bin, gap bins outside of the cache are looked up directly
+  TH1D* ResolvedGap( vector<TH1D*> &resolved, int gapBin, AliJTH1D &histo, int i0, int i1, int i2, int i3, int i4 ){
+    if( gapBin < 0 || gapBin >= int(resolved.size()) ) return histo.At( i0, i1, i2, i3, i4 );
+    return Resolved( resolved[gapBin], histo, i0, i1, i2, i3, i4 );
+  }
+  
   void FillPairPtAndCosThetaStarHistograms(fillType fTyp, AliJBaseTrack *ftk1, AliJBaseTrack *ftk2);
   void FillXeHistograms(fillType fTyp);
   void FillDeltaEtaHistograms(fillType fTyp, int zBin);
@@ -29,7 +29,8 @@ AliJEventPool::AliJEventPool(AliJCard *cardin, AliJHistogramInterface *histosin,
   //ftk1(NULL),
   //ftk2(NULL),
   fthisPoolType(particle),
-  fpoolList(NULL)
+  fpoolList(NULL),
+  fSorted()
 {       
   // constructor
   
@@ -76,7 +77,8 @@ AliJEventPool::AliJEventPool(const AliJEventPool& obj) :
   //ftk1(obj.ftk1),
   //ftk2(obj.ftk2),
   fthisPoolType(obj.fthisPoolType),
-  fpoolList(obj.fpoolList)
+  fpoolList(obj.fpoolList),
+  fSorted()
 {
   // copy constructor
   JUNUSED(obj);
@@ -120,17 +122,25 @@ void AliJEventPool::Mix( TClonesArray *triggList,
                 fevent[cBin][backCounter] != iev )
         {
             fnoMixCut[cBin]++;
+            // the pool tracks are stored bucket by bucket in associated pT bins
+            const vector<int> &offsets = fBucketOffsets[cBin][backCounter];
+            const vector<float> &minPt = fBucketMinPt[cBin][backCounter];
+            int noBuckets = int(offsets.size())-1;
             //=================================================
             // try to use only one track from each fevent
             //=================================================
             for(int ii=0;ii<noTrigg;ii++){
                 AliJBaseTrack *ftk1 = (AliJBaseTrack*)triggList->At(ii);        
                 //fhistos->fhTriggPtBin[kMixed][cBin][iptt]->Fill(ptt); //who needs that?
-                for(int jj=0;jj<noAssoc ;jj++){
-                    AliJBaseTrack *ftk2 = (AliJBaseTrack*)fpoolList->At(jj);
-                    if(leadingParticle && ftk1->Pt() < ftk2->Pt()) continue; // In leading particle correlations, accept only those associated particles whose pT is lower than that of the trigger
-                    fcorrelations->FillHisto(cFTyp,kMixed, cBin, zBin, ftk1, ftk2);
-                } //inner loop mixing
+                for(int ib=0;ib<noBuckets;ib++){
+                    // In leading particle correlations, skip the buckets in which all the tracks are harder than the trigger
+                    if(leadingParticle && ftk1->Pt() < minPt[ib]) continue;
+                    for(int jj=offsets[ib];jj<offsets[ib+1];jj++){
+                        AliJBaseTrack *ftk2 = (AliJBaseTrack*)fpoolList->UncheckedAt(jj);
+                        if(leadingParticle && ftk1->Pt() < ftk2->Pt()) continue; // In leading particle correlations, accept only those associated particles whose pT is lower than that of the trigger
+                        fcorrelations->FillHisto(cFTyp,kMixed, cBin, zBin, ftk1, ftk2);
+                    } //inner loop mixing
+                }//associated pT bin loop
             }//outer loop mixing
         }//if good for mix
     }//mixed fevent loop
@@ -153,22 +163,25 @@ void AliJEventPool::AcceptList(TClonesArray *inList, float cent, float Z, float
     fcentrality[cBin][fwhereToStore[cBin]] = cent;
     fmult      [cBin][fwhereToStore[cBin]] = inMult;
 
+    // store the tracks ordered by the associated pT bin, Mix() then loops bucket by bucket
+    SortByAssocBin(inList, fSorted, fBucketOffsets[cBin][fwhereToStore[cBin]], &fBucketMinPt[cBin][fwhereToStore[cBin]]);
+
     fLists[cBin][fwhereToStore[cBin]]->Clear();
-    for(int i=0;i<inList->GetEntriesFast();i++){
+    for(int i=0;i<int(fSorted.size());i++){
 				if( fthisPoolType == kJPhoton || fthisPoolType == kJDecayphoton ){
-					AliJPhoton *tkp = (AliJPhoton*)inList->At(i);
+					AliJPhoton *tkp = (AliJPhoton*)fSorted[i];
 					new ((*fLists[cBin][fwhereToStore[cBin]])[i]) AliJPhoton(*tkp);
 				}
 				else if( fthisPoolType == kJPizero || fthisPoolType == kJEta ){
-					AliJPiZero *tkpz = (AliJPiZero*)inList->At(i);
+					AliJPiZero *tkpz = (AliJPiZero*)fSorted[i];
 					new ((*fLists[cBin][fwhereToStore[cBin]])[i]) AliJPiZero(*tkpz);
 				}
         else if ( fthisPoolType == kJHadronMC ){
-          AliJMCTrack *mcTrack = (AliJMCTrack*)inList->At(i);
+          AliJMCTrack *mcTrack = (AliJMCTrack*)fSorted[i];
           new ((*fLists[cBin][fwhereToStore[cBin]])[i]) AliJMCTrack(*mcTrack);
         }
 				else{
-					AliJTrack *tk3 = (AliJTrack*)inList->At(i);
+					AliJTrack *tk3 = (AliJTrack*)fSorted[i];
 					new ((*fLists[cBin][fwhereToStore[cBin]])[i]) AliJTrack(*tk3);
 				}
     }
@@ -179,6 +192,36 @@ void AliJEventPool::AcceptList(TClonesArray *inList, float cent, float Z, float
 
 
 
+//______________________________________________________________________________
+void AliJEventPool::SortByAssocBin(TClonesArray *inList, vector<AliJBaseTrack*> &sorted, vector<int> &offsets, vector<float> *minPt){
+    // counting sort of the tracks by associated pT bin, the order inside a bin is kept
+    int noTracks = inList->GetEntriesFast();
+    int maxBin = -1;
+    for(int i=0;i<noTracks;i++){
+        int ipta = ((AliJBaseTrack*)inList->UncheckedAt(i))->GetAssocBin();
+        if( ipta > maxBin ) maxBin = ipta;
+    }
+    int noBuckets = maxBin+2; // the last bucket collects the tracks without associated bin
+
+    offsets.assign(noBuckets+1, 0);
+    for(int i=0;i<noTracks;i++){
+        int ipta = ((AliJBaseTrack*)inList->UncheckedAt(i))->GetAssocBin();
+        offsets[(ipta<0 ? noBuckets-1 : ipta)+1]++;
+    }
+    for(int ib=0;ib<noBuckets;ib++) offsets[ib+1] += offsets[ib];
+
+    sorted.resize(noTracks);
+    if( minPt ) minPt->assign(noBuckets, 1e30);
+    vector<int> next(offsets.begin(), offsets.end()-1);
+    for(int i=0;i<noTracks;i++){
+        AliJBaseTrack *tk = (AliJBaseTrack*)inList->UncheckedAt(i);
+        int ib = tk->GetAssocBin() < 0 ? noBuckets-1 : tk->GetAssocBin();
+        sorted[next[ib]++] = tk;
+        if( minPt && tk->Pt() < (*minPt)[ib] ) (*minPt)[ib] = tk->Pt();
+    }
+}
+
+
 //==================== Sampling ===========================
 void AliJEventPool::Mysample(TH1D *fromh, TH1D *toh )
 {
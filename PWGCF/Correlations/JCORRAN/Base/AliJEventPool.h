@@ -10,6 +10,7 @@
 #include <fstream>
 #include <stdlib.h>
 #include <stdio.h>
+#include <vector>
 
 using namespace std;
 
@@ -46,6 +47,11 @@ class AliJEventPool {
         void AcceptList(TClonesArray *inList, float cent, float Z, float inMult, int iev);
 
         void Mysample(TH1D *fromh, TH1D *toh );
+
+        // Order the tracks of a list by their associated pT bin. Bucket b holds the tracks
+        // sorted[offsets[b]] ... sorted[offsets[b+1]-1], tracks outside of the associated
+        // bins go to the last bucket. If requested, minPt[b] is the lowest pT in bucket b.
+        static void SortByAssocBin(TClonesArray *inList, vector<AliJBaseTrack*> &sorted, vector<int> &offsets, vector<float> *minPt = NULL);
         void PrintOut(){for(int i=0;i<kMaxNoCentrBin;i++)
             cout<<"c: "<<i<<" mixed "<<fnoMix[i]<<" accepted "<<fnoMixCut[i]<<" "<<(fnoMix[i]>0?fnoMixCut[i]*1.0/fnoMix[i]:0)<< endl;}
 
@@ -60,7 +66,10 @@ class AliJEventPool {
         long fnoMix[kMaxNoCentrBin];  // comment me
         long fnoMixCut[kMaxNoCentrBin];   // comment me
 
-        TClonesArray   *fLists[kMaxNoCentrBin][MAXNOEVENT]; // mix lists
+        TClonesArray   *fLists[kMaxNoCentrBin][MAXNOEVENT]; // mix lists, tracks stored in associated pT bin order
+        vector<int>     fBucketOffsets[kMaxNoCentrBin][MAXNOEVENT]; // first track of each associated pT bin in fLists
+        vector<float>   fBucketMinPt[kMaxNoCentrBin][MAXNOEVENT]; // lowest pT of each associated pT bin in fLists
+        vector<AliJBaseTrack*> fSorted; // work array for AcceptList
         AliJCard  *fcard;  // card
         AliJCorrelationInterface *fcorrelations; // correlation object
         AliJHistogramInterface *fhistos;  // histos
@@ -63,8 +63,13 @@ AliJFFlucAnalysis::AliJFFlucAnalysis()
 	//fh_Qvector(),
 	fh_ntracks(),
 	fh_vn(),
-	fh_vn_vn()
+	fh_vn_vn(),
+	fSPValues(),
+	fSPHistos(),
+	fSPSlots(),
+	fSPSlotWeight()
 {
+	fNEtaGaps = 0;
 	const int NCent = 7;
 	Double_t CentBin[NCent+1] = {0, 5, 10, 20, 30, 40, 50, 60};
 	fNCent = NCent;
@@ -114,9 +119,14 @@ AliJFFlucAnalysis::AliJFFlucAnalysis(const char *name)
 	//fh_Qvector(),
 	fh_ntracks(),
 	fh_vn(),
-	fh_vn_vn()
+	fh_vn_vn(),
+	fSPValues(),
+	fSPHistos(),
+	fSPSlots(),
+	fSPSlotWeight()
 {
 	cout << "analysis task created " << endl;
+	fNEtaGaps = 0;
 	const int NCent = 7;
 	Double_t CentBin[NCent+1] = {0, 5, 10, 20, 30, 40, 50, 60};
 	fNCent = NCent;
@@ -188,9 +198,18 @@ AliJFFlucAnalysis::AliJFFlucAnalysis(const AliJFFlucAnalysis& a):
 	//fh_Qvector(a.fh_Qvector),
 	fh_ntracks(a.fh_ntracks),
 	fh_vn(a.fh_vn),
-	fh_vn_vn(a.fh_vn_vn)
+	fh_vn_vn(a.fh_vn_vn),
+	fSPValues(),
+	fSPHistos(),
+	fSPSlots(),
+	fSPSlotWeight()
 {
 	//copy constructor
+	fNEtaGaps = a.fNEtaGaps;
+	for(int ig=0; ig<fNEtaGaps; ig++){
+		fEtaGap[ig][0] = a.fEtaGap[ig][0];
+		fEtaGap[ig][1] = a.fEtaGap[ig][1];
+	}
 	//	DefineOutput(1, TList::Class() );
 }
 //________________________________________________________________________
@@ -229,6 +248,7 @@ void AliJFFlucAnalysis::UserCreateOutputObjects(){
 	fCorrBin .Set("C", "C","C:%d", AliJBin::kSingle).SetBin(17);
 
 	fBin_Nptbins .Set("PtBin","PtBin", "Pt:%d", AliJBin::kSingle).SetBin(N_ptbins);
+	fBin_EtaGap .Set("EtaGap","EtaGap","EtaGap:%d", AliJBin::kSingle).SetBin(fNEtaGaps+1);
 
 	// set AliJTH1D here //
 	fh_cent
@@ -275,22 +295,26 @@ void AliJFFlucAnalysis::UserCreateOutputObjects(){
 		<< fHistCentBin
 		<< "END" ;
 
+	// the SP histograms get an eta gap bin only if additional eta gaps are configured
 	fh_vn
 		<< TH1D("hvn","hvn", 1024, -1.5, 1.5)
 		<< fBin_h << fBin_k
-		<< fHistCentBin
-		<< "END";   // histogram of vn_h^k values for [ih][ik][iCent]
+		<< fHistCentBin;
+	if( fNEtaGaps > 0 ) fh_vn << fBin_EtaGap;
+	fh_vn << "END";   // histogram of vn_h^k values for [ih][ik][iCent]([iGap])
 	fh_vn_vn
 		<< TH1D("hvn_vn", "hvn_vn", 1024, -1.5, 1.5)
 		<< fBin_h << fBin_k
 		<< fBin_hh << fBin_kk
-		<< fHistCentBin
-		<< "END";  // histo of < vn * vn > for [ih][ik][ihh][ikk][iCent]
+		<< fHistCentBin;
+	if( fNEtaGaps > 0 ) fh_vn_vn << fBin_EtaGap;
+	fh_vn_vn << "END";  // histo of < vn * vn > for [ih][ik][ihh][ikk][iCent]([iGap])
 	fh_correlator
 		<< TH1D("h_corr", "h_corr", 1024, -1.5, 1.5)
 		<< fCorrBin
-		<< fHistCentBin
-		<< "END" ;
+		<< fHistCentBin;
+	if( fNEtaGaps > 0 ) fh_correlator << fBin_EtaGap;
+	fh_correlator << "END" ;
 
 	fh_SC_ptdep_4corr
 		<< TH1D("hvnvm_SC","hvnvm_SC", 1024, -1.5, 1.5)
@@ -343,6 +367,32 @@ void AliJFFlucAnalysis::UserCreateOutputObjects(){
 		<< "END" ; // fBin_h > not stand for harmonics, only for v2, v3, v4, v5
 	//AliJTH1D set done.
 
+	// flat buffer of the SP correlators and the list of filled slots
+	fSPValues.assign( (fNEtaGaps+1)*kNSPValues, 0 );
+	fSPHistos.assign( (fNEtaGaps+1)*fNCent*kNSPValues, (TH1D*)NULL );
+	fSPSlots.clear();
+	fSPSlotWeight.clear();
+	for(int ih=2; ih<kNH; ih++){
+		for(int ik=0; ik<nKL; ik++){
+			fSPSlots.push_back( kSPvn + ih*nKL + ik );
+			fSPSlotWeight.push_back( kSPWeight2p );
+		}
+	}
+	for(int ih=2; ih<kNH; ih++){
+		for(int ik=1; ik<nKL; ik++){
+			for(int ihh=2; ihh<kNH; ihh++){
+				for(int ikk=1; ikk<nKL; ikk++){
+					fSPSlots.push_back( kSPvnvn + ((ih*nKL + ik)*kNH + ihh)*nKL + ikk );
+					fSPSlotWeight.push_back( kSPWeight4p );
+				}
+			}
+		}
+	}
+	for(int icorr=0; icorr<kNSPcorr; icorr++){
+		fSPSlots.push_back( kSPcorr + icorr );
+		fSPSlotWeight.push_back( icorr < 12 ? kSPWeight1 : kSPWeight4p );
+	}
+
 	fHMG->Print();
 	fHMG->WriteConfig();
 
@@ -388,158 +438,47 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 
 	enum{kSubA, kSubB, kNSub};
 	enum{kMin, kMax};
-	enum{kReal, kImg, kNPhase};
 	Double_t Eta_config[kNSub][2];
 	Eta_config[kSubA][kMin] = fEta_min;  // 0.4 min for SubA
 	Eta_config[kSubA][kMax] = fEta_max;  // 0.8 max for SubA
 	Eta_config[kSubB][kMin] = -1*fEta_max; // -0.8  min for SubB
 	Eta_config[kSubB][kMax] = -1*fEta_min; // -0.4  max for SubB
 
-	// use complex variable instead of doulbe Qn //
-	TComplex QnA[kNH];
-	TComplex QnB[kNH];
-	TComplex QnB_star[kNH];
-	//---------------- Do initialize here -----------
-	for(int ih=0; ih<kNH; ih++){
-		QnA[ih]= TComplex(0,0);
-		QnB[ih]= TComplex(0,0);
-		QnB_star[ih] = TComplex(0,0);
+	// Q-vectors of all harmonics for the eta gap configurations, in one loop over the tracks
+	// configuration 0 is the one set with SetEtaRange, the others are added with AddEtaGap
+	int nGaps = fNEtaGaps+1;
+	Double_t etaRange[kMaxEtaGaps+1][2];
+	etaRange[0][kMin] = fEta_min;
+	etaRange[0][kMax] = fEta_max;
+	for(int ig=1; ig<nGaps; ig++){
+		etaRange[ig][kMin] = fEtaGap[ig-1][kMin];
+		etaRange[ig][kMax] = fEtaGap[ig-1][kMax];
 	}
-	//--------------- Calculate Qn--------------------
-	for(int ih=0; ih<kNH; ih++){
-		QnA[ih] = CalculateQnSP( Eta_config[kSubA][kMin], Eta_config[kSubA][kMax], ih);
-		QnB[ih] = CalculateQnSP( Eta_config[kSubB][kMin], Eta_config[kSubB][kMax], ih);
-		//fh_Qvector[fCBin][0][ih]->Fill( QnA[ih].Theta() );
-		//fh_Qvector[fCBin][1][ih]->Fill( QnB[ih].Theta() );
-		QnB_star[ih] = TComplex::Conjugate ( QnB[ih] ) ;
-	}
-	NSubTracks[kSubA] = QnA[0].Re(); // this is number of tracks in Sub A
-	NSubTracks[kSubB] = QnB[0].Re(); // this is number of tracks in Sub B
+	TComplex QnA[kMaxEtaGaps+1][kNH];
+	TComplex QnB[kMaxEtaGaps+1][kNH];
+	CalculateQnSPGaps( nGaps, etaRange, QnA, QnB );
+	NSubTracks[kSubA] = QnA[0][0].Re(); // this is number of tracks in Sub A
+	NSubTracks[kSubB] = QnB[0][0].Re(); // this is number of tracks in Sub B
 	//-------------- Fill histos with below Values ----
 	// v2^2 :  k=1  /// remember QnQn = vn^(2k) not k
 	// use k=0 for check v2, v3 only
-	Double_t vn2[kNH][nKL];
-	Double_t vn2_vn2[kNH][nKL][kNH][nKL];
-	//initiation
-	for(int ih=0; ih<kNH; ih++){
-		for(int ik=0; ik<nKL ; ik++){
-			vn2[ih][ik] =    -999;
-			for(int ihh=0; ihh<kNH; ihh++){
-				for(int ikk=0; ikk<nKL; ikk++){
-					vn2_vn2[ih][ik][ihh][ikk] = -999;
-				}
-			}
+	for(int ig=0; ig<nGaps; ig++){
+		Double_t *values = &fSPValues[ig*kNSPValues];
+		CalculateSPCorrelators( QnA[ig], QnB[ig], values );
+		Double_t ebe_2p_weight = 1;
+		Double_t ebe_4p_weight = 1;
+		if( IsEbEWeighted == kTRUE ){
+			Double_t nA = QnA[ig][0].Re();
+			Double_t nB = QnB[ig][0].Re();
+			ebe_2p_weight = nA * nB ;
+			ebe_4p_weight = nA * nB * (nA-1) * (nB-1) ;
 		}
+		FillSPCorrelators( ig, values, ebe_2p_weight, ebe_4p_weight );
 	}
-	// calculate vn^2k
+	const Double_t *spValues = &fSPValues[0]; // results of configuration 0
 	for(int ih=2; ih<kNH; ih++){
-		for(int ik=0; ik<nKL; ik++){ // 2k(0) =1, 2k(1) =2, 2k(2)=4....
-			if(ik==0){
-				vn2[ih][ik] = TMath::Sqrt( ( ( QnA[ih] * QnB_star[ih] ).Re() ) );
-				fSingleVn[ih][0] = vn2[ih][ik]; // fill single vn with SP as method 0
-			}else{
-				TComplex QnAk;
-				TComplex QnBstark;
-				QnAk = TComplex::Power( QnA[ih], ik);
-				QnBstark = TComplex::Power(QnB_star[ih], ik);
-				vn2[ih][ik] = ( QnAk * QnBstark ).Re();
-			}
-		}
+		fSingleVn[ih][0] = spValues[kSPvn + ih*nKL]; // fill single vn with SP as method 0
 	}
-	// vn^2k calcualted for n.... k....
-	// calculate hvn_vn (2 combination of vn)
-	for( int ih=2; ih<kNH; ih++){
-		for( int ik=1; ik<nKL; ik++){
-			for( int ihh=2; ihh<kNH; ihh++){
-				for(int ikk=1; ikk<nKL; ikk++){
-					vn2_vn2[ih][ik][ihh][ikk] = (TComplex::Power( QnA[ih]*QnB_star[ih],ik)*TComplex::Power(QnA[ihh]*QnB_star[ihh],ikk) ).Re();
-				}
-			}
-		}
-	}
-	//************************************************************************
-	// doing this
-	//Fill the Histos here
-	Double_t ebe_2p_weight = 1;
-	Double_t ebe_4p_weight = 1;
-	if( IsEbEWeighted == kTRUE ){
-		ebe_2p_weight = NSubTracks[kSubA] * NSubTracks[kSubB] ;
-		ebe_4p_weight = NSubTracks[kSubA]* NSubTracks[kSubB] * (NSubTracks[kSubA]-1) * (NSubTracks[kSubB]-1) ;
-	}
-
-	for(int ih=2; ih< kNH; ih++){
-		for(int ik=0; ik<nKL; ik++){
-			if(vn2[ih][ik] != -999)
-				fh_vn[ih][ik][fCBin]->Fill( vn2[ih][ik] , ebe_2p_weight ); // Fill hvn2
-		}
-	}
-
-	for( int ih=2; ih<kNH; ih++){
-		for( int ik=1; ik<nKL; ik++){
-			for( int ihh=2; ihh<kNH; ihh++){
-				for(int ikk=1; ikk<nKL; ikk++){
-					if(vn2_vn2[ih][ik][ihh][ikk] != -999 )
-						fh_vn_vn[ih][ik][ihh][ikk][fCBin]->Fill( vn2_vn2[ih][ik][ihh][ikk], ebe_4p_weight ) ; // Fill hvn_vn
-				}
-			}
-		}
-	}
-	///	Fill more correlators in manualy
-	TComplex V4V2starv2_2 =	QnA[4] *TComplex::Power( QnB_star[2] ,2) * vn2[2][1] ;
-	TComplex V4V2starv2_4 = QnA[4] * TComplex::Power( QnB_star[2], 2) * vn2[2][2] ;
-	TComplex V4V2star = QnA[4] * TComplex::Power( QnB_star[2], 2 );
-	TComplex V5V2starV3starv2_2 = QnA[5] * QnB_star[2] * QnB_star[3] * vn2[2][1] ;
-	TComplex V5V2starV3star = QnA[5] * QnB_star[2] * QnB_star[3] ;
-	TComplex V5V2starV3startv3_2 = QnA[5] * QnB_star[2] * QnB_star[3] * vn2[3][1];
-	TComplex V6V2star_3 = QnA[6] * TComplex::Power( QnB_star[2] , 3) ;
-	TComplex V6V3star_2 = QnA[6] * TComplex::Power( QnB_star[3], 2) ;
-	TComplex V7V2star_2V3star = QnA[7] * TComplex::Power( QnB_star[2] , 2) * QnB_star[3];
-
-
-	// New correlattors (Modified by You's corretion term for self-correlations)
-	TComplex nV4V2star = (QnA[4] * QnB_star[2] * QnB_star[2]) -( 1./(NSubTracks[1]-1) * QnA[4] * QnB_star[4] );
-	TComplex nV5V2starV3star = (QnA[5] * QnB_star[2] * QnB_star[3])- (1/(NSubTracks[1]-1) * QnA[5] * QnB_star[5]);
-	TComplex nV6V3star_2 = (QnA[6] * QnB_star[3] * QnB_star[3]) - (1/(NSubTracks[1]-1) * QnA[6] * QnB_star[6] );
-
-
-
-	// New correlattors (Modifed by Ante's correction term for self-correlations for SC result)
-	TComplex nV4V4V2V2 = (QnA[4]*QnB_star[4]*QnA[2]*QnB_star[2]) - ((1/(NSubTracks[1]-1) * QnB_star[6] * QnA[4] *QnA[2] ))
-		- ((1/(NSubTracks[0]-1) * QnA[6]*QnB_star[4] * QnB_star[2])) + (1/((NSubTracks[0]-1)*(NSubTracks[1]-1))*QnA[6]*QnB_star[6] );
-	TComplex nV3V3V2V2 = (QnA[3]*QnB_star[3]*QnA[2]*QnB_star[2]) - ((1/(NSubTracks[1]-1) * QnB_star[5] * QnA[3] *QnA[2] ))
-		- ((1/(NSubTracks[0]-1) * QnA[5]*QnB_star[3] * QnB_star[2])) + (1/((NSubTracks[0]-1)*(NSubTracks[1]-1))*QnA[5]*QnB_star[5] );
-	// add higher order SC results
-	TComplex nV5V5V2V2 = (QnA[5]*QnB_star[5]*QnA[2]*QnB_star[2]) - ((1/(NSubTracks[1]-1) * QnB_star[7] * QnA[5] *QnA[2] ))
-		- ((1/(NSubTracks[0]-1) * QnA[7]*QnB_star[5] * QnB_star[2])) + (1/((NSubTracks[0]-1)*(NSubTracks[1]-1))*QnA[7]*QnB_star[7] );
-	TComplex nV5V5V3V3 = (QnA[5]*QnB_star[5]*QnA[3]*QnB_star[3]) - ((1/(NSubTracks[1]-1) * QnB_star[8] * QnA[5] *QnA[3] ))
-		- ((1/(NSubTracks[0]-1) * QnA[8]*QnB_star[5] * QnB_star[3])) + (1/((NSubTracks[0]-1)*(NSubTracks[1]-1))*QnA[8]*QnB_star[8] );
-	TComplex nV4V4V3V3 = (QnA[4]*QnB_star[4]*QnA[3]*QnB_star[3]) - ((1/(NSubTracks[1]-1) * QnB_star[7] * QnA[4] *QnA[3] ))
-		- ((1/(NSubTracks[0]-1) * QnA[7]*QnB_star[4] * QnB_star[3])) + (1/((NSubTracks[0]-1)*(NSubTracks[1]-1))*QnA[7]*QnB_star[7] );
-
-
-
-	fh_correlator[0][fCBin]->Fill( V4V2starv2_2.Re() );
-	fh_correlator[1][fCBin]->Fill( V4V2starv2_4.Re() );
-	fh_correlator[2][fCBin]->Fill( V4V2star.Re() ) ; // added 2015.3.18
-	fh_correlator[3][fCBin]->Fill( V5V2starV3starv2_2.Re() );
-	fh_correlator[4][fCBin]->Fill( V5V2starV3star.Re() );
-	fh_correlator[5][fCBin]->Fill( V5V2starV3startv3_2.Re() );
-	fh_correlator[6][fCBin]->Fill( V6V2star_3.Re() );
-	fh_correlator[7][fCBin]->Fill( V6V3star_2.Re() );
-	fh_correlator[8][fCBin]->Fill( V7V2star_2V3star.Re() ) ;
-
-	fh_correlator[9][fCBin]->Fill( nV4V2star.Re() ); // added 2015. 6. 10
-	fh_correlator[10][fCBin]->Fill( nV5V2starV3star.Re() );
-	fh_correlator[11][fCBin]->Fill( nV6V3star_2.Re() ) ;
-
-	// use this to avoid self-correlation 4p correlation (2 particles from A, 2 particles from B) -> MA(MA-1)MB(MB-1) : evt weight..
-	fh_correlator[12][fCBin]->Fill( nV4V4V2V2.Re() , ebe_4p_weight);
-	fh_correlator[13][fCBin]->Fill( nV3V3V2V2.Re() , ebe_4p_weight);
-
-	fh_correlator[14][fCBin]->Fill( nV5V5V2V2.Re() , ebe_4p_weight);
-	fh_correlator[15][fCBin]->Fill( nV5V5V3V3.Re() , ebe_4p_weight);
-	fh_correlator[16][fCBin]->Fill( nV4V4V3V3.Re() , ebe_4p_weight);
-
 
 	if(IsSCptdep == kTRUE){
 		const int SCNH =6; // 0, 1, 2(v2), 3(v3), 4(v4), 5(v5)
@@ -661,7 +600,7 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 		//Check evt-by-evt SP/QC ratio. (term-by-term)
 		// calculate  (vn^2 vm^2)_SP /  (vn^2 vm^2)_QC
 		// 4p ( v3v3v2v2, v4v4v2v2, v5v5v2v2, v5v5v3v3, v4v4v3v3
-		Double_t SP_4p_value[5] = { nV3V3V2V2.Re(), nV4V4V2V2.Re(), nV5V5V2V2.Re(), nV5V5V3V3.Re(), nV4V4V3V3.Re()};
+		Double_t SP_4p_value[5] = { spValues[kSPcorr+13], spValues[kSPcorr+12], spValues[kSPcorr+14], spValues[kSPcorr+15], spValues[kSPcorr+16] };
 		Double_t evtSP_QC_ratio_2p = -99.;
 		Double_t evtSP_QC_ratio_4p = -99.;
 		int har1[5] = {3, 4, 5, 5, 4 }; // m of SC(m,n)
@@ -675,7 +614,7 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 		}
 		// 2p , v2, v3, v4, v5
 		for(int i=0; i<4; i++){
-			Double_t SP_2p_value = vn2[2+i][1];
+			Double_t SP_2p_value = spValues[kSPvn + (2+i)*nKL + 1];
 			evtSP_QC_ratio_2p = SP_2p_value / QC_2p_value[i+2];
 			if( evtSP_QC_ratio_2p < -1 || evtSP_QC_ratio_2p > 5.)
 				evtSP_QC_ratio_2p = -99;
@@ -769,6 +708,167 @@ TComplex AliJFFlucAnalysis::CalculateQnSP( Double_t eta1, Double_t eta2, int har
 
 	return Qn;
 }
+//________________________________________________________________________
+void AliJFFlucAnalysis::CalculateQnSPGaps( int nGaps, const Double_t (*etaRange)[2], TComplex (*QnA)[kNH], TComplex (*QnB)[kNH] )
+{
+	// Same as CalculateQnSP, but for all harmonics and eta gap configurations in one loop over the tracks.
+	// Subevent A is etaRange[ig][0] < eta < etaRange[ig][1], subevent B the mirrored range.
+	// exp(i*n*phi) is obtained by successive multiplication of exp(i*phi).
+	for(int ig=0; ig<nGaps; ig++){
+		for(int ih=0; ih<kNH; ih++){
+			QnA[ig][ih] = TComplex(0,0);
+			QnB[ig][ih] = TComplex(0,0);
+		}
+	}
+	TComplex einphi[kNH];
+	Long64_t ntracks = fInputList->GetEntriesFast();
+	for(Long64_t it=0; it< ntracks; it++){
+		AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
+		Double_t eta = itrack->Eta();
+		Bool_t isUsed = kFALSE;
+		for(int ig=0; ig<nGaps; ig++){
+			if( (eta >= etaRange[ig][0] && eta <= etaRange[ig][1]) || (eta >= -etaRange[ig][1] && eta <= -etaRange[ig][0]) ){
+				isUsed = kTRUE;
+				break;
+			}
+		}
+		if( !isUsed ) continue; // eta cut
+
+		Double_t pt = itrack->Pt();
+		Double_t phi = itrack->Phi();
+		Double_t phi_module_corr = 1;
+		int isub = -1;
+		if( eta < 0 )
+			isub = 0;
+		if( eta > 0 )
+			isub = 1;
+		if( IsPhiModule == kTRUE){
+			phi_module_corr = h_phi_module[fCBin][isub]->GetBinContent( (h_phi_module[fCBin][isub]->GetXaxis()->FindBin( phi ) )  );
+		}
+		Double_t effCorr = fEfficiency->GetCorrection( pt, fEffFilterBit, fCent );
+		Double_t weight = 1./effCorr * phi_module_corr;
+
+		TComplex eiphi( TMath::Cos(phi), TMath::Sin(phi) );
+		einphi[0] = TComplex( weight, 0 );
+		for(int ih=1; ih<kNH; ih++)
+			einphi[ih] = einphi[ih-1] * eiphi;
+
+		for(int ig=0; ig<nGaps; ig++){
+			if( eta >= etaRange[ig][0] && eta <= etaRange[ig][1] ){
+				for(int ih=0; ih<kNH; ih++) QnA[ig][ih] += einphi[ih];
+			}
+			if( eta >= -etaRange[ig][1] && eta <= -etaRange[ig][0] ){
+				for(int ih=0; ih<kNH; ih++) QnB[ig][ih] += einphi[ih];
+			}
+		}
+	}
+
+	for(int ig=0; ig<nGaps; ig++){
+		for(int ih=1; ih<kNH; ih++){
+			QnA[ig][ih] /= QnA[ig][0].Re(); // Use Qn[0] as total number of tracks(*eff)
+			QnB[ig][ih] /= QnB[ig][0].Re();
+		}
+	}
+}
+//________________________________________________________________________
+void AliJFFlucAnalysis::CalculateSPCorrelators( const TComplex *QnA, const TComplex *QnB, Double_t *values ) const
+{
+	// Fill the flat buffer with the SP correlators of one eta gap configuration (layout: kSPvn, kSPvnvn, kSPcorr).
+	// The powers (QnA QnB*)^k are tabulated once per harmonic by successive multiplication.
+	Double_t nA = QnA[0].Re(); // number of tracks in Sub A
+	Double_t nB = QnB[0].Re(); // number of tracks in Sub B
+	TComplex QnB_star[kNH];
+	TComplex QnAB[kNH][nKL]; // (QnA QnB*)^k
+	for(int ih=0; ih<kNH; ih++){
+		QnB_star[ih] = TComplex::Conjugate( QnB[ih] );
+		QnAB[ih][0] = TComplex(1,0);
+		TComplex QnAQnBstar = QnA[ih] * QnB_star[ih];
+		for(int ik=1; ik<nKL; ik++)
+			QnAB[ih][ik] = QnAB[ih][ik-1] * QnAQnBstar;
+	}
+	// vn^2k for n.... k....
+	for(int ih=0; ih<kNH; ih++){
+		values[kSPvn + ih*nKL] = TMath::Sqrt( QnAB[ih][1].Re() );
+		for(int ik=1; ik<nKL; ik++)
+			values[kSPvn + ih*nKL + ik] = QnAB[ih][ik].Re();
+	}
+	// 2 combination of vn
+	for(int ih=0; ih<kNH; ih++){
+		for(int ik=0; ik<nKL; ik++){
+			Double_t *vn_vn = &values[kSPvnvn + (ih*nKL + ik)*kNH*nKL];
+			for(int ihh=0; ihh<kNH; ihh++){
+				for(int ikk=0; ikk<nKL; ikk++)
+					vn_vn[ihh*nKL + ikk] = ( QnAB[ih][ik] * QnAB[ihh][ikk] ).Re();
+			}
+		}
+	}
+	///	more correlators
+	const Double_t *vn2 = &values[kSPvn];
+	TComplex V2star_2 = QnB_star[2] * QnB_star[2];
+	TComplex V4V2star = QnA[4] * V2star_2;
+	TComplex V5V2starV3star = QnA[5] * QnB_star[2] * QnB_star[3] ;
+	Double_t *corr = &values[kSPcorr];
+	corr[0] = ( V4V2star * vn2[2*nKL+1] ).Re();
+	corr[1] = ( V4V2star * vn2[2*nKL+2] ).Re();
+	corr[2] = V4V2star.Re();
+	corr[3] = ( V5V2starV3star * vn2[2*nKL+1] ).Re();
+	corr[4] = V5V2starV3star.Re();
+	corr[5] = ( V5V2starV3star * vn2[3*nKL+1] ).Re();
+	corr[6] = ( QnA[6] * V2star_2 * QnB_star[2] ).Re();
+	corr[7] = ( QnA[6] * QnB_star[3] * QnB_star[3] ).Re();
+	corr[8] = ( QnA[7] * V2star_2 * QnB_star[3] ).Re();
+
+	// New correlattors (Modified by You's corretion term for self-correlations)
+	corr[9] = ( V4V2star - ( 1./(nB-1) * QnA[4] * QnB_star[4] ) ).Re();
+	corr[10] = ( V5V2starV3star - ( 1./(nB-1) * QnA[5] * QnB_star[5] ) ).Re();
+	corr[11] = ( (QnA[6] * QnB_star[3] * QnB_star[3]) - ( 1./(nB-1) * QnA[6] * QnB_star[6] ) ).Re();
+
+	// New correlattors (Modifed by Ante's correction term for self-correlations for SC result)
+	// <vm^2 vn^2> for (m,n) = (4,2), (3,2), (5,2), (5,3), (4,3)
+	const int har1[5] = { 4, 3, 5, 5, 4 };
+	const int har2[5] = { 2, 2, 2, 3, 3 };
+	for(int i=0; i<5; i++){
+		int m = har1[i], n = har2[i];
+		corr[12+i] = ( (QnA[m]*QnB_star[m]*QnA[n]*QnB_star[n]) - ((1/(nB-1) * QnB_star[m+n] * QnA[m] *QnA[n] ))
+			- ((1/(nA-1) * QnA[m+n]*QnB_star[m] * QnB_star[n])) + (1/((nA-1)*(nB-1))*QnA[m+n]*QnB_star[m+n] ) ).Re();
+	}
+}
+//________________________________________________________________________
+void AliJFFlucAnalysis::FillSPCorrelators( int igap, const Double_t *values, Double_t ebe_2p_weight, Double_t ebe_4p_weight )
+{
+	// Fill the filled slots of the flat buffer into their histograms
+	Double_t weights[3] = { 1, ebe_2p_weight, ebe_4p_weight };
+	TH1D **histos = &fSPHistos[ (igap*fNCent + fCBin)*kNSPValues ];
+	for(size_t i=0; i<fSPSlots.size(); i++){
+		int islot = fSPSlots[i];
+		if( !histos[islot] ) histos[islot] = ResolveSPHisto( igap, islot );
+		histos[islot]->Fill( values[islot], weights[fSPSlotWeight[i]] );
+	}
+}
+//________________________________________________________________________
+TH1D* AliJFFlucAnalysis::ResolveSPHisto( int igap, int islot )
+{
+	// histogram of a slot of the flat buffer, the eta gap index is ignored if only one configuration is used
+	if( islot < kSPvnvn )
+		return fh_vn.At( islot/nKL, islot%nKL, fCBin, igap );
+	if( islot < kSPcorr ){
+		int i = islot - kSPvnvn;
+		return fh_vn_vn.At( i/(nKL*kNH*nKL), (i/(kNH*nKL))%nKL, (i/nKL)%kNH, i%nKL, fCBin, igap );
+	}
+	return fh_correlator.At( islot - kSPcorr, fCBin, igap );
+}
+//________________________________________________________________________
+void AliJFFlucAnalysis::AddEtaGap( double eta_min, double eta_max )
+{
+	// must be called before UserCreateOutputObjects
+	if( fNEtaGaps >= kMaxEtaGaps ){
+		cout << "ERROR: only " << kMaxEtaGaps << " additional eta gaps can be used" << endl;
+		return;
+	}
+	fEtaGap[fNEtaGaps][0] = eta_min;
+	fEtaGap[fNEtaGaps][1] = eta_max;
+	fNEtaGaps++;
+}
 ///________________________________________________________________________
 Double_t AliJFFlucAnalysis::Get_QC_Vn(Double_t QnA_real, Double_t QnA_img, Double_t QnB_real, Double_t QnB_img )
 {
@@ -22,6 +22,8 @@ class AliJEfficiency;
 class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 
 	public:
+		enum{kMaxEtaGaps=8}; // maximum number of additional eta gap configurations
+
 		AliJFFlucAnalysis();
 		AliJFFlucAnalysis(const char *name);
 		AliJFFlucAnalysis(const AliJFFlucAnalysis& a); // not implemented
@@ -41,6 +43,7 @@ class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 		void SetPhiModuleHistos( int cent, int sub, TH1D *hModuledPhi);
 
 		void SetEtaRange( double eta_min, double eta_max){fEta_min = eta_min; fEta_max = eta_max; }
+		void AddEtaGap( double eta_min, double eta_max); // additional |eta| range of the subevents, analysed in the same track loop
 		void SetDebugLevel( int dblv ){ fDebugLevel = dblv; }
 		void SetEffConfig( int Mode, int FilterBit ){ fEffMode = Mode; fEffFilterBit = FilterBit; cout << "fEffMode set = " << fEffMode << endl;}
 		void SetIsSCptdep( Bool_t isSCptdep ){ IsSCptdep = isSCptdep; cout << "doing addtional loop to check SC pt dep = "<< IsSCptdep << endl; }
@@ -78,6 +81,14 @@ class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 	private:
 		enum{kH0, kH1, kH2, kH3, kH4, kH5, kH6, kH7, kH8, kNH}; //harmonics // do we need vn up to v8? .. yes we need..
 		enum{kK0, kK1, kK2, kK3, kK4, nKL}; // order // do we really need vn^8
+		// layout of the flat buffer of SP correlators of one eta gap configuration
+		enum{kSPvn=0, kSPvnvn=kNH*nKL, kSPcorr=kSPvnvn+kNH*nKL*kNH*nKL, kNSPcorr=17, kNSPValues=kSPcorr+kNSPcorr};
+		enum{kSPWeight1, kSPWeight2p, kSPWeight4p};
+
+		void CalculateQnSPGaps( int nGaps, const Double_t (*etaRange)[2], TComplex (*QnA)[kNH], TComplex (*QnB)[kNH] );
+		void CalculateSPCorrelators( const TComplex *QnA, const TComplex *QnB, Double_t *values ) const;
+		void FillSPCorrelators( int igap, const Double_t *values, Double_t ebe_2p_weight, Double_t ebe_4p_weight );
+		TH1D* ResolveSPHisto( int igap, int islot );
 
 //		TDirectory           *fOutput;     // Output
 		Long64_t AnaEntry;
@@ -102,6 +113,8 @@ class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 		Bool_t IsSCptdep;  // flag to check SC pt dep or not
 		Bool_t IsEbEWeighted; // flag for ebe weight for QC method
 		Double_t fSingleVn[kNH][3]; // 3 method
+		int fNEtaGaps; // number of additional eta gap configurations
+		Double_t fEtaGap[kMaxEtaGaps][2]; // |eta| min and max of the additional configurations
 
 // Histograms
 		double fEta_min;
@@ -127,6 +140,7 @@ class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 		AliJBin fHistCentBin;//!
 		AliJBin fVertexBin;//! // x, y, z
 		AliJBin fCorrBin;//!
+		AliJBin fBin_EtaGap;//!
 
 		AliJTH1D fh_cent;//! // for cent dist
 		AliJTH1D fh_ImpactParameter;//! // for impact parameter for mc
@@ -158,7 +172,12 @@ class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 		AliJTH1D fh_QvectorQCphi;//!
 		AliJTH1D fh_evt_SP_QC_ratio_2p;//! // check SP QC evt by evt ratio
 		AliJTH1D fh_evt_SP_QC_ratio_4p;//! // check SP QC evt by evt ratio
-		ClassDef(AliJFFlucAnalysis, 1); // example of analysis
+
+		std::vector<Double_t> fSPValues;//! // SP correlators of the event [igap][islot]
+		std::vector<TH1D*> fSPHistos;//! // histograms of the SP correlators, resolved at first fill [igap][icent][islot]
+		std::vector<int> fSPSlots;//! // slots of the flat buffer which are filled
+		std::vector<int> fSPSlotWeight;//! // event weight used for each filled slot
+		ClassDef(AliJFFlucAnalysis, 2); // example of analysis
 };
 
 #endif
@@ -58,6 +58,7 @@ AliJFFlucTask::AliJFFlucTask():
 	fFilterBit = 0;
 	fEta_min = 0;
 	fEta_max = 0;
+	fNEtaGaps = 0;
 	fDebugLevel = 0;
 	fEffMode =0;
 	fEffFilterBit=0;
@@ -106,6 +107,7 @@ AliJFFlucTask::AliJFFlucTask(const char *name,  Bool_t IsMC, Bool_t IsExcludeWea
 	fFilterBit = 0;
 	fEta_min = 0;
 	fEta_max = 0;
+	fNEtaGaps = 0;
 	fDebugLevel = 0;
 	fEffMode =0;
 	fEffFilterBit=0;
@@ -182,6 +184,8 @@ void AliJFFlucTask::UserCreateOutputObjects()
 	fFFlucAna->SetSCwithQC( IsSCwithQC );
 	fFFlucAna->SetEbEWeight( IsEbEWeighted );
 	fFFlucAna->SetQCEtaCut( fQC_eta_min, fQC_eta_max );
+	for(int ig=0; ig<fNEtaGaps; ig++)
+		fFFlucAna->AddEtaGap( fEtaGap[ig][0], fEtaGap[ig][1] );
 
 //	fFFlucAna->SetSCwithFineCentbin( IsSCwithFineCentBin );
 	// setting histos for phi modulation
@@ -111,6 +111,9 @@ class AliJFFlucTask : public AliAnalysisTaskSE {
 //					cout << "setting Number of Cluster in TPC = " << fNclOfTPC << endl;};
   void SetCentDetName( TString CentName ){ fCentDetName = CentName;
 					cout << "setting : Cenetrality determination =" << fCentDetName.Data() << endl; };
+  void AddEtaGap( double eta_min, double eta_max ){
+					if( fNEtaGaps < AliJFFlucAnalysis::kMaxEtaGaps ){ fEtaGap[fNEtaGaps][0]=eta_min; fEtaGap[fNEtaGaps][1]=eta_max; fNEtaGaps++; }
+					cout << "adding Eta gap " << eta_min << " ~ " << eta_max << endl;};
   void SetQCetaCut( Double_t QC_eta_min, Double_t QC_eta_max){
 					fQC_eta_min=QC_eta_min; fQC_eta_max=QC_eta_max;
 					cout << "setting : QC eta range " << fQC_eta_min << "~" << fQC_eta_max << endl; };
@@ -127,6 +130,8 @@ class AliJFFlucTask : public AliAnalysisTaskSE {
   float TPCTracks;
   double fEta_min;
   double fEta_max;
+  int fNEtaGaps; // additional eta gaps analysed in the same pass
+  double fEtaGap[AliJFFlucAnalysis::kMaxEtaGaps][2];
   double fPt_min;
   double fPt_max;
   double fzvtxCut;
@@ -154,7 +159,7 @@ class AliJFFlucTask : public AliAnalysisTaskSE {
   TDirectory *fOutput;     // output
   TH1D *h_ModuledPhi[7][2]; // cent7, sub2
 
-  ClassDef(AliJFFlucTask, 1);
+  ClassDef(AliJFFlucTask, 2);
 
 };
 #endif // AliJFFlucTask_H
@@ -315,6 +315,17 @@ class AliJTH1Derived : public AliJTH1 {
         virtual ~AliJTH1Derived();
 
         AliJTH1DerivedPlayer<T> & operator[](int i){ fPlayer.Init();fPlayer[i];return fPlayer; }
+        // Resolve a complete index to the histogram pointer at once, e.g. outside of a pair loop
+        T * At( int i0, int i1=-1, int i2=-1, int i3=-1, int i4=-1, int i5=-1 ){
+            int index[6] = { i0, i1, i2, i3, i4, i5 };
+            if( Dimension() > 6 ) { JERROR("Exceed Dimension"); }
+            ClearIndex();
+            for( int d=0;d<Dimension();d++ ){
+                if( OutOf( index[d], 0, SizeOf(d)-1 ) ){ JERROR(Form("wrong Index %d of %dth in ",index[d], d)+GetName()); }
+                fIndex[d] = index[d];
+            }
+            return static_cast<T*>(GetItem());
+        }
         T * operator->(){ return static_cast<T*>(GetSingleItem()); }
         operator T*(){ return static_cast<T*>(GetSingleItem()); }
         // Virtual from AliJArrayBase
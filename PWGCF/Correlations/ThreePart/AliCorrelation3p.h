@@ -18,6 +18,7 @@
 #include "TF1.h"
 #include "TH2D.h"
 #include "TH3D.h"
+#include <vector>
 class TH1;
 class TH1F;
 class TH2F;
@@ -54,6 +55,10 @@ class AliCorrelation3p : public TNamed {
   int Fill( AliVParticle* trigger		, AliVParticle* p1				, const double weight=1.0);
   int Filla( AliVParticle* p1			, AliVParticle* p2				, const double weight=1.0);
   int FillTrigger( AliVParticle*ptrigger);
+  /// fill the triplets of one trigger with all pairs of associated particles
+  int FillTriplets( AliVParticle* trigger	, const std::vector<AliVParticle*>& associated1, const std::vector<Double_t>& weights1, const std::vector<AliVParticle*>& associated2, const std::vector<Double_t>& weights2, const double weight=1.0);
+  /// fill the a-a 2p correlation with all pairs of associated particles
+  int FillAssociatedPairs(const std::vector<AliVParticle*>& associated1, const std::vector<Double_t>& weights1, const std::vector<AliVParticle*>& associated2, const std::vector<Double_t>& weights2);
   int MakeResultsFile(const char* scalingmethod, bool recreate=false, bool fakecor=false);
   /// overloaded from TObject: cleanup
   virtual void Clear(Option_t * option ="");
@@ -115,6 +120,7 @@ class AliCorrelation3p : public TNamed {
   Int_t GetNumberHist(Int_t khist,Int_t Mbin,Int_t ZBin) const;
   Int_t GetMultBin(Double_t Mult);
   Int_t GetZBin(Double_t Zvert);
+  void TripletKinematics(AliVParticle* ptrigger,const std::vector<AliVParticle*>& associated,std::vector<Int_t>& index,std::vector<Double_t>& deltaphi,std::vector<Double_t>& eta) const;
   void HistFill(Int_t Histn,Double_t Val1);
   void HistFill(Int_t Histn,Double_t Val1,Double_t Val2);
   void HistFill(Int_t Histn,Double_t Val1,Double_t Val2, Double_t Val_3);
@@ -315,6 +315,89 @@ int AliCorrelation3p_noQA::Filla(AliVParticle* p1,AliVParticle* p2,const double
   return 0;
 }
 
+int AliCorrelation3p_noQA::FillTriplets( AliVParticle* ptrigger, const std::vector<AliVParticle*>& associated1, const std::vector<Double_t>& weights1, const std::vector<AliVParticle*>& associated2, const std::vector<Double_t>& weights2, const double weight)
+{
+  /// fill the triplets of one trigger, same as Fill(ptrigger,p1,p2,weight*w1*w2) for all p1 in associated1
+  /// and p2 in associated2. If both are the same vector, each pair of different particles is filled in both orders.
+  /// The trigger dependent cuts and phi differences are evaluated once per associated particle, not per triplet.
+  if (!ptrigger) {return 0;}
+  const bool samevector = (&associated1==&associated2);
+  std::vector<Int_t> index1,index2;
+  std::vector<Double_t> dphi1,dphi2,eta1,eta2;
+  TripletKinematics(ptrigger,associated1,index1,dphi1,eta1);
+  if(!samevector) TripletKinematics(ptrigger,associated2,index2,dphi2,eta2);
+  const std::vector<Int_t>& i2 = samevector?index1:index2;
+  const std::vector<Double_t>& dp2 = samevector?dphi1:dphi2;
+  const std::vector<Double_t>& e2 = samevector?eta1:eta2;
+  Int_t histn = GetNumberHist(khPhiPhiDEta,fMBin,fVzBin);
+  TH3F* hist = (histn>=0)?dynamic_cast<TH3F*>(fHistograms->At(histn)):NULL;
+  for (UInt_t i=0;i<index1.size();i++){
+    for (UInt_t j=(samevector?i+1:0);j<i2.size();j++){
+      Double_t fillweight = weight*weights1[index1[i]]*weights2[i2[j]];
+      Double_t DeltaEta12 = eta1[i]-e2[j];
+      if(TMath::Abs(dphi1[i]-dp2[j])<1.0E-10&&TMath::Abs(DeltaEta12)<1.0E-10) continue;//Track duplicate, reject.
+      if(hist) hist->Fill(DeltaEta12,dphi1[i],dp2[j],fillweight);
+      else HistFill(histn,DeltaEta12,dphi1[i],dp2[j],fillweight);
+      if(!samevector) continue;
+      DeltaEta12 = e2[j]-eta1[i];
+      if(hist) hist->Fill(DeltaEta12,dp2[j],dphi1[i],fillweight);
+      else HistFill(histn,DeltaEta12,dp2[j],dphi1[i],fillweight);
+    }
+  }
+  return 0;
+}
+
+int AliCorrelation3p_noQA::FillAssociatedPairs(const std::vector<AliVParticle*>& associated1, const std::vector<Double_t>& weights1, const std::vector<AliVParticle*>& associated2, const std::vector<Double_t>& weights2)
+{
+  /// fill the a-a 2p correlation, same as Filla(p1,p2,w1*w2) and Filla(p2,p1,w1*w2) for all p1 in associated1
+  /// and p2 in associated2, for the pairs of different particles if both are the same vector.
+  const bool samevector = (&associated1==&associated2);
+  std::vector<Double_t> phi1(associated1.size()),eta1(associated1.size()),phi2(associated2.size()),eta2(associated2.size());
+  for (UInt_t i=0;i<associated1.size();i++){phi1[i]=associated1[i]->Phi();eta1[i]=associated1[i]->Eta();}
+  for (UInt_t j=0;j<associated2.size();j++){phi2[j]=associated2[j]->Phi();eta2[j]=associated2[j]->Eta();}
+  Int_t histn = GetNumberHist(khPhiEtaa,fMBin,fVzBin);
+  TH2D* hist = (histn>=0)?dynamic_cast<TH2D*>(fHistograms->At(histn)):NULL;
+  for (UInt_t i=0;i<associated1.size();i++){
+    for (UInt_t j=(samevector?i+1:0);j<associated2.size();j++){
+      Double_t fillweight = weights1[i]*weights2[j];
+      for (int order=0;order<2;order++){
+	Double_t DeltaPhi = (order==0)?phi1[i]-phi2[j]:phi2[j]-phi1[i];
+	if (DeltaPhi<-0.5*gkPii) DeltaPhi += 2*gkPii;
+	if (DeltaPhi>1.5*gkPii)  DeltaPhi -= 2*gkPii;
+	Double_t DeltaEta = (order==0)?eta1[i]-eta2[j]:eta2[j]-eta1[i];
+	if(hist) hist->Fill(DeltaEta,DeltaPhi,fillweight);
+	else HistFill(histn,DeltaEta,DeltaPhi,fillweight);
+      }
+    }
+  }
+  return 0;
+}
+
+void AliCorrelation3p_noQA::TripletKinematics(AliVParticle* ptrigger,const std::vector<AliVParticle*>& associated,std::vector<Int_t>& index,std::vector<Double_t>& deltaphi,std::vector<Double_t>& eta) const
+{
+  /// associated particles passing the trigger dependent cuts of Fill(ptrigger,p1,p2), with their phi difference to the trigger and eta
+  index.clear();deltaphi.clear();eta.clear();
+  const Double_t ptT = ptrigger->Pt();
+  const Double_t phiT = ptrigger->Phi();
+  const Double_t etaT = ptrigger->Eta();
+  for (UInt_t i=0;i<associated.size();i++){
+    AliVParticle* p = associated[i];
+    if (!p) continue;
+    if (ptT<=p->Pt()) continue;
+    const double Pii=TMath::Pi();
+    Double_t DeltaPhi = phiT - p->Phi();
+    if(DeltaPhi<-0.5*Pii||DeltaPhi>1.5*Pii){
+      if (DeltaPhi<-0.5*Pii) DeltaPhi += 2*Pii;
+      if (DeltaPhi>1.5*Pii)  DeltaPhi -= 2*Pii;
+    }
+    Double_t Eta = p->Eta();
+    if(TMath::Abs(Eta-etaT)<1.0E-10) continue;//Track duplicate, reject.
+    index.push_back(i);
+    deltaphi.push_back(DeltaPhi);
+    eta.push_back(Eta);
+  }
+}
+
 int AliCorrelation3p_noQA::FillTrigger(AliVParticle* ptrigger)
 {
   Double_t fillweight = dynamic_cast<AliFilteredTrack*>(ptrigger)->GetEff();
@@ -39,6 +39,7 @@
 #include "AliESDtrack.h"
 #include "AliAODTrack.h"
 #include "AliTHn.h"
+#include "AliTHnMultiProjection.h"
 #include "AliAnalysisTaskTriggeredBF.h"
 
 #include "AliBalancePsi.h"
@@ -817,6 +818,41 @@ TH1D *AliBalancePsi::GetBalanceFunctionHistogram(Int_t iVariableSingle,
   return gHistBalanceFunctionHistogram;
 }
 
+//____________________________________________________________________//
+void AliBalancePsi::ProjectPsiVertexBins(AliTHn *gHist,
+					 Int_t vertexAxis,
+					 Int_t axisX,
+					 Int_t axisY,
+					 Int_t binPsiMin,
+					 Int_t binPsiMax,
+					 Int_t binVertexMin,
+					 Int_t binVertexMax,
+					 TObjArray &projections) const {
+  //Projects the AliTHn (step 0) on axisX (and axisY) separately for each 
+  //psi (axis 0) and vertex bin in one pass over the filled bins, 
+  //instead of SetRangeUser + Project for every bin.
+  //The ranges set on the other axes (e.g. pt) are kept, vertexAxis < 0: no vertex binning.
+  //The projection of (iBinPsi,iBinVertex) is stored at index 
+  //(iBinPsi-binPsiMin)*(binVertexMax-binVertexMin+1) + (iBinVertex-binVertexMin), 
+  //the array owns the histograms.
+  AliTHnMultiProjection multiProjection(gHist->GetGrid(0)->GetGrid());
+
+  for(Int_t iBinPsi = binPsiMin; iBinPsi <= binPsiMax; iBinPsi++){
+    for(Int_t iBinVertex = binVertexMin; iBinVertex <= binVertexMax; iBinVertex++){
+      Int_t iProj = multiProjection.AddProjection(axisX,axisY);
+      multiProjection.SetRange(iProj,0,iBinPsi,iBinPsi);
+      if(vertexAxis >= 0)
+	multiProjection.SetRange(iProj,vertexAxis,iBinVertex,iBinVertex);
+    }
+  }
+  multiProjection.Process();
+
+  projections.SetOwner(kTRUE);
+  projections.Expand(multiProjection.GetNProjections());
+  for(Int_t iProj = 0; iProj < multiProjection.GetNProjections(); iProj++)
+    projections.AddAt(multiProjection.ReleaseProjection(iProj),iProj);
+}
+
 //____________________________________________________________________//
 TH1D *AliBalancePsi::GetBalanceFunctionHistogram2pMethod(Int_t iVariableSingle,
 							 Int_t iVariablePair,
@@ -909,10 +945,24 @@ TH1D *AliBalancePsi::GetBalanceFunctionHistogram2pMethod(Int_t iVariableSingle,
     binVertexMin = fHistPN->GetGrid(0)->GetGrid()->GetAxis(5)->FindBin(vertexZMin);
     binVertexMax = fHistPN->GetGrid(0)->GetGrid()->GetAxis(5)->FindBin(vertexZMax-0.00001);
   }  
-  Double_t binPsiLowEdge    = 0.;
-  Double_t binPsiUpEdge     = 1000.;
-  Double_t binVertexLowEdge = 0.;
-  Double_t binVertexUpEdge  = 1000.;
+
+  // project all psi and vertex bins in one pass over each AliTHn (pt ranges set above are kept)
+  Int_t vertexAxisSingle = fVertexBinning ? 2 : -1;
+  Int_t vertexAxisPair   = fVertexBinning ? 5 : -1;
+  TObjArray projPN, projNP, projPP, projNN, projP, projN;
+  TObjArray projPNMix, projNPMix, projPPMix, projNNMix, projPMix, projNMix;
+  ProjectPsiVertexBins(fHistPN,vertexAxisPair,iVariablePair,-1,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projPN);
+  ProjectPsiVertexBins(fHistNP,vertexAxisPair,iVariablePair,-1,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projNP);
+  ProjectPsiVertexBins(fHistPP,vertexAxisPair,iVariablePair,-1,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projPP);
+  ProjectPsiVertexBins(fHistNN,vertexAxisPair,iVariablePair,-1,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projNN);
+  ProjectPsiVertexBins(fHistP,vertexAxisSingle,iVariableSingle,-1,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projP);
+  ProjectPsiVertexBins(fHistN,vertexAxisSingle,iVariableSingle,-1,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projN);
+  ProjectPsiVertexBins(fHistPNMix,vertexAxisPair,iVariablePair,-1,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projPNMix);
+  ProjectPsiVertexBins(fHistNPMix,vertexAxisPair,iVariablePair,-1,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projNPMix);
+  ProjectPsiVertexBins(fHistPPMix,vertexAxisPair,iVariablePair,-1,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projPPMix);
+  ProjectPsiVertexBins(fHistNNMix,vertexAxisPair,iVariablePair,-1,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projNNMix);
+  ProjectPsiVertexBins(fHistPMix,vertexAxisSingle,iVariableSingle,-1,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projPMix);
+  ProjectPsiVertexBins(fHistNMix,vertexAxisSingle,iVariableSingle,-1,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projNMix);
 
   TH1D* h1 = NULL;
   TH1D* h2 = NULL;
@@ -925,73 +975,23 @@ TH1D *AliBalancePsi::GetBalanceFunctionHistogram2pMethod(Int_t iVariableSingle,
   
       cout<<"In the balance function (1D) loop: "<<iBinPsi<<" (psiBin), "<<iBinVertex<<" (vertexBin)  "<<endl;
 
-      // determine the bin edges for this bin
-      binPsiLowEdge    = fHistPN->GetGrid(0)->GetGrid()->GetAxis(0)->GetBinLowEdge(iBinPsi);
-      binPsiUpEdge     = fHistPN->GetGrid(0)->GetGrid()->GetAxis(0)->GetBinUpEdge(iBinPsi);
-      if(fVertexBinning){
-	binVertexLowEdge = fHistPN->GetGrid(0)->GetGrid()->GetAxis(5)->GetBinLowEdge(iBinVertex);
-	binVertexUpEdge  = fHistPN->GetGrid(0)->GetGrid()->GetAxis(5)->GetBinUpEdge(iBinVertex);
-      }
-      
-      // Psi_2
-      fHistP->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistN->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistPN->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistNP->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistPP->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistNN->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-
-      // Vz
-      if(fVertexBinning){
-	fHistP->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistN->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistPN->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistNP->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistPP->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistNN->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-      }
-
-      // ============================================================================================
-      // the same for event mixing
-      
-      // Psi_2
-      fHistPMix->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistNMix->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistPNMix->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistNPMix->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistPPMix->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistNNMix->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      
-      // Vz
-      if(fVertexBinning){
-	fHistPMix->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistNMix->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistPNMix->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistNPMix->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistPPMix->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistNNMix->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-      }
-      
-      // ============================================================================================
-
-      //Printf("P:%lf - N:%lf - PN:%lf - NP:%lf - PP:%lf - NN:%lf",fHistP->GetEntries(0),fHistN->GetEntries(0),fHistPN->GetEntries(0),fHistNP->GetEntries(0),fHistPP->GetEntries(0),fHistNN->GetEntries(0));
-      
-      // Project into the wanted space (1st: analysis step, 2nd: axis)
-      TH1D* hTempHelper1 = (TH1D*)fHistPN->Project(0,iVariablePair);
-      TH1D* hTempHelper2 = (TH1D*)fHistNP->Project(0,iVariablePair);
-      TH1D* hTempHelper3 = (TH1D*)fHistPP->Project(0,iVariablePair);
-      TH1D* hTempHelper4 = (TH1D*)fHistNN->Project(0,iVariablePair);
-      TH1D* hTemp5 = (TH1D*)fHistP->Project(0,iVariableSingle);
-      TH1D* hTemp6 = (TH1D*)fHistN->Project(0,iVariableSingle);
+      // projections of this psi and vertex bin (1st: analysis step, 2nd: axis)
+      Int_t iProj = (iBinPsi-binPsiMin)*(binVertexMax-binVertexMin+1) + (iBinVertex-binVertexMin);
+      TH1D* hTempHelper1 = (TH1D*)projPN.At(iProj);
+      TH1D* hTempHelper2 = (TH1D*)projNP.At(iProj);
+      TH1D* hTempHelper3 = (TH1D*)projPP.At(iProj);
+      TH1D* hTempHelper4 = (TH1D*)projNN.At(iProj);
+      TH1D* hTemp5 = (TH1D*)projP.At(iProj);
+      TH1D* hTemp6 = (TH1D*)projN.At(iProj);
       
       // ============================================================================================
       // the same for event mixing
-      TH1D* hTempHelper1Mix = (TH1D*)fHistPNMix->Project(0,iVariablePair);
-      TH1D* hTempHelper2Mix = (TH1D*)fHistNPMix->Project(0,iVariablePair);
-      TH1D* hTempHelper3Mix = (TH1D*)fHistPPMix->Project(0,iVariablePair);
-      TH1D* hTempHelper4Mix = (TH1D*)fHistNNMix->Project(0,iVariablePair);
-      TH1D* hTemp5Mix = (TH1D*)fHistPMix->Project(0,iVariableSingle);
-      TH1D* hTemp6Mix = (TH1D*)fHistNMix->Project(0,iVariableSingle);
+      TH1D* hTempHelper1Mix = (TH1D*)projPNMix.At(iProj);
+      TH1D* hTempHelper2Mix = (TH1D*)projNPMix.At(iProj);
+      TH1D* hTempHelper3Mix = (TH1D*)projPPMix.At(iProj);
+      TH1D* hTempHelper4Mix = (TH1D*)projNNMix.At(iProj);
+      TH1D* hTemp5Mix = (TH1D*)projPMix.At(iProj);
+      TH1D* hTemp6Mix = (TH1D*)projNMix.At(iProj);
       // ============================================================================================
 
       hTempHelper1->Sumw2();
@@ -1472,10 +1472,22 @@ TH2D *AliBalancePsi::GetBalanceFunctionDeltaEtaDeltaPhi2pMethod(Double_t psiMin,
     binVertexMin = fHistPN->GetGrid(0)->GetGrid()->GetAxis(5)->FindBin(vertexZMin);
     binVertexMax = fHistPN->GetGrid(0)->GetGrid()->GetAxis(5)->FindBin(vertexZMax-0.00001);
   }  
-  Double_t binPsiLowEdge    = 0.;
-  Double_t binPsiUpEdge     = 0.;
-  Double_t binVertexLowEdge = 0.;
-  Double_t binVertexUpEdge  = 0.;
+
+  // project all psi and vertex bins in one pass over each AliTHn (pt ranges set above are kept)
+  Int_t vertexAxisSingle = fVertexBinning ? 2 : -1;
+  Int_t vertexAxisPair   = fVertexBinning ? 5 : -1;
+  TObjArray projPN, projNP, projPP, projNN, projP, projN;
+  TObjArray projPNMix, projNPMix, projPPMix, projNNMix;
+  ProjectPsiVertexBins(fHistPN,vertexAxisPair,1,2,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projPN);
+  ProjectPsiVertexBins(fHistNP,vertexAxisPair,1,2,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projNP);
+  ProjectPsiVertexBins(fHistPP,vertexAxisPair,1,2,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projPP);
+  ProjectPsiVertexBins(fHistNN,vertexAxisPair,1,2,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projNN);
+  ProjectPsiVertexBins(fHistP,vertexAxisSingle,1,-1,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projP);
+  ProjectPsiVertexBins(fHistN,vertexAxisSingle,1,-1,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projN);
+  ProjectPsiVertexBins(fHistPNMix,vertexAxisPair,1,2,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projPNMix);
+  ProjectPsiVertexBins(fHistNPMix,vertexAxisPair,1,2,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projNPMix);
+  ProjectPsiVertexBins(fHistPPMix,vertexAxisPair,1,2,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projPPMix);
+  ProjectPsiVertexBins(fHistNNMix,vertexAxisPair,1,2,binPsiMin,binPsiMax,binVertexMin,binVertexMax,projNNMix);
 
   TH2D* h1 = NULL;
   TH2D* h2 = NULL;
@@ -1488,76 +1500,21 @@ TH2D *AliBalancePsi::GetBalanceFunctionDeltaEtaDeltaPhi2pMethod(Double_t psiMin,
   
       cout<<"In the balance function (2D) loop: "<<iBinPsi<<" (psiBin), "<<iBinVertex<<" (vertexBin)  "<<endl;
 
-      // determine the bin edges for this bin
-      binPsiLowEdge    = fHistPN->GetGrid(0)->GetGrid()->GetAxis(0)->GetBinLowEdge(iBinPsi);
-      binPsiUpEdge     = fHistPN->GetGrid(0)->GetGrid()->GetAxis(0)->GetBinUpEdge(iBinPsi);
-      if(fVertexBinning){
-	binVertexLowEdge = fHistPN->GetGrid(0)->GetGrid()->GetAxis(5)->GetBinLowEdge(iBinVertex);
-	binVertexUpEdge  = fHistPN->GetGrid(0)->GetGrid()->GetAxis(5)->GetBinUpEdge(iBinVertex);
-      }
-
-      // Psi_2
-      fHistP->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistN->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistPN->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistNP->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistPP->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistNN->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-  
-      // Vz
-      if(fVertexBinning){
-	fHistP->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistN->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistPN->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistNP->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistPP->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistNN->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-      }
-
-
-
-      // ============================================================================================
-      // the same for event mixing
-      
-      // Psi_2
-      fHistPMix->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistNMix->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistPNMix->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistNPMix->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistPPMix->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      fHistNNMix->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(binPsiLowEdge,binPsiUpEdge-0.00001); 
-      
-      // Vz
-      if(fVertexBinning){
-	fHistPMix->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistNMix->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistPNMix->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistNPMix->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistPPMix->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-	fHistNNMix->GetGrid(0)->GetGrid()->GetAxis(5)->SetRangeUser(binVertexLowEdge,binVertexUpEdge-0.00001); 
-      }
-      
-      // ============================================================================================
-      
-      
-      //AliInfo(Form("P:%lf - N:%lf - PN:%lf - NP:%lf - PP:%lf - NN:%lf",fHistP->GetEntries(0),fHistN->GetEntries(0),fHistPN->GetEntries(0),fHistNP->GetEntries(0),fHistPP->GetEntries(0),fHistNN->GetEntries(0)));
-
-      // Project into the wanted space (1st: analysis step, 2nd: axis)
-      TH2D* hTemp1 = (TH2D*)fHistPN->Project(0,1,2);
-      TH2D* hTemp2 = (TH2D*)fHistNP->Project(0,1,2);
-      TH2D* hTemp3 = (TH2D*)fHistPP->Project(0,1,2);
-      TH2D* hTemp4 = (TH2D*)fHistNN->Project(0,1,2);
-      TH1D* hTemp5 = (TH1D*)fHistP->Project(0,1);
-      TH1D* hTemp6 = (TH1D*)fHistN->Project(0,1);
+      // projections of this psi and vertex bin (1st: analysis step, 2nd: axis)
+      Int_t iProj = (iBinPsi-binPsiMin)*(binVertexMax-binVertexMin+1) + (iBinVertex-binVertexMin);
+      TH2D* hTemp1 = (TH2D*)projPN.At(iProj);
+      TH2D* hTemp2 = (TH2D*)projNP.At(iProj);
+      TH2D* hTemp3 = (TH2D*)projPP.At(iProj);
+      TH2D* hTemp4 = (TH2D*)projNN.At(iProj);
+      TH1D* hTemp5 = (TH1D*)projP.At(iProj);
+      TH1D* hTemp6 = (TH1D*)projN.At(iProj);
       
       // ============================================================================================
       // the same for event mixing
-      TH2D* hTemp1Mix = (TH2D*)fHistPNMix->Project(0,1,2);
-      TH2D* hTemp2Mix = (TH2D*)fHistNPMix->Project(0,1,2);
-      TH2D* hTemp3Mix = (TH2D*)fHistPPMix->Project(0,1,2);
-      TH2D* hTemp4Mix = (TH2D*)fHistNNMix->Project(0,1,2);
-      // TH1D* hTemp5Mix = (TH1D*)fHistPMix->Project(0,1);
-      // TH1D* hTemp6Mix = (TH1D*)fHistNMix->Project(0,1);
+      TH2D* hTemp1Mix = (TH2D*)projPNMix.At(iProj);
+      TH2D* hTemp2Mix = (TH2D*)projNPMix.At(iProj);
+      TH2D* hTemp3Mix = (TH2D*)projPPMix.At(iProj);
+      TH2D* hTemp4Mix = (TH2D*)projNNMix.At(iProj);
       // ============================================================================================
       
       hTemp1->Sumw2();
@@ -28,6 +28,7 @@ using std::vector;
 class TH1D;
 class TH2D;
 class TH3D;
+class TObjArray;
 
 const Int_t kTrackVariablesSingle = 3;       // track variables in histogram (event class, pTtrig, vertexZ)
 const Int_t kTrackVariablesPair   = 6;       // track variables in histogram (event class, dEta, dPhi, pTtrig, ptAssociated, vertexZ)
@@ -239,6 +240,9 @@ class AliBalancePsi : public TObject {
 
  private:
   Float_t   GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign); 
+  void      ProjectPsiVertexBins(AliTHn *gHist, Int_t vertexAxis, Int_t axisX, Int_t axisY,
+				 Int_t binPsiMin, Int_t binPsiMax, Int_t binVertexMin, Int_t binVertexMax,
+				 TObjArray &projections) const; // projections for all psi/vertex bins in one pass
 
   Bool_t fShuffle; //shuffled balance function object
   TString fAnalysisLevel; //ESD, AOD or MC
@@ -64,8 +64,12 @@
 #include "AliAnalysisTaskEbyeIterPID.h"
 
 #include "iostream"
+#include <algorithm>
 using namespace std;
 
+// particle species (el, pi, ka, pr, de, mu) times sign of the pdg code, counted per cell of the window scan
+static const Int_t kNWindowCounters = 12;
+
 
 ClassImp(AliAnalysisTaskEbyeIterPID)
 
@@ -1350,11 +1354,68 @@ void AliAnalysisTaskEbyeIterPID::FillTPCdEdxMC()
   // ======================================================================
   //   
   // ========= Efficiency Check Eta momentum and Centrality scan ==========
+  // bin the reconstructed tracks and the generated particles once in the grid of the window edges,
+  // the moments of all eta and momentum windows are then read from its integral
   const Int_t nMoments = 9;
+  if(!fTreeSRedirector) return;
+  TArrayD etaEdges, momEdges;
+  SetWindowEdges(etaEdges, fetaDownArr, fetaUpArr, fnEtaWinBinsMC);
+  SetWindowEdges(momEdges, fpDownArr, fpUpArr, fnMomBinsMC);
+  TArrayI recGrid, genGrid;
+  ResetWindowGrid(recGrid, etaEdges, momEdges);
+  for(Int_t i = 0; i < fESD->GetNumberOfTracks(); i++) {    
+    
+    // initialize the dummy particle id
+    fElMC =-100.; fPiMC =-100.; fKaMC =-100.; fPrMC =-100.; fDeMC =-100.; fMuMC =-100.; 
+    AliESDtrack *trackReal = fESD->GetTrack(i); 
+    Int_t lab = TMath::Abs(trackReal->GetLabel());           // avoid from negatif labels, they include some garbage
+    fEtaMC    = trackReal->Eta();
+    
+    // MC track cuts
+    if (!stack->IsPhysicalPrimary(lab)) continue;                         // MC primary track check
+    
+    // Tack cuts from detector
+    if (!trackReal -> GetInnerParam()) continue;
+    if (!fESDtrackCuts -> AcceptTrack(trackReal)) continue;  // real track cuts 
+    
+    if (fTightCuts) if (trackReal->GetTPCsignalN()<70) continue;                                          
+    if (fTightCuts) if (trackReal->GetLengthInActiveZone(1,3,230, trackReal->GetBz(),0,0)<120) continue;  
+    
+    // match the track with mc track
+    TParticle *trackMC  = stack->Particle(lab);   
+    Int_t pdg           = trackMC->GetPdgCode();
+    
+    Int_t iPart = -10;
+    if (TMath::Abs(pdg) == 11)          iPart = 0; // select el-
+    if (TMath::Abs(pdg) == 211)         iPart = 1; // select pi+
+    if (TMath::Abs(pdg) == 321)         iPart = 2; // select ka+
+    if (TMath::Abs(pdg) == 2212)        iPart = 3; // select pr+
+    if (TMath::Abs(pdg) == 1000010020)  iPart = 4; // select de
+    if (TMath::Abs(pdg) == 13)          iPart = 5; // select mu-
+    if (iPart == -10) continue;
+    
+    if (iPart == 0 ) fElMC = trackReal->GetTPCsignal();
+    if (iPart == 1 ) fPiMC = trackReal->GetTPCsignal();
+    if (iPart == 2 ) fKaMC = trackReal->GetTPCsignal();
+    if (iPart == 3 ) fPrMC = trackReal->GetTPCsignal();
+    if (iPart == 4 ) fDeMC = trackReal->GetTPCsignal();
+    if (iPart == 5 ) fMuMC = trackReal->GetTPCsignal();
+    
+    // count the track in its eta and momentum cell
+    fptotMC = trackReal->GetInnerParam()->GetP();
+    FillWindowGrid(recGrid, etaEdges, momEdges, fEtaMC, fptotMC, iPart, pdg);
+    
+  } // ======= end of track loop =======
+  IntegrateWindowGrid(recGrid, etaEdges, momEdges);
+  FillGenWindowGrid(genGrid, etaEdges, momEdges, stack);
+  
   for (Int_t ieta=0; ieta<fnEtaWinBinsMC; ieta++){
     for (Int_t imom=0; imom<fnMomBinsMC; imom++){
       for (Int_t icent=0; icent<fnCentbinsData-1; icent++){
         
+        // the centrality is the one of the event, no particle is counted in the other bins
+        if ( !((fCentrality>=fcentDownArr[icent]) && (fCentrality<fcentUpArr[icent])) ) continue;
+        
         // -----------------------------------------------------------------------------------------
         // ----------------------------   reconstructed MC particles  ------------------------------
         // -----------------------------------------------------------------------------------------
@@ -1363,105 +1424,12 @@ void AliAnalysisTaskEbyeIterPID::FillTPCdEdxMC()
 	TVectorF recMomentsPos(nMoments);
 	TVectorF recMomentsNeg(nMoments);
 	TVectorF recMomentsCross(nMoments);
-	for(Int_t i=0;i<nMoments; i++){  recMoments[i]=0.; recMomentsPos[i]=0.;  recMomentsNeg[i]=0.;}
-	
-	// loop over tracks
         Int_t nTracks=0, trCount=0;
-        for(Int_t i = 0; i < fESD->GetNumberOfTracks(); i++) {    
-    
-          // initialize the dummy particle id
-          fElMC =-100.; fPiMC =-100.; fKaMC =-100.; fPrMC =-100.; fDeMC =-100.; fMuMC =-100.; 
-          AliESDtrack *trackReal = fESD->GetTrack(i); 
-          Int_t lab = TMath::Abs(trackReal->GetLabel());           // avoid from negatif labels, they include some garbage
-          fEtaMC    = trackReal->Eta();
-        
-          // MC track cuts
-          if ((fEtaMC<fetaDownArr[ieta]) || (fEtaMC>fetaUpArr[ieta])) continue;  // eta Cut
-          if (!stack->IsPhysicalPrimary(lab)) continue;                         // MC primary track check
-        
-          // Tack cuts from detector
-          if (!trackReal -> GetInnerParam()) continue;
-          if (!fESDtrackCuts -> AcceptTrack(trackReal)) continue;  // real track cuts 
-          
-          if (fTightCuts) if (trackReal->GetTPCsignalN()<70) continue;                                          
-          if (fTightCuts) if (trackReal->GetLengthInActiveZone(1,3,230, trackReal->GetBz(),0,0)<120) continue;  
- 
-          // match the track with mc track
-          TParticle *trackMC  = stack->Particle(lab);   
-          Int_t pdg           = trackMC->GetPdgCode();
-        
-          Int_t iPart = -10;
-          if (TMath::Abs(pdg) == 11)          iPart = 0; // select el-
-          if (TMath::Abs(pdg) == 211)         iPart = 1; // select pi+
-          if (TMath::Abs(pdg) == 321)         iPart = 2; // select ka+
-          if (TMath::Abs(pdg) == 2212)        iPart = 3; // select pr+
-          if (TMath::Abs(pdg) == 1000010020)  iPart = 4; // select de
-          if (TMath::Abs(pdg) == 13)          iPart = 5; // select mu-
-          if (iPart == -10) continue;
-      
-          if (iPart == 0 ) fElMC = trackReal->GetTPCsignal();
-          if (iPart == 1 ) fPiMC = trackReal->GetTPCsignal();
-          if (iPart == 2 ) fKaMC = trackReal->GetTPCsignal();
-          if (iPart == 3 ) fPrMC = trackReal->GetTPCsignal();
-          if (iPart == 4 ) fDeMC = trackReal->GetTPCsignal();
-          if (iPart == 5 ) fMuMC = trackReal->GetTPCsignal();
-    
-          // count first moments for given Centrality and momentum window
-	  fptotMC = trackReal->GetInnerParam()->GetP();
-          if ( (fCentrality>=fcentDownArr[icent]) 
-               && (fCentrality<fcentUpArr[icent]) 
-               && (fptotMC>=fpDownArr[imom]) 
-               && (fptotMC<=fpUpArr[imom]) ) 
-          { 
-	    nTracks++;                                // count the particles after track cuts
-	    if ( fPiMC>-1 || fKaMC>-1 || fPrMC>-1) trCount++;
-            if ( fPiMC>-1 ) recMoments[kPi]++;
-            if ( fKaMC>-1 ) recMoments[kKa]++;
-            if ( fPrMC>-1 ) recMoments[kPr]++;
-	    if ( fPiMC>-1 && pdg<0) recMomentsNeg[kPi]++;
-            if ( fKaMC>-1 && pdg<0) recMomentsNeg[kKa]++;
-            if ( fPrMC>-1 && pdg<0) recMomentsNeg[kPr]++;
-	    if ( fPiMC>-1 && pdg>0) recMomentsPos[kPi]++;
-            if ( fKaMC>-1 && pdg>0) recMomentsPos[kKa]++;
-            if ( fPrMC>-1 && pdg>0) recMomentsPos[kPr]++;
-          } 
-          
-        } // ======= end of track loop =======
-    
-        // calculate second moments
-        recMoments[kPiPi]=recMoments[kPi]*recMoments[kPi]; 
-	recMoments[kKaKa]=recMoments[kKa]*recMoments[kKa]; 
-        recMoments[kPrPr]=recMoments[kPr]*recMoments[kPr]; 
-        recMoments[kPiKa]=recMoments[kPi]*recMoments[kKa]; 
-        recMoments[kPiPr]=recMoments[kPi]*recMoments[kPr]; 
-        recMoments[kKaPr]=recMoments[kKa]*recMoments[kPr]; 
-	recMomentsNeg[kPiPi]=recMomentsNeg[kPi]*recMomentsNeg[kPi]; 
-	recMomentsNeg[kKaKa]=recMomentsNeg[kKa]*recMomentsNeg[kKa]; 
-        recMomentsNeg[kPrPr]=recMomentsNeg[kPr]*recMomentsNeg[kPr]; 
-        recMomentsNeg[kPiKa]=recMomentsNeg[kPi]*recMomentsNeg[kKa]; 
-        recMomentsNeg[kPiPr]=recMomentsNeg[kPi]*recMomentsNeg[kPr]; 
-        recMomentsNeg[kKaPr]=recMomentsNeg[kKa]*recMomentsNeg[kPr]; 
-	recMomentsPos[kPiPi]=recMomentsPos[kPi]*recMomentsPos[kPi]; 
-	recMomentsPos[kKaKa]=recMomentsPos[kKa]*recMomentsPos[kKa]; 
-        recMomentsPos[kPrPr]=recMomentsPos[kPr]*recMomentsPos[kPr]; 
-        recMomentsPos[kPiKa]=recMomentsPos[kPi]*recMomentsPos[kKa]; 
-        recMomentsPos[kPiPr]=recMomentsPos[kPi]*recMomentsPos[kPr]; 
-        recMomentsPos[kKaPr]=recMomentsPos[kKa]*recMomentsPos[kPr]; 
-	recMomentsCross[kPiPosPiNeg]=recMomentsPos[kPi]*recMomentsNeg[kPi]; 
-	recMomentsCross[kPiPosKaNeg]=recMomentsPos[kPi]*recMomentsNeg[kKa]; 
-	recMomentsCross[kPiPosPrNeg]=recMomentsPos[kPi]*recMomentsNeg[kPr]; 
-	recMomentsCross[kKaPosPiNeg]=recMomentsPos[kKa]*recMomentsNeg[kPi]; 
-	recMomentsCross[kKaPosKaNeg]=recMomentsPos[kKa]*recMomentsNeg[kKa]; 
-	recMomentsCross[kKaPosPrNeg]=recMomentsPos[kKa]*recMomentsNeg[kPr]; 
-	recMomentsCross[kPrPosPiNeg]=recMomentsPos[kPr]*recMomentsNeg[kPi]; 
-	recMomentsCross[kPrPosKaNeg]=recMomentsPos[kPr]*recMomentsNeg[kKa]; 
-	recMomentsCross[kPrPosPrNeg]=recMomentsPos[kPr]*recMomentsNeg[kPr]; 
-
+        GetWindowMoments(recGrid, etaEdges, momEdges, ieta, imom, nTracks, trCount, recMoments, recMomentsPos, recMomentsNeg, recMomentsCross);
       
         // fill tree which contains moments
         Int_t dataType = 0, sampleNo = 0;
         Double_t centBin = (fcentDownArr[icent]+fcentUpArr[icent])/2.;
-        if(!fTreeSRedirector) return;
         // if there is at least one track in an event fill the tree
         if ( trCount>0 ){
           (*fTreeSRedirector)<<"mcRec"<<
@@ -1491,85 +1459,11 @@ void AliAnalysisTaskEbyeIterPID::FillTPCdEdxMC()
 	TVectorF genMomentsPos(nMoments);
 	TVectorF genMomentsNeg(nMoments);
 	TVectorF genMomentsCross(nMoments);
-	for(Int_t i=0;i<nMoments; i++){  genMoments[i]=0.; genMomentsPos[i]=0.;  genMomentsNeg[i]=0.;}
-	
-	// go into event loop
         Int_t nTracksgen=0, trCountgen=0; 
-	AliMCParticle *trackMCgen;
-        for (Int_t iTracks = 0; iTracks < fMCEvent->GetNumberOfTracks(); iTracks++) {    // track loop
-  
-        // initialize the dummy particle id
-          fElMCgen =-100.; fPiMCgen =-100.; fKaMCgen =-100.; fPrMCgen =-100.; fDeMCgen =-100.; fMuMCgen =-100.;
-          trackMCgen = (AliMCParticle *)fMCEvent->GetTrack(iTracks);
-    
-         // apply primary vertex and eta cut
-          if ((trackMCgen->Eta()<fetaDownArr[ieta]) || (trackMCgen->Eta()>fetaUpArr[ieta])) continue;
-          if (!stack->IsPhysicalPrimary(iTracks)) continue;
-          Int_t pdg  = trackMCgen->Particle()->GetPdgCode();
-        
-          Int_t iPart = -10;
-          if (TMath::Abs(pdg) == 11)          {iPart = 0; fElMCgen = iPart;} // select el-
-          if (TMath::Abs(pdg) == 211)         {iPart = 1; fPiMCgen = iPart;} // select pi+
-          if (TMath::Abs(pdg) == 321)         {iPart = 2; fKaMCgen = iPart;} // select ka+
-          if (TMath::Abs(pdg) == 2212)        {iPart = 3; fPrMCgen = iPart;} // select pr+
-          if (TMath::Abs(pdg) == 1000010020)  {iPart = 4; fDeMCgen = iPart;} // select de
-          if (TMath::Abs(pdg) == 13)          {iPart = 5; fMuMCgen = iPart;} // select mu-
-          if (iPart == -10) continue;
-          fptotMCgen = trackMCgen->P();      
-       
-          // count first moments
-          if ((fCentrality>=fcentDownArr[icent])
-               &&(fCentrality<fcentUpArr[icent])
-               &&(fptotMCgen>=fpDownArr[imom])
-               &&(fptotMCgen<=fpUpArr[imom])) 
-          { 
-	    nTracksgen++;
-	    if ( fPiMCgen>-1 || fKaMCgen>-1 || fPrMCgen>-1) trCountgen++;
-            if ( fPiMCgen>-1 ) genMoments[kPi]++;
-            if ( fKaMCgen>-1 ) genMoments[kKa]++;
-            if ( fPrMCgen>-1 ) genMoments[kPr]++;
-	    if ( fPiMCgen>-1 && pdg<0) genMomentsNeg[kPi]++;
-            if ( fKaMCgen>-1 && pdg<0) genMomentsNeg[kKa]++;
-            if ( fPrMCgen>-1 && pdg<0) genMomentsNeg[kPr]++;
-	    if ( fPiMCgen>-1 && pdg>0) genMomentsPos[kPi]++;
-            if ( fKaMCgen>-1 && pdg>0) genMomentsPos[kKa]++;
-            if ( fPrMCgen>-1 && pdg>0) genMomentsPos[kPr]++;
-          }   
-      
-	} // ======= end of track loop ======= 
-	
-	// calculate second moments
-        genMoments[kPiPi]=genMoments[kPi]*genMoments[kPi]; 
-	genMoments[kKaKa]=genMoments[kKa]*genMoments[kKa]; 
-        genMoments[kPrPr]=genMoments[kPr]*genMoments[kPr]; 
-        genMoments[kPiKa]=genMoments[kPi]*genMoments[kKa]; 
-        genMoments[kPiPr]=genMoments[kPi]*genMoments[kPr]; 
-        genMoments[kKaPr]=genMoments[kKa]*genMoments[kPr]; 
-	genMomentsNeg[kPiPi]=genMomentsNeg[kPi]*genMomentsNeg[kPi]; 
-	genMomentsNeg[kKaKa]=genMomentsNeg[kKa]*genMomentsNeg[kKa]; 
-        genMomentsNeg[kPrPr]=genMomentsNeg[kPr]*genMomentsNeg[kPr]; 
-        genMomentsNeg[kPiKa]=genMomentsNeg[kPi]*genMomentsNeg[kKa]; 
-        genMomentsNeg[kPiPr]=genMomentsNeg[kPi]*genMomentsNeg[kPr]; 
-        genMomentsNeg[kKaPr]=genMomentsNeg[kKa]*genMomentsNeg[kPr]; 
-	genMomentsPos[kPiPi]=genMomentsPos[kPi]*genMomentsPos[kPi]; 
-	genMomentsPos[kKaKa]=genMomentsPos[kKa]*genMomentsPos[kKa]; 
-        genMomentsPos[kPrPr]=genMomentsPos[kPr]*genMomentsPos[kPr]; 
-        genMomentsPos[kPiKa]=genMomentsPos[kPi]*genMomentsPos[kKa]; 
-        genMomentsPos[kPiPr]=genMomentsPos[kPi]*genMomentsPos[kPr]; 
-        genMomentsPos[kKaPr]=genMomentsPos[kKa]*genMomentsPos[kPr]; 
-	genMomentsCross[kPiPosPiNeg]=genMomentsPos[kPi]*genMomentsNeg[kPi]; 
-	genMomentsCross[kPiPosKaNeg]=genMomentsPos[kPi]*genMomentsNeg[kKa]; 
-	genMomentsCross[kPiPosPrNeg]=genMomentsPos[kPi]*genMomentsNeg[kPr]; 
-	genMomentsCross[kKaPosPiNeg]=genMomentsPos[kKa]*genMomentsNeg[kPi]; 
-	genMomentsCross[kKaPosKaNeg]=genMomentsPos[kKa]*genMomentsNeg[kKa]; 
-	genMomentsCross[kKaPosPrNeg]=genMomentsPos[kKa]*genMomentsNeg[kPr]; 
-	genMomentsCross[kPrPosPiNeg]=genMomentsPos[kPr]*genMomentsNeg[kPi]; 
-	genMomentsCross[kPrPosKaNeg]=genMomentsPos[kPr]*genMomentsNeg[kKa]; 
-	genMomentsCross[kPrPosPrNeg]=genMomentsPos[kPr]*genMomentsNeg[kPr]; 
+        GetWindowMoments(genGrid, etaEdges, momEdges, ieta, imom, nTracksgen, trCountgen, genMoments, genMomentsPos, genMomentsNeg, genMomentsCross);
 	 
         // fill tree which contains moments
         dataType = 1, sampleNo = 0;  // dataType-> 1 for MCgen
-        if(!fTreeSRedirector) return;
         // if there is at least one track in an event fill the tree
         if ( trCountgen>0 ){   
           (*fTreeSRedirector)<<"mcGen"<<
@@ -1622,95 +1516,33 @@ void AliAnalysisTaskEbyeIterPID::FastGen()
   // ======================================================================
   //   
   // ========= Efficiency Check Eta momentum and Centrality scan ==========
+  // bin the generated particles once in the grid of the window edges, the moments
+  // of all eta and momentum windows are then read from its integral
   const Int_t nMoments = 9;
-   for (Int_t ieta=0; ieta<fnEtaWinBinsMC; ieta++){
+  if(!fTreeSRedirector) return;
+  TArrayD etaEdges, momEdges;
+  SetWindowEdges(etaEdges, fetaDownArr, fetaUpArr, fnEtaWinBinsMC);
+  SetWindowEdges(momEdges, fpDownArr, fpUpArr, fnMomBinsMC);
+  TArrayI genGrid;
+  FillGenWindowGrid(genGrid, etaEdges, momEdges, stack);
+  for (Int_t ieta=0; ieta<fnEtaWinBinsMC; ieta++){
     for (Int_t imom=0; imom<fnMomBinsMC; imom++){
       for (Int_t icent=0; icent<fnCentbinsData-1; icent++){
         
+        // the centrality is the one of the event, no particle is counted in the other bins
+        if ( !((fCentrality>=fcentDownArr[icent]) && (fCentrality<fcentUpArr[icent])) ) continue;
+        
 	// vectors to hold moments
 	TVectorF genMoments(nMoments);
 	TVectorF genMomentsPos(nMoments);
 	TVectorF genMomentsNeg(nMoments);
 	TVectorF genMomentsCross(nMoments);
-	for(Int_t i=0;i<nMoments; i++){  genMoments[i]=0.; genMomentsPos[i]=0.;  genMomentsNeg[i]=0.;}
-	  
-	Float_t nTracksgen=0, trCountgen=0;
-	AliMCParticle *trackMCgen;
-        for (Int_t iTracks = 0; iTracks < fMCEvent->GetNumberOfTracks(); iTracks++) {    // track loop
-  
-	  // initialize the dummy particle id
-          fElMCgen =-100.; fPiMCgen =-100.; fKaMCgen =-100.; fPrMCgen =-100.; fDeMCgen =-100.; fMuMCgen =-100.;
-          trackMCgen = (AliMCParticle *)fMCEvent->GetTrack(iTracks);
-    
-	  // apply primary vertex and eta cut
-          if ((trackMCgen->Eta()<fetaDownArr[ieta]) || (trackMCgen->Eta()>fetaUpArr[ieta])) continue;
-	  // if ( !(stack->IsPhysicalPrimary(iTracks) || stack->IsSecondaryFromWeakDecay(iTracks)) ) continue;
-	  if (!stack->IsPhysicalPrimary(iTracks)) continue;
-          Int_t pdg  = trackMCgen->Particle()->GetPdgCode();
-        
-          Int_t iPart = -10;
-          if (TMath::Abs(pdg) == 11)          {iPart = 0; fElMCgen = iPart;} // select el-
-          if (TMath::Abs(pdg) == 211)         {iPart = 1; fPiMCgen = iPart;} // select pi+
-          if (TMath::Abs(pdg) == 321)         {iPart = 2; fKaMCgen = iPart;} // select ka+
-          if (TMath::Abs(pdg) == 2212)        {iPart = 3; fPrMCgen = iPart;} // select pr+
-          if (TMath::Abs(pdg) == 1000010020)  {iPart = 4; fDeMCgen = iPart;} // select de
-          if (TMath::Abs(pdg) == 13)          {iPart = 5; fMuMCgen = iPart;} // select mu-
-          if (iPart == -10) continue;
-	  fptotMCgen = trackMCgen->P();  
-       
-          // count first moments
-          if ((fCentrality>=fcentDownArr[icent])
-               &&(fCentrality<fcentUpArr[icent])
-               &&(fptotMCgen>=fpDownArr[imom])
-               &&(fptotMCgen<=fpUpArr[imom])) 
-          { 
-	    nTracksgen++;
-	    if ( fPiMCgen>-1 || fKaMCgen>-1 || fPrMCgen>-1) trCountgen++;
-            if ( fPiMCgen>-1 ) genMoments[kPi]++;
-            if ( fKaMCgen>-1 ) genMoments[kKa]++;
-            if ( fPrMCgen>-1 ) genMoments[kPr]++;
-	    if ( fPiMCgen>-1 && pdg<0) genMomentsNeg[kPi]++;
-            if ( fKaMCgen>-1 && pdg<0) genMomentsNeg[kKa]++;
-            if ( fPrMCgen>-1 && pdg<0) genMomentsNeg[kPr]++;
-	    if ( fPiMCgen>-1 && pdg>0) genMomentsPos[kPi]++;
-            if ( fKaMCgen>-1 && pdg>0) genMomentsPos[kKa]++;
-            if ( fPrMCgen>-1 && pdg>0) genMomentsPos[kPr]++; 
-          }   
-      
-        } // ======= end of track loop ======= 
-      
-        // calculate second moments
-        genMoments[kPiPi]=genMoments[kPi]*genMoments[kPi]; 
-	genMoments[kKaKa]=genMoments[kKa]*genMoments[kKa]; 
-        genMoments[kPrPr]=genMoments[kPr]*genMoments[kPr]; 
-        genMoments[kPiKa]=genMoments[kPi]*genMoments[kKa]; 
-        genMoments[kPiPr]=genMoments[kPi]*genMoments[kPr]; 
-        genMoments[kKaPr]=genMoments[kKa]*genMoments[kPr]; 
-	genMomentsNeg[kPiPi]=genMomentsNeg[kPi]*genMomentsNeg[kPi]; 
-	genMomentsNeg[kKaKa]=genMomentsNeg[kKa]*genMomentsNeg[kKa]; 
-        genMomentsNeg[kPrPr]=genMomentsNeg[kPr]*genMomentsNeg[kPr]; 
-        genMomentsNeg[kPiKa]=genMomentsNeg[kPi]*genMomentsNeg[kKa]; 
-        genMomentsNeg[kPiPr]=genMomentsNeg[kPi]*genMomentsNeg[kPr]; 
-        genMomentsNeg[kKaPr]=genMomentsNeg[kKa]*genMomentsNeg[kPr]; 
-	genMomentsPos[kPiPi]=genMomentsPos[kPi]*genMomentsPos[kPi]; 
-	genMomentsPos[kKaKa]=genMomentsPos[kKa]*genMomentsPos[kKa]; 
-        genMomentsPos[kPrPr]=genMomentsPos[kPr]*genMomentsPos[kPr]; 
-        genMomentsPos[kPiKa]=genMomentsPos[kPi]*genMomentsPos[kKa]; 
-        genMomentsPos[kPiPr]=genMomentsPos[kPi]*genMomentsPos[kPr]; 
-        genMomentsPos[kKaPr]=genMomentsPos[kKa]*genMomentsPos[kPr]; 
-	genMomentsCross[kPiPosPiNeg]=genMomentsPos[kPi]*genMomentsNeg[kPi]; 
-	genMomentsCross[kPiPosKaNeg]=genMomentsPos[kPi]*genMomentsNeg[kKa]; 
-	genMomentsCross[kPiPosPrNeg]=genMomentsPos[kPi]*genMomentsNeg[kPr]; 
-	genMomentsCross[kKaPosPiNeg]=genMomentsPos[kKa]*genMomentsNeg[kPi]; 
-	genMomentsCross[kKaPosKaNeg]=genMomentsPos[kKa]*genMomentsNeg[kKa]; 
-	genMomentsCross[kKaPosPrNeg]=genMomentsPos[kKa]*genMomentsNeg[kPr]; 
-	genMomentsCross[kPrPosPiNeg]=genMomentsPos[kPr]*genMomentsNeg[kPi]; 
-	genMomentsCross[kPrPosKaNeg]=genMomentsPos[kPr]*genMomentsNeg[kKa]; 
-	genMomentsCross[kPrPosPrNeg]=genMomentsPos[kPr]*genMomentsNeg[kPr];
+	Int_t nGen=0, trGen=0;
+	GetWindowMoments(genGrid, etaEdges, momEdges, ieta, imom, nGen, trGen, genMoments, genMomentsPos, genMomentsNeg, genMomentsCross);
+	Float_t nTracksgen=nGen, trCountgen=trGen;
   
         // fill tree which contains moments
 	Double_t centBin = (fcentDownArr[icent]+fcentUpArr[icent])/2.;
-        if(!fTreeSRedirector) return;
         // if there is at least one track in an event fill the tree
         if ( trCountgen>0 ){   
           (*fTreeSRedirector)<<"mcGen"<<
@@ -2279,6 +2111,158 @@ Int_t AliAnalysisTaskEbyeIterPID::CountEmptyEvents(Int_t counterBin){
   cout << " ====== EVENT IS COOL GO AHEAD ======= " << endl;
   return emptyCount;
 
+}
+//________________________________________________________________________
+void AliAnalysisTaskEbyeIterPID::SetWindowEdges(TArrayD &edges, const Float_t *down, const Float_t *up, Int_t nWindows) const
+{
+  //
+  // Sorted distinct lower and upper edges of the eta or momentum windows
+  //
+  TArrayD all(2*nWindows);
+  for (Int_t i=0; i<nWindows; i++) { all[2*i] = down[i]; all[2*i+1] = up[i]; }
+  Double_t *first = all.GetArray();
+  std::sort(first, first+2*nWindows);
+  Int_t nEdges = std::unique(first, first+2*nWindows) - first;
+  edges.Set(nEdges, first);
+}
+//________________________________________________________________________
+Int_t AliAnalysisTaskEbyeIterPID::GetWindowCell(Double_t x, const TArrayD &edges) const
+{
+  //
+  // Cell of x in the grid of the window edges: 2k+1 if x is equal to the edge k, 2k if it is
+  // between the edges k-1 and k. Windows include both edges, so each of them is a range of cells
+  //
+  Int_t k = TMath::BinarySearch(edges.GetSize(), edges.GetArray(), x);  // last edge <= x
+  if (k>=0 && edges[k]==x) return 2*k+1;
+  return 2*k+2;
+}
+//________________________________________________________________________
+void AliAnalysisTaskEbyeIterPID::ResetWindowGrid(TArrayI &grid, const TArrayD &etaEdges, const TArrayD &momEdges) const
+{
+  //
+  // Empty grid of the eta and momentum cells, with one extra row and column for the integral
+  //
+  grid.Set((2*etaEdges.GetSize()+2)*(2*momEdges.GetSize()+2)*kNWindowCounters);
+  grid.Reset();
+}
+//________________________________________________________________________
+void AliAnalysisTaskEbyeIterPID::FillWindowGrid(TArrayI &grid, const TArrayD &etaEdges, const TArrayD &momEdges, Double_t eta, Double_t ptot, Int_t iPart, Int_t pdg) const
+{
+  //
+  // Count a particle in its eta and momentum cell
+  //
+  Int_t nMom  = 2*momEdges.GetSize()+2;
+  Int_t ieta  = GetWindowCell(eta, etaEdges)+1;
+  Int_t imom  = GetWindowCell(ptot, momEdges)+1;
+  grid[(ieta*nMom+imom)*kNWindowCounters + 2*iPart + ((pdg<0) ? 1 : 0)]++;
+}
+//________________________________________________________________________
+void AliAnalysisTaskEbyeIterPID::FillGenWindowGrid(TArrayI &grid, const TArrayD &etaEdges, const TArrayD &momEdges, AliStack *stack)
+{
+  //
+  // Count the generated primaries in the grid of the window edges, single pass over the MC event
+  //
+  ResetWindowGrid(grid, etaEdges, momEdges);
+  AliMCParticle *trackMCgen;
+  for (Int_t iTracks = 0; iTracks < fMCEvent->GetNumberOfTracks(); iTracks++) {    // track loop
+    
+    // initialize the dummy particle id
+    fElMCgen =-100.; fPiMCgen =-100.; fKaMCgen =-100.; fPrMCgen =-100.; fDeMCgen =-100.; fMuMCgen =-100.;
+    trackMCgen = (AliMCParticle *)fMCEvent->GetTrack(iTracks);
+    
+    // apply primary vertex cut
+    if (!stack->IsPhysicalPrimary(iTracks)) continue;
+    Int_t pdg  = trackMCgen->Particle()->GetPdgCode();
+    
+    Int_t iPart = -10;
+    if (TMath::Abs(pdg) == 11)          {iPart = 0; fElMCgen = iPart;} // select el-
+    if (TMath::Abs(pdg) == 211)         {iPart = 1; fPiMCgen = iPart;} // select pi+
+    if (TMath::Abs(pdg) == 321)         {iPart = 2; fKaMCgen = iPart;} // select ka+
+    if (TMath::Abs(pdg) == 2212)        {iPart = 3; fPrMCgen = iPart;} // select pr+
+    if (TMath::Abs(pdg) == 1000010020)  {iPart = 4; fDeMCgen = iPart;} // select de
+    if (TMath::Abs(pdg) == 13)          {iPart = 5; fMuMCgen = iPart;} // select mu-
+    if (iPart == -10) continue;
+    fptotMCgen = trackMCgen->P();
+    FillWindowGrid(grid, etaEdges, momEdges, trackMCgen->Eta(), fptotMCgen, iPart, pdg);
+    
+  } // ======= end of track loop =======
+  IntegrateWindowGrid(grid, etaEdges, momEdges);
+}
+//________________________________________________________________________
+void AliAnalysisTaskEbyeIterPID::IntegrateWindowGrid(TArrayI &grid, const TArrayD &etaEdges, const TArrayD &momEdges) const
+{
+  //
+  // Replace the counts by their integral over all cells with lower or equal eta and momentum
+  //
+  Int_t nEta = 2*etaEdges.GetSize()+2;
+  Int_t nMom = 2*momEdges.GetSize()+2;
+  Int_t *g = grid.GetArray();
+  for (Int_t ieta=1; ieta<nEta; ieta++){
+    for (Int_t imom=1; imom<nMom; imom++){
+      Int_t *cell  = g + (ieta*nMom+imom)*kNWindowCounters;
+      Int_t *below = cell - nMom*kNWindowCounters;
+      for (Int_t i=0; i<kNWindowCounters; i++) cell[i] += below[i] + cell[i-kNWindowCounters] - below[i-kNWindowCounters];
+    }
+  }
+}
+//________________________________________________________________________
+void AliAnalysisTaskEbyeIterPID::GetWindowMoments(const TArrayI &grid, const TArrayD &etaEdges, const TArrayD &momEdges, Int_t ieta, Int_t imom,
+                                                  Int_t &nTracks, Int_t &trCount, TVectorF &moments, TVectorF &momentsPos, TVectorF &momentsNeg, TVectorF &momentsCross) const
+{
+  //
+  // Number of particles and moments inside the eta window ieta and the momentum window imom
+  // (both edges included), from the integrated grid
+  //
+  Int_t nMom = 2*momEdges.GetSize()+2;
+  Int_t etaLo = GetWindowCell(fetaDownArr[ieta], etaEdges), etaHi = GetWindowCell(fetaUpArr[ieta], etaEdges)+1;
+  Int_t momLo = GetWindowCell(fpDownArr[imom], momEdges),   momHi = GetWindowCell(fpUpArr[imom], momEdges)+1;
+  Int_t counts[kNWindowCounters];
+  for (Int_t i=0; i<kNWindowCounters; i++) counts[i] = 0;
+  if (etaHi>etaLo && momHi>momLo) {
+    const Int_t *hihi = grid.GetArray() + (etaHi*nMom+momHi)*kNWindowCounters;
+    const Int_t *hilo = grid.GetArray() + (etaHi*nMom+momLo)*kNWindowCounters;
+    const Int_t *lohi = grid.GetArray() + (etaLo*nMom+momHi)*kNWindowCounters;
+    const Int_t *lolo = grid.GetArray() + (etaLo*nMom+momLo)*kNWindowCounters;
+    for (Int_t i=0; i<kNWindowCounters; i++) counts[i] = hihi[i] - hilo[i] - lohi[i] + lolo[i];
+  }
+  
+  // first moments, pi ka and pr are the species 1 2 and 3 of the counters
+  nTracks = 0;
+  for (Int_t i=0; i<kNWindowCounters; i++) nTracks += counts[i];
+  trCount = counts[2] + counts[3] + counts[4] + counts[5] + counts[6] + counts[7];
+  momentsPos[kPi] = counts[2]; momentsNeg[kPi] = counts[3]; moments[kPi] = counts[2]+counts[3];
+  momentsPos[kKa] = counts[4]; momentsNeg[kKa] = counts[5]; moments[kKa] = counts[4]+counts[5];
+  momentsPos[kPr] = counts[6]; momentsNeg[kPr] = counts[7]; moments[kPr] = counts[6]+counts[7];
+  
+  // calculate second moments
+  moments[kPiPi]=moments[kPi]*moments[kPi]; 
+  moments[kKaKa]=moments[kKa]*moments[kKa]; 
+  moments[kPrPr]=moments[kPr]*moments[kPr]; 
+  moments[kPiKa]=moments[kPi]*moments[kKa]; 
+  moments[kPiPr]=moments[kPi]*moments[kPr]; 
+  moments[kKaPr]=moments[kKa]*moments[kPr]; 
+  momentsNeg[kPiPi]=momentsNeg[kPi]*momentsNeg[kPi]; 
+  momentsNeg[kKaKa]=momentsNeg[kKa]*momentsNeg[kKa]; 
+  momentsNeg[kPrPr]=momentsNeg[kPr]*momentsNeg[kPr]; 
+  momentsNeg[kPiKa]=momentsNeg[kPi]*momentsNeg[kKa]; 
+  momentsNeg[kPiPr]=momentsNeg[kPi]*momentsNeg[kPr]; 
+  momentsNeg[kKaPr]=momentsNeg[kKa]*momentsNeg[kPr]; 
+  momentsPos[kPiPi]=momentsPos[kPi]*momentsPos[kPi]; 
+  momentsPos[kKaKa]=momentsPos[kKa]*momentsPos[kKa]; 
+  momentsPos[kPrPr]=momentsPos[kPr]*momentsPos[kPr]; 
+  momentsPos[kPiKa]=momentsPos[kPi]*momentsPos[kKa]; 
+  momentsPos[kPiPr]=momentsPos[kPi]*momentsPos[kPr]; 
+  momentsPos[kKaPr]=momentsPos[kKa]*momentsPos[kPr]; 
+  momentsCross[kPiPosPiNeg]=momentsPos[kPi]*momentsNeg[kPi]; 
+  momentsCross[kPiPosKaNeg]=momentsPos[kPi]*momentsNeg[kKa]; 
+  momentsCross[kPiPosPrNeg]=momentsPos[kPi]*momentsNeg[kPr]; 
+  momentsCross[kKaPosPiNeg]=momentsPos[kKa]*momentsNeg[kPi]; 
+  momentsCross[kKaPosKaNeg]=momentsPos[kKa]*momentsNeg[kKa]; 
+  momentsCross[kKaPosPrNeg]=momentsPos[kKa]*momentsNeg[kPr]; 
+  momentsCross[kPrPosPiNeg]=momentsPos[kPr]*momentsNeg[kPi]; 
+  momentsCross[kPrPosKaNeg]=momentsPos[kPr]*momentsNeg[kKa]; 
+  momentsCross[kPrPosPrNeg]=momentsPos[kPr]*momentsNeg[kPr]; 
+  
 }
 //________________________________________________________________________
 void AliAnalysisTaskEbyeIterPID::Terminate(Option_t *) 
@@ -22,6 +22,7 @@ class AliESDtrackCuts;
 class AliPIDResponse;
 class AliHeader;
 class AliESDpid;
+class AliStack;
 class fPIDCombined;
 
 
@@ -30,6 +31,9 @@ class fPIDCombined;
 #include "THnSparse.h"
 #include "THn.h"
 #include "TTreeStream.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
+#include "TVectorF.h"
 #include "AliESDv0Cuts.h"
 
 // class AliAnalysisTaskPIDetaTreeElectrons : public AliAnalysisTaskPIDV0base {
@@ -168,6 +172,14 @@ enum momentType {kPi=0,kKa=1,kPr=2,kPiPi=3,kKaKa=4,kPrPr=5,kPiKa=6,kPiPr=7,kKaPr
    void  FillCleanPions();                    // Fill Clean Pions
    Int_t CountEmptyEvents(Int_t counterBin);  // Just count if there is empty events
    void  BinLogAxis(TH1 *h);
+   void  SetWindowEdges(TArrayD &edges, const Float_t *down, const Float_t *up, Int_t nWindows) const;  // sorted distinct edges of the eta or momentum windows
+   Int_t GetWindowCell(Double_t x, const TArrayD &edges) const;                                          // cell of a value in the grid of the window edges
+   void  ResetWindowGrid(TArrayI &grid, const TArrayD &etaEdges, const TArrayD &momEdges) const;
+   void  FillWindowGrid(TArrayI &grid, const TArrayD &etaEdges, const TArrayD &momEdges, Double_t eta, Double_t ptot, Int_t iPart, Int_t pdg) const;
+   void  FillGenWindowGrid(TArrayI &grid, const TArrayD &etaEdges, const TArrayD &momEdges, AliStack *stack);  // single pass over the generated particles
+   void  IntegrateWindowGrid(TArrayI &grid, const TArrayD &etaEdges, const TArrayD &momEdges) const;
+   void  GetWindowMoments(const TArrayI &grid, const TArrayD &etaEdges, const TArrayD &momEdges, Int_t ieta, Int_t imom,
+                          Int_t &nTracks, Int_t &trCount, TVectorF &moments, TVectorF &momentsPos, TVectorF &momentsNeg, TVectorF &momentsCross) const;
   
   // ---------------------------------------------------------------------------------
   //                                   Members
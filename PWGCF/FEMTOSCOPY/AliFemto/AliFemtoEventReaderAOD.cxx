@@ -94,7 +94,10 @@ AliFemtoEventReaderAOD::AliFemtoEventReaderAOD():
   fIsKaonAnalysis(kFALSE),
   fIsProtonAnalysis(kFALSE),
   fIsPionAnalysis(kFALSE),
-  fIsElectronAnalysis(kFALSE)
+  fIsElectronAnalysis(kFALSE),
+  fPIDTable(),
+  fPIDTableTracks(),
+  fPIDTableRows()
 {
   // default constructor
   fAllTrue.ResetAllBits(kTRUE);
@@ -148,8 +151,10 @@ AliFemtoEventReaderAOD::AliFemtoEventReaderAOD(const AliFemtoEventReaderAOD &aRe
   fIsKaonAnalysis(aReader.fIsKaonAnalysis),
   fIsProtonAnalysis(aReader.fIsProtonAnalysis),
   fIsPionAnalysis(aReader.fIsPionAnalysis),
-  fIsElectronAnalysis(aReader.fIsElectronAnalysis)
-
+  fIsElectronAnalysis(aReader.fIsElectronAnalysis),
+  fPIDTable(),
+  fPIDTableTracks(),
+  fPIDTableRows()
 {
   // copy constructor
   fAllTrue.ResetAllBits(kTRUE);
@@ -223,6 +228,7 @@ AliFemtoEventReaderAOD &AliFemtoEventReaderAOD::operator=(const AliFemtoEventRea
   fIsProtonAnalysis = aReader.fIsProtonAnalysis;
   fIsPionAnalysis = aReader.fIsPionAnalysis;
   fIsElectronAnalysis = aReader.fIsElectronAnalysis;
+  ResetPIDTable();
 
   return *this;
 }
@@ -301,6 +307,9 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
 
   AliFemtoEvent *tEvent = new AliFemtoEvent();
 
+  // PID responses of the previous event are not valid anymore
+  ResetPIDTable();
+
   // setting global event characteristics
   tEvent->SetRunNumber(fEvent->GetRunNumber());
   tEvent->SetMagneticField(fEvent->GetMagneticField()*kilogauss);//to check if here is ok
@@ -1250,12 +1259,15 @@ AliFemtoV0 *AliFemtoEventReaderAOD::CopyAODtoFemtoV0(AliAODv0 *tAODv0)
     tFemtoV0->SetStatusPos(trackpos->GetStatus());
     tFemtoV0->SetStatusNeg(trackneg->GetStatus());
 
-    tFemtoV0->SetPosNSigmaTPCK(fAODpidUtil->NumberOfSigmasTPC(trackpos, AliPID::kKaon));
-    tFemtoV0->SetNegNSigmaTPCK(fAODpidUtil->NumberOfSigmasTPC(trackneg, AliPID::kKaon));
-    tFemtoV0->SetPosNSigmaTPCP(fAODpidUtil->NumberOfSigmasTPC(trackpos, AliPID::kProton));
-    tFemtoV0->SetNegNSigmaTPCP(fAODpidUtil->NumberOfSigmasTPC(trackneg, AliPID::kProton));
-    tFemtoV0->SetPosNSigmaTPCPi(fAODpidUtil->NumberOfSigmasTPC(trackpos, AliPID::kPion));
-    tFemtoV0->SetNegNSigmaTPCPi(fAODpidUtil->NumberOfSigmasTPC(trackneg, AliPID::kPion));
+    const int pidRowPos = PIDTableRow(trackpos);
+    const int pidRowNeg = PIDTableRow(trackneg);
+
+    tFemtoV0->SetPosNSigmaTPCK(PIDTableValue(pidRowPos, kPIDTPCK));
+    tFemtoV0->SetNegNSigmaTPCK(PIDTableValue(pidRowNeg, kPIDTPCK));
+    tFemtoV0->SetPosNSigmaTPCP(PIDTableValue(pidRowPos, kPIDTPCP));
+    tFemtoV0->SetNegNSigmaTPCP(PIDTableValue(pidRowNeg, kPIDTPCP));
+    tFemtoV0->SetPosNSigmaTPCPi(PIDTableValue(pidRowPos, kPIDTPCPi));
+    tFemtoV0->SetNegNSigmaTPCPi(PIDTableValue(pidRowNeg, kPIDTPCPi));
 
 
     float bfield = 5 * fMagFieldSign;
@@ -1364,11 +1376,11 @@ AliFemtoV0 *AliFemtoEventReaderAOD::CopyAODtoFemtoV0(AliAODv0 *tAODv0)
 
     if (((tFemtoV0->StatusPos() & AliVTrack::kTOFout) == AliVTrack::kTOFout) && ((tFemtoV0->StatusPos() & AliVTrack::kTIME) == AliVTrack::kTIME)) {
       // if (tFemtoV0->StatusPos() & AliESDtrack::kTOFout & AliESDtrack::kTIME) {  //AliESDtrack::kTOFpid=0x8000
-      probMisPos = fAODpidUtil->GetTOFMismatchProbability(trackpos);
+      probMisPos = PIDTableValue(pidRowPos, kPIDTOFMismatch);
     }
     if (((tFemtoV0->StatusNeg() & AliVTrack::kTOFout) == AliVTrack::kTOFout) && ((tFemtoV0->StatusNeg() & AliVTrack::kTIME) == AliVTrack::kTIME)) {
       // if (tFemtoV0->StatusNeg() & AliESDtrack::kTOFout & AliESDtrack::kTIME) {  //AliESDtrack::kTOFpid=0x8000
-      probMisNeg = fAODpidUtil->GetTOFMismatchProbability(trackneg);
+      probMisNeg = PIDTableValue(pidRowNeg, kPIDTOFMismatch);
     }
 
     // if(// (tFemtoV0->StatusPos()& AliESDtrack::kTOFpid)==0 ||
@@ -1396,16 +1408,16 @@ AliFemtoV0 *AliFemtoEventReaderAOD::CopyAODtoFemtoV0(AliAODv0 *tAODv0)
       if (((tFemtoV0->StatusPos() & AliVTrack::kTOFout) == AliVTrack::kTOFout) && ((tFemtoV0->StatusPos() & AliVTrack::kTIME) == AliVTrack::kTIME) && probMisPos < 0.01) {
 
         // if(trackpos->IsOn(AliESDtrack::kTOFout & AliESDtrack::kTIME)) {
-        tFemtoV0->SetPosNSigmaTOFK(fAODpidUtil->NumberOfSigmasTOF(trackpos, AliPID::kKaon));
-        tFemtoV0->SetPosNSigmaTOFP(fAODpidUtil->NumberOfSigmasTOF(trackpos, AliPID::kProton));
-        tFemtoV0->SetPosNSigmaTOFPi(fAODpidUtil->NumberOfSigmasTOF(trackpos, AliPID::kPion));
+        tFemtoV0->SetPosNSigmaTOFK(PIDTableValue(pidRowPos, kPIDTOFK));
+        tFemtoV0->SetPosNSigmaTOFP(PIDTableValue(pidRowPos, kPIDTOFP));
+        tFemtoV0->SetPosNSigmaTOFPi(PIDTableValue(pidRowPos, kPIDTOFPi));
       }
       if (((tFemtoV0->StatusNeg() & AliVTrack::kTOFout) == AliVTrack::kTOFout) && ((tFemtoV0->StatusNeg() & AliVTrack::kTIME) == AliVTrack::kTIME) && probMisNeg < 0.01) {
 
         // if(trackneg->IsOn(AliESDtrack::kTOFout & AliESDtrack::kTIME)) {
-        tFemtoV0->SetNegNSigmaTOFK(fAODpidUtil->NumberOfSigmasTOF(trackneg, AliPID::kKaon));
-        tFemtoV0->SetNegNSigmaTOFP(fAODpidUtil->NumberOfSigmasTOF(trackneg, AliPID::kProton));
-        tFemtoV0->SetNegNSigmaTOFPi(fAODpidUtil->NumberOfSigmasTOF(trackneg, AliPID::kPion));
+        tFemtoV0->SetNegNSigmaTOFK(PIDTableValue(pidRowNeg, kPIDTOFK));
+        tFemtoV0->SetNegNSigmaTOFP(PIDTableValue(pidRowNeg, kPIDTOFP));
+        tFemtoV0->SetNegNSigmaTOFPi(PIDTableValue(pidRowNeg, kPIDTOFPi));
       }
       double TOFSignalPos = trackpos->GetTOFsignal();
       double TOFSignalNeg = trackneg->GetTOFsignal();
@@ -1507,9 +1519,11 @@ AliFemtoXi *AliFemtoEventReaderAOD::CopyAODtoFemtoXi(AliAODcascade *tAODxi)
     tFemtoXi->SetNdofBac(trackbac->Chi2perNDF());//bac!
     tFemtoXi->SetStatusBac(trackbac->GetStatus()); //bac!
 
-    tFemtoXi->SetBacNSigmaTPCK(fAODpidUtil->NumberOfSigmasTPC(trackbac, AliPID::kKaon));
-    tFemtoXi->SetBacNSigmaTPCP(fAODpidUtil->NumberOfSigmasTPC(trackbac, AliPID::kProton));
-    tFemtoXi->SetBacNSigmaTPCPi(fAODpidUtil->NumberOfSigmasTPC(trackbac, AliPID::kPion));
+    const int pidRowBac = PIDTableRow(trackbac);
+
+    tFemtoXi->SetBacNSigmaTPCK(PIDTableValue(pidRowBac, kPIDTPCK));
+    tFemtoXi->SetBacNSigmaTPCP(PIDTableValue(pidRowBac, kPIDTPCP));
+    tFemtoXi->SetBacNSigmaTPCPi(PIDTableValue(pidRowBac, kPIDTPCPi));
 
 
     //NEED TO ADD:  
@@ -1584,7 +1598,7 @@ AliFemtoXi *AliFemtoEventReaderAOD::CopyAODtoFemtoXi(AliAODcascade *tAODxi)
 
     if (((tFemtoXi->StatusBac() & AliVTrack::kTOFout) == AliVTrack::kTOFout) && ((tFemtoXi->StatusBac() & AliVTrack::kTIME) == AliVTrack::kTIME)) {
       // if (tFemtoXi->StatusBac() & AliESDtrack::kTOFout & AliESDtrack::kTIME) {  //AliESDtrack::kTOFpid=0x8000
-      probMisBac = fAODpidUtil->GetTOFMismatchProbability(trackbac);
+      probMisBac = PIDTableValue(pidRowBac, kPIDTOFMismatch);
     }
 
     // if(// (tFemtoXi->StatusPos()& AliESDtrack::kTOFpid)==0 ||
@@ -1605,9 +1619,9 @@ AliFemtoXi *AliFemtoEventReaderAOD::CopyAODtoFemtoXi(AliAODcascade *tAODxi)
     {
       if (((tFemtoXi->StatusBac() & AliVTrack::kTOFout) == AliVTrack::kTOFout) && ((tFemtoXi->StatusBac() & AliVTrack::kTIME) == AliVTrack::kTIME) && probMisBac < 0.01)
       {
-        tFemtoXi->SetBacNSigmaTOFK(fAODpidUtil->NumberOfSigmasTOF(trackbac, AliPID::kKaon));
-        tFemtoXi->SetBacNSigmaTOFP(fAODpidUtil->NumberOfSigmasTOF(trackbac, AliPID::kProton));
-        tFemtoXi->SetBacNSigmaTOFPi(fAODpidUtil->NumberOfSigmasTOF(trackbac, AliPID::kPion));
+        tFemtoXi->SetBacNSigmaTOFK(PIDTableValue(pidRowBac, kPIDTOFK));
+        tFemtoXi->SetBacNSigmaTOFP(PIDTableValue(pidRowBac, kPIDTOFP));
+        tFemtoXi->SetBacNSigmaTOFPi(PIDTableValue(pidRowBac, kPIDTOFPi));
       }
 
       double TOFSignalBac = trackbac->GetTOFsignal();
@@ -1790,20 +1804,21 @@ void AliFemtoEventReaderAOD::CopyPIDtoFemtoTrack(AliAODTrack *tAodTrack, AliFemt
     tAodTrack->GetIntegratedTimes(aodpid);
 
     tTOF -= fAODpidUtil->GetTOFResponse().GetStartTime(tAodTrack->P());
-
-    probMis = fAODpidUtil->GetTOFMismatchProbability(tAodTrack);
   }
 
+  const int pidRow = PIDTableRow(tAodTrack);
+  probMis = PIDTableValue(pidRow, kPIDTOFMismatch);
+
 
 
   tFemtoTrack->SetTofExpectedTimes(tTOF - aodpid[2], tTOF - aodpid[3], tTOF - aodpid[4]);
 
   //////  TPC ////////////////////////////////////////////
 
-  const float nsigmaTPCK = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kKaon);
-  const float nsigmaTPCPi = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kPion);
-  const float nsigmaTPCP = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kProton);
-  const float nsigmaTPCE = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kElectron);
+  const float nsigmaTPCK = PIDTableValue(pidRow, kPIDTPCK);
+  const float nsigmaTPCPi = PIDTableValue(pidRow, kPIDTPCPi);
+  const float nsigmaTPCP = PIDTableValue(pidRow, kPIDTPCP);
+  const float nsigmaTPCE = PIDTableValue(pidRow, kPIDTPCE);
 
   tFemtoTrack->SetNSigmaTPCPi(nsigmaTPCPi);
   tFemtoTrack->SetNSigmaTPCK(nsigmaTPCK);
@@ -1831,10 +1846,10 @@ void AliFemtoEventReaderAOD::CopyPIDtoFemtoTrack(AliAODTrack *tAodTrack, AliFemt
       && ((status & AliVTrack::kTIME) == AliVTrack::kTIME)
       && probMis < 0.01) {
 
-    nsigmaTOFPi = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kPion);
-    nsigmaTOFK = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kKaon);
-    nsigmaTOFP = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kProton);
-    nsigmaTOFE = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kElectron);
+    nsigmaTOFPi = PIDTableValue(pidRow, kPIDTOFPi);
+    nsigmaTOFK = PIDTableValue(pidRow, kPIDTOFK);
+    nsigmaTOFP = PIDTableValue(pidRow, kPIDTOFP);
+    nsigmaTOFE = PIDTableValue(pidRow, kPIDTOFE);
 
     Double_t len = 200; // esdtrack->GetIntegratedLength(); !!!!!
     Double_t tof = tAodTrack->GetTOFsignal();
@@ -1850,6 +1865,66 @@ void AliFemtoEventReaderAOD::CopyPIDtoFemtoTrack(AliAODTrack *tAodTrack, AliFemt
   //////////////////////////////////////
 }
 
+int AliFemtoEventReaderAOD::PIDTableRow(const AliAODTrack *track)
+{
+  // The table is filled with all species used by the track, V0 and cascade
+  // conversions, so every row is evaluated exactly once per event. Rows are
+  // indexed by track ID, the negative IDs of TPC-only tracks in odd slots
+  const int id = track->GetID();
+  const size_t slot = id >= 0 ? 2 * size_t(id) : 2 * size_t(-id - 1) + 1;
+  if (slot < fPIDTableRows.size()) {
+    const int known = fPIDTableRows[slot];
+    if (known >= 0 && fPIDTableTracks[known] == track) {
+      return known;
+    }
+  } else {
+    fPIDTableRows.resize(slot + 1, -1);
+  }
+
+  // a second track with the same ID is evaluated but not indexed
+  const int row = fPIDTableTracks.size();
+  if (fPIDTableRows[slot] < 0) {
+    fPIDTableRows[slot] = row;
+  }
+  fPIDTableTracks.push_back(track);
+  fPIDTable.resize((row + 1) * kNPIDColumns);
+  float *values = &fPIDTable[row * kNPIDColumns];
+
+  values[kPIDTPCE] = fAODpidUtil->NumberOfSigmasTPC(track, AliPID::kElectron);
+  values[kPIDTPCPi] = fAODpidUtil->NumberOfSigmasTPC(track, AliPID::kPion);
+  values[kPIDTPCK] = fAODpidUtil->NumberOfSigmasTPC(track, AliPID::kKaon);
+  values[kPIDTPCP] = fAODpidUtil->NumberOfSigmasTPC(track, AliPID::kProton);
+
+  // TOF response only for tracks with a TOF signal not flagged as mismatch
+  values[kPIDTOFMismatch] = 1.0;
+  values[kPIDTOFE] = -1000.;
+  values[kPIDTOFPi] = -1000.;
+  values[kPIDTOFK] = -1000.;
+  values[kPIDTOFP] = -1000.;
+
+  const ULong_t status = track->GetStatus();
+  if (((status & AliVTrack::kTOFout) == AliVTrack::kTOFout)
+      && ((status & AliVTrack::kTIME) == AliVTrack::kTIME)) {
+    values[kPIDTOFMismatch] = fAODpidUtil->GetTOFMismatchProbability(track);
+    if (values[kPIDTOFMismatch] < 0.01) {
+      values[kPIDTOFE] = fAODpidUtil->NumberOfSigmasTOF(track, AliPID::kElectron);
+      values[kPIDTOFPi] = fAODpidUtil->NumberOfSigmasTOF(track, AliPID::kPion);
+      values[kPIDTOFK] = fAODpidUtil->NumberOfSigmasTOF(track, AliPID::kKaon);
+      values[kPIDTOFP] = fAODpidUtil->NumberOfSigmasTOF(track, AliPID::kProton);
+    }
+  }
+
+  return row;
+}
+
+void AliFemtoEventReaderAOD::ResetPIDTable()
+{
+  // keeps the capacity of the table, so no reallocation after the first events
+  fPIDTable.clear();
+  fPIDTableTracks.clear();
+  std::fill(fPIDTableRows.begin(), fPIDTableRows.end(), -1);
+}
+
 void AliFemtoEventReaderAOD::SetCentralityPreSelection(double min, double max)
 {
   fCentRange[0] = min;
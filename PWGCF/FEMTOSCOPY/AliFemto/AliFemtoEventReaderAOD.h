@@ -108,6 +108,24 @@ protected:
   virtual AliFemtoXi *CopyAODtoFemtoXi(AliAODcascade *tAODxi);
   virtual void CopyPIDtoFemtoTrack(AliAODTrack *tAodTrack, AliFemtoTrack *tFemtoTrack);
 
+  /// Columns of the per-event PID table
+  enum EPIDTableColumn {kPIDTPCE = 0, kPIDTPCPi, kPIDTPCK, kPIDTPCP,
+                        kPIDTOFE, kPIDTOFPi, kPIDTOFK, kPIDTOFP,
+                        kPIDTOFMismatch, kNPIDColumns
+                       };
+
+  /// Row of the track in the per-event PID table. The PID response of a
+  /// track is evaluated on first request and then looked up, so tracks
+  /// used as primary track and as daughter of several V0s or cascades
+  /// are evaluated once per event.
+  int PIDTableRow(const AliAODTrack *track);
+  /// Value of the PID table (see EPIDTableColumn)
+  float PIDTableValue(int row, EPIDTableColumn column) const {
+    return fPIDTable[row * kNPIDColumns + column];
+  }
+  /// Clear the PID table, to be called for each new event
+  void ResetPIDTable();
+
   int            fNumberofEvent;    ///< number of Events in AOD file
   int            fCurEvent;         ///< number of current event
   AliAODEvent   *fEvent;            ///< AOD event
@@ -164,10 +182,14 @@ private:
   Bool_t fIsElectronAnalysis; // e+e- are taken (for gamma cut tuning)
   //Special MC analysis for pi,K,p,e slected by PDG code <--
 
+  std::vector<float> fPIDTable;                    //!< PID response of the tracks of the current event
+  std::vector<const AliAODTrack *> fPIDTableTracks; //!< track of each row of fPIDTable
+  std::vector<int> fPIDTableRows;                  //!< row of fPIDTable by track ID (see PIDTableRow), -1 if not evaluated
+
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
-  ClassDef(AliFemtoEventReaderAOD, 12);
+  ClassDef(AliFemtoEventReaderAOD, 13);
   /// \endcond
 #endif
 
@@ -2,6 +2,8 @@
 /// \file AliFemtoParticle.cxx
 ///
 
+#include <TMath.h>
+
 #include "AliFemtoKink.h"
 #include "AliFemtoParticle.h"
 #include "AliFemtoXi.h"
@@ -42,7 +44,14 @@ AliFemtoParticle::AliFemtoParticle() :
   fTpcV0PosExitPoint(),
   fHelixV0Neg(),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fEta(0),
+  fPhi(0),
+  fPhiStar(NULL),
+  fPhiStarSize(0),
+  fPhiStarMagSign(0),
+  fPhiStarMinRad(0),
+  fPhiStarMaxRad(0)
 {
   // Default constructor
   std::fill_n(fPurity, 6, 0.0);
@@ -63,7 +72,14 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoParticle &aParticle):
   fTpcV0PosExitPoint(aParticle.fTpcV0PosExitPoint),
   fHelixV0Neg(aParticle.fHelixV0Neg),
   fTpcV0NegEntrancePoint(aParticle.fTpcV0NegEntrancePoint),
-  fTpcV0NegExitPoint(aParticle.fTpcV0NegExitPoint)
+  fTpcV0NegExitPoint(aParticle.fTpcV0NegExitPoint),
+  fEta(aParticle.fEta),
+  fPhi(aParticle.fPhi),
+  fPhiStar(NULL),
+  fPhiStarSize(0),
+  fPhiStarMagSign(0),
+  fPhiStarMinRad(0),
+  fPhiStarMaxRad(0)
 {
   // Copy constructor
   memcpy(fPurity, aParticle.fPurity, sizeof(fPurity));
@@ -89,6 +105,7 @@ AliFemtoParticle::~AliFemtoParticle()
   delete fKink;
   delete fXi;
   delete fHiddenInfo;
+  delete [] fPhiStar;
 }
 //_____________________
 AliFemtoParticle::AliFemtoParticle(const AliFemtoTrack *const hbtTrack, const double &mass):
@@ -106,7 +123,14 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoTrack *const hbtTrack, const do
   fTpcV0PosExitPoint(),
   fHelixV0Neg(),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fEta(fFourMomentum.vect().PseudoRapidity()),
+  fPhi(fFourMomentum.vect().Phi()),
+  fPhiStar(NULL),
+  fPhiStarSize(0),
+  fPhiStarMagSign(0),
+  fPhiStarMinRad(0),
+  fPhiStarMaxRad(0)
 {
   // Constructor from normal track
   /* TO JA ODZNACZYLEM NIE WIEM DLACZEGO
@@ -140,7 +164,14 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoV0 *const hbtV0, const double &
   fTpcV0PosExitPoint(),
   fHelixV0Neg(hbtV0->HelixNeg()),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fEta(fFourMomentum.vect().PseudoRapidity()),
+  fPhi(fFourMomentum.vect().Phi()),
+  fPhiStar(NULL),
+  fPhiStarSize(0),
+  fPhiStarMagSign(0),
+  fPhiStarMinRad(0),
+  fPhiStarMaxRad(0)
 {
   // Constructor from V0
 
@@ -167,7 +198,14 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoKink *const hbtKink, const doub
   fTpcV0PosExitPoint(),
   fHelixV0Neg(),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fEta(fFourMomentum.vect().PseudoRapidity()),
+  fPhi(fFourMomentum.vect().Phi()),
+  fPhiStar(NULL),
+  fPhiStarSize(0),
+  fPhiStarMagSign(0),
+  fPhiStarMinRad(0),
+  fPhiStarMaxRad(0)
 {
   // Constructor from Kink
   for (int ip = 0; ip < 6; ip++) fPurity[ip] = 0.0;
@@ -191,7 +229,14 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoXi *const hbtXi, const double &
   fTpcV0PosExitPoint(),
   fHelixV0Neg(),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fEta(fFourMomentum.vect().PseudoRapidity()),
+  fPhi(fFourMomentum.vect().Phi()),
+  fPhiStar(NULL),
+  fPhiStarSize(0),
+  fPhiStarMagSign(0),
+  fPhiStarMinRad(0),
+  fPhiStarMaxRad(0)
 {
   // Constructor from Xi
   for (int ip = 0; ip < 6; ip++) fPurity[ip] = 0.0;
@@ -280,6 +325,12 @@ AliFemtoParticle &AliFemtoParticle::operator=(const AliFemtoParticle &aParticle)
   fTpcV0NegEntrancePoint = aParticle.fTpcV0NegEntrancePoint;
   fTpcV0NegExitPoint = aParticle.fTpcV0NegExitPoint;
 
+  fEta = aParticle.fEta;
+  fPhi = aParticle.fPhi;
+  delete [] fPhiStar;
+  fPhiStar = NULL;
+  fPhiStarSize = 0;
+
   return *this;
 }
 // //_____________________
@@ -295,6 +346,41 @@ AliFemtoParticle &AliFemtoParticle::operator=(const AliFemtoParticle &aParticle)
 //   return fNominalTpcEntrancePoint;
 // }
 //_____________________
+const double* AliFemtoParticle::PhiStarTable(int magSign, double minRad, double maxRad, int &size) const
+{
+  // Table of phi* = phi + asin(-0.075 q B r / pt) on the radius grid used
+  // by the close pair cuts; computed once and reused for all pairs
+  if (!fTrack) {
+    size = 0;
+    return NULL;
+  }
+
+  if (!fPhiStar || magSign != fPhiStarMagSign || minRad != fPhiStarMinRad || maxRad != fPhiStarMaxRad) {
+    int n = 0;
+    for (double rad = minRad; rad < maxRad; rad += 0.01) n++;
+    if (n > fPhiStarSize || !fPhiStar) {
+      delete [] fPhiStar;
+      fPhiStar = new double[n > 0 ? n : 1];
+    }
+    fPhiStarSize = n;
+    fPhiStarMagSign = magSign;
+    fPhiStarMinRad = minRad;
+    fPhiStarMaxRad = maxRad;
+
+    const double curv = -0.075 * fTrack->Charge() * magSign / fTrack->Pt();
+    int i = 0;
+    for (double rad = minRad; rad < maxRad; rad += 0.01) {
+      double phistar = fPhi + TMath::ASin(curv * rad);
+      if (phistar > TMath::Pi()) phistar -= TMath::TwoPi();
+      else if (phistar < -TMath::Pi()) phistar += TMath::TwoPi();
+      fPhiStar[i++] = phistar;
+    }
+  }
+
+  size = fPhiStarSize;
+  return fPhiStar;
+}
+//_____________________
 void AliFemtoParticle::CalculatePurity()
 {
   // Calculate additional parameterized purity
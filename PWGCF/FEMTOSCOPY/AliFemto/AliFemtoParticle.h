@@ -64,6 +64,14 @@ public:
 
   void ResetFourMomentum(const AliFemtoLorentzVector &fourMomentum);
 
+  double Eta() const;  ///< pseudorapidity of the momentum the particle was built from
+  double Phi() const;  ///< azimuthal angle of the momentum the particle was built from
+
+  /// Angle \f$ \phi^{*}(r) \f$ of the track at the radii r = minRad, minRad + 0.01, ... < maxRad (in m),
+  /// in the range [-pi, pi]. The table is built on first request and kept until other
+  /// parameters are requested. Returns NULL for particles not built from a track.
+  const double* PhiStarTable(int magSign, double minRad, double maxRad, int &size) const;
+
   const AliFemtoHiddenInfo* HiddenInfo() const;
 
   AliFemtoHiddenInfo* GetHiddenInfo() const;
@@ -126,6 +134,15 @@ private:
   AliFmPhysicalHelixD fHelixV0Neg;            // helix for negative V0 daughter
   AliFemtoThreeVector fTpcV0NegEntrancePoint; // negative V0 daughter entrance point to TPC
   AliFemtoThreeVector fTpcV0NegExitPoint;     // negative V0 daughter exit point from TPC
+
+  double fEta;  // cached pseudorapidity
+  double fPhi;  // cached azimuthal angle
+
+  mutable double *fPhiStar;        // phi* table of the track
+  mutable int fPhiStarSize;        // number of entries in the phi* table
+  mutable int fPhiStarMagSign;     // magnetic field sign used for the phi* table
+  mutable double fPhiStarMinRad;   // minimum radius used for the phi* table
+  mutable double fPhiStarMaxRad;   // maximum radius used for the phi* table
 };
 
 inline AliFemtoTrack *AliFemtoParticle::Track() const
@@ -140,6 +157,14 @@ inline const AliFemtoLorentzVector &AliFemtoParticle::FourMomentum() const
 {
   return fFourMomentum;
 }
+inline double AliFemtoParticle::Eta() const
+{
+  return fEta;
+}
+inline double AliFemtoParticle::Phi() const
+{
+  return fPhi;
+}
 inline AliFmPhysicalHelixD &AliFemtoParticle::Helix()
 {
   return fHelix;
@@ -197,6 +222,12 @@ inline void AliFemtoParticle::SetHiddenInfo(AliFemtoHiddenInfo *aHiddenInfo)
 inline void AliFemtoParticle::ResetFourMomentum(const AliFemtoLorentzVector &vec)
 {
   fFourMomentum = vec;
+  // the cached kinematics follow the new momentum, the phi* table is rebuilt on demand
+  fEta = fFourMomentum.vect().PseudoRapidity();
+  fPhi = fFourMomentum.vect().Phi();
+  delete [] fPhiStar;
+  fPhiStar = NULL;
+  fPhiStarSize = 0;
 }
 
 inline AliFemtoKink *AliFemtoParticle::Kink() const
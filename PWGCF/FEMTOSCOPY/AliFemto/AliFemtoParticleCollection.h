@@ -8,6 +8,8 @@
  * Description: part of STAR HBT Framework: AliFemtoMaker package
  *   The ParticleCollection is the main component of the picoEvent
  *   It points to the particle objects in the picoEvent.
+ *   The collection is a vector, so the pair loops run over contiguous
+ *   memory; the particles themselves live in the arena of the picoEvent.
  *
  ***************************************************************************
  *
@@ -30,19 +32,21 @@
 #define AliFemtoParticleCollection_hh
 #include "AliFemtoParticle.h"
 #include <list>
+#include <vector>
 
 #if !defined(ST_NO_NAMESPACES)
 using std::list;
+using std::vector;
 #endif
 
 #ifdef ST_NO_TEMPLATE_DEF_ARGS
-typedef list<AliFemtoParticle *, allocator<AliFemtoParticle *> >            AliFemtoParticleCollection;
-typedef list<AliFemtoParticle *, allocator<AliFemtoParticle *> >::iterator  AliFemtoParticleIterator;
-typedef list<AliFemtoParticle *, allocator<AliFemtoParticle *> >::const_iterator  AliFemtoParticleConstIterator;
+typedef vector<AliFemtoParticle *, allocator<AliFemtoParticle *> >            AliFemtoParticleCollection;
+typedef vector<AliFemtoParticle *, allocator<AliFemtoParticle *> >::iterator  AliFemtoParticleIterator;
+typedef vector<AliFemtoParticle *, allocator<AliFemtoParticle *> >::const_iterator  AliFemtoParticleConstIterator;
 #else
-typedef list<AliFemtoParticle *>            AliFemtoParticleCollection;
-typedef list<AliFemtoParticle *>::iterator  AliFemtoParticleIterator;
-typedef list<AliFemtoParticle *>::const_iterator  AliFemtoParticleConstIterator;
+typedef vector<AliFemtoParticle *>            AliFemtoParticleCollection;
+typedef vector<AliFemtoParticle *>::iterator  AliFemtoParticleIterator;
+typedef vector<AliFemtoParticle *>::const_iterator  AliFemtoParticleConstIterator;
 #endif
 
 #endif
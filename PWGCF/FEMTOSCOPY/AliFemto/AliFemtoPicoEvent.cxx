@@ -63,11 +63,17 @@
 #include "AliFemtoPicoEvent.h"
 #include "AliFemtoParticleCollection.h"
 
+// Number of particles in one block of the arena. Blocks are never moved,
+// so the particles keep their addresses while the arena grows.
+static const unsigned int kArenaBlockSize = 64;
+
 //________________
 AliFemtoPicoEvent::AliFemtoPicoEvent() :
   fFirstParticleCollection(0),
   fSecondParticleCollection(0),
-  fThirdParticleCollection(0)
+  fThirdParticleCollection(0),
+  fArenaBlocks(),
+  fArenaSize(0)
 {
   // Default constructor
   fFirstParticleCollection = new AliFemtoParticleCollection;
@@ -78,7 +84,9 @@ AliFemtoPicoEvent::AliFemtoPicoEvent() :
 AliFemtoPicoEvent::AliFemtoPicoEvent(const AliFemtoPicoEvent& aPicoEvent) :
   fFirstParticleCollection(0),
   fSecondParticleCollection(0),
-  fThirdParticleCollection(0)
+  fThirdParticleCollection(0),
+  fArenaBlocks(),
+  fArenaSize(0)
 {
   // Copy constructor
   AliFemtoParticleIterator iter;
@@ -105,36 +113,19 @@ AliFemtoPicoEvent::AliFemtoPicoEvent(const AliFemtoPicoEvent& aPicoEvent) :
 //_________________
 AliFemtoPicoEvent::~AliFemtoPicoEvent(){
   // Destructor
-  AliFemtoParticleIterator iter;
-  
-  if (fFirstParticleCollection){
-    for (iter=fFirstParticleCollection->begin();iter!=fFirstParticleCollection->end();iter++){
-      delete *iter;
-    }
-    fFirstParticleCollection->clear();
-    delete fFirstParticleCollection;
-    fFirstParticleCollection = 0;
-  }
-  
-  if (fSecondParticleCollection){
-    for (iter=fSecondParticleCollection->begin();iter!=fSecondParticleCollection->end();iter++){
-      delete *iter;
-    }
-    fSecondParticleCollection->clear();
-    delete fSecondParticleCollection;
-    fSecondParticleCollection = 0;
-  }
+  Reset();
 
-  if (fThirdParticleCollection){
-    if (fThirdParticleCollection->size() != 0 ) {
-      for (iter=fThirdParticleCollection->begin();iter!=fThirdParticleCollection->end();iter++){
-	delete *iter;
-      }
-    }
-    fThirdParticleCollection->clear();
-    delete fThirdParticleCollection;
-    fThirdParticleCollection = 0;
+  delete fFirstParticleCollection;
+  fFirstParticleCollection = 0;
+  delete fSecondParticleCollection;
+  fSecondParticleCollection = 0;
+  delete fThirdParticleCollection;
+  fThirdParticleCollection = 0;
+
+  for (unsigned int i = 0; i < fArenaBlocks.size(); i++) {
+    ::operator delete(fArenaBlocks[i]);
   }
+  fArenaBlocks.clear();
 }
 //_________________
 AliFemtoPicoEvent& AliFemtoPicoEvent::operator=(const AliFemtoPicoEvent& aPicoEvent) 
@@ -144,49 +135,19 @@ AliFemtoPicoEvent& AliFemtoPicoEvent::operator=(const AliFemtoPicoEvent& aPicoEv
     return *this;
 
   AliFemtoParticleIterator iter;
-   
-  if (fFirstParticleCollection){
-      for (iter=fFirstParticleCollection->begin();iter!=fFirstParticleCollection->end();iter++){
-	delete *iter;
-      }
-      fFirstParticleCollection->clear();
-      delete fFirstParticleCollection;
-      fFirstParticleCollection = 0;
-  }
-
-  if (fSecondParticleCollection){
-    for (iter=fSecondParticleCollection->begin();iter!=fSecondParticleCollection->end();iter++){
-      delete *iter;
-    }
-    fSecondParticleCollection->clear();
-    delete fSecondParticleCollection;
-    fSecondParticleCollection = 0;
-  }
 
-  if (fThirdParticleCollection){
-    if (fThirdParticleCollection->size() != 0 ) {
-      for (iter=fThirdParticleCollection->begin();iter!=fThirdParticleCollection->end();iter++){
-	delete *iter;
-      }
-    }
-    fThirdParticleCollection->clear();
-    delete fThirdParticleCollection;
-    fThirdParticleCollection = 0;
-  }
+  Reset();
 
-  fFirstParticleCollection = new AliFemtoParticleCollection;
   if (aPicoEvent.fFirstParticleCollection) {
     for (iter=aPicoEvent.fFirstParticleCollection->begin();iter!=aPicoEvent.fFirstParticleCollection->end();iter++){
       fFirstParticleCollection->push_back(*iter);
     }
   }
-  fSecondParticleCollection = new AliFemtoParticleCollection;
   if (aPicoEvent.fSecondParticleCollection) {
     for (iter=aPicoEvent.fSecondParticleCollection->begin();iter!=aPicoEvent.fSecondParticleCollection->end();iter++){
       fSecondParticleCollection->push_back(*iter);
     }
   }
-  fThirdParticleCollection = new AliFemtoParticleCollection;
   if (aPicoEvent.fThirdParticleCollection) {
     for (iter=aPicoEvent.fThirdParticleCollection->begin();iter!=aPicoEvent.fThirdParticleCollection->end();iter++){
       fThirdParticleCollection->push_back(*iter);
@@ -195,4 +156,54 @@ AliFemtoPicoEvent& AliFemtoPicoEvent::operator=(const AliFemtoPicoEvent& aPicoEv
 
   return *this;
 }
+//_________________
+void AliFemtoPicoEvent::Reset()
+{
+  // Delete the particles of all collections. The particles of the arena
+  // are destroyed in place, the memory of the arena and of the collections
+  // is kept for the next event.
+  DeleteParticles(fFirstParticleCollection);
+  DeleteParticles(fSecondParticleCollection);
+  DeleteParticles(fThirdParticleCollection);
+
+  for (unsigned int i = 0; i < fArenaSize; i++) {
+    AliFemtoParticle *particle = fArenaBlocks[i / kArenaBlockSize] + i % kArenaBlockSize;
+    particle->~AliFemtoParticle();
+  }
+  fArenaSize = 0;
+}
+//_________________
+void* AliFemtoPicoEvent::AllocateParticle()
+{
+  // Storage for the next particle of the arena
+  const unsigned int block = fArenaSize / kArenaBlockSize;
+  if (block == fArenaBlocks.size()) {
+    fArenaBlocks.push_back(static_cast<AliFemtoParticle*>(::operator new(kArenaBlockSize * sizeof(AliFemtoParticle))));
+  }
+  return fArenaBlocks[block] + fArenaSize++ % kArenaBlockSize;
+}
+//_________________
+bool AliFemtoPicoEvent::IsInArena(const AliFemtoParticle* aParticle) const
+{
+  // Is the particle constructed in the arena (and not created with new)?
+  for (unsigned int i = 0; i < fArenaBlocks.size(); i++) {
+    if (aParticle >= fArenaBlocks[i] && aParticle < fArenaBlocks[i] + kArenaBlockSize) {
+      return true;
+    }
+  }
+  return false;
+}
+//_________________
+void AliFemtoPicoEvent::DeleteParticles(AliFemtoParticleCollection* aCollection)
+{
+  // Delete the particles of the collection which were created with new,
+  // the particles of the arena are destroyed by Reset()
+  if (!aCollection) return;
 
+  for (AliFemtoParticleIterator iter=aCollection->begin();iter!=aCollection->end();iter++){
+    if (!IsInArena(*iter)) {
+      delete *iter;
+    }
+  }
+  aCollection->clear();
+}
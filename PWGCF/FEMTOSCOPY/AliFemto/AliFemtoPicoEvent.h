@@ -44,6 +44,9 @@
 
 #include "AliFemtoParticleCollection.h"
 
+#include <new>
+#include <vector>
+
 class AliFemtoPicoEvent{
 public:
   AliFemtoPicoEvent();
@@ -58,14 +61,35 @@ public:
   AliFemtoParticleCollection* SecondParticleCollection();
   AliFemtoParticleCollection* ThirdParticleCollection();
 
+  /* particles constructed in the arena of the pico event; they are owned by */
+  /* the pico event like the particles created with new                      */
+  template <class T> AliFemtoParticle* NewParticle(const T* track, const double& mass);
+
+  /* delete all particles, keeping the memory of the arena and collections   */
+  /* so the pico event can be reused for a new event                         */
+  void Reset();
+
 private:
+  void* AllocateParticle();
+  bool  IsInArena(const AliFemtoParticle* aParticle) const;
+  void  DeleteParticles(AliFemtoParticleCollection* aCollection);
+
   AliFemtoParticleCollection* fFirstParticleCollection;  // Collection of particles of type 1
   AliFemtoParticleCollection* fSecondParticleCollection; // Collection of particles of type 2
   AliFemtoParticleCollection* fThirdParticleCollection;  // Collection of particles of type 3
+
+  std::vector<AliFemtoParticle*> fArenaBlocks;           // Blocks of contiguous storage for the particles
+  unsigned int fArenaSize;                               // Number of particles constructed in the arena
 };
 
 inline AliFemtoParticleCollection* AliFemtoPicoEvent::FirstParticleCollection(){return fFirstParticleCollection;}
 inline AliFemtoParticleCollection* AliFemtoPicoEvent::SecondParticleCollection(){return fSecondParticleCollection;}
 inline AliFemtoParticleCollection* AliFemtoPicoEvent::ThirdParticleCollection(){return fThirdParticleCollection;}
 
+template <class T>
+inline AliFemtoParticle* AliFemtoPicoEvent::NewParticle(const T* track, const double& mass)
+{
+  return new (AllocateParticle()) AliFemtoParticle(track, mass);
+}
+
 #endif
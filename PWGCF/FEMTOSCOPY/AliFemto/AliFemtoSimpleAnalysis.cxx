@@ -33,6 +33,8 @@ AliFemtoCorrFctn*    copyTheCorrFctn(AliFemtoCorrFctn*);
 /// method on each track. If it passes, a new AliFemtoParticle is constructed
 /// from the track's pointer (or more generally, the item returned by
 /// dereferencing the container's iterator) and the cut's expected mass.
+/// If a pico event is given, the particle is constructed in its arena,
+/// otherwise it is created with new.
 ///
 /// This templated function accepts a track cut, track collection, and an
 /// AliFemtoParticleCollection (which points to the output) as input. The types
@@ -48,7 +50,8 @@ AliFemtoCorrFctn*    copyTheCorrFctn(AliFemtoCorrFctn*);
 template <class TrackCollectionType, class TrackCutType>
 void DoFillParticleCollection(TrackCutType *cut,
                               TrackCollectionType *track_collection,
-                              AliFemtoParticleCollection *output)
+                              AliFemtoParticleCollection *output,
+                              AliFemtoPicoEvent *arena)
 {
   // lets's just name the iterator type
   typedef typename TrackCollectionType::iterator TrackCollectionIterType;
@@ -59,7 +62,8 @@ void DoFillParticleCollection(TrackCutType *cut,
     const Bool_t track_passes = cut->Pass(*pIter);
     cut->FillCutMonitor(*pIter, track_passes);
     if (track_passes) {
-      output->push_back(new AliFemtoParticle(*pIter, cut->Mass()));
+      output->push_back(arena ? arena->NewParticle(*pIter, cut->Mass())
+                              : new AliFemtoParticle(*pIter, cut->Mass()));
     }
   }
 }
@@ -70,10 +74,11 @@ void DoFillParticleCollection(TrackCutType *cut,
 //
 // The actual loop implementation has been moved to the collection-generic
 // DoFillParticleCollection() function
-void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
-                               AliFemtoEvent *hbtEvent,
-                               AliFemtoParticleCollection *partCollection,
-                               bool performSharedDaughterCut=kFALSE)
+static void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
+                                      AliFemtoEvent *hbtEvent,
+                                      AliFemtoParticleCollection *partCollection,
+                                      bool performSharedDaughterCut,
+                                      AliFemtoPicoEvent *arena)
 {
   /// Fill particle collection with all particles in the event which pass
   /// the provided cut
@@ -87,7 +92,8 @@ void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
     DoFillParticleCollection(
       (AliFemtoTrackCut*)partCut,
       hbtEvent->TrackCollection(),
-      partCollection
+      partCollection,
+      arena
     );
 
     break;
@@ -102,14 +108,16 @@ void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
       AliFemtoV0SharedDaughterCut shared_daughter_cut;
       AliFemtoV0Collection v0_coll = shared_daughter_cut.AliFemtoV0SharedDaughterCutCollection(hbtEvent->V0Collection(), v0_cut);
       for (AliFemtoV0Iterator pIter = v0_coll.begin(); pIter != v0_coll.end(); ++pIter) {
-        partCollection->push_back(new AliFemtoParticle(*pIter, v0_cut->Mass()));
+        partCollection->push_back(arena ? arena->NewParticle(*pIter, v0_cut->Mass())
+                                        : new AliFemtoParticle(*pIter, v0_cut->Mass()));
       }
     } else {
 
       DoFillParticleCollection(
         v0_cut,
         hbtEvent->V0Collection(),
-        partCollection
+        partCollection,
+        arena
       );
 
     }
@@ -128,7 +136,8 @@ void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
       AliFemtoXiSharedDaughterCut shared_daughter_cut;
       AliFemtoXiCollection xi_coll = shared_daughter_cut.AliFemtoXiSharedDaughterCutCollection(hbtEvent->XiCollection(), xi_cut);
       for (AliFemtoXiIterator pIter = xi_coll.begin(); pIter != xi_coll.end(); ++pIter) {
-        partCollection->push_back(new AliFemtoParticle(*pIter, xi_cut->Mass()));
+        partCollection->push_back(arena ? arena->NewParticle(*pIter, xi_cut->Mass())
+                                        : new AliFemtoParticle(*pIter, xi_cut->Mass()));
       }
     } 
     else
@@ -136,7 +145,8 @@ void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
       DoFillParticleCollection(
         (AliFemtoXiTrackCut*)partCut,
         hbtEvent->XiCollection(),
-        partCollection
+        partCollection,
+        arena
       );
     }
     break;
@@ -148,7 +158,8 @@ void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
     DoFillParticleCollection(
       (AliFemtoKinkCut*)partCut,
       hbtEvent->KinkCollection(),
-      partCollection
+      partCollection,
+      arena
     );
 
     break;
@@ -160,6 +171,16 @@ void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
 
   partCut->FillCutMonitor(hbtEvent, partCollection);
 }
+
+// Particles are created with new - used by the analyses which build their
+// pico events themselves
+void FillHbtParticleCollection(AliFemtoParticleCut *partCut,
+                               AliFemtoEvent *hbtEvent,
+                               AliFemtoParticleCollection *partCollection,
+                               bool performSharedDaughterCut=kFALSE)
+{
+  FillHbtParticleCollection(partCut, hbtEvent, partCollection, performSharedDaughterCut, NULL);
+}
 //____________________________
 AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fPicoEventCollectionVectorHideAway(NULL),
@@ -170,6 +191,7 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fSecondParticleCut(NULL),
   fMixingBuffer(NULL),
   fPicoEvent(NULL),
+  fRecycledPicoEvent(NULL),
   fNumEventsToMix(0),
   fNeventsProcessed(0),
   fMinSizePartCollection(0),
@@ -192,6 +214,7 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis(const AliFemtoSimpleAnalysis& a):
   fSecondParticleCut(NULL),
   fMixingBuffer(NULL),
   fPicoEvent(NULL),
+  fRecycledPicoEvent(NULL),
   fNumEventsToMix(a.fNumEventsToMix),
   fNeventsProcessed(0),
   fMinSizePartCollection(a.fMinSizePartCollection),
@@ -308,6 +331,8 @@ AliFemtoSimpleAnalysis::~AliFemtoSimpleAnalysis()
     }
     delete fMixingBuffer;
   }
+
+  delete fRecycledPicoEvent;
 }
 //______________________
 AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAnalysis& aAna)
@@ -463,9 +488,14 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
   // Analysis likes the event -- build a pico event from it, using tracks the
   // analysis likes. This is what we will make pairs from and put in Mixing
   // Buffer.
-  // No memory leak: we will delete picoevents when they come out of the
+  // No memory leak: we will recycle picoevents when they come out of the
   // mixing buffer
-  fPicoEvent = new AliFemtoPicoEvent;
+  if (fRecycledPicoEvent) {
+    fPicoEvent = fRecycledPicoEvent;
+    fRecycledPicoEvent = NULL;
+  } else {
+    fPicoEvent = new AliFemtoPicoEvent;
+  }
 
   AliFemtoParticleCollection *collection1 = fPicoEvent->FirstParticleCollection(),
                              *collection2 = fPicoEvent->SecondParticleCollection();
@@ -474,7 +504,7 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
   if (collection1 == NULL || collection2 == NULL) {
     cout << "E-AliFemtoSimpleAnalysis::ProcessEvent: new PicoEvent is missing particle collections!\n";
     EventEnd(hbtEvent);  // cleanup for EbyE
-    delete fPicoEvent;
+    RecyclePicoEvent(fPicoEvent);
     return;
   }
 
@@ -484,14 +514,16 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
   FillHbtParticleCollection(fFirstParticleCut,
                             (AliFemtoEvent*)hbtEvent,
                             fPicoEvent->FirstParticleCollection(),
-                            fPerformSharedDaughterCut);
+                            fPerformSharedDaughterCut,
+                            fPicoEvent);
 
   // fill second particle cut if not analyzing identical particles
   if ( !AnalyzeIdenticalParticles() ) {
       FillHbtParticleCollection(fSecondParticleCut,
                                 (AliFemtoEvent*)hbtEvent,
                                 fPicoEvent->SecondParticleCollection(),
-                                fPerformSharedDaughterCut);
+                                fPerformSharedDaughterCut,
+                                fPicoEvent);
   }
 
   const UInt_t coll_1_size = collection1->size(),
@@ -518,7 +550,7 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
 
   if (!tmpPassEvent) {
     EventEnd(hbtEvent);
-    delete fPicoEvent;
+    RecyclePicoEvent(fPicoEvent);
     return;
   }
 
@@ -558,9 +590,9 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
     cout << " - mixed done   " << endl;
   }
 
-  //--------- If mixing buffer is full, delete oldest event ---------//
+  //--------- If mixing buffer is full, recycle oldest event ---------//
   if ( MixingBufferFull() ) {
-    delete MixingBuffer()->back();
+    RecyclePicoEvent(MixingBuffer()->back());
     MixingBuffer()->pop_back();
   }
 
@@ -571,6 +603,19 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
   //cout << "AliFemtoSimpleAnalysis::ProcessEvent() - return to caller ... " << endl;
 }
 
+//_________________________
+void AliFemtoSimpleAnalysis::RecyclePicoEvent(AliFemtoPicoEvent* picoEvent)
+{
+  // one spare pico event is enough: each event takes at most one out of
+  // the mixing buffers
+  if (fRecycledPicoEvent) {
+    delete picoEvent;
+    return;
+  }
+  picoEvent->Reset();
+  fRecycledPicoEvent = picoEvent;
+}
+
 //_________________________
 void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
                                        AliFemtoParticleCollection *partCollection1,
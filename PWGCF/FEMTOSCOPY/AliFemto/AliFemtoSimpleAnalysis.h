@@ -159,6 +159,11 @@ protected:
                  AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
                  Bool_t enablePairMonitors=kFALSE);
 
+  /// Keep a pico event which is not used anymore (left the mixing buffer or
+  /// was rejected) for the next event. Its particles are deleted, the memory
+  /// of its particle arena and collections is reused.
+  void RecyclePicoEvent(AliFemtoPicoEvent* picoEvent);
+
   AliFemtoPicoEventCollectionVectorHideAway* fPicoEventCollectionVectorHideAway; //!<! Mixing Buffer used for Analyses which wrap this one
 
   AliFemtoPairCut*             fPairCut;             ///< cut applied to pairs
@@ -168,6 +173,7 @@ protected:
   AliFemtoParticleCut*         fSecondParticleCut;   ///< select particles of type #2
   AliFemtoPicoEventCollection* fMixingBuffer;        ///< mixing buffer used in this simplest analysis
   AliFemtoPicoEvent*           fPicoEvent;           //!<! The current event, in the small (pico) form
+  AliFemtoPicoEvent*           fRecycledPicoEvent;   //!<! Empty pico event, reused for the next event
 
   unsigned int fNumEventsToMix;                      ///< How many "previous" events get mixed with this one, to make background
   unsigned int fNeventsProcessed;                    ///< How many events processed so far
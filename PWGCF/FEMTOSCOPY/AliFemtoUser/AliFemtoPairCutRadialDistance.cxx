@@ -15,6 +15,8 @@
  ********************************************************************************/
 
 #include "AliFemtoPairCutRadialDistance.h"
+#include "AliFemtoEvent.h"
+#include "SystemOfUnits.h"
 #include <string>
 #include <cstdio>
 
@@ -70,76 +72,62 @@ AliFemtoPairCutRadialDistance& AliFemtoPairCutRadialDistance::operator=(const Al
   return *this;
 }
 //__________________
-bool AliFemtoPairCutRadialDistance::Pass(const AliFemtoPair* pair){
-  // Accept pairs based on their TPC entrance separation and
-  // quality and sharity
-  //  bool temp = true;
-
-//    double pih = 3.14159265358979312;
-//    double pit = 6.28318530717958623;
-
-  double phi1 = pair->Track1()->Track()->P().Phi();
-  double phi2 = pair->Track2()->Track()->P().Phi();
-  double chg1 = pair->Track1()->Track()->Charge();
-  double chg2 = pair->Track2()->Track()->Charge();
-  double ptv1 = pair->Track1()->Track()->Pt();
-  double ptv2 = pair->Track2()->Track()->Pt();
-  double eta1 = pair->Track1()->Track()->P().PseudoRapidity();
-  double eta2 = pair->Track2()->Track()->P().PseudoRapidity();
-
-
-  AliAODInputHandler *aodH = dynamic_cast<AliAODInputHandler*> (AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler());
-  Double_t magsign = 0.0;
-
-  if (!aodH) {
-    // AliWarning("Could not get AODInputHandler");
-    return false;
-  }
-  else {
-    AliAODEvent *fAOD;
-    fAOD = aodH->GetEvent();
-    //cout<<fAOD<<endl;
-    magsign = fAOD->GetMagneticField();
-  }
-
-  if (magsign > 1)
+void AliFemtoPairCutRadialDistance::EventBegin(const AliFemtoEvent* aEvent)
+{
+  // Take the magnetic field sign once per event instead of once per pair
+  // (the event stores the field in internal units, the cut expects kG)
+  Double_t magfield = aEvent->MagneticField() / units::kilogauss;
+  if (magfield > 1)
     fMagSign = 1;
-  else if ( magsign < 1)
+  else if (magfield < 1)
     fMagSign = -1;
   else
-    fMagSign = magsign;
-
-  //cout << "mag sign = " << magsign << endl;
+    fMagSign = magfield;
+}
+//__________________
+bool AliFemtoPairCutRadialDistance::Pass(const AliFemtoPair* pair){
+  // Accept pairs based on their TPC entrance separation and
+  // quality and sharity
 
-  Double_t rad;
+  const AliFemtoParticle *part1 = pair->Track1();
+  const AliFemtoParticle *part2 = pair->Track2();
+  Double_t etad = part2->Eta() - part1->Eta();
   Bool_t pass5 = kTRUE;
 
-  rad = fMinRad;
-
   if (fPhistarmin) {
-    for (rad = fMinRad; rad < fMaxRad; rad += 0.01) {
-      Double_t dps = (phi2-phi1+(TMath::ASin(-0.075*chg2*fMagSign*rad/ptv2))-(TMath::ASin(-0.075*chg1*fMagSign*rad/ptv1)));
-      dps = TVector2::Phi_mpi_pi(dps);
-      Double_t etad = eta2 - eta1;
-      if (fabs(etad)<fEtaMin && fabs(dps)<fDPhiStarMin) {
-        // cout << "5% cut is not passed - returning" << endl;
-        pass5 = kFALSE;
-        break;
+    // the eta condition does not depend on the radius: scan the
+    // precomputed phi* tables only for pairs close in eta
+    if (fabs(etad) < fEtaMin) {
+      Int_t n1 = 0, n2 = 0;
+      const Double_t *phistar1 = part1->PhiStarTable(fMagSign, fMinRad, fMaxRad, n1);
+      const Double_t *phistar2 = part2->PhiStarTable(fMagSign, fMinRad, fMaxRad, n2);
+      const Int_t n = phistar1 && phistar2 ? TMath::Min(n1, n2) : 0;
+      for (Int_t i = 0; i < n; i++) {
+        Double_t dps = phistar2[i] - phistar1[i];
+        if (dps > TMath::Pi()) dps -= TMath::TwoPi();
+        else if (dps < -TMath::Pi()) dps += TMath::TwoPi();
+        if (fabs(dps) < fDPhiStarMin) {
+          pass5 = kFALSE;
+          break;
+        }
       }
     }
   }
   else {
+    double chg1 = part1->Track()->Charge();
+    double chg2 = part2->Track()->Charge();
+    double ptv1 = part1->Track()->Pt();
+    double ptv2 = part2->Track()->Pt();
 
-    double afsi0b = 0.07510020733*chg1*fMagSign*rad/ptv1;
-    double afsi1b = 0.07510020733*chg2*fMagSign*rad/ptv2;
+    double afsi0b = 0.07510020733*chg1*fMagSign*fMinRad/ptv1;
+    double afsi1b = 0.07510020733*chg2*fMagSign*fMinRad/ptv2;
 
     if (fabs(afsi0b) >=1.) return kTRUE;
     if (fabs(afsi1b) >=1.) return kTRUE;
 
-    Double_t dps =  phi2 - phi1 + TMath::ASin(afsi1b) - TMath::ASin(afsi0b);
+    Double_t dps = part2->Phi() - part1->Phi() + TMath::ASin(afsi1b) - TMath::ASin(afsi0b);
     dps = TVector2::Phi_mpi_pi(dps);
 
-    Double_t etad = eta2 - eta1;
     if (fabs(etad)<fEtaMin && fabs(dps)<fDPhiStarMin) {
       pass5 = kFALSE;
     }
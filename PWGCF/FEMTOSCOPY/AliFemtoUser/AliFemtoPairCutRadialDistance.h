@@ -39,6 +39,7 @@ public:
   AliFemtoPairCutRadialDistance& operator=(const AliFemtoPairCutRadialDistance& c);
 
   virtual bool Pass(const AliFemtoPair* pair);
+  virtual void EventBegin(const AliFemtoEvent* aEvent);
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   virtual AliFemtoPairCut* Clone();
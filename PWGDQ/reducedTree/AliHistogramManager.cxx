@@ -603,12 +603,22 @@ void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values
   //
   //  fill a class of histograms
   //
-  THashList* hList = (THashList*)fMainList.FindObject(className);
+  THashList* hList = FindHistClass(className);
   if(!hList) {
     /*cout << "Warning in AliHistogramManager::FillHistClass(): Histogram list " << className << " not found!" << endl;
     cout << "         Histogram list not filled" << endl; */
     return;
   }
+  FillHistClass(hList, values);
+}
+
+
+//_________________________________________________________________
+void AliHistogramManager::FillHistClass(THashList* hList, Float_t* values) {
+  //
+  //  fill a class of histograms, for callers which keep the histogram list
+  //  (e.g. fills in tight loops, avoiding the lookup by name)
+  //
   if(!hList) {
     return;
   }
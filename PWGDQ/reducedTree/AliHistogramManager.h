@@ -65,6 +65,8 @@ class AliHistogramManager : public TObject {
                         TAxis* axis);
   
   void FillHistClass(const Char_t* className, Float_t* values);
+  void FillHistClass(THashList* hList, Float_t* values);      // fill a list obtained with FindHistClass()
+  THashList* FindHistClass(const Char_t* className) const {return (THashList*)fMainList.FindObject(className);}
   
   void SetUseDefaultVariableNames(Bool_t flag) {fUseDefaultVariableNames = flag;};
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -0,0 +1,113 @@
+/*
+***********************************************************
+  Implementation of the AliMixingPool class
+  Contact: iarsene@cern.ch
+  *********************************************************
+*/
+
+#ifndef ALIMIXINGPOOL_H
+#include "AliMixingPool.h"
+#endif
+
+#include <TList.h>
+#include <TMath.h>
+
+#include "AliReducedBaseTrack.h"
+
+ClassImp(AliMixingPool);
+
+//_________________________________________________________________________
+AliMixingPool::AliMixingPool() :
+  TObject(),
+  fNEvents(0),
+  fNLegs(),
+  fLegs(),
+  fFlags(),
+  fEventOffsets()
+{
+  //
+  // default constructor
+  //
+  for(Int_t ileg=0; ileg<2; ++ileg) {
+    fNLegs[ileg] = 0;
+    fEventOffsets[ileg].Set(1);
+  }
+}
+
+
+//_________________________________________________________________________
+AliMixingPool::~AliMixingPool() {
+  //
+  // destructor
+  //
+}
+
+
+//_________________________________________________________________________
+void AliMixingPool::AddEvent(TList* leg1List, TList* leg2List) {
+  //
+  // Copy the kinematics and the cut flags of the legs of an event at the end of the pool
+  //
+  TList* lists[2] = {leg1List, leg2List};
+  for(Int_t ileg=0; ileg<2; ++ileg) {
+    Int_t nNew = lists[ileg]->GetEntries();
+    if(fNLegs[ileg]+nNew>fFlags[ileg].GetSize()) {
+      Int_t size = TMath::Max(2*fFlags[ileg].GetSize(), fNLegs[ileg]+nNew);
+      if(size<64) size = 64;
+      fLegs[ileg].Set(size*kNLegVariables);
+      fFlags[ileg].Set(size);
+    }
+    if(fEventOffsets[ileg].GetSize()<fNEvents+2)
+      fEventOffsets[ileg].Set(TMath::Max(2*fEventOffsets[ileg].GetSize(), fNEvents+2));
+
+    TIter nextTrack(lists[ileg]);
+    AliReducedBaseTrack* track=0x0;
+    while((track=(AliReducedBaseTrack*)nextTrack())) {
+      Float_t* leg = fLegs[ileg].GetArray()+fNLegs[ileg]*kNLegVariables;
+      leg[kPx] = track->Px(); leg[kPy] = track->Py(); leg[kPz] = track->Pz();
+      leg[kP] = track->P(); leg[kCharge] = track->Charge();
+      fFlags[ileg][fNLegs[ileg]] = Long64_t(track->GetFlags());
+      ++fNLegs[ileg];
+    }
+    fEventOffsets[ileg][fNEvents+1] = fNLegs[ileg];
+  }
+  ++fNEvents;
+}
+
+
+//_________________________________________________________________________
+void AliMixingPool::UnsetFlags(ULong_t mask) {
+  //
+  // Unset the bits in mask for all the legs in the pool, then remove the legs without any
+  // bit left and the events without any leg left
+  //
+  Int_t nLegs[2] = {0, 0};
+  Int_t nEvents = 0;
+  for(Int_t iev=0; iev<fNEvents; ++iev) {
+    Int_t nLegsEvent = 0;
+    for(Int_t ileg=0; ileg<2; ++ileg) {
+      Int_t first = fEventOffsets[ileg][iev];
+      Int_t last = fEventOffsets[ileg][iev+1];
+      Float_t* legs = fLegs[ileg].GetArray();
+      Long64_t* flags = fFlags[ileg].GetArray();
+      fEventOffsets[ileg][nEvents] = nLegs[ileg];
+      for(Int_t i=first; i<last; ++i) {
+        ULong_t f = ULong_t(flags[i]) & ~mask;
+        if(!f) continue;
+        if(i!=nLegs[ileg]) {
+          for(Int_t iv=0; iv<kNLegVariables; ++iv)
+            legs[nLegs[ileg]*kNLegVariables+iv] = legs[i*kNLegVariables+iv];
+        }
+        flags[nLegs[ileg]] = Long64_t(f);
+        ++nLegs[ileg];
+      }
+      nLegsEvent += nLegs[ileg]-fEventOffsets[ileg][nEvents];
+    }
+    if(nLegsEvent) ++nEvents;      // otherwise the next event overwrites this one
+  }
+  for(Int_t ileg=0; ileg<2; ++ileg) {
+    fNLegs[ileg] = nLegs[ileg];
+    fEventOffsets[ileg][nEvents] = nLegs[ileg];
+  }
+  fNEvents = nEvents;
+}
@@ -0,0 +1,52 @@
+//
+// Event mixing pool
+//
+// Holds the legs of the events of one event category in contiguous arrays:
+// the kinematics (px,py,pz,p,charge) and the cut bit masks of the legs,
+// plus the index of the first leg of each event.
+//
+#ifndef ALIMIXINGPOOL_H
+#define ALIMIXINGPOOL_H
+
+#include <TObject.h>
+#include <TArrayF.h>
+#include <TArrayI.h>
+#include <TArrayL64.h>
+
+class TList;
+
+class AliMixingPool : public TObject {
+
+public:
+  enum LegVariables {
+    kPx=0, kPy, kPz, kP, kCharge,
+    kNLegVariables
+  };
+
+  AliMixingPool();
+  virtual ~AliMixingPool();
+
+  void AddEvent(TList* leg1List, TList* leg2List);
+  void UnsetFlags(ULong_t mask);    // unset the bits and remove the legs and events left without bits
+
+  Int_t GetNEvents() const {return fNEvents;}
+  Int_t GetNLegs(Int_t leg) const {return fNLegs[leg];}
+  Int_t GetFirstLeg(Int_t leg, Int_t event) const {return fEventOffsets[leg][event];}
+  Int_t GetLastLeg(Int_t leg, Int_t event) const {return fEventOffsets[leg][event+1];}   // one after the last leg
+  const Float_t* GetLeg(Int_t leg, Int_t i) const {return fLegs[leg].GetArray()+i*kNLegVariables;}
+  ULong_t GetFlags(Int_t leg, Int_t i) const {return ULong_t(fFlags[leg][i]);}
+
+private:
+  AliMixingPool(const AliMixingPool& pool);
+  AliMixingPool& operator=(const AliMixingPool& pool);
+
+  Int_t fNEvents;               // number of events in the pool
+  Int_t fNLegs[2];              // number of leg1 and leg2 tracks in the pool
+  TArrayF fLegs[2];             //! kinematics of the leg1 and leg2 tracks, kNLegVariables per track
+  TArrayL64 fFlags[2];          //! cut bit masks of the leg1 and leg2 tracks
+  TArrayI fEventOffsets[2];     //! first leg1 and leg2 track of each event, fNEvents+1 entries
+
+  ClassDef(AliMixingPool,1);
+};
+
+#endif
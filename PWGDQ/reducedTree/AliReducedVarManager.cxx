@@ -1580,13 +1580,28 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
   // type - Parameter encoding the resonance type 
   //        This is needed for making a mass assumption on the legs
   //
+  Float_t leg1[5] = {t1->Px(), t1->Py(), t1->Pz(), t1->P(), Float_t(t1->Charge())};
+  Float_t leg2[5] = {t2->Px(), t2->Py(), t2->Pz(), t2->P(), Float_t(t2->Charge())};
+  FillPairInfoME(leg1, leg2, type, values);
+}
+
+
+//_________________________________________________________________
+void AliReducedVarManager::FillPairInfoME(const Float_t* leg1, const Float_t* leg2, Int_t type, Float_t* values) {
+  //
+  // Lightweight fill pair information from the packed kinematics of 2 legs: (px,py,pz,p,charge)
+  // NOTE: Used by the event mixing, which keeps only these variables for the tracks in the pools
+  //       (see AliMixingPool)
+  // type - Parameter encoding the resonance type 
+  //        This is needed for making a mass assumption on the legs
+  //
   PAIR p;
-  p.PxPyPz(t1->Px()+t2->Px(), t1->Py()+t2->Py(), t1->Pz()+t2->Pz());
+  p.PxPyPz(leg1[0]+leg2[0], leg1[1]+leg2[1], leg1[2]+leg2[2]);
   p.CandidateId(type);
     
-  if(t1->Charge()*t2->Charge()<0) p.PairType(1);
-  else if(t1->Charge()>0)         p.PairType(0);
-  else                            p.PairType(2);
+  if(leg1[4]*leg2[4]<0) p.PairType(1);
+  else if(leg1[4]>0)    p.PairType(0);
+  else                  p.PairType(2);
   values[kPairType] = p.PairType();
   values[kCandidateId] = type;
   values[kPairChisquare] = -999.;
@@ -1596,14 +1611,14 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
     
   if(fgUsedVars[kMass]) {     
     values[kMass] = m1*m1+m2*m2 + 
-                    2.0*(TMath::Sqrt(m1*m1+t1->P()*t1->P())*TMath::Sqrt(m2*m2+t2->P()*t2->P()) - 
-                    t1->Px()*t2->Px() - t1->Py()*t2->Py() - t1->Pz()*t2->Pz());
+                    2.0*(TMath::Sqrt(m1*m1+leg1[3]*leg1[3])*TMath::Sqrt(m2*m2+leg2[3]*leg2[3]) - 
+                    leg1[0]*leg2[0] - leg1[1]*leg2[1] - leg1[2]*leg2[2]);
     if(values[kMass]<0.0) {
       cout << "FillPairInfoME(track, track, type, values): Warning: Very small squared mass found. "
            << "   Could be negative due to resolution of Float_t so it will be set to a small positive value." << endl; 
       cout << "   mass2: " << values[kMass] << endl;
-      cout << "p1(p,x,y,z): " << t1->P() << ", " << t1->Px() << ", " << t1->Py() << ", " << t1->Pz() << endl;
-      cout << "p2(p,x,y,z): " << t2->P() << ", " << t2->Px() << ", " << t2->Py() << ", " << t2->Pz() << endl;
+      cout << "p1(p,x,y,z): " << leg1[3] << ", " << leg1[0] << ", " << leg1[1] << ", " << leg1[2] << endl;
+      cout << "p2(p,x,y,z): " << leg2[3] << ", " << leg2[0] << ", " << leg2[1] << ", " << leg2[2] << endl;
       values[kMass] = 0.0;
     }
     else
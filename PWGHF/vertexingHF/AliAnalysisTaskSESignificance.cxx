@@ -29,6 +29,7 @@
 #include <TClonesArray.h>
 #include <TCanvas.h>
 #include <TList.h>
+#include <TObjArray.h>
 #include <TFile.h>
 #include <TString.h>
 #include <TH1F.h>
@@ -88,7 +89,8 @@ AliAnalysisTaskSESignificance::AliAnalysisTaskSESignificance():
   fNVars(0),
   fNBins(100),
   fPartOrAndAntiPart(0),
-  fDsChannel(0)
+  fDsChannel(0),
+  fFillTightestCell(kFALSE)
 {
   // Default constructor
   SetPDGCodes();
@@ -128,7 +130,8 @@ AliAnalysisTaskSESignificance::AliAnalysisTaskSESignificance(const char *name, T
   fNVars(0),
   fNBins(100),
   fPartOrAndAntiPart(0),
-  fDsChannel(0)
+  fDsChannel(0),
+  fFillTightestCell(kFALSE)
 {
 
   SetPDGCodes();
@@ -608,10 +611,16 @@ void AliAnalysisTaskSESignificance::UserExec(Option_t */*option*/)
       TString mdvname=Form("multiDimVectorPtBin%d",ptbin);
       AliMultiDimVector* muvec=(AliMultiDimVector*)fCutList->FindObject(mdvname.Data());
 
-      ULong64_t *addresses = muvec->GetGlobalAddressesAboveCuts(fVars,(Float_t)d->Pt(),nVals);
+      // with fFillTightestCell only the tightest cell passed is filled, the
+      // histograms are integrated over the looser cells in Terminate
+      ULong64_t tightest=0;
+      ULong64_t *addresses = 0x0;
+      if(fFillTightestCell) nVals=muvec->GetTightestCellAddress(fVars,(Float_t)d->Pt(),tightest) ? 1 : 0;
+      else addresses = muvec->GetGlobalAddressesAboveCuts(fVars,(Float_t)d->Pt(),nVals);
+      const ULong64_t *cells = fFillTightestCell ? &tightest : addresses;
       if(fDebug>1)printf("nvals = %d\n",nVals);
       for(Int_t ivals=0;ivals<nVals;ivals++){
-	if(addresses[ivals]>=muvec->GetNTotCells()){
+	if(cells[ivals]>=muvec->GetNTotCells()){
 	  if (fDebug>1) printf("Overflow!!\n");
 	  delete [] addresses;
 	  return;
@@ -622,24 +631,24 @@ void AliAnalysisTaskSESignificance::UserExec(Option_t */*option*/)
 	//fill the histograms with the appropriate method
 	switch (fDecChannel){
 	case 0:
-	  FillDplus(d,arrayMC,(Int_t)(ptbin*nHistpermv+addresses[ivals]),isSelected);
+	  FillDplus(d,arrayMC,(Int_t)(ptbin*nHistpermv+cells[ivals]),isSelected);
 	  break;
 	case 1:
-	  FillD02p(d,arrayMC,(Int_t)(ptbin*nHistpermv+addresses[ivals]),isSelected);
+	  FillD02p(d,arrayMC,(Int_t)(ptbin*nHistpermv+cells[ivals]),isSelected);
 	  break;
 	case 2:
-	  FillDstar(DStarToD0pi,arrayMC,(Int_t)(ptbin*nHistpermv+addresses[ivals]),isSelected);
+	  FillDstar(DStarToD0pi,arrayMC,(Int_t)(ptbin*nHistpermv+cells[ivals]),isSelected);
 	  break;
 	case 3:
 	  if(isSelected&1){
-	    FillDs(d,arrayMC,(Int_t)(ptbin*nHistpermv+addresses[ivals]),isSelected,1);
+	    FillDs(d,arrayMC,(Int_t)(ptbin*nHistpermv+cells[ivals]),isSelected,1);
 	  }
 	  break;
 	case 4:
-	  FillD04p(d,arrayMC,(Int_t)(ptbin*nHistpermv+addresses[ivals]),isSelected);
+	  FillD04p(d,arrayMC,(Int_t)(ptbin*nHistpermv+cells[ivals]),isSelected);
 	  break;
 	case 5:
-	  FillLambdac(d,arrayMC,(Int_t)(ptbin*nHistpermv+addresses[ivals]),isSelected);
+	  FillLambdac(d,arrayMC,(Int_t)(ptbin*nHistpermv+cells[ivals]),isSelected);
 	  break;
 	default:
 	  break;
@@ -652,15 +661,18 @@ void AliAnalysisTaskSESignificance::UserExec(Option_t */*option*/)
 	nVals=0;
 	fRDCuts->GetCutVarsForOpt(d,fVars,fNVars,fPDGdaughters,aod);
 	delete [] addresses;
-	addresses = muvec->GetGlobalAddressesAboveCuts(fVars,(Float_t)d->Pt(),nVals);
+	addresses = 0x0;
+	if(fFillTightestCell) nVals=muvec->GetTightestCellAddress(fVars,(Float_t)d->Pt(),tightest) ? 1 : 0;
+	else addresses = muvec->GetGlobalAddressesAboveCuts(fVars,(Float_t)d->Pt(),nVals);
+	cells = fFillTightestCell ? &tightest : addresses;
 	if(fDebug>1)printf("nvals = %d\n",nVals);
 	for(Int_t ivals=0;ivals<nVals;ivals++){
-	  if(addresses[ivals]>=muvec->GetNTotCells()){
+	  if(cells[ivals]>=muvec->GetNTotCells()){
 	    if (fDebug>1) printf("Overflow!!\n");
 	    delete [] addresses;	    
 	    return;
 	  }
-	  FillDs(d,arrayMC,(Int_t)(ptbin*nHistpermv+addresses[ivals]),isSelected,0);	  
+	  FillDs(d,arrayMC,(Int_t)(ptbin*nHistpermv+cells[ivals]),isSelected,0);	  
 	  
 	}
 
@@ -980,6 +992,14 @@ void AliAnalysisTaskSESignificance::Terminate(Option_t */*option*/)
     fCutList->ls();
     return;
   }
+  if(fFillTightestCell){
+    IntegrateCellHistos("hMass");
+    if(fReadMC){
+      IntegrateCellHistos("hSig");
+      IntegrateCellHistos("hBkg");
+      if(fDecChannel != AliAnalysisTaskSESignificance::kDplustoKpipi) IntegrateCellHistos("hRfl");
+    }
+  }
   Int_t nHist=mdvtmp->GetNTotCells();
   TCanvas *c1=new TCanvas("c1","Invariant mass distribution - loose cuts",500,500);
   Bool_t drawn=kFALSE;
@@ -1016,6 +1036,31 @@ void AliAnalysisTaskSESignificance::Terminate(Option_t */*option*/)
   
   return;
 }
+//________________________________________________________________________
+void AliAnalysisTaskSESignificance::IntegrateCellHistos(const char *prefix)
+{
+  // Adds to the histogram of each cell the histograms of the tighter cells,
+  // as done by AliMultiDimVector::Integrate: one cumulative pass per cut variable.
+  // To be called once, on the merged output of a run with fFillTightestCell
+
+  for(Int_t iPtBin=0;iPtBin<fNPtBins;iPtBin++){
+    AliMultiDimVector* muvec=(AliMultiDimVector*)fCutList->FindObject(Form("multiDimVectorPtBin%d",iPtBin));
+    if(!muvec) continue;
+    Int_t nHistpermv=muvec->GetNTotCells();
+    TObjArray hists(nHistpermv);
+    for(Int_t i=0;i<nHistpermv;i++) hists.AddAt(fOutput->FindObject(Form("%s_%d",prefix,iPtBin*nHistpermv+i)),i);
+    for(Int_t iv=0;iv<muvec->GetNVariables();iv++){
+      ULong64_t stride=muvec->GetAddressStride(iv);
+      ULong64_t nSteps=muvec->GetNCutSteps(iv);
+      for(ULong64_t i=nHistpermv;i-->0;){
+	if((i/stride)%nSteps==nSteps-1) continue;
+	TH1F* h=(TH1F*)hists.UncheckedAt(i);
+	TH1F* hTighter=(TH1F*)hists.UncheckedAt(i+stride);
+	if(h && hTighter) h->Add(hTighter);
+      }
+    }
+  }
+}
 //_________________________________________________________________________________________________
 Int_t AliAnalysisTaskSESignificance::CheckOrigin(const AliAODMCParticle* mcPart, const TClonesArray* mcArray)const{
 
@@ -541,15 +541,40 @@ void  AliMultiDimVector::GetFillRange(Int_t iVar, Int_t iCell, Int_t& minbin, In
 }
 //_____________________________________________________________________________ 
 void AliMultiDimVector::Integrate(){
-  // integrates the matrix
+  // integrates the matrix: the content of each cell becomes the sum over
+  // the cells with tighter or equal cuts (same result as CountsAboveCell),
+  // obtained with one cumulative pass per variable
   if(fIsIntegrated){
     AliError("MultiDimVector already integrated");
     return;
   }
-  TArrayF integral(fNTotCells);
-  for(ULong64_t i=0;i<fNTotCells;i++) integral[i]=CountsAboveCell(i);
-  for(ULong64_t i=0;i<fNTotCells;i++) fVett[i]= integral[i];
+  for(Int_t iv=0;iv<fNVariables;iv++){
+    ULong64_t stride=GetAddressStride(iv);
+    ULong64_t nSteps=fNCutSteps[iv];
+    // descending addresses: cell+stride is already cumulated when cell is reached
+    for(ULong64_t i=fNTotCells;i-->0;){
+      if((i/stride)%nSteps<nSteps-1) fVett[i]+=fVett[i+stride];
+    }
+  }
   fIsIntegrated=kTRUE;
+}
+//_____________________________________________________________________________ 
+ULong64_t AliMultiDimVector::GetAddressStride(Int_t iVar) const{
+  // distance between the global addresses of two consecutive cells of variable iVar
+  ULong64_t stride=fNPtBins;
+  for(Int_t j=iVar+1;j<fNVariables;j++) stride*=fNCutSteps[j];
+  return stride;
+}
+//_____________________________________________________________________________ 
+Bool_t AliMultiDimVector::GetTightestCellAddress(const Float_t *values, Float_t pt, ULong64_t& globadd) const{
+  // global address of the tightest cell passed by values, i.e. the only cell
+  // to be filled before calling Integrate(); kFALSE if the loosest cuts are not passed
+  Int_t ptbin=GetPtBin(pt);
+  if(ptbin<0) return kFALSE;
+  Int_t ind[fgkMaxNVariables];
+  if(!GetIndicesFromValues(values,ind)) return kFALSE;
+  globadd=GetGlobalAddressFromIndices(ind,ptbin);
+  return kTRUE;
 }//_____________________________________________________________________________ 
 ULong64_t* AliMultiDimVector::GetGlobalAddressesAboveCuts(const Float_t *values, Int_t ptbin, Int_t& nVals) const{
   // fills an array with global addresses of cells passing the cuts
@@ -70,6 +70,8 @@ class AliMultiDimVector :  public TNamed{
   ULong64_t GetGlobalAddressFromIndices(const Int_t *ind, Int_t ptbin) const;
   Bool_t    GetIndicesFromValues(const Float_t *values, Int_t *ind) const;
   ULong64_t GetGlobalAddressFromValues(const Float_t *values, Int_t ptbin) const;
+  Bool_t    GetTightestCellAddress(const Float_t *values, Float_t pt, ULong64_t& globadd) const;
+  ULong64_t GetAddressStride(Int_t iVar) const;
   Bool_t    GetCutValuesFromGlobalAddress(ULong64_t globadd, Float_t *cuts, Int_t &ptbin) const;
   
   ULong64_t* GetGlobalAddressesAboveCuts(const Float_t *values, Float_t pt, Int_t& nVals) const{
@@ -45,6 +45,15 @@
 ClassImp(AliNormalizationCounter);
 /// \endcond
 
+namespace {
+  // keywords of the Event rubric, same order as AliNormalizationCounter::EEventKeys
+  const char* kEventKeyNames[] = {"triggered","V0AND","PileUp","PbPbC0SMH-B-NOPF-ALLNOTRD","Candles0.3","PrimaryV","countForNorm",
+				  "noPrimaryV","zvtxGT10","!V0A&Candle03","!V0A&PrimaryV","Candid(Filter)","Candid(Analysis)",
+				  "NCandid(Filter)","NCandid(Analysis)"};
+  // multiplicity values counted in the buffer, the others are counted directly in the collection
+  const Int_t kMaxBufferedMultiplicity=5000;
+}
+
 //____________________________________________
 AliNormalizationCounter::AliNormalizationCounter(): 
 TNamed(),
@@ -57,7 +66,9 @@ fSpherocitySteps(100.),
 fHistTrackFilterEvMult(0),
 fHistTrackAnaEvMult(0),
 fHistTrackFilterSpdMult(0),
-fHistTrackAnaSpdMult(0)
+fHistTrackAnaSpdMult(0),
+fBufferRun(-1),
+fBuffer()
 {
   // empty constructor
 }
@@ -74,7 +85,9 @@ fSpherocitySteps(100.),
 fHistTrackFilterEvMult(0),
 fHistTrackAnaEvMult(0),
 fHistTrackFilterSpdMult(0),
-fHistTrackAnaSpdMult(0)
+fHistTrackAnaSpdMult(0),
+fBufferRun(-1),
+fBuffer()
 {
   ;
 }
@@ -148,7 +161,9 @@ Long64_t AliNormalizationCounter::Merge(TCollection* list){
 }
 //_______________________________________
 void AliNormalizationCounter::Add(const AliNormalizationCounter *norm){
+  FlushCounts();
   fCounters.Add(&(norm->fCounters));
+  norm->CountBuffer(fCounters);
   fHistTrackFilterEvMult->Add(norm->fHistTrackFilterEvMult);
   fHistTrackAnaEvMult->Add(norm->fHistTrackAnaEvMult);
   fHistTrackFilterSpdMult->Add(norm->fHistTrackFilterSpdMult);
@@ -186,7 +201,7 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
   //event must be either physics or MC
   if(!(event->GetEventType() == 7||event->GetEventType() == 0))return;
   
-  FillCounters("triggered",runNumber,multiplicity,spherocity);
+  FillCounters(kTriggered,runNumber,multiplicity,spherocity);
 
   //Find V0AND
   AliTriggerAnalysis trAn; /// Trigger Analysis
@@ -197,7 +212,7 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
     v0B = trAn.IsOfflineTriggerFired(eventESD , AliTriggerAnalysis::kV0C);
     v0A = trAn.IsOfflineTriggerFired(eventESD , AliTriggerAnalysis::kV0A);
   }
-  if(v0A&&v0B) FillCounters("V0AND",runNumber,multiplicity,spherocity);
+  if(v0A&&v0B) FillCounters(kV0AND,runNumber,multiplicity,spherocity);
   
   //FindPrimary vertex  
   // AliVVertex *vtrc =  (AliVVertex*)event->GetPrimaryVertex();
@@ -210,30 +225,30 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
   AliAODEvent *eventAOD = (AliAODEvent*)event;
   TString trigclass=eventAOD->GetFiredTriggerClasses();
   if(trigclass.Contains("C0SMH-B-NOPF-ALLNOTRD")||trigclass.Contains("C0SMH-B-NOPF-ALL")){
-    FillCounters("PbPbC0SMH-B-NOPF-ALLNOTRD",runNumber,multiplicity,spherocity);
+    FillCounters(kPbPbC0SMH,runNumber,multiplicity,spherocity);
   }
 
   //FindPrimary vertex  
   if(isEventSelected){
-    FillCounters("PrimaryV",runNumber,multiplicity,spherocity);
+    FillCounters(kPrimaryV,runNumber,multiplicity,spherocity);
     flagPV=kTRUE;
   }else{
     if(rdCut->GetWhyRejection()==0){
-      FillCounters("noPrimaryV",runNumber,multiplicity,spherocity);
+      FillCounters(kNoPrimaryV,runNumber,multiplicity,spherocity);
     }
     //find good vtx outside range
     if(rdCut->GetWhyRejection()==6){
-      FillCounters("zvtxGT10",runNumber,multiplicity,spherocity);
-      FillCounters("PrimaryV",runNumber,multiplicity,spherocity);
+      FillCounters(kZvtxGT10,runNumber,multiplicity,spherocity);
+      FillCounters(kPrimaryV,runNumber,multiplicity,spherocity);
       flagPV=kTRUE;
     }
     if(rdCut->GetWhyRejection()==1){
-      FillCounters("PileUp",runNumber,multiplicity,spherocity);
+      FillCounters(kPileUp,runNumber,multiplicity,spherocity);
     }
   }
   //to be counted for normalization
   if(rdCut->CountEventForNormalization()){
-    FillCounters("countForNorm",runNumber,multiplicity,spherocity);
+    FillCounters(kCountForNorm,runNumber,multiplicity,spherocity);
   }
 
 
@@ -242,17 +257,17 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
   for(Int_t i=0;i<trkEntries&&!flag03;i++){
     AliAODTrack *track=(AliAODTrack*)event->GetTrack(i);
     if((track->Pt()>0.3)&&(!flag03)){
-      FillCounters("Candles0.3",runNumber,multiplicity,spherocity);
+      FillCounters(kCandles03,runNumber,multiplicity,spherocity);
       flag03=kTRUE;
       break;
     }
   }
   
   if(!(v0A&&v0B)&&(flag03)){ 
-    FillCounters("!V0A&Candle03",runNumber,multiplicity,spherocity);
+    FillCounters(kNoV0ACandle03,runNumber,multiplicity,spherocity);
   }
   if(!(v0A&&v0B)&&flagPV){
-    FillCounters("!V0A&PrimaryV",runNumber,multiplicity,spherocity);
+    FillCounters(kNoV0APrimaryV,runNumber,multiplicity,spherocity);
   }
   
   return;
@@ -277,37 +292,22 @@ void AliNormalizationCounter::StoreCandidates(AliVEvent *event,Int_t nCand,Bool_
   if(flagFilter)fHistTrackFilterSpdMult->Fill(nSPD,nCand);
   else fHistTrackAnaSpdMult->Fill(nSPD,nCand);
   
-  Int_t runNumber = event->GetRunNumber();
-  Int_t multiplicity = Multiplicity(event);
   if(nCand==0)return;
+  Int_t runNumber = event->GetRunNumber();
+  Int_t multiplicity = fMultiplicity ? Multiplicity(event) : 0;
   if(flagFilter){
-    if(fMultiplicity) 
-      fCounters.Count(Form("Event:Candid(Filter)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-    else 
-      fCounters.Count(Form("Event:Candid(Filter)/Run:%d",runNumber));
-    for(Int_t i=0;i<nCand;i++){ 
-      if(fMultiplicity) 
-	fCounters.Count(Form("Event:NCandid(Filter)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-      else 
-	fCounters.Count(Form("Event:NCandid(Filter)/Run:%d",runNumber));
-    }
+    FillCounters(kCandidFilter,runNumber,multiplicity,0.);
+    FillCounters(kNCandidFilter,runNumber,multiplicity,0.,nCand);
   }else{
-    if(fMultiplicity) 
-      fCounters.Count(Form("Event:Candid(Analysis)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-    else
-      fCounters.Count(Form("Event:Candid(Analysis)/Run:%d",runNumber));
-    for(Int_t i=0;i<nCand;i++){ 
-      if(fMultiplicity) 
-	fCounters.Count(Form("Event:NCandid(Analysis)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-      else
-	fCounters.Count(Form("Event:NCandid(Analysis)/Run:%d",runNumber));
-    }
+    FillCounters(kCandidAnalysis,runNumber,multiplicity,0.);
+    FillCounters(kNCandidAnalysis,runNumber,multiplicity,0.,nCand);
   }
   return;
 }
 //_______________________________________________________________________
 TH1D* AliNormalizationCounter::DrawAgainstRuns(TString candle,Bool_t drawHist){
   //
+  FlushCounts();
   fCounters.SortRubric("Run");
   TString selection;
   selection.Form("event:%s",candle.Data());
@@ -337,10 +337,12 @@ TH1D* AliNormalizationCounter::DrawRatio(TString candle1,TString candle2){
 }
 //___________________________________________________________________________
 void AliNormalizationCounter::PrintRubrics(){
+  FlushCounts();
   fCounters.PrintKeyWords();
 }
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetSum(TString candle){
+  FlushCounts();
   TString selection="event:";
   selection.Append(candle);
   return fCounters.GetSum(selection.Data());
@@ -372,6 +374,7 @@ Double_t AliNormalizationCounter::GetNEventsForNorm(){
 }
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t runnumber){
+  FlushCounts();
   TString listofruns = fCounters.GetKeyWords("RUN");
   if(!listofruns.Contains(Form("%d",runnumber))){
     printf("WARNING: %d is not a valid run number\n",runnumber);
@@ -390,6 +393,8 @@ Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t runnumber){
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t minmultiplicity, Int_t maxmultiplicity){
 
+  FlushCounts();
+
   if(!fMultiplicity) {
     AliInfo("Sorry, you didn't activate the multiplicity in the counter!");
     return 0.;
@@ -421,6 +426,8 @@ Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t minmultiplicity, Int_t
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t minmultiplicity, Int_t maxmultiplicity, Double_t minspherocity, Double_t maxspherocity){
 
+  FlushCounts();
+
   if(!fMultiplicity || !fSpherocity) {
     AliInfo("You must activate both multiplicity and spherocity in the counters to use this method!");
     return 0.;
@@ -462,6 +469,8 @@ Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t minmultiplicity, Int_t
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetNEventsForNormSpheroOnly(Double_t minspherocity, Double_t maxspherocity){
 
+  FlushCounts();
+
   if(!fSpherocity) {
     AliInfo("Sorry, you didn't activate the sphericity in the counter!");
     return 0.;
@@ -497,6 +506,7 @@ Double_t AliNormalizationCounter::GetNEventsForNormSpheroOnly(Double_t minsphero
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetSum(TString candle,Int_t minmultiplicity, Int_t maxmultiplicity){
   // counts events of given type in a given multiplicity range
+  FlushCounts();
 
   if(!fMultiplicity) {
     AliInfo("Sorry, you didn't activate the multiplicity in the counter!");
@@ -521,6 +531,7 @@ Double_t AliNormalizationCounter::GetSum(TString candle,Int_t minmultiplicity, I
 //___________________________________________________________________________
 TH1D* AliNormalizationCounter::DrawNEventsForNorm(Bool_t drawRatio){
   //usare algebra histos
+  FlushCounts();
   fCounters.SortRubric("Run");
   TString selection;
 
@@ -575,17 +586,59 @@ Int_t AliNormalizationCounter::Multiplicity(AliVEvent* event){
 }
 
 //___________________________________________________________________________
-void AliNormalizationCounter::FillCounters(TString name, Int_t runNumber, Int_t multiplicity, Double_t spherocity){
-
-
-  Int_t sphToInteger=spherocity*fSpherocitySteps;
-  if(fMultiplicity  && !fSpherocity) 
-    fCounters.Count(Form("Event:%s/Run:%d/Multiplicity:%d",name.Data(),runNumber,multiplicity));
-  else if(fMultiplicity  && fSpherocity) 
-    fCounters.Count(Form("Event:%s/Run:%d/Multiplicity:%d/Spherocity:%d",name.Data(),runNumber,multiplicity,sphToInteger));
-  else if(!fMultiplicity  && fSpherocity) 
-    fCounters.Count(Form("Event:%s/Run:%d/Spherocity:%d",name.Data(),runNumber,sphToInteger));
-  else 
-    fCounters.Count(Form("Event:%s/Run:%d",name.Data(),runNumber));
+void AliNormalizationCounter::FillCounters(Int_t key, Int_t runNumber, Int_t multiplicity, Double_t spherocity, Int_t value){
+  // counts value events of type key: the counts of the current run are summed in
+  // fBuffer and moved to fCounters when the run changes (see FlushCounts).
+  // The candidate keys are counted without spherocity
+
+  Bool_t withSph = fSpherocity && key<kCandidFilter;
+  Int_t nSph = fSpherocity ? (Int_t)fSpherocitySteps+1 : 1;
+  Int_t iMult = fMultiplicity ? multiplicity : 0;
+  Int_t iSph = withSph ? (Int_t)(spherocity*fSpherocitySteps) : 0;
+  if(iMult<0 || iMult>=kMaxBufferedMultiplicity || iSph<0 || iSph>=nSph){
+    fCounters.Count(CounterKey(key,runNumber,iMult,iSph),value);
+    return;
+  }
+  if(runNumber!=fBufferRun){
+    FlushCounts();
+    fBufferRun=runNumber;
+  }
+  Int_t index=(iMult*nSph+iSph)*kNEventKeys+key;
+  if(index>=fBuffer.GetSize()) fBuffer.Set(TMath::Max(2*fBuffer.GetSize(),(iMult+1)*nSph*kNEventKeys));
+  fBuffer[index]+=value;
   return;
 }
+
+//___________________________________________________________________________
+TString AliNormalizationCounter::CounterKey(Int_t key, Int_t runNumber, Int_t multiplicity, Int_t sphToInteger) const{
+  // key of the counter collection for the given Event keyword, run, multiplicity and spherocity
+
+  Bool_t withSph = fSpherocity && key<kCandidFilter;
+  TString name;
+  name.Form("Event:%s/Run:%d",kEventKeyNames[key],runNumber);
+  if(fMultiplicity) name+=Form("/Multiplicity:%d",multiplicity);
+  if(withSph) name+=Form("/Spherocity:%d",sphToInteger);
+  return name;
+}
+
+//___________________________________________________________________________
+void AliNormalizationCounter::CountBuffer(AliCounterCollection &counters) const{
+  // adds the buffered counts to counters, one Count per filled cell
+
+  Int_t nSph = fSpherocity ? (Int_t)fSpherocitySteps+1 : 1;
+  const Int_t *buffer = fBuffer.GetArray();
+  for(Int_t i=0;i<fBuffer.GetSize();i++){
+    if(!buffer[i]) continue;
+    Int_t key = i%kNEventKeys;
+    Int_t iSph = (i/kNEventKeys)%nSph;
+    Int_t iMult = i/(kNEventKeys*nSph);
+    counters.Count(CounterKey(key,fBufferRun,iMult,iSph),buffer[i]);
+  }
+}
+
+//___________________________________________________________________________
+void AliNormalizationCounter::FlushCounts(){
+  // moves the buffered counts to fCounters, to be done before any access to fCounters
+  CountBuffer(fCounters);
+  fBuffer.Reset();
+}
@@ -33,6 +33,7 @@
 #include <TH1F.h>
 #include <TH2F.h>
 #include <TH1D.h>
+#include <TArrayI.h>
 #include <AliESDEvent.h>
 #include <AliESDtrack.h>
 #include <AliAODTrack.h>
@@ -54,7 +55,7 @@ class AliNormalizationCounter : public TNamed
   virtual ~AliNormalizationCounter();
   Long64_t Merge(TCollection* list);
 
-  AliCounterCollection* GetCounter(){return &fCounters;}
+  AliCounterCollection* GetCounter(){FlushCounts(); return &fCounters;}
   void Init();
   void Add(const AliNormalizationCounter*);
   void SetESD(Bool_t flag){fESD=flag;}
@@ -82,8 +83,15 @@ class AliNormalizationCounter : public TNamed
  private:
   AliNormalizationCounter(const AliNormalizationCounter &source);
   AliNormalizationCounter& operator=(const AliNormalizationCounter& source);
+  /// keywords of the Event rubric, in the order given in Init
+  enum EEventKeys {kTriggered, kV0AND, kPileUp, kPbPbC0SMH, kCandles03, kPrimaryV, kCountForNorm,
+		   kNoPrimaryV, kZvtxGT10, kNoV0ACandle03, kNoV0APrimaryV, kCandidFilter, kCandidAnalysis,
+		   kNCandidFilter, kNCandidAnalysis, kNEventKeys};
   Int_t Multiplicity(AliVEvent* event);
-  void FillCounters(TString name, Int_t runNumber, Int_t multiplicity, Double_t spherocity);
+  void FillCounters(Int_t key, Int_t runNumber, Int_t multiplicity, Double_t spherocity, Int_t value=1);
+  TString CounterKey(Int_t key, Int_t runNumber, Int_t multiplicity, Int_t sphToInteger) const;
+  void CountBuffer(AliCounterCollection &counters) const;
+  void FlushCounts();
 
 
   AliCounterCollection fCounters; /// internal counter
@@ -96,9 +104,11 @@ class AliNormalizationCounter : public TNamed
   TH2F *fHistTrackAnaEvMult;/// hist to store no of analysis candidates vs no of tracks in the event
   TH2F *fHistTrackFilterSpdMult; /// hist to store no of filter candidates vs  SPD multiplicity
   TH2F *fHistTrackAnaSpdMult;/// hist to store no of analysis candidates vs SPD multiplicity 
+  Int_t fBufferRun;          /// run of the counts in fBuffer
+  TArrayI fBuffer;           /// counts of run fBufferRun not yet moved to fCounters, indexed by (multiplicity,spherocity,Event key)
 
   /// \cond CLASSIMP    
-  ClassDef(AliNormalizationCounter,7);
+  ClassDef(AliNormalizationCounter,8);
   /// \endcond
 };
 #endif
@@ -13,6 +13,7 @@
 
 #include "AliAnalysisManager.h"
 #include "AliEmcalJet.h"
+#include "AliJetContainer.h"
 #include "AliLog.h"
 #include "AliRhoParameter.h"
 
@@ -21,7 +22,10 @@ ClassImp(AliAnalysisTaskRho)
 //________________________________________________________________________
 AliAnalysisTaskRho::AliAnalysisTaskRho() : 
   AliAnalysisTaskRhoBase("AliAnalysisTaskRho"),
-  fNExclLeadJets(0)
+  fNExclLeadJets(0),
+  fRhoEstimator(0),
+  fOwnRhoEstimator(kFALSE),
+  fRhoSelection(-1)
 {
   // Constructor.
 }
@@ -29,11 +33,40 @@ AliAnalysisTaskRho::AliAnalysisTaskRho() :
 //________________________________________________________________________
 AliAnalysisTaskRho::AliAnalysisTaskRho(const char *name, Bool_t histo) :
   AliAnalysisTaskRhoBase(name, histo),
-  fNExclLeadJets(0)
+  fNExclLeadJets(0),
+  fRhoEstimator(0),
+  fOwnRhoEstimator(kFALSE),
+  fRhoSelection(-1)
 {
   // Constructor.
 }
 
+//________________________________________________________________________
+AliAnalysisTaskRho::~AliAnalysisTaskRho()
+{
+  // Destructor.
+
+  if (fOwnRhoEstimator) delete fRhoEstimator;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskRho::ExecOnce()
+{
+  // Init the analysis.
+
+  AliAnalysisTaskRhoBase::ExecOnce();
+
+  // The kt jets are scanned once per event by an estimator shared with
+  // the rho tasks using the same jet container
+  if (fOwnRhoEstimator) delete fRhoEstimator;
+  fRhoEstimator = AliRhoEstimator::Request(GetSharedObjects(), GetJetContainer(0));
+  fOwnRhoEstimator = kFALSE;
+  if (!fRhoEstimator) {
+    fRhoEstimator = new AliRhoEstimator(GetName());
+    fOwnRhoEstimator = kTRUE;
+  }
+  fRhoSelection = fRhoEstimator->AddSelection(0, fNExclLeadJets);
+}
 
 //________________________________________________________________________
 Bool_t AliAnalysisTaskRho::Run() 
@@ -47,65 +80,12 @@ Bool_t AliAnalysisTaskRho::Run()
   if (!fJets)
     return kFALSE;
 
-  const Int_t Njets   = fJets->GetEntries();
-
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
-
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
-      if (!jet) {
-	AliError(Form("%s: Could not receive jet %d", GetName(), ij));
-	continue;
-      } 
-
-      if (!AcceptJet(jet))
-        continue;
-
-      if (jet->Pt() > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jet->Pt();
-	maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-	maxJetPts[1] = jet->Pt();
-	maxJetIds[1] = ij;
-      }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
-  }
-
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
-
-  // push all jets within selected acceptance into stack
-  for (Int_t iJets = 0; iJets < Njets; ++iJets) {
-
-    // exlcuding lead jets
-    if (iJets == maxJetIds[0] || iJets == maxJetIds[1])
-      continue;
-
-    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
-    if (!jet) {
-      AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
-      continue;
-    } 
-
-    if (!AcceptJet(jet))
-      continue;
-
-    rhovec[NjetAcc] = jet->Pt() / jet->Area();
-    ++NjetAcc;
-  }
-
+  // the leading jets are found and excluded by the estimator
+  fRhoEstimator->Process(GetJetContainer(0), fVertex);
 
-  if (NjetAcc > 0) {
+  if (fRhoEstimator->GetNJets(fRhoSelection) > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = fRhoEstimator->GetRho(fRhoSelection);
     fOutRho->SetVal(rho);
 
     if (fOutRhoScaled) {
@@ -4,24 +4,30 @@
 // $Id$
 
 #include "AliAnalysisTaskRhoBase.h"
+#include "AliRhoEstimator.h"
 
 class AliAnalysisTaskRho : public AliAnalysisTaskRhoBase {
 
  public:
   AliAnalysisTaskRho();
   AliAnalysisTaskRho(const char *name, Bool_t histo=kFALSE);
-  virtual ~AliAnalysisTaskRho() {}
+  virtual ~AliAnalysisTaskRho();
 
   void             SetExcludeLeadJets(UInt_t n)    { fNExclLeadJets = n    ; }
 
  protected:
+  void             ExecOnce();
   Bool_t           Run();
 
   UInt_t           fNExclLeadJets;                 // number of leading jets to be excluded from the median calculation
 
+  AliRhoEstimator *fRhoEstimator;                  //!estimator shared with the rho tasks using the same jets
+  Bool_t           fOwnRhoEstimator;               //!whether the estimator is owned by this task
+  Int_t            fRhoSelection;                  //!selection of the jets in the estimator
+
   AliAnalysisTaskRho(const AliAnalysisTaskRho&);             // not implemented
   AliAnalysisTaskRho& operator=(const AliAnalysisTaskRho&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRho, 10); // Rho task
+  ClassDef(AliAnalysisTaskRho, 12); // Rho task
 };
 #endif
@@ -24,7 +24,8 @@ AliAnalysisTaskRhoAverage::AliAnalysisTaskRhoAverage() :
   fRhoType(0),
   fNExclLeadPart(0),
   fUseMedian(kFALSE),
-  fTotalArea(1)
+  fTotalArea(1),
+  fRhoValues()
 {
   // Default constructor.
 }
@@ -35,7 +36,8 @@ AliAnalysisTaskRhoAverage::AliAnalysisTaskRhoAverage(const char *name, Bool_t hi
   fRhoType(0),
   fNExclLeadPart(0),
   fUseMedian(kFALSE),
-  fTotalArea(1)
+  fTotalArea(1),
+  fRhoValues()
 {
   // Constructor.
 }
@@ -45,8 +47,6 @@ Bool_t AliAnalysisTaskRhoAverage::Run()
 {
   // Run the analysis.
 
-  const Int_t NMAX = 9999;
-  static Double_t rhovec[NMAX];
   Int_t NpartAcc = 0;
 
   Int_t   maxPartIds[] = {0, 0};
@@ -108,13 +108,14 @@ Bool_t AliAnalysisTaskRhoAverage::Run()
   if (tracks && (fRhoType == 0 || fRhoType == 1)) {
     AliVParticle *track = 0;
     tracks->ResetCurrentID();
-    while ((track = tracks->GetNextAcceptParticle()) && NpartAcc < NMAX) {
+    while ((track = tracks->GetNextAcceptParticle())) {
 
       // exlcuding lead particles
       if (tracks->GetCurrentID() == maxPartIds[0]-1 || tracks->GetCurrentID() == maxPartIds[1]-1)
         continue;
 
-      rhovec[NpartAcc] = track->Pt();
+      if (fRhoValues.GetSize() <= NpartAcc) fRhoValues.Set(2 * NpartAcc + 128);
+      fRhoValues[NpartAcc] = track->Pt();
       ++NpartAcc;
     }
   }
@@ -123,7 +124,7 @@ Bool_t AliAnalysisTaskRhoAverage::Run()
 
     AliVCluster *cluster = 0;
     clusters->ResetCurrentID();
-    while ((cluster = clusters->GetNextAcceptCluster()) && NpartAcc < NMAX) {
+    while ((cluster = clusters->GetNextAcceptCluster())) {
       // exlcuding lead particles
       if (clusters->GetCurrentID() == -maxPartIds[0]-1 || clusters->GetCurrentID() == -maxPartIds[1]-1)
         continue;
@@ -131,22 +132,19 @@ Bool_t AliAnalysisTaskRhoAverage::Run()
       TLorentzVector nPart;
       clusters->GetMomentum(nPart, clusters->GetCurrentID());
 
-      rhovec[NpartAcc] = nPart.Pt();
+      if (fRhoValues.GetSize() <= NpartAcc) fRhoValues.Set(2 * NpartAcc + 128);
+      fRhoValues[NpartAcc] = nPart.Pt();
       ++NpartAcc;
     }
   }
 
-  if (NpartAcc == NMAX) {
-    AliError(Form("%s: NpartAcc >= %d", GetName(), NMAX));
-  }
-
   Double_t rho = 0;
 
   if (NpartAcc > 0) {
     if (fUseMedian)
-      rho = TMath::Median(NpartAcc, rhovec);
+      rho = AliRhoEstimator::Median(NpartAcc, fRhoValues.GetArray());
     else
-      rho = TMath::Mean(NpartAcc, rhovec);
+      rho = AliRhoEstimator::Mean(NpartAcc, fRhoValues.GetArray());
 
     rho *= NpartAcc / fTotalArea;
   }
@@ -39,6 +39,7 @@ AliAnalysisTaskRhoDev::AliAnalysisTaskRhoDev() :
   fRhoSparse(kFALSE),
   fExclJetOverlap(),
   fOccupancyFactor(0),
+  fRhoValues(),
   fHistOccCorrvsCent(nullptr)
 {
 }
@@ -55,6 +56,7 @@ AliAnalysisTaskRhoDev::AliAnalysisTaskRhoDev(const char *name, Bool_t histo) :
   fRhoSparse(kFALSE),
   fExclJetOverlap(),
   fOccupancyFactor(0),
+  fRhoValues(),
   fHistOccCorrvsCent(nullptr)
 {
 }
@@ -104,7 +106,6 @@ void AliAnalysisTaskRhoDev::CalculateRho()
 
   auto maxJets = GetLeadingJets();
 
-  static Double_t rhovec[999];
   Int_t NjetAcc = 0;
   Double_t TotaljetArea = 0; // Total area of background jets (including ghost jets)
   Double_t TotaljetAreaPhys = 0; // Total area of physical background jets (excluding ghost jets)
@@ -141,7 +142,8 @@ void AliAnalysisTaskRhoDev::CalculateRho()
 
     if (overlapsWithSignal) continue;
 
-    rhovec[NjetAcc] = jet->Pt() / jet->Area();
+    if (fRhoValues.GetSize() <= NjetAcc) fRhoValues.Set(2 * NjetAcc + 128);
+    fRhoValues[NjetAcc] = jet->Pt() / jet->Area();
     ++NjetAcc;
   }
 
@@ -155,7 +157,7 @@ void AliAnalysisTaskRhoDev::CalculateRho()
 
   if (NjetAcc > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = AliRhoEstimator::Median(NjetAcc, fRhoValues.GetArray());
 
     if (fRhoSparse) rho = rho * fOccupancyFactor;
 
@@ -17,7 +17,10 @@
 
 #include <utility>
 
+#include <TArrayD.h>
+
 #include "AliAnalysisTaskRhoBaseDev.h"
+#include "AliRhoEstimator.h"
 
 /** \class AliAnalysisTaskRhoDev
  * \brief Class for a task that calculates the UE
@@ -71,13 +74,14 @@ class AliAnalysisTaskRhoDev : public AliAnalysisTaskRhoBaseDev {
   TString          fExclJetOverlap;                ///< name of the jet collection that should be used to reject jets that are considered "signal"
 
   Double_t         fOccupancyFactor;               //!<!occupancy correction factor for sparse events
+  TArrayD          fRhoValues;                     //!<!pt densities of the jets entering the median
   TH2F            *fHistOccCorrvsCent;             //!<!occupancy correction vs. centrality
 
   AliAnalysisTaskRhoDev(const AliAnalysisTaskRhoDev&);             // not implemented
   AliAnalysisTaskRhoDev& operator=(const AliAnalysisTaskRhoDev&);  // not implemented
   
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskRhoDev, 2);
+  ClassDef(AliAnalysisTaskRhoDev, 3);
   /// \endcond
 };
 #endif
@@ -4,13 +4,14 @@
 // $Id$
 
 #include "AliAnalysisTaskRhoMassBase.h"
+#include "AliRhoEstimator.h"
 
 class AliAnalysisTaskRhoMass : public AliAnalysisTaskRhoMassBase {
 
  public:
   AliAnalysisTaskRhoMass();
   AliAnalysisTaskRhoMass(const char *name, Bool_t histo=kFALSE);
-  virtual ~AliAnalysisTaskRhoMass() {}
+  virtual ~AliAnalysisTaskRhoMass();
 
   enum JetRhoMassType {
     kMd     = 0,            //rho_m from arXiv:1211.2811
@@ -25,6 +26,7 @@ class AliAnalysisTaskRhoMass : public AliAnalysisTaskRhoMassBase {
   void             SetPionMassForClusters(Bool_t b) { fPionMassClusters = b ; }
 
  protected:
+  void             ExecOnce();
   Bool_t           Run();
 
   Double_t         GetSumMConstituents(AliEmcalJet *jet);
@@ -35,11 +37,14 @@ class AliAnalysisTaskRhoMass : public AliAnalysisTaskRhoMassBase {
   JetRhoMassType   fJetRhoMassType;                // method for rho_m calculation
   Bool_t           fPionMassClusters;              // assume pion mass for clusters
 
+  AliRhoEstimator *fRhoEstimator;                  //!estimator shared with the rho tasks using the same jets
+  Bool_t           fOwnRhoEstimator;               //!whether the estimator is owned by this task
+  Int_t            fRhoSelection;                  //!selection of the jets in the estimator
   TH2F            *fHistMdAreavsCent;              //! Md/Area vs cent for all kt clusters
 
   AliAnalysisTaskRhoMass(const AliAnalysisTaskRhoMass&);             // not implemented
   AliAnalysisTaskRhoMass& operator=(const AliAnalysisTaskRhoMass&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoMass, 2); // Rho_m task
+  ClassDef(AliAnalysisTaskRhoMass, 4); // Rho_m task
 };
 #endif
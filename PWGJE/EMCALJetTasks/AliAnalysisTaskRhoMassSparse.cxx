@@ -23,9 +23,14 @@ ClassImp(AliAnalysisTaskRhoMassSparse)
 AliAnalysisTaskRhoMassSparse::AliAnalysisTaskRhoMassSparse() : 
   AliAnalysisTaskRhoMassBase("AliAnalysisTaskRhoMassSparse"),
   fNExclLeadJets(0),
+  fRhoCMS(0),
   fJetRhoMassType(kMd),
   fPionMassClusters(kFALSE),
-  fHistMdAreavsCent(0)
+  fRhoEstimator(0),
+  fOwnRhoEstimator(kFALSE),
+  fRhoSelection(-1),
+  fHistMdAreavsCent(0),
+  fHistOccCorrvsCent(0)
 {
   // Constructor.
 }
@@ -34,9 +39,14 @@ AliAnalysisTaskRhoMassSparse::AliAnalysisTaskRhoMassSparse() :
 AliAnalysisTaskRhoMassSparse::AliAnalysisTaskRhoMassSparse(const char *name, Bool_t histo) :
   AliAnalysisTaskRhoMassBase(name, histo),
   fNExclLeadJets(0),
+  fRhoCMS(0),
   fJetRhoMassType(kMd),
   fPionMassClusters(kFALSE),
-  fHistMdAreavsCent(0)
+  fRhoEstimator(0),
+  fOwnRhoEstimator(kFALSE),
+  fRhoSelection(-1),
+  fHistMdAreavsCent(0),
+  fHistOccCorrvsCent(0)
 {
   // Constructor.
 }
@@ -64,29 +74,46 @@ void AliAnalysisTaskRhoMassSparse::UserCreateOutputObjects()
 //________________________________________________________________________
 Bool_t AliAnalysisTaskRhoMassSparse::IsJetOverlapping(AliEmcalJet* jet1, AliEmcalJet* jet2)
 {
-  for (Int_t i = 0; i < jet1->GetNumberOfTracks(); ++i)
-  {
-    Int_t jet1Track = jet1->TrackAt(i);
-    for (Int_t j = 0; j < jet2->GetNumberOfTracks(); ++j)
-    {
-      Int_t jet2Track = jet2->TrackAt(j);
-      if (jet1Track == jet2Track)
-        return kTRUE;
-    }
-  }
-  return kFALSE;
+  return AliRhoEstimator::IsJetOverlapping(jet1, jet2);
 }
 
 //________________________________________________________________________
 Bool_t AliAnalysisTaskRhoMassSparse::IsJetSignal(AliEmcalJet* jet)
 {
-  if(jet->Pt()>5){
-      return kTRUE;
-  }else{
-    return kFALSE;
-  }
+  return AliRhoEstimator::IsJetSignal(jet);
 }
 
+//________________________________________________________________________
+AliAnalysisTaskRhoMassSparse::~AliAnalysisTaskRhoMassSparse()
+{
+  // Destructor.
+
+  if (fOwnRhoEstimator) delete fRhoEstimator;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskRhoMassSparse::ExecOnce()
+{
+  // Init the analysis.
+
+  AliAnalysisTaskRhoMassBase::ExecOnce();
+
+  // The kt jets are scanned once per event by an estimator shared with
+  // the rho tasks using the same jet container
+  if (fOwnRhoEstimator) delete fRhoEstimator;
+  fRhoEstimator = AliRhoEstimator::Request(GetSharedObjects(), GetJetContainer(0));
+  fOwnRhoEstimator = kFALSE;
+  if (!fRhoEstimator) {
+    fRhoEstimator = new AliRhoEstimator(GetName());
+    fOwnRhoEstimator = kTRUE;
+  }
+
+  // jets overlapping with the signal jets of the second jet container are excluded
+  Int_t signalDef = fRhoEstimator->AddSignalJets(GetJetContainer(1));
+  Int_t massDef = fRhoEstimator->AddMassDefinition(static_cast<AliRhoEstimator::EMassType>(fJetRhoMassType), fPionMassClusters,
+                                                   fTracks, fCaloClusters);
+  fRhoSelection = fRhoEstimator->AddSelection(AliRhoEstimator::kPositiveArea, fNExclLeadJets, signalDef, massDef);
+}
 
 //________________________________________________________________________
 Bool_t AliAnalysisTaskRhoMassSparse::Run() 
@@ -100,110 +127,14 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
   if (!fJets)
     return kFALSE;
 
-  const Int_t Njets   = fJets->GetEntries();
-  
-  AliJetContainer *sigjets = static_cast<AliJetContainer*>(fJetCollArray.At(1));
-  
-  Int_t NjetsSig = 0;
-  if (sigjets) NjetsSig = sigjets->GetNJets();
-
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
-
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
-      if (!jet) {
-	AliError(Form("%s: Could not receive jet %d", GetName(), ij));
-	continue;
-      } 
-
-      if (!AcceptJet(jet))
-        continue;
-
-      if (jet->Pt() > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jet->Pt();
-	maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-	maxJetPts[1] = jet->Pt();
-	maxJetIds[1] = ij;
-      }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
-  }
-
-  static Double_t rhomvec[999];
-  static Double_t Evec[999];
-  static Double_t Mvec[999];
-  Int_t NjetAcc = 0;
-  Double_t TotaljetArea=0;
-  Double_t TotaljetAreaPhys=0;
-
-  // push all jets within selected acceptance into stack
-  for (Int_t iJets = 0; iJets < Njets; ++iJets) {
+  // the leading jets and the jets overlapping with signal jets are excluded by the estimator
+  fRhoEstimator->Process(GetJetContainer(0), fVertex);
 
-    // exlcuding lead jets
-    if (iJets == maxJetIds[0] || iJets == maxJetIds[1])
-      continue;
+  const Int_t NjetAcc = fRhoEstimator->GetNJets(fRhoSelection);
+  for (Int_t i = 0; i < NjetAcc; ++i)
+    fHistMdAreavsCent->Fill(fCent,fRhoEstimator->GetRhoMassAt(fRhoSelection, i));
 
-    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
-    if (!jet) {
-      AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
-      continue;
-    } 
-
-    TotaljetArea+=jet->Area();
-
-    if(jet->Pt()>0.1){
-      TotaljetAreaPhys+=jet->Area();
-    }
-
-    if (!AcceptJet(jet))
-      continue;
-
-      // Search for overlap with signal jets
-    Bool_t isOverlapping = kFALSE;
-    if (sigjets) {
-      for(Int_t j=0;j<NjetsSig;j++)
-	{
-	  AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
-	  if(!signalJet)
-	    continue;
-	  if(!IsJetSignal(signalJet))     
-	    continue;
-	  
-	  if(IsJetOverlapping(signalJet, jet))
-	    {
-	      isOverlapping = kTRUE;
-	      break;
-	    }
-	}
-    }
-
-    if(isOverlapping) 
-      continue;
-
-    // Double_t sumM = GetSumMConstituents(jet);
-    // Double_t sumPt = GetSumPtConstituents(jet);
-
-    if(jet->Area()>0.) {// && (jet->M()*jet->M() + jet->Pt()*jet->Pt())>0.) {
-       //rhomvec[NjetAcc] = (TMath::Sqrt(sumM*sumM + sumPt*sumPt) - sumPt ) / jet->Area();
-      // rhomvec[NjetAcc] = (TMath::Sqrt(jet->M()*jet->M() + jet->Pt()*jet->Pt()) - jet->Pt() ) / jet->Area();
-      rhomvec[NjetAcc] = GetMd(jet) / jet->Area();
-      fHistMdAreavsCent->Fill(fCent,rhomvec[NjetAcc]);
-      Evec[NjetAcc] = jet->E();
-      Mvec[NjetAcc] = jet->M();
-      ++NjetAcc;
-    }
-  }
-
-  Double_t OccCorr=0.0;
-  if(TotaljetArea>0) OccCorr=TotaljetAreaPhys/TotaljetArea;
+  Double_t OccCorr = fRhoEstimator->GetOccupancy(fRhoSelection);
  
   if (fCreateHisto)
     fHistOccCorrvsCent->Fill(fCent, OccCorr);
@@ -211,7 +142,7 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
 
   if (NjetAcc > 0) {
     //find median value
-    Double_t rhom = TMath::Median(NjetAcc, rhomvec);
+    Double_t rhom = fRhoEstimator->GetRhoMass(fRhoSelection);
     if(fRhoCMS){
       rhom = rhom * OccCorr;
     }
@@ -219,8 +150,8 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     fOutRhoMass->SetVal(rhom);
 
     Int_t Ntracks = fTracks->GetEntries();
-    Double_t meanM = TMath::Mean(NjetAcc, Mvec);
-    Double_t meanE = TMath::Mean(NjetAcc, Evec);
+    Double_t meanM = fRhoEstimator->GetMeanM(fRhoSelection);
+    Double_t meanE = fRhoEstimator->GetMeanE(fRhoSelection);
     Double_t gamma = 0.;
     if(meanM>0.) gamma = meanE/meanM;
     fHistGammaVsNtrack->Fill(Ntracks,gamma);
@@ -265,52 +196,5 @@ Double_t AliAnalysisTaskRhoMassSparse::GetSumPtConstituents(AliEmcalJet *jet) {
 //________________________________________________________________________
 Double_t AliAnalysisTaskRhoMassSparse::GetMd(AliEmcalJet *jet) {
   //get md as defined in http://arxiv.org/pdf/1211.2811.pdf
-  Double_t sum = 0.;
-  Double_t px = 0.;
-  Double_t py = 0.;
-  Double_t pz = 0.;
-  Double_t E = 0.;
-
-  if (fTracks) {
-    AliVParticle *vp;
-    for(Int_t icc=0; icc<jet->GetNumberOfTracks(); icc++) {
-      vp = static_cast<AliVParticle*>(jet->TrackAt(icc, fTracks));
-      if(!vp) continue;
-      if(fJetRhoMassType==kMd) sum += TMath::Sqrt(vp->M()*vp->M() + vp->Pt()*vp->Pt()) - vp->Pt(); //sqrt(E^2-P^2+pt^2)=sqrt(E^2-pz^2)
-      else if(fJetRhoMassType==kMdP) sum += TMath::Sqrt(vp->M()*vp->M() + vp->P()*vp->P()) - vp->P();
-      else if(fJetRhoMassType==kMd4) {
-	px+=vp->Px();
-	py+=vp->Py();
-	pz+=vp->Pz();
-	E+=vp->E();
-      }
-    }
-  }
-
-  if (fCaloClusters) {
-    AliVCluster *vp;
-    for(Int_t icc=0; icc<jet->GetNumberOfClusters(); icc++) {
-      vp = static_cast<AliVCluster*>(jet->ClusterAt(icc, fCaloClusters));
-      if(!vp) continue;
-      TLorentzVector nPart;
-      vp->GetMomentum(nPart, fVertex);
-      Double_t m = 0.;
-      if(fPionMassClusters) m = 0.13957;
-      if(fJetRhoMassType==kMd) sum += TMath::Sqrt(m*m + nPart.Pt()*nPart.Pt()) - nPart.Pt();
-      else if(fJetRhoMassType==kMdP) sum += TMath::Sqrt(nPart.M()*nPart.M() + nPart.P()*nPart.P()) - nPart.P();
-      else if(fJetRhoMassType==kMd4) {
-	px+=nPart.Px();
-	py+=nPart.Py();
-	pz+=nPart.Pz();
-	E+=nPart.E();
-      }
-    }
-  }
-
-  if(fJetRhoMassType==kMd4) {
-    Double_t pt = TMath::Sqrt(px*px + py*py);
-    Double_t m2 = E*E - pt*pt - pz*pz;
-    sum = TMath::Sqrt(m2 + pt*pt) - pt;
-  }
-  return sum;
+  return AliRhoEstimator::GetMd(jet, fTracks, fCaloClusters, fVertex, static_cast<AliRhoEstimator::EMassType>(fJetRhoMassType), fPionMassClusters);
 }
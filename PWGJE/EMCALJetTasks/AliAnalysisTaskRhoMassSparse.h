@@ -4,13 +4,14 @@
 // $Id$
 
 #include "AliAnalysisTaskRhoMassBase.h"
+#include "AliRhoEstimator.h"
 
 class AliAnalysisTaskRhoMassSparse : public AliAnalysisTaskRhoMassBase {
 
  public:
   AliAnalysisTaskRhoMassSparse();
   AliAnalysisTaskRhoMassSparse(const char *name, Bool_t histo=kFALSE);
-  virtual ~AliAnalysisTaskRhoMassSparse() {}
+  virtual ~AliAnalysisTaskRhoMassSparse();
 
   enum JetRhoMassType {
     kMd     = 0,            //rho_m from arXiv:1211.2811
@@ -29,6 +30,7 @@ class AliAnalysisTaskRhoMassSparse : public AliAnalysisTaskRhoMassBase {
 
 
  protected:
+  void             ExecOnce();
   Bool_t           Run();
 
   Double_t         GetSumMConstituents(AliEmcalJet *jet);
@@ -40,12 +42,15 @@ class AliAnalysisTaskRhoMassSparse : public AliAnalysisTaskRhoMassBase {
   JetRhoMassType   fJetRhoMassType;                // method for rho_m calculation
   Bool_t           fPionMassClusters;              // assume pion mass for clusters
 
+  AliRhoEstimator *fRhoEstimator;                  //!estimator shared with the rho tasks using the same jets
+  Bool_t           fOwnRhoEstimator;               //!whether the estimator is owned by this task
+  Int_t            fRhoSelection;                  //!selection of the jets in the estimator
   TH2F            *fHistMdAreavsCent;              //! Md/Area vs cent for all kt clusters
   TH2F            *fHistOccCorrvsCent;             //!occupancy correction vs. centrality
 
   AliAnalysisTaskRhoMassSparse(const AliAnalysisTaskRhoMassSparse&);             // not implemented
   AliAnalysisTaskRhoMassSparse& operator=(const AliAnalysisTaskRhoMassSparse&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoMassSparse, 1); // Rho_m task
+  ClassDef(AliAnalysisTaskRhoMassSparse, 3); // Rho_m task
 };
 #endif
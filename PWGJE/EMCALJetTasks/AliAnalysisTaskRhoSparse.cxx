@@ -24,6 +24,9 @@ AliAnalysisTaskRhoSparse::AliAnalysisTaskRhoSparse() :
   AliAnalysisTaskRhoBase("AliAnalysisTaskRhoSparse"),
   fNExclLeadJets(0),
   fRhoCMS(0),
+  fRhoEstimator(0),
+  fOwnRhoEstimator(kFALSE),
+  fRhoSelection(-1),
   fHistOccCorrvsCent(0)
 {
   // Constructor.
@@ -34,6 +37,9 @@ AliAnalysisTaskRhoSparse::AliAnalysisTaskRhoSparse(const char *name, Bool_t hist
   AliAnalysisTaskRhoBase(name, histo),
   fNExclLeadJets(0),
   fRhoCMS(0),
+  fRhoEstimator(0),
+  fOwnRhoEstimator(kFALSE),
+  fRhoSelection(-1),
   fHistOccCorrvsCent(0)
 {
   // Constructor.
@@ -53,29 +59,44 @@ void AliAnalysisTaskRhoSparse::UserCreateOutputObjects()
 //________________________________________________________________________
 Bool_t AliAnalysisTaskRhoSparse::IsJetOverlapping(AliEmcalJet* jet1, AliEmcalJet* jet2)
 {
-  for (Int_t i = 0; i < jet1->GetNumberOfTracks(); ++i)
-  {
-    Int_t jet1Track = jet1->TrackAt(i);
-    for (Int_t j = 0; j < jet2->GetNumberOfTracks(); ++j)
-    {
-      Int_t jet2Track = jet2->TrackAt(j);
-      if (jet1Track == jet2Track)
-        return kTRUE;
-    }
-  }
-  return kFALSE;
+  return AliRhoEstimator::IsJetOverlapping(jet1, jet2);
 }
 
 //________________________________________________________________________
 Bool_t AliAnalysisTaskRhoSparse::IsJetSignal(AliEmcalJet* jet)
 {
-  if(jet->Pt()>5){
-      return kTRUE;
-  }else{
-    return kFALSE;
-  }
+  return AliRhoEstimator::IsJetSignal(jet);
+}
+
+//________________________________________________________________________
+AliAnalysisTaskRhoSparse::~AliAnalysisTaskRhoSparse()
+{
+  // Destructor.
+
+  if (fOwnRhoEstimator) delete fRhoEstimator;
 }
 
+//________________________________________________________________________
+void AliAnalysisTaskRhoSparse::ExecOnce()
+{
+  // Init the analysis.
+
+  AliAnalysisTaskRhoBase::ExecOnce();
+
+  // The kt jets are scanned once per event by an estimator shared with
+  // the rho tasks using the same jet container
+  if (fOwnRhoEstimator) delete fRhoEstimator;
+  fRhoEstimator = AliRhoEstimator::Request(GetSharedObjects(), GetJetContainer(0));
+  fOwnRhoEstimator = kFALSE;
+  if (!fRhoEstimator) {
+    fRhoEstimator = new AliRhoEstimator(GetName());
+    fOwnRhoEstimator = kTRUE;
+  }
+
+  // jets overlapping with the signal jets of the second jet container are excluded
+  Int_t signalDef = fRhoEstimator->AddSignalJets(GetJetContainer(1));
+  fRhoSelection = fRhoEstimator->AddSelection(AliRhoEstimator::kPhysicalJets, fNExclLeadJets, signalDef);
+}
 
 //________________________________________________________________________
 Bool_t AliAnalysisTaskRhoSparse::Run() 
@@ -89,107 +110,17 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
   if (!fJets)
     return kFALSE;
 
-  const Int_t Njets = fJets->GetEntries();
-
-  AliJetContainer *sigjets = static_cast<AliJetContainer*>(fJetCollArray.At(1));
-
-  Int_t NjetsSig = 0;
-  if (sigjets) NjetsSig = sigjets->GetNJets();
-
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
-
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
-      if (!jet) {
-	AliError(Form("%s: Could not receive jet %d", GetName(), ij));
-	continue;
-      } 
-
-      if (!AcceptJet(jet))
-        continue;
-
-      if (jet->Pt() > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jet->Pt();
-	maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-	maxJetPts[1] = jet->Pt();
-	maxJetIds[1] = ij;
-      }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
-  }
-
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
-  Double_t TotaljetArea=0;
-  Double_t TotaljetAreaPhys=0;
-
-  // push all jets within selected acceptance into stack
-  for (Int_t iJets = 0; iJets < Njets; ++iJets) {
-
-    // exlcuding lead jets
-    if (iJets == maxJetIds[0] || iJets == maxJetIds[1])
-      continue;
-
-    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
-    if (!jet) {
-      AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
-      continue;
-    } 
-
-    TotaljetArea+=jet->Area();
-    
-    if(jet->Pt()>0.1){
-      TotaljetAreaPhys+=jet->Area();
-    }
-
-    if (!AcceptJet(jet))
-      continue;
-
-   // Search for overlap with signal jets
-    Bool_t isOverlapping = kFALSE;
-    if (sigjets) {
-      for(Int_t j=0;j<NjetsSig;j++)
-	{
-	  AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
-	  if(!signalJet)
-	    continue;
-	  if(!IsJetSignal(signalJet))     
-	    continue;
-	  
-	  if(IsJetOverlapping(signalJet, jet))
-	    {
-	      isOverlapping = kTRUE;
-	      break;
-	    }
-	}
-    }
-
-    if(isOverlapping) 
-      continue;
-
-    if(jet->Pt()>0.1){
-      rhovec[NjetAcc] = jet->Pt() / jet->Area();
-      ++NjetAcc;
-    }
-  }
+  // the leading jets and the jets overlapping with signal jets are excluded by the estimator
+  fRhoEstimator->Process(GetJetContainer(0), fVertex);
 
-  Double_t OccCorr=0.0;
-  if(TotaljetArea>0) OccCorr=TotaljetAreaPhys/TotaljetArea;
+  Double_t OccCorr = fRhoEstimator->GetOccupancy(fRhoSelection);
  
   if (fCreateHisto)
     fHistOccCorrvsCent->Fill(fCent, OccCorr);
 
-  if (NjetAcc > 0) {
+  if (fRhoEstimator->GetNJets(fRhoSelection) > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = fRhoEstimator->GetRho(fRhoSelection);
 
     if(fRhoCMS){
       rho = rho * OccCorr;
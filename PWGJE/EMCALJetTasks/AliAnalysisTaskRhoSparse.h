@@ -4,13 +4,14 @@
 // $Id$
 
 #include "AliAnalysisTaskRhoBase.h"
+#include "AliRhoEstimator.h"
 
 class AliAnalysisTaskRhoSparse : public AliAnalysisTaskRhoBase {
 
  public:
   AliAnalysisTaskRhoSparse();
   AliAnalysisTaskRhoSparse(const char *name, Bool_t histo=kFALSE);
-  virtual ~AliAnalysisTaskRhoSparse() {}
+  virtual ~AliAnalysisTaskRhoSparse();
 
   void             UserCreateOutputObjects();
   void             SetExcludeLeadJets(UInt_t n)    { fNExclLeadJets = n    ; }
@@ -19,16 +20,20 @@ class AliAnalysisTaskRhoSparse : public AliAnalysisTaskRhoBase {
   Bool_t           IsJetSignal(AliEmcalJet* jet1);
 
  protected:
+  void             ExecOnce();
   Bool_t           Run();
 
   UInt_t           fNExclLeadJets;                 // number of leading jets to be excluded from the median calculation
   Bool_t           fRhoCMS;                        // flag to run CMS method
 
+  AliRhoEstimator *fRhoEstimator;                  //!estimator shared with the rho tasks using the same jets
+  Bool_t           fOwnRhoEstimator;               //!whether the estimator is owned by this task
+  Int_t            fRhoSelection;                  //!selection of the jets in the estimator
   TH2F            *fHistOccCorrvsCent;             //!occupancy correction vs. centrality
 
   AliAnalysisTaskRhoSparse(const AliAnalysisTaskRhoSparse&);             // not implemented
   AliAnalysisTaskRhoSparse& operator=(const AliAnalysisTaskRhoSparse&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoSparse, 2); // Rho task
+  ClassDef(AliAnalysisTaskRhoSparse, 4); // Rho task
 };
 #endif
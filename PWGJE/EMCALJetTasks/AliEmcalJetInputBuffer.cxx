@@ -0,0 +1,153 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include <TBufferFile.h>
+#include <TClonesArray.h>
+#include <TMD5.h>
+#include <TObjArray.h>
+
+#include <AliAnalysisManager.h>
+#include <AliLog.h>
+
+#include "AliTLorentzVector.h"
+#include "AliParticleContainer.h"
+#include "AliClusterContainer.h"
+
+#include "AliEmcalJetInputBuffer.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalJetInputBuffer);
+/// \endcond
+
+/**
+ * Default constructor. This constructor is only for ROOT I/O and
+ * not to be used by users.
+ */
+AliEmcalJetInputBuffer::AliEmcalJetInputBuffer() :
+  TNamed(),
+  fNEntries(0),
+  fMomenta(),
+  fIndexes(),
+  fProcessedEvent(-1),
+  fProcessedArray(0)
+{
+}
+
+/**
+ * Standard named constructor.
+ * @param key Key describing the container configuration
+ */
+AliEmcalJetInputBuffer::AliEmcalJetInputBuffer(const char *key) :
+  TNamed(key, key),
+  fNEntries(0),
+  fMomenta(),
+  fIndexes(),
+  fProcessedEvent(-1),
+  fProcessedArray(0)
+{
+}
+
+AliEmcalJetInputBuffer *AliEmcalJetInputBuffer::Request(TObjArray *sharedObjects, const TString &key)
+{
+  if (!sharedObjects) return 0;
+  AliEmcalJetInputBuffer *buffer = dynamic_cast<AliEmcalJetInputBuffer*>(sharedObjects->FindObject(key));
+  if (!buffer) {
+    buffer = new AliEmcalJetInputBuffer(key);
+    sharedObjects->Add(buffer);
+    ::Info("AliEmcalJetInputBuffer::Request", "Created jet input buffer: %s", key.Data());
+  }
+  return buffer;
+}
+
+TString AliEmcalJetInputBuffer::MakeKey(const TObjArray &particleConts, const TObjArray &clusterConts)
+{
+  // The streamed state of a container contains all its cut settings (the transient
+  // members, i.e. the connected arrays, are not streamed), so two containers with the
+  // same checksum accept the same objects in each event
+  TString key;
+  const TObjArray *conts[2] = {&particleConts, &clusterConts};
+  for (Int_t i = 0; i < 2; i++) {
+    key += (i == 0) ? "P" : "C";
+    TIter next(conts[i]);
+    TObject *cont = 0;
+    while ((cont = next())) {
+      TBufferFile buf(TBuffer::kWrite);
+      cont->Streamer(buf);
+      if (buf.Length() <= 0) return "";
+      TMD5 md5;
+      md5.Update(reinterpret_cast<UChar_t*>(buf.Buffer()), buf.Length());
+      md5.Final();
+      key += TString::Format(":%s_%s", cont->ClassName(), md5.AsString());
+    }
+    key += ";";
+  }
+  return key;
+}
+
+void AliEmcalJetInputBuffer::Add(Double_t px, Double_t py, Double_t pz, Double_t e, Int_t index)
+{
+  if (fIndexes.GetSize() <= fNEntries) {
+    Int_t size = fNEntries < 64 ? 128 : 2 * fNEntries;
+    fIndexes.Set(size);
+    fMomenta.Set(4 * size);
+  }
+  Double_t *mom = fMomenta.GetArray() + 4 * fNEntries;
+  mom[0] = px; mom[1] = py; mom[2] = pz; mom[3] = e;
+  fIndexes[fNEntries] = index;
+  fNEntries++;
+}
+
+void AliEmcalJetInputBuffer::Update(const TObjArray &particleConts, const TObjArray &clusterConts, Int_t indexShift)
+{
+  // The number of calls of the analysis manager identifies the event (the tree entry
+  // restarts with each file). Without analysis manager the buffer is always filled
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t event = mgr ? mgr->GetNcalls() : -1;
+
+  AliEmcalContainer *first = static_cast<AliEmcalContainer*>(particleConts.First());
+  if (!first) first = static_cast<AliEmcalContainer*>(clusterConts.First());
+  const TClonesArray *array = first ? first->GetArray() : 0;
+
+  if (event > 0 && event == fProcessedEvent && array == fProcessedArray) return;
+  fProcessedEvent = event;
+  fProcessedArray = array;
+  fNEntries = 0;
+
+  Int_t iColl = 1;
+  TIter nextPartColl(&particleConts);
+  AliParticleContainer* tracks = 0;
+  while ((tracks = static_cast<AliParticleContainer*>(nextPartColl()))) {
+    AliDebug(2,Form("Tracks from collection %d: '%s'. Embedded: %i, nTracks: %i", iColl-1, tracks->GetName(), tracks->GetIsEmbedding(), tracks->GetNParticles()));
+    AliParticleIterableMomentumContainer itcont = tracks->accepted_momentum();
+    for (AliParticleIterableMomentumContainer::iterator it = itcont.begin(); it != itcont.end(); it++) {
+      AliDebug(2,Form("Track %d accepted (label = %d, pt = %f, eta = %f, phi = %f, E = %f, m = %f, px = %f, py = %f, pz = %f)", it.current_index(), it->second->GetLabel(), it->first.Pt(), it->first.Eta(), it->first.Phi(), it->first.E(), it->first.M(), it->first.Px(), it->first.Py(), it->first.Pz()));
+      Add(it->first.Px(), it->first.Py(), it->first.Pz(), it->first.E(), it.current_index() + indexShift * iColl);
+    }
+    iColl++;
+  }
+
+  iColl = 1;
+  TIter nextClusColl(&clusterConts);
+  AliClusterContainer* clusters = 0;
+  while ((clusters = static_cast<AliClusterContainer*>(nextClusColl()))) {
+    AliDebug(2,Form("Clusters from collection %d: '%s'. Embedded: %i, nClusters: %i", iColl-1, clusters->GetName(), clusters->GetIsEmbedding(), clusters->GetNClusters()));
+    AliClusterIterableMomentumContainer itcont = clusters->accepted_momentum();
+    for (AliClusterIterableMomentumContainer::iterator it = itcont.begin(); it != itcont.end(); it++) {
+      AliDebug(2,Form("Cluster %d accepted (label = %d, energy = %.3f)", it.current_index(), it->second->GetLabel(), it->first.E()));
+      Add(it->first.Px(), it->first.Py(), it->first.Pz(), it->first.E(), -it.current_index() - indexShift * iColl);
+    }
+    iColl++;
+  }
+}
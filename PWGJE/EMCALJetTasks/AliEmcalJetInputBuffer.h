@@ -0,0 +1,85 @@
+#ifndef ALIEMCALJETINPUTBUFFER_H
+#define ALIEMCALJETINPUTBUFFER_H
+
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+class TClonesArray;
+class TObjArray;
+
+#include <TArrayD.h>
+#include <TArrayI.h>
+#include <TNamed.h>
+
+/**
+ * @class AliEmcalJetInputBuffer
+ * @brief Jet finder input shared by the jet tasks of a train
+ *
+ * Jet trains usually run several instances of AliEmcalJetTask (different radii,
+ * algorithms, recombination schemes) on the same particle and cluster containers.
+ * The input of the jet finder only depends on the configuration of these containers,
+ * so it is built once per event and container set and kept in packed arrays
+ * (\f$ p_{x} \f$, \f$ p_{y} \f$, \f$ p_{z} \f$, \f$ E \f$ and the constituent index),
+ * which the jet tasks hand to FastJet in one go.
+ *
+ * Buffers are identified by a key describing the full configuration of the
+ * containers (see MakeKey). Jet tasks with the same key share one buffer, kept in
+ * the list of objects shared by the EMCal tasks of the analysis manager (see
+ * AliAnalysisTaskEmcal::GetSharedObjects). The buffer is refilled once per call of
+ * the analysis manager (AliAnalysisManager::GetNcalls).
+ */
+class AliEmcalJetInputBuffer : public TNamed {
+ public:
+  AliEmcalJetInputBuffer();
+  AliEmcalJetInputBuffer(const char *key);
+  virtual ~AliEmcalJetInputBuffer() {}
+
+  /**
+   * Get the buffer for a container configuration from a list of shared
+   * objects. If no buffer with this key exists a new one is created and added
+   * @param[in] sharedObjects List of shared objects (owner of the buffers)
+   * @param[in] key Key describing the container configuration
+   * @return Shared input buffer, NULL if no list is provided
+   */
+  static AliEmcalJetInputBuffer *Request(TObjArray *sharedObjects, const TString &key);
+
+  /**
+   * Build the key of a container configuration from the persistent state
+   * (i.e. all cut settings) of the particle and cluster containers
+   * @param[in] particleConts Particle containers
+   * @param[in] clusterConts Cluster containers
+   * @return Key, empty if a container could not be serialized
+   */
+  static TString MakeKey(const TObjArray &particleConts, const TObjArray &clusterConts);
+
+  /**
+   * Fill the buffer with the accepted objects of the containers, unless
+   * this was already done for the current event of the analysis manager
+   * @param[in] particleConts Particle containers
+   * @param[in] clusterConts Cluster containers
+   * @param[in] indexShift Offset between the constituent indices of two containers
+   */
+  void Update(const TObjArray &particleConts, const TObjArray &clusterConts, Int_t indexShift);
+
+  Int_t           GetNEntries()             const { return fNEntries         ; }
+  const Double_t *GetMomenta()              const { return fMomenta.GetArray(); }
+  const Int_t    *GetIndexes()              const { return fIndexes.GetArray(); }
+
+ protected:
+  void            Add(Double_t px, Double_t py, Double_t pz, Double_t e, Int_t index);
+
+  Int_t               fNEntries;            //!<! Number of entries for the current event
+  TArrayD             fMomenta;             //!<! Packed momenta (px, py, pz, E) of the entries
+  TArrayI             fIndexes;             //!<! Constituent indices of the entries
+  Long64_t            fProcessedEvent;      //!<! Call of the analysis manager processed last
+  const TClonesArray *fProcessedArray;      //!<! First input array processed last
+
+ private:
+  AliEmcalJetInputBuffer(const AliEmcalJetInputBuffer&);            // not implemented
+  AliEmcalJetInputBuffer &operator=(const AliEmcalJetInputBuffer&); // not implemented
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalJetInputBuffer, 2);
+  /// \endcond
+};
+#endif
@@ -33,6 +33,7 @@
 #include "AliEmcalParticle.h"
 #include "AliFJWrapper.h"
 #include "AliEmcalJetUtility.h"
+#include "AliEmcalJetInputBuffer.h"
 #include "AliParticleContainer.h"
 #include "AliClusterContainer.h"
 
@@ -70,6 +71,7 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fUtilities(0),
   fLocked(0),
+  fShareInput(kTRUE),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -79,7 +81,10 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fJets(0),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
-  fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask")
+  fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask"),
+  fInputBuffer(0),
+  fOwnInputBuffer(kFALSE),
+  fSortedJetIndexes()
 {
 }
 
@@ -105,6 +110,7 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fUtilities(0),
   fLocked(0),
+  fShareInput(kTRUE),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -114,7 +120,10 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fJets(0),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
-  fFastJetWrapper(name,name)
+  fFastJetWrapper(name,name),
+  fInputBuffer(0),
+  fOwnInputBuffer(kFALSE),
+  fSortedJetIndexes()
 {
 }
 
@@ -123,6 +132,7 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
  */
 AliEmcalJetTask::~AliEmcalJetTask()
 {
+  if (fOwnInputBuffer) delete fInputBuffer;
 }
 
 /**
@@ -216,10 +226,11 @@ Bool_t AliEmcalJetTask::Run()
 }
 
 /**
- * This method steers the jet finding. It first loops over all particle and cluster containers
- * that were provided when the task was initialized. All accepted objects (tracks, particle, clusters)
- * are added as input vectors to the FastJet wrapper. Then the jet finding is launched
- * in the wrapper.
+ * This method steers the jet finding. The accepted objects (tracks, particle, clusters)
+ * of all particle and cluster containers that were provided when the task was initialized
+ * are collected in the input buffer, which may be shared with other jet tasks using the same
+ * containers. The buffer is handed to the FastJet wrapper (applying the artificial tracking
+ * inefficiency, if requested) and the jet finding is launched in the wrapper.
  * @return Total number of jets found.
  */
 Int_t AliEmcalJetTask::FindJets()
@@ -229,47 +240,40 @@ Int_t AliEmcalJetTask::FindJets()
     return 0;
   }
 
+  if (!fInputBuffer) {
+    AliError("Input buffer not initialized, returning.");
+    return 0;
+  }
+
   fFastJetWrapper.Clear();
 
   AliDebug(2,Form("Jet type = %d", fJetType));
 
-  Int_t iColl = 1;
-  TIter nextPartColl(&fParticleCollArray);
-  AliParticleContainer* tracks = 0;
-  while ((tracks = static_cast<AliParticleContainer*>(nextPartColl()))) {
-    AliDebug(2,Form("Tracks from collection %d: '%s'. Embedded: %i, nTracks: %i", iColl-1, tracks->GetName(), tracks->GetIsEmbedding(), tracks->GetNParticles()));
-    AliParticleIterableMomentumContainer itcont = tracks->accepted_momentum();
-    for (AliParticleIterableMomentumContainer::iterator it = itcont.begin(); it != itcont.end(); it++) {
+  fInputBuffer->Update(fParticleCollArray, fClusterCollArray, fgkConstIndexShift);
+  const Int_t nInput = fInputBuffer->GetNEntries();
+  const Double_t *momenta = fInputBuffer->GetMomenta();
+  const Int_t *uids = fInputBuffer->GetIndexes();
+
+  if (fTrackEfficiency < 1.) {
+    for (Int_t i = 0; i < nInput; i++) {
+      Int_t uid = uids[i];
       // artificial inefficiency
-      if (fTrackEfficiency < 1.) {
+      if (uid >= fgkConstIndexShift) {
+        AliParticleContainer* tracks = GetParticleContainer(uid / fgkConstIndexShift - 1);
         if (fTrackEfficiencyOnlyForEmbedding == kFALSE || (fTrackEfficiencyOnlyForEmbedding == kTRUE && tracks->GetIsEmbedding())) {
           Double_t rnd = gRandom->Rndm();
           if (fTrackEfficiency < rnd) {
-            AliDebug(2,Form("Track %d rejected due to artificial tracking inefficiency", it.current_index()));
+            AliDebug(2,Form("Track %d rejected due to artificial tracking inefficiency", uid % fgkConstIndexShift));
             continue;
           }
         }
       }
-
-      AliDebug(2,Form("Track %d accepted (label = %d, pt = %f, eta = %f, phi = %f, E = %f, m = %f, px = %f, py = %f, pz = %f)", it.current_index(), it->second->GetLabel(), it->first.Pt(), it->first.Eta(), it->first.Phi(), it->first.E(), it->first.M(), it->first.Px(), it->first.Py(), it->first.Pz()));
-      Int_t uid = it.current_index() + fgkConstIndexShift * iColl;
-      fFastJetWrapper.AddInputVector(it->first.Px(), it->first.Py(), it->first.Pz(), it->first.E(), uid);
+      const Double_t *mom = momenta + 4 * i;
+      fFastJetWrapper.AddInputVector(mom[0], mom[1], mom[2], mom[3], uid);
     }
-    iColl++;
   }
-
-  iColl = 1;
-  TIter nextClusColl(&fClusterCollArray);
-  AliClusterContainer* clusters = 0;
-  while ((clusters = static_cast<AliClusterContainer*>(nextClusColl()))) {
-    AliDebug(2,Form("Clusters from collection %d: '%s'. Embedded: %i, nClusters: %i", iColl-1, clusters->GetName(), clusters->GetIsEmbedding(), clusters->GetNClusters()));
-    AliClusterIterableMomentumContainer itcont = clusters->accepted_momentum();
-    for (AliClusterIterableMomentumContainer::iterator it = itcont.begin(); it != itcont.end(); it++) {
-      AliDebug(2,Form("Cluster %d accepted (label = %d, energy = %.3f)", it.current_index(), it->second->GetLabel(), it->first.E()));
-      Int_t uid = -it.current_index() - fgkConstIndexShift * iColl;
-      fFastJetWrapper.AddInputVector(it->first.Px(), it->first.Py(), it->first.Pz(), it->first.E(), uid);
-    }
-    iColl++;
+  else {
+    fFastJetWrapper.AddInputVectors(momenta, uids, nInput);
   }
 
   if (fFastJetWrapper.GetInputVectors().size() == 0) return 0;
@@ -289,22 +293,22 @@ void AliEmcalJetTask::FillJetBranch()
 {
   PrepareUtilities();
 
-  // loop over fastjet jets
-  std::vector<fastjet::PseudoJet> jets_incl = fFastJetWrapper.GetInclusiveJets();
+  // loop over fastjet jets (no copy of the jet vector)
+  const std::vector<fastjet::PseudoJet>& jets_incl = fFastJetWrapper.GetInclusiveJets();
   // sort jets according to jet pt
-  static Int_t indexes[9999] = {-1};
-  GetSortedArray(indexes, jets_incl);
+  GetSortedArray(fSortedJetIndexes, jets_incl);
 
   AliDebug(1,Form("%d jets found", (Int_t)jets_incl.size()));
   for (UInt_t ijet = 0, jetCount = 0; ijet < jets_incl.size(); ++ijet) {
-    Int_t ij = indexes[ijet];
+    Int_t ij = fSortedJetIndexes[ijet];
     AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), fFastJetWrapper.GetJetArea(ij)));
 
+    // kinematic cuts first, the area needs a loop over the jet constituents
     if (jets_incl[ij].perp() < fMinJetPt) continue;
-    if (fFastJetWrapper.GetJetArea(ij) < fMinJetArea) continue;
     if ((jets_incl[ij].eta() < fJetEtaMin) || (jets_incl[ij].eta() > fJetEtaMax) ||
         (jets_incl[ij].phi() < fJetPhiMin) || (jets_incl[ij].phi() > fJetPhiMax))
       continue;
+    if (fFastJetWrapper.GetJetArea(ij) < fMinJetArea) continue;
 
     AliEmcalJet *jet = new ((*fJets)[jetCount])
     		          AliEmcalJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
@@ -340,23 +344,23 @@ void AliEmcalJetTask::FillJetBranch()
 
 /**
  * Sorts jets by pT (decreasing)
- * @param[out] indexes This array is used to return the indexes of the jets ordered by pT
+ * @param[out] indexes This array is used to return the indexes of the jets ordered by pT (resized if needed)
  * @param[in] array Vector containing the list of jets obtained by the FastJet wrapper
  * @return kTRUE if at least one jet was found in array; kFALSE otherwise
  */
-Bool_t AliEmcalJetTask::GetSortedArray(Int_t indexes[], std::vector<fastjet::PseudoJet> array) const
+Bool_t AliEmcalJetTask::GetSortedArray(TArrayI& indexes, const std::vector<fastjet::PseudoJet>& array) const
 {
-  static Float_t pt[9999] = {0};
-
   const Int_t n = (Int_t)array.size();
 
   if (n < 1)
     return kFALSE;
 
+  std::vector<Float_t> pt(n);
   for (Int_t i = 0; i < n; i++)
     pt[i] = array[i].perp();
 
-  TMath::Sort(n, pt, indexes);
+  if (indexes.GetSize() < n) indexes.Set(n);
+  TMath::Sort(n, &pt[0], indexes.GetArray());
 
   return kTRUE;
 }
@@ -409,6 +413,20 @@ void AliEmcalJetTask::ExecOnce()
   // containers' arrays are setup.
   fClusterContainerIndexMap.CopyMappingFrom(AliClusterContainer::GetEmcalContainerIndexMap(), fClusterCollArray);
   fParticleContainerIndexMap.CopyMappingFrom(AliParticleContainer::GetEmcalContainerIndexMap(), fParticleCollArray);
+
+  // Setup the input buffer, shared with the jet tasks that use the same containers
+  if (fOwnInputBuffer) delete fInputBuffer;
+  fInputBuffer = 0;
+  TString inputKey;
+  if (fShareInput) inputKey = AliEmcalJetInputBuffer::MakeKey(fParticleCollArray, fClusterCollArray);
+  if (!inputKey.IsNull()) fInputBuffer = AliEmcalJetInputBuffer::Request(GetSharedObjects(), inputKey);
+  if (fInputBuffer) {
+    fOwnInputBuffer = kFALSE;
+  }
+  else {
+    fInputBuffer = new AliEmcalJetInputBuffer(GetName());
+    fOwnInputBuffer = kTRUE;
+  }
 }
 
 /**
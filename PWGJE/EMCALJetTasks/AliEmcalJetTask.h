@@ -8,7 +8,9 @@ class TClonesArray;
 class TObjArray;
 class AliVEvent;
 class AliEmcalJetUtility;
+class AliEmcalJetInputBuffer;
 
+#include <TArrayI.h>
 #include <AliLog.h>
 
 #include "AliAnalysisTaskEmcal.h"
@@ -40,6 +42,12 @@ namespace fastjet {
  * defined as being charged, neutral or full. The jet finding is delegated to
  * the class AliFJWrapper which implements an interface to FastJet.
  *
+ * The accepted constituents are collected in an AliEmcalJetInputBuffer. Jet tasks
+ * whose particle and cluster containers have the same configuration (e.g. the same
+ * input with different radii or algorithms) share one buffer, which is filled only
+ * once per event and handed to FastJet in one go. Sharing can be switched off
+ * with SetShareInput(kFALSE).
+ *
  * The FastJet contrib utilities are available via the AliEmcalJetUtility base class
  * and its derived classes. Utilities can be added via the AddUtility(AliEmcalJetUtility*) method.
  * All the utilities added in the list will be executed. Users can implement new utilities
@@ -79,6 +87,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetLegacyMode(Bool_t mode)                 { if (IsLocked()) return; fLegacyMode       = mode  ; }
   void                   SetFillGhost(Bool_t b=kTRUE)               { if (IsLocked()) return; fFillGhost        = b     ; }
   void                   SetRadius(Double_t r)                      { if (IsLocked()) return; fRadius           = r     ; }
+  void                   SetShareInput(Bool_t b=kTRUE)              { if (IsLocked()) return; fShareInput       = b     ; }
 
   void                   SetEtaRange(Double_t emi, Double_t ema);
   void                   SetMinJetClusPt(Double_t min);
@@ -105,6 +114,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Int_t                  GetRecombScheme()                { return fRecombScheme      ; }
   Double_t               GetTrackEfficiency()             { return fTrackEfficiency   ; }
   Bool_t                 GetTrackEfficiencyOnlyForEmbedding() { return fTrackEfficiencyOnlyForEmbedding; }
+  Bool_t                 GetShareInput()                  { return fShareInput        ; }
 
   TClonesArray*          GetJets()                        { return fJets              ; }
   TObjArray*             GetUtilities()                   { return fUtilities         ; }
@@ -150,7 +160,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   PrepareUtilities();
   void                   ExecuteUtilities(AliEmcalJet* jet, Int_t ij);
   void                   TerminateUtilities();
-  Bool_t                 GetSortedArray(Int_t indexes[], std::vector<fastjet::PseudoJet> array) const;
+  Bool_t                 GetSortedArray(TArrayI& indexes, const std::vector<fastjet::PseudoJet>& array) const;
   Bool_t                 IsJetInEmcal(Double_t eta, Double_t phi, Double_t r);
   Bool_t                 IsJetInDcal(Double_t eta, Double_t phi, Double_t r);
   Bool_t                 IsJetInDcalOnly(Double_t eta, Double_t phi, Double_t r);
@@ -173,6 +183,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   TObjArray             *fUtilities;              // jet utilities (gen subtractor, constituent subtractor etc.)
   Bool_t                 fTrackEfficiencyOnlyForEmbedding; // Apply aritificial tracking inefficiency only for embedded tracks
   Bool_t                 fLocked;                 // true if lock is set
+  Bool_t                 fShareInput;             // share the jet finder input with jet tasks using the same containers
 
   TString                fJetsName;               //!name of jet collection
   Bool_t                 fIsInit;                 //!=true if already initialized
@@ -183,6 +194,9 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
 
   TClonesArray          *fJets;                   //!jet collection
   AliFJWrapper           fFastJetWrapper;         //!fastjet wrapper
+  AliEmcalJetInputBuffer *fInputBuffer;           //!jet finder input (shared or owned, see fOwnInputBuffer)
+  Bool_t                 fOwnInputBuffer;         //!=true if the input buffer is not shared
+  TArrayI                fSortedJetIndexes;       //!indexes of the jets sorted by pt
 
   static const Int_t     fgkConstIndexShift;      //!contituent index shift
 
@@ -197,7 +211,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 24);
+  ClassDef(AliEmcalJetTask, 25);
   /// \endcond
 };
 #endif
@@ -35,6 +35,7 @@ AliAnalysisTaskEmcalJet("AliEmcalPicoTrackInGridMaker",kTRUE),
   fNCells(-1),
   fNCellsEMCal(-1),
   fNCellsDCal(-1),
+  fMedianValues(),
   fMultVsRho(0)
 {
   // Constructor.
@@ -99,6 +100,7 @@ AliEmcalPicoTrackInGridMaker::AliEmcalPicoTrackInGridMaker(const char *name) :
   fNCells(-1),
   fNCellsEMCal(-1),
   fNCellsDCal(-1),
+  fMedianValues(),
   fMultVsRho(0)
 {
   // Constructor.
@@ -410,7 +412,9 @@ Double_t AliEmcalPicoTrackInGridMaker::CalculateMedian(const Int_t patchType, co
   Int_t stepSize = GetTriggerPatchIdStepSizeNoOverlap(GetPatchDim(patchType),level);
   //Printf("patchType: %d dim: %d stepSizeNoOverlap: %d ",patchType,GetPatchDim(patchType),stepSize);
 
-  static Double_t arr[999];
+  // at most one entry per patch
+  if(fMedianValues.GetSize()<n) fMedianValues.Set(n);
+  Double_t *arr = fMedianValues.GetArray();
   Int_t c = 0;
 
   //find patch with highest energy
@@ -106,6 +106,7 @@ class AliEmcalPicoTrackInGridMaker : public AliAnalysisTaskEmcalJet {
   TArrayI            fActiveAreaMPP[2][5];  // active area in mini patches for each trigger patch
   TArrayI            fActiveAreaCP[2][5];   // active area in cells for each trigger patch
   Int_t              fNPatchesEMCal[5];     // number of patches in EMCal
+  TArrayD            fMedianValues;         //! patch densities entering the median calculation
 
  private:
   AliEmcalPicoTrackInGridMaker(const AliEmcalPicoTrackInGridMaker&);            // not implemented
@@ -134,6 +135,6 @@ class AliEmcalPicoTrackInGridMaker : public AliAnalysisTaskEmcalJet {
 
   TH2F              *fMultVsRho;            //! track multiplicity vs rho from EMCal
 
-  ClassDef(AliEmcalPicoTrackInGridMaker, 3); // Task to make PicoTracks in a grid corresponding to EMCAL/DCAL acceptance
+  ClassDef(AliEmcalPicoTrackInGridMaker, 4); // Task to make PicoTracks in a grid corresponding to EMCAL/DCAL acceptance
 };
 #endif
@@ -19,6 +19,7 @@ class AliFJWrapper
   virtual void  AddInputVector (Double_t px, Double_t py, Double_t pz, Double_t E, Int_t index = -99999);
   virtual void  AddInputVector (const fastjet::PseudoJet& vec,                Int_t index = -99999);
   virtual void  AddInputVectors(const std::vector<fastjet::PseudoJet>& vecs,  Int_t offsetIndex = -99999);
+  virtual void  AddInputVectors(const Double_t* momenta, const Int_t* indexes, Int_t n);
   virtual void  AddInputGhost  (Double_t px, Double_t py, Double_t pz, Double_t E, Int_t index = -99999);
   virtual const char *ClassName()                            const { return "AliFJWrapper";              }
   virtual void  Clear(const Option_t* /*opt*/ = "");
@@ -449,6 +450,22 @@ void AliFJWrapper::AddInputVectors(const std::vector<fj::PseudoJet>& vecs, Int_t
   }*/
 }
 
+//_________________________________________________________________________________________________
+void AliFJWrapper::AddInputVectors(const Double_t* momenta, const Int_t* indexes, Int_t n)
+{
+  // Add n input vectors from packed arrays: momenta holds (px, py, pz, E) of each vector,
+  // indexes the user indices.
+
+  fInputVectors.reserve(fInputVectors.size() + n);
+  if (fEventSub) fEventSubInputVectors.reserve(fEventSubInputVectors.size() + n);
+  for (Int_t i = 0; i < n; ++i) {
+    const Double_t* mom = momenta + 4 * i;
+    fInputVectors.push_back(fj::PseudoJet(mom[0], mom[1], mom[2], mom[3]));
+    fInputVectors.back().set_user_index(indexes[i]);
+    if (fEventSub) fEventSubInputVectors.push_back(fInputVectors.back());
+  }
+}
+
 //_________________________________________________________________________________________________
 void AliFJWrapper::AddInputGhost(Double_t px, Double_t py, Double_t pz, Double_t E, Int_t index)
 {
@@ -26,6 +26,7 @@ AliJetEmbeddingFromPYTHIATask::AliJetEmbeddingFromPYTHIATask() :
   AliJetEmbeddingFromAODTask("AliJetEmbeddingFromPYTHIATask"),
   fPYTHIAPath(),
   fPtHardBinScaling(),
+  fPtHardBinOrder(),
   fLHC11hAnchorRun(kTRUE),
   fAnchorRun(-1),
   fFileTable(0),
@@ -49,6 +50,7 @@ AliJetEmbeddingFromPYTHIATask::AliJetEmbeddingFromPYTHIATask(const char *name, B
   AliJetEmbeddingFromAODTask(name, drawqa),
   fPYTHIAPath("alien:///alice/sim/2012/LHC12a15e_fix/%d/%d/AOD149/%04d/AliAOD.root"),
   fPtHardBinScaling(),
+  fPtHardBinOrder(),
   fLHC11hAnchorRun(kTRUE),
   fAnchorRun(-1),
   fFileTable(0),
@@ -161,10 +163,12 @@ Bool_t AliJetEmbeddingFromPYTHIATask::GetNextEntry()
 //________________________________________________________________________
 Int_t AliJetEmbeddingFromPYTHIATask::GetRandomPtHardBin() 
 {
-  static Int_t order[20]={-1};
-
-  if (order[0] == -1)
-    TMath::Sort(fPtHardBinScaling.GetSize(), fPtHardBinScaling.GetArray(), order);
+  // sorted once per task instance (the scaling is fixed after ExecOnce)
+  if (fPtHardBinOrder.GetSize() != fPtHardBinScaling.GetSize()) {
+    fPtHardBinOrder.Set(fPtHardBinScaling.GetSize());
+    TMath::Sort(fPtHardBinScaling.GetSize(), fPtHardBinScaling.GetArray(), fPtHardBinOrder.GetArray());
+  }
+  const Int_t *order = fPtHardBinOrder.GetArray();
 
   Double_t rnd = gRandom->Rndm();
   Double_t sum = 0;
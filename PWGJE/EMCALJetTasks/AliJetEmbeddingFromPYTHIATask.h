@@ -8,6 +8,7 @@
 
 #include "AliJetEmbeddingFromAODTask.h"
 #include <TArrayD.h>
+#include <TArrayI.h>
 
 template<class T> 
 class TParameter;
@@ -42,6 +43,7 @@ class AliJetEmbeddingFromPYTHIATask : public AliJetEmbeddingFromAODTask {
 
   TString          fPYTHIAPath              ;// Path of the PYTHIA production
   TArrayD          fPtHardBinScaling        ;// Pt hard bin scaling
+  TArrayI          fPtHardBinOrder          ;//!Pt hard bins sorted by decreasing scaling
   Bool_t           fLHC11hAnchorRun         ;// LHC11h anchor runs
   Int_t            fAnchorRun               ;// Anchor run
   THashTable      *fFileTable               ;// Table of allowed/vetoed files
@@ -58,6 +60,6 @@ class AliJetEmbeddingFromPYTHIATask : public AliJetEmbeddingFromAODTask {
   AliJetEmbeddingFromPYTHIATask(const AliJetEmbeddingFromPYTHIATask&);            // not implemented
   AliJetEmbeddingFromPYTHIATask &operator=(const AliJetEmbeddingFromPYTHIATask&); // not implemented
 
-  ClassDef(AliJetEmbeddingFromPYTHIATask, 4) // Jet embedding from PYTHIA task
+  ClassDef(AliJetEmbeddingFromPYTHIATask, 5) // Jet embedding from PYTHIA task
 };
 #endif
@@ -0,0 +1,516 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include <algorithm>
+
+#include <TBufferFile.h>
+#include <TClonesArray.h>
+#include <TLorentzVector.h>
+#include <TMath.h>
+#include <TMD5.h>
+#include <TObjString.h>
+
+#include <AliAnalysisManager.h>
+#include <AliLog.h>
+#include <AliVCluster.h>
+#include <AliVParticle.h>
+
+#include "AliEmcalJet.h"
+#include "AliJetContainer.h"
+
+#include "AliRhoEstimator.h"
+
+/// \cond CLASSIMP
+ClassImp(AliRhoEstimator);
+/// \endcond
+
+/**
+ * Default constructor. This constructor is only for ROOT I/O and
+ * not to be used by users.
+ */
+AliRhoEstimator::AliRhoEstimator() :
+  TNamed(),
+  fSignalJets(),
+  fSignalKeys(),
+  fNMassDefs(0),
+  fMassTypes(),
+  fMassPionClusters(),
+  fMassTracks(),
+  fMassClusters(),
+  fNSelections(0),
+  fSelFlags(),
+  fSelNExclLeadJets(),
+  fSelSignalDefs(),
+  fSelMassDefs(),
+  fNJets(0),
+  fJetStatus(),
+  fPt(),
+  fArea(),
+  fE(),
+  fM(),
+  fMd(),
+  fOverlap(),
+  fNSelectionsDone(0),
+  fSelNJets(),
+  fSelRho(),
+  fSelRhoMass(),
+  fSelOccupancy(),
+  fSelMeanE(),
+  fSelMeanM(),
+  fSelRhoMassValues(),
+  fBuffer(),
+  fProcessedEvent(-1),
+  fProcessedArray(0),
+  fNSignalDone(0),
+  fNMassDone(0)
+{
+  fSignalKeys.SetOwner(kTRUE);
+  fLeadIds[0] = fLeadIds[1] = -1;
+  fLeadPts[0] = fLeadPts[1] = 0;
+}
+
+/**
+ * Standard named constructor.
+ * @param key Key describing the jet container configuration
+ */
+AliRhoEstimator::AliRhoEstimator(const char *key) :
+  TNamed(key, key),
+  fSignalJets(),
+  fSignalKeys(),
+  fNMassDefs(0),
+  fMassTypes(),
+  fMassPionClusters(),
+  fMassTracks(),
+  fMassClusters(),
+  fNSelections(0),
+  fSelFlags(),
+  fSelNExclLeadJets(),
+  fSelSignalDefs(),
+  fSelMassDefs(),
+  fNJets(0),
+  fJetStatus(),
+  fPt(),
+  fArea(),
+  fE(),
+  fM(),
+  fMd(),
+  fOverlap(),
+  fNSelectionsDone(0),
+  fSelNJets(),
+  fSelRho(),
+  fSelRhoMass(),
+  fSelOccupancy(),
+  fSelMeanE(),
+  fSelMeanM(),
+  fSelRhoMassValues(),
+  fBuffer(),
+  fProcessedEvent(-1),
+  fProcessedArray(0),
+  fNSignalDone(0),
+  fNMassDone(0)
+{
+  fSignalKeys.SetOwner(kTRUE);
+  fLeadIds[0] = fLeadIds[1] = -1;
+  fLeadPts[0] = fLeadPts[1] = 0;
+}
+
+AliRhoEstimator *AliRhoEstimator::Request(TObjArray *sharedObjects, const AliJetContainer *jets)
+{
+  if (!sharedObjects) return 0;
+  TString key = MakeKey(jets);
+  if (key.IsNull()) return 0;
+  key.Prepend("AliRhoEstimator:");
+  AliRhoEstimator *estimator = dynamic_cast<AliRhoEstimator*>(sharedObjects->FindObject(key));
+  if (!estimator) {
+    estimator = new AliRhoEstimator(key);
+    sharedObjects->Add(estimator);
+    ::Info("AliRhoEstimator::Request", "Created rho estimator: %s", key.Data());
+  }
+  return estimator;
+}
+
+TString AliRhoEstimator::MakeKey(const AliJetContainer *jets)
+{
+  // The streamed state of a container contains the name of the jet branch and all
+  // its cut settings, so two containers with the same checksum accept the same jets
+  if (!jets) return "";
+  TBufferFile buf(TBuffer::kWrite);
+  const_cast<AliJetContainer*>(jets)->Streamer(buf);
+  if (buf.Length() <= 0) return "";
+  TMD5 md5;
+  md5.Update(reinterpret_cast<UChar_t*>(buf.Buffer()), buf.Length());
+  md5.Final();
+  return TString::Format("%s_%s", jets->GetArrayName().Data(), md5.AsString());
+}
+
+/**
+ * Register a signal jet collection. The jets overlapping with a signal jet
+ * (see IsJetSignal and IsJetOverlapping) can be excluded from the medians.
+ * @param[in] sigJets Signal jet container, connected to its array
+ * @return Index of the signal jet collection, -1 if no container is provided
+ */
+Int_t AliRhoEstimator::AddSignalJets(AliJetContainer *sigJets)
+{
+  if (!sigJets) return -1;
+
+  TString key = MakeKey(sigJets);
+  if (key.IsNull()) key = TString::Format("%p", static_cast<void*>(sigJets));
+  TObject *known = fSignalKeys.FindObject(key);
+  if (known) return fSignalKeys.IndexOf(known);
+
+  fSignalJets.Add(sigJets);
+  fSignalKeys.Add(new TObjString(key));
+  return fSignalKeys.GetEntriesFast() - 1;
+}
+
+/**
+ * Register a definition of the mass density of the jets.
+ * @param[in] type Definition of the mass density
+ * @param[in] pionMassClusters Whether the pion mass is assumed for the clusters
+ * @param[in] tracks Track array the jet constituents refer to
+ * @param[in] clusters Cluster array the jet constituents refer to
+ * @return Index of the mass definition
+ */
+Int_t AliRhoEstimator::AddMassDefinition(EMassType type, Bool_t pionMassClusters, TClonesArray *tracks, TClonesArray *clusters)
+{
+  for (Int_t i = 0; i < fNMassDefs; i++) {
+    if (fMassTypes[i] == type && fMassPionClusters[i] == pionMassClusters &&
+        fMassTracks.At(i) == tracks && fMassClusters.At(i) == clusters) return i;
+  }
+
+  fMassTypes.Set(fNMassDefs + 1);
+  fMassPionClusters.Set(fNMassDefs + 1);
+  fMassTypes[fNMassDefs] = type;
+  fMassPionClusters[fNMassDefs] = pionMassClusters;
+  fMassTracks.AddAtAndExpand(tracks, fNMassDefs);
+  fMassClusters.AddAtAndExpand(clusters, fNMassDefs);
+  return fNMassDefs++;
+}
+
+/**
+ * Register a selection of the jets entering the medians. Selections are
+ * computed once per event, whatever the number of tasks using them.
+ * @param[in] selection Requirements on the jets (EJetSelection)
+ * @param[in] nExclLeadJets Number of leading jets excluded from the medians and the occupancy, at most two
+ * @param[in] signalDef Signal jet collection (see AddSignalJets), jets overlapping with its signal jets are excluded
+ * @param[in] massDef Mass definition (see AddMassDefinition) used for the mass densities
+ * @return Index of the selection
+ */
+Int_t AliRhoEstimator::AddSelection(UInt_t selection, UInt_t nExclLeadJets, Int_t signalDef, Int_t massDef)
+{
+  if (nExclLeadJets > 2) nExclLeadJets = 2;
+  for (Int_t i = 0; i < fNSelections; i++) {
+    if (fSelFlags[i] == static_cast<Int_t>(selection) && fSelNExclLeadJets[i] == static_cast<Int_t>(nExclLeadJets) &&
+        fSelSignalDefs[i] == signalDef && fSelMassDefs[i] == massDef) return i;
+  }
+
+  Int_t n = fNSelections + 1;
+  fSelFlags.Set(n);
+  fSelNExclLeadJets.Set(n);
+  fSelSignalDefs.Set(n);
+  fSelMassDefs.Set(n);
+  fSelNJets.Set(n);
+  fSelRho.Set(n);
+  fSelRhoMass.Set(n);
+  fSelOccupancy.Set(n);
+  fSelMeanE.Set(n);
+  fSelMeanM.Set(n);
+  fSelFlags[fNSelections] = selection;
+  fSelNExclLeadJets[fNSelections] = nExclLeadJets;
+  fSelSignalDefs[fNSelections] = signalDef;
+  fSelMassDefs[fNSelections] = massDef;
+  return fNSelections++;
+}
+
+void AliRhoEstimator::Process(AliJetContainer *jets, const Double_t *vertex)
+{
+  // The number of calls of the analysis manager identifies the event (the tree entry
+  // restarts with each file). Without analysis manager the estimator is always updated
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t event = mgr ? mgr->GetNcalls() : -1;
+  const TClonesArray *array = jets ? jets->GetArray() : 0;
+
+  Int_t nSignal = fSignalJets.GetEntriesFast();
+  if (event <= 0 || event != fProcessedEvent || array != fProcessedArray ||
+      nSignal != fNSignalDone || fNMassDefs != fNMassDone) {
+    fProcessedEvent = event;
+    fProcessedArray = array;
+    Scan(jets, vertex);
+    fNSelectionsDone = 0;
+  }
+
+  // Selections registered by a task initialized in this event are computed on demand
+  if (fNSelectionsDone == fNSelections) return;
+  if (fSelRhoMassValues.GetSize() < fNSelections * fNJets) fSelRhoMassValues.Set(fNSelections * fNJets);
+  for (Int_t sel = fNSelectionsDone; sel < fNSelections; sel++) ComputeSelection(sel);
+  fNSelectionsDone = fNSelections;
+}
+
+/**
+ * Loop over the jets and keep the quantities needed by the selections.
+ * @param[in] jets Jet container used for the background estimate
+ * @param[in] vertex Event vertex, used for the cluster momenta
+ */
+void AliRhoEstimator::Scan(AliJetContainer *jets, const Double_t *vertex)
+{
+  const Int_t nSignal = fSignalJets.GetEntriesFast();
+  fNSignalDone = nSignal;
+  fNMassDone = fNMassDefs;
+  fLeadIds[0] = fLeadIds[1] = -1;
+  fLeadPts[0] = fLeadPts[1] = 0;
+
+  const TClonesArray *array = jets ? jets->GetArray() : 0;
+  fNJets = array ? array->GetEntriesFast() : 0;
+  if (fJetStatus.GetSize() < fNJets) {
+    Int_t size = fNJets < 64 ? 128 : 2 * fNJets;
+    fJetStatus.Set(size);
+    fPt.Set(size);
+    fArea.Set(size);
+    fE.Set(size);
+    fM.Set(size);
+    fBuffer.Set(size);
+  }
+  if (fMd.GetSize() < fNJets * fNMassDefs) fMd.Set(fJetStatus.GetSize() * fNMassDefs);
+  if (fOverlap.GetSize() < fNJets * nSignal) fOverlap.Set(fJetStatus.GetSize() * nSignal);
+
+  for (Int_t iJets = 0; iJets < fNJets; ++iJets) {
+    AliEmcalJet *jet = static_cast<AliEmcalJet*>(array->At(iJets));
+    if (!jet) {
+      AliError(Form("Could not receive jet %d", iJets));
+      fJetStatus[iJets] = 0;
+      continue;
+    }
+
+    fPt[iJets] = jet->Pt();
+    fArea[iJets] = jet->Area();
+
+    UInt_t rejectionReason = 0;
+    if (!jets->AcceptJet(jet, rejectionReason)) {
+      fJetStatus[iJets] = 1;
+      continue;
+    }
+    fJetStatus[iJets] = 2;
+
+    // Jets with equal transverse momentum keep the order of the jet array
+    if (jet->Pt() > fLeadPts[0]) {
+      fLeadPts[1] = fLeadPts[0];
+      fLeadIds[1] = fLeadIds[0];
+      fLeadPts[0] = jet->Pt();
+      fLeadIds[0] = iJets;
+    } else if (jet->Pt() > fLeadPts[1]) {
+      fLeadPts[1] = jet->Pt();
+      fLeadIds[1] = iJets;
+    }
+
+    fE[iJets] = jet->E();
+    fM[iJets] = jet->M();
+
+    for (Int_t iSig = 0; iSig < nSignal; iSig++) {
+      AliJetContainer *sigJets = static_cast<AliJetContainer*>(fSignalJets.At(iSig));
+      Bool_t isOverlapping = kFALSE;
+      const Int_t nJetsSig = sigJets->GetNJets();
+      for (Int_t j = 0; j < nJetsSig; j++) {
+        AliEmcalJet *signalJet = sigJets->GetAcceptJet(j);
+        if (!signalJet) continue;
+        if (!IsJetSignal(signalJet)) continue;
+        if (IsJetOverlapping(signalJet, jet)) {
+          isOverlapping = kTRUE;
+          break;
+        }
+      }
+      fOverlap[iJets * nSignal + iSig] = isOverlapping;
+    }
+
+    // The mass densities are only needed for jets with a positive area
+    for (Int_t iMass = 0; iMass < fNMassDefs; iMass++) {
+      fMd[iJets * fNMassDefs + iMass] = jet->Area() > 0. ?
+          GetMd(jet, static_cast<TClonesArray*>(fMassTracks.At(iMass)), static_cast<TClonesArray*>(fMassClusters.At(iMass)),
+                vertex, static_cast<EMassType>(fMassTypes[iMass]), fMassPionClusters[iMass]) : 0.;
+    }
+  }
+}
+
+/**
+ * Compute the medians, means and occupancy of a selection from the
+ * per-jet quantities of the current event.
+ * @param[in] sel Index of the selection
+ */
+void AliRhoEstimator::ComputeSelection(Int_t sel)
+{
+  const Int_t nSignal = fNSignalDone;
+  const UInt_t flags = fSelFlags[sel];
+  const Int_t nExcl = fSelNExclLeadJets[sel];
+  const Int_t sig = fSelSignalDefs[sel];
+  const Int_t mass = fSelMassDefs[sel];
+  Double_t *rhom = fSelRhoMassValues.GetArray() + sel * fNJets;
+
+  Int_t n = 0;
+  Double_t totalArea = 0;
+  Double_t totalAreaPhys = 0;
+  Double_t sumE = 0;
+  Double_t sumM = 0;
+  for (Int_t iJets = 0; iJets < fNJets; ++iJets) {
+    if (fJetStatus[iJets] == 0) continue;
+    if (nExcl > 0 && iJets == fLeadIds[0]) continue;
+    if (nExcl > 1 && iJets == fLeadIds[1]) continue;
+
+    // All jets enter the occupancy, ghost jets with no physical area
+    totalArea += fArea[iJets];
+    if (fPt[iJets] > 0.1) totalAreaPhys += fArea[iJets];
+
+    if (fJetStatus[iJets] != 2) continue;
+    if (sig >= 0 && fOverlap[iJets * nSignal + sig]) continue;
+    if ((flags & kPhysicalJets) && fPt[iJets] <= 0.1) continue;
+    if ((flags & kPositiveArea) && fArea[iJets] <= 0.) continue;
+
+    fBuffer[n] = fPt[iJets] / fArea[iJets];
+    rhom[n] = mass >= 0 ? fMd[iJets * fNMassDefs + mass] / fArea[iJets] : 0.;
+    sumE += fE[iJets];
+    sumM += fM[iJets];
+    n++;
+  }
+
+  fSelNJets[sel] = n;
+  fSelOccupancy[sel] = totalArea > 0 ? totalAreaPhys / totalArea : 0;
+  fSelMeanE[sel] = n > 0 ? sumE / n : 0;
+  fSelMeanM[sel] = n > 0 ? sumM / n : 0;
+  fSelRho[sel] = Median(n, fBuffer.GetArray());
+  for (Int_t i = 0; i < n; i++) fBuffer[i] = rhom[i];
+  fSelRhoMass[sel] = Median(n, fBuffer.GetArray());
+}
+
+/**
+ * Signal jets used for the overlap removal in sparse events.
+ * @param[in] jet Jet of the signal collection
+ * @return Whether the jet is a signal jet
+ */
+Bool_t AliRhoEstimator::IsJetSignal(const AliEmcalJet *jet)
+{
+  return jet->Pt() > 5;
+}
+
+/**
+ * Whether two jets share a track.
+ * @param[in] jet1 First jet
+ * @param[in] jet2 Second jet
+ * @return kTRUE if the jets have a common track
+ */
+Bool_t AliRhoEstimator::IsJetOverlapping(const AliEmcalJet *jet1, const AliEmcalJet *jet2)
+{
+  for (Int_t i = 0; i < jet1->GetNumberOfTracks(); ++i) {
+    Int_t jet1Track = jet1->TrackAt(i);
+    for (Int_t j = 0; j < jet2->GetNumberOfTracks(); ++j) {
+      if (jet1Track == jet2->TrackAt(j)) return kTRUE;
+    }
+  }
+  return kFALSE;
+}
+
+/**
+ * Mass density \f$ m_{\delta} \f$ of a jet as defined in http://arxiv.org/pdf/1211.2811.pdf
+ * @param[in] jet Jet
+ * @param[in] tracks Track array the jet constituents refer to
+ * @param[in] clusters Cluster array the jet constituents refer to
+ * @param[in] vertex Event vertex, used for the cluster momenta
+ * @param[in] type Definition of the mass density
+ * @param[in] pionMassClusters Whether the pion mass is assumed for the clusters
+ * @return \f$ m_{\delta} \f$ of the jet
+ */
+Double_t AliRhoEstimator::GetMd(const AliEmcalJet *jet, TClonesArray *tracks, TClonesArray *clusters, const Double_t *vertex,
+                                EMassType type, Bool_t pionMassClusters)
+{
+  Double_t sum = 0.;
+  Double_t px = 0.;
+  Double_t py = 0.;
+  Double_t pz = 0.;
+  Double_t E = 0.;
+
+  if (tracks) {
+    AliVParticle *vp;
+    for(Int_t icc=0; icc<jet->GetNumberOfTracks(); icc++) {
+      vp = static_cast<AliVParticle*>(jet->TrackAt(icc, tracks));
+      if(!vp) continue;
+      if(type==kMd) sum += TMath::Sqrt(vp->M()*vp->M() + vp->Pt()*vp->Pt()) - vp->Pt(); //sqrt(E^2-P^2+pt^2)=sqrt(E^2-pz^2)
+      else if(type==kMdP) sum += TMath::Sqrt(vp->M()*vp->M() + vp->P()*vp->P()) - vp->P();
+      else if(type==kMd4) {
+        px+=vp->Px();
+        py+=vp->Py();
+        pz+=vp->Pz();
+        E+=vp->E();
+      }
+    }
+  }
+
+  if (clusters) {
+    AliVCluster *vp;
+    for(Int_t icc=0; icc<jet->GetNumberOfClusters(); icc++) {
+      vp = static_cast<AliVCluster*>(jet->ClusterAt(icc, clusters));
+      if(!vp) continue;
+      TLorentzVector nPart;
+      vp->GetMomentum(nPart, vertex);
+      Double_t m = 0.;
+      if(pionMassClusters) m = 0.13957;
+      if(type==kMd) sum += TMath::Sqrt(m*m + nPart.Pt()*nPart.Pt()) - nPart.Pt();
+      else if(type==kMdP) sum += TMath::Sqrt(nPart.M()*nPart.M() + nPart.P()*nPart.P()) - nPart.P();
+      else if(type==kMd4) {
+        px+=nPart.Px();
+        py+=nPart.Py();
+        pz+=nPart.Pz();
+        E+=nPart.E();
+      }
+    }
+  }
+
+  if(type==kMd4) {
+    Double_t pt = TMath::Sqrt(px*px + py*py);
+    Double_t m2 = E*E - pt*pt - pz*pz;
+    sum = TMath::Sqrt(m2 + pt*pt) - pt;
+  }
+  return sum;
+}
+
+/**
+ * Median by selection. For an even number of values the average of the
+ * two central values is returned, as in TMath::Median.
+ * @param[in] n Number of values
+ * @param[in,out] values Values, reordered on return
+ * @return Median, 0 if there are no values
+ */
+Double_t AliRhoEstimator::Median(Int_t n, Double_t *values)
+{
+  if (n <= 0) return 0;
+
+  Double_t *mid = values + n / 2;
+  std::nth_element(values, mid, values + n);
+  if (n % 2 == 1) return *mid;
+
+  // after the selection all values below mid are smaller or equal
+  return 0.5 * (*std::max_element(values, mid) + *mid);
+}
+
+/**
+ * Arithmetic mean, summed in the order of the values as in TMath::Mean.
+ * @param[in] n Number of values
+ * @param[in] values Values
+ * @return Mean, 0 if there are no values
+ */
+Double_t AliRhoEstimator::Mean(Int_t n, const Double_t *values)
+{
+  if (n <= 0) return 0;
+
+  Double_t sum = 0;
+  for (Int_t i = 0; i < n; i++) sum += values[i];
+  return sum / n;
+}
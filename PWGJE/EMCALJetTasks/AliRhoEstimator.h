@@ -0,0 +1,176 @@
+#ifndef ALIRHOESTIMATOR_H
+#define ALIRHOESTIMATOR_H
+
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+class TClonesArray;
+class AliEmcalJet;
+class AliJetContainer;
+
+#include <TArrayD.h>
+#include <TArrayI.h>
+#include <TNamed.h>
+#include <TObjArray.h>
+
+/**
+ * @class AliRhoEstimator
+ * @brief Event-by-event background estimate from the kt jets of an event
+ *
+ * The rho tasks of a train (AliAnalysisTaskRho, AliAnalysisTaskRhoSparse,
+ * AliAnalysisTaskRhoMass, AliAnalysisTaskRhoMassSparse) usually run on the same kt
+ * jet collection. The estimator loops once per event over this collection and keeps,
+ * for each jet, everything these tasks need: the acceptance, the \f$ p_{T} \f$,
+ * area, energy and mass, the mass density \f$ m_{\delta} \f$ of each registered
+ * mass definition and the overlap with each registered signal jet collection. The
+ * two leading accepted jets are found in the same loop.
+ *
+ * The tasks register their selection (see AddSelection) when they are initialized.
+ * For each selection the estimator computes, once per event, the medians \f$ \rho \f$
+ * and \f$ \rho_{m} \f$, the mean energy and mass of the jets entering the medians and
+ * the occupancy correction for sparse events (https://arxiv.org/abs/1207.2392). The
+ * tasks only read these cached results.
+ *
+ * Estimators are identified by a key describing the configuration of the jet container
+ * (see MakeKey). Tasks with the same key share one estimator, kept in the list of objects
+ * shared by the EMCal tasks of the analysis manager (see
+ * AliAnalysisTaskEmcal::GetSharedObjects). The estimator is updated once per call of
+ * the analysis manager (AliAnalysisManager::GetNcalls).
+ *
+ * Typical use in a rho task:
+ * ~~~{.cxx}
+ * // ExecOnce()
+ * fRhoEstimator = AliRhoEstimator::Request(GetSharedObjects(), GetJetContainer(0));
+ * fRhoSelection = fRhoEstimator->AddSelection(AliRhoEstimator::kPhysicalJets, fNExclLeadJets,
+ *                                             fRhoEstimator->AddSignalJets(GetJetContainer(1)));
+ * // Run()
+ * fRhoEstimator->Process(GetJetContainer(0), fVertex);
+ * Double_t rho = fRhoEstimator->GetRho(fRhoSelection) * fRhoEstimator->GetOccupancy(fRhoSelection);
+ * ~~~
+ */
+class AliRhoEstimator : public TNamed {
+ public:
+  /**
+   * @enum EJetSelection
+   * @brief Requirements on the jets entering the medians of a selection
+   */
+  enum EJetSelection {
+    kPhysicalJets   = BIT(0),          ///< Only jets with \f$ p_{T} > 0.1 \f$ GeV/c (no ghost jets)
+    kPositiveArea   = BIT(1)           ///< Only jets with a positive area
+  };
+
+  /**
+   * @enum EMassType
+   * @brief Definitions of the mass density, values as in AliAnalysisTaskRhoMass::JetRhoMassType
+   */
+  enum EMassType {
+    kMd     = 0,                       ///< rho_m from arXiv:1211.2811
+    kMdP    = 1,                       ///< rho_m using P instead of pT
+    kMd4    = 2                        ///< rho_m using addition of 4-vectors
+  };
+
+  AliRhoEstimator();
+  AliRhoEstimator(const char *key);
+  virtual ~AliRhoEstimator() {}
+
+  /**
+   * Get the estimator for a jet container configuration from a list of shared
+   * objects. If no estimator with this key exists a new one is created and added
+   * @param[in] sharedObjects List of shared objects (owner of the estimators)
+   * @param[in] jets Jet container used for the background estimate
+   * @return Shared estimator, NULL if no list is provided or the container could not be serialized
+   */
+  static AliRhoEstimator *Request(TObjArray *sharedObjects, const AliJetContainer *jets);
+
+  /**
+   * Build the key of a jet container configuration from its persistent state
+   * (i.e. the jet branch and all cut settings)
+   * @param[in] jets Jet container
+   * @return Key, empty if the container could not be serialized
+   */
+  static TString MakeKey(const AliJetContainer *jets);
+
+  Int_t           AddSignalJets(AliJetContainer *sigJets);
+  Int_t           AddMassDefinition(EMassType type, Bool_t pionMassClusters, TClonesArray *tracks, TClonesArray *clusters);
+  Int_t           AddSelection(UInt_t selection, UInt_t nExclLeadJets, Int_t signalDef = -1, Int_t massDef = -1);
+
+  /**
+   * Loop over the jets and compute the results of all selections, unless
+   * this was already done for the current event of the analysis manager
+   * @param[in] jets Jet container used for the background estimate
+   * @param[in] vertex Event vertex, used for the cluster momenta
+   */
+  void            Process(AliJetContainer *jets, const Double_t *vertex);
+
+  Int_t           GetNJets(Int_t sel)              const { return fSelNJets[sel]                     ; }
+  Double_t        GetRho(Int_t sel)                const { return fSelRho[sel]                       ; }
+  Double_t        GetRhoMass(Int_t sel)            const { return fSelRhoMass[sel]                   ; }
+  Double_t        GetRhoMassAt(Int_t sel, Int_t i) const { return fSelRhoMassValues[sel * fNJets + i]; }
+  Double_t        GetOccupancy(Int_t sel)          const { return fSelOccupancy[sel]                 ; }
+  Double_t        GetMeanE(Int_t sel)              const { return fSelMeanE[sel]                     ; }
+  Double_t        GetMeanM(Int_t sel)              const { return fSelMeanM[sel]                     ; }
+  Int_t           GetLeadJetIndex(Int_t i)         const { return fLeadIds[i]                        ; }
+
+  static Bool_t   IsJetSignal(const AliEmcalJet *jet);
+  static Bool_t   IsJetOverlapping(const AliEmcalJet *jet1, const AliEmcalJet *jet2);
+  static Double_t GetMd(const AliEmcalJet *jet, TClonesArray *tracks, TClonesArray *clusters, const Double_t *vertex,
+                        EMassType type, Bool_t pionMassClusters);
+
+  static Double_t Median(Int_t n, Double_t *values);
+  static Double_t Mean(Int_t n, const Double_t *values);
+
+ protected:
+  void            Scan(AliJetContainer *jets, const Double_t *vertex);
+  void            ComputeSelection(Int_t sel);
+
+  // Registered signal jet collections, mass definitions and selections
+  TObjArray       fSignalJets;              //!<! Signal jet containers (not owned)
+  TObjArray       fSignalKeys;              //!<! Keys of the signal jet containers
+  Int_t           fNMassDefs;               //!<! Number of mass definitions
+  TArrayI         fMassTypes;               //!<! Mass density definitions (EMassType)
+  TArrayI         fMassPionClusters;        //!<! Whether the pion mass is assumed for clusters
+  TObjArray       fMassTracks;              //!<! Track arrays of the mass definitions (not owned)
+  TObjArray       fMassClusters;            //!<! Cluster arrays of the mass definitions (not owned)
+  Int_t           fNSelections;             //!<! Number of selections
+  TArrayI         fSelFlags;                //!<! Jet requirements of the selections (EJetSelection)
+  TArrayI         fSelNExclLeadJets;        //!<! Number of excluded leading jets of the selections
+  TArrayI         fSelSignalDefs;           //!<! Signal jet collections of the selections (-1 for none)
+  TArrayI         fSelMassDefs;             //!<! Mass definitions of the selections (-1 for none)
+
+  // Per-jet quantities of the current event, indexed by the position in the jet array
+  Int_t           fNJets;                   //!<! Number of jets in the jet array
+  TArrayI         fJetStatus;               //!<! 0: missing jet, 1: rejected, 2: accepted
+  TArrayD         fPt;                      //!<! Transverse momenta
+  TArrayD         fArea;                    //!<! Jet areas
+  TArrayD         fE;                       //!<! Jet energies
+  TArrayD         fM;                       //!<! Jet masses
+  TArrayD         fMd;                      //!<! Mass densities m_delta, one per jet and mass definition
+  TArrayI         fOverlap;                 //!<! Overlap with signal jets, one per jet and signal collection
+  Int_t           fLeadIds[2];              //!<! Indices of the two leading accepted jets
+  Double_t        fLeadPts[2];              //!<! Transverse momenta of the two leading accepted jets
+
+  // Results of the selections for the current event
+  Int_t           fNSelectionsDone;         //!<! Number of selections computed for the current event
+  TArrayI         fSelNJets;                //!<! Number of jets entering the medians
+  TArrayD         fSelRho;                  //!<! Median pT densities
+  TArrayD         fSelRhoMass;              //!<! Median mass densities
+  TArrayD         fSelOccupancy;            //!<! Occupancy corrections
+  TArrayD         fSelMeanE;                //!<! Mean energies of the jets entering the medians
+  TArrayD         fSelMeanM;                //!<! Mean masses of the jets entering the medians
+  TArrayD         fSelRhoMassValues;        //!<! Mass densities of the jets entering the medians, fNJets per selection
+  TArrayD         fBuffer;                  //!<! Work buffer for the medians, reordered by the selection
+
+  Long64_t        fProcessedEvent;          //!<! Call of the analysis manager processed last
+  const TClonesArray *fProcessedArray;      //!<! Jet array processed last
+  Int_t           fNSignalDone;             //!<! Number of signal collections in the last loop over the jets
+  Int_t           fNMassDone;               //!<! Number of mass definitions in the last loop over the jets
+
+ private:
+  AliRhoEstimator(const AliRhoEstimator&);            // not implemented
+  AliRhoEstimator &operator=(const AliRhoEstimator&); // not implemented
+
+  /// \cond CLASSIMP
+  ClassDef(AliRhoEstimator, 2);
+  /// \endcond
+};
+#endif
@@ -60,7 +60,12 @@ AliFMDDensityCalculator::AliFMDDensityCalculator()
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fStripEta(),
+    fStripCut(),
+    fStripMaxWeight(),
+    fStripAcc(),
+    fStripFits()
 {
   // 
   // Constructor 
@@ -98,7 +103,12 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const char* title)
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fStripEta(),
+    fStripCut(),
+    fStripMaxWeight(),
+    fStripAcc(),
+    fStripFits()
 {
   // 
   // Constructor 
@@ -167,7 +177,12 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const
     fDoTiming(o.fDoTiming),
     fHTiming(o.fHTiming), 
   fMaxOutliers(o.fMaxOutliers),
-  fOutlierCut(o.fOutlierCut)
+  fOutlierCut(o.fOutlierCut),
+  fStripEta(),
+  fStripCut(),
+  fStripMaxWeight(),
+  fStripAcc(),
+  fStripFits()
 {
   // 
   // Copy constructor 
@@ -430,13 +445,16 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
       // etaCache.Reset(AliESDFMD::kInvalidEta);
       // phiCache.Reset(AliESDFMD::kInvalidEta);
 
+      // Look up eta, cuts, fits, and acceptance once per strip 
+      FillStripTable(fmd, d, r, nt, lowFlux);
+
       // --- Loop over sectors and strips ----------------------------
       for (UShort_t s=0; s<ns; s++) { 
 	for (UShort_t t=0; t<nt; t++) {
 	  
 	  Float_t  mult   = fmd.Multiplicity(d,r,s,t);
 	  Double_t phi    = fmd.Phi(d,r,s,t) * TMath::DegToRad();
-	  Double_t eta    = fmd.Eta(d,r,s,t);
+	  Double_t eta    = fStripEta[t];
 	  Double_t oldPhi = phi;
 	  Double_t oldEta = eta;
 	  START_TIMER(timer);
@@ -455,6 +473,8 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 		 ip.X(), ip.Y(), ip.Z(), oldEta, eta, oldPhi, phi);
 	  }
 	  ADD_TIMER(timer,rePhiTime);
+	  // Only use the strip table if eta was not re-calculated 
+	  Bool_t   tabled = (eta == fStripEta[t]);
 	  START_TIMER(timer);
 	  etaCache[s*nt+t] = eta;
 	  phiCache[s*nt+t] = phi;
@@ -485,18 +505,26 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 
 	  // --- Apply phi corner correction to eloss ----------------
 	  if (fUsePhiAcceptance == kPhiCorrectELoss) 
-	    mult *= AcceptanceCorrection(r,t);
+	    mult *= fStripAcc[t];
 
 	  // --- Get the low multiplicity cut ------------------------
 	  Double_t cut  = 1024;
-	  if (eta != AliESDFMD::kInvalidEta) cut = GetMultCut(d, r, eta,false);
+	  if (eta != AliESDFMD::kInvalidEta) 
+	    cut = (tabled ? fStripCut[t] : GetMultCut(d, r, eta,false));
 	  else AliWarningF("Eta for FMD%d%c[%02d,%03d] is invalid: %f", 
 			   d, r, s, t, eta);
 
 	  // --- Now caluculate Nch for this strip using fits --------
 	  START_TIMER(timer);
 	  Double_t n   = 0;
-	  if (cut > 0 && mult > cut) n = NParticles(mult,d,r,eta,lowFlux);
+	  if (cut > 0 && mult > cut) {
+	    if (tabled) 
+	      n = NParticlesFromFit(mult, static_cast<AliFMDCorrELossFit::ELossFit*>
+				    (fStripFits.UncheckedAt(t)), 
+				    fStripMaxWeight[t], d, r, eta, lowFlux);
+	    else 
+	      n = NParticles(mult,d,r,eta,lowFlux);
+	  }
 	  rh->fELoss->Fill(mult);
 	  // rh->fEvsN->Fill(mult,n);
 	  // rh->fEtaVsN->Fill(eta, n);
@@ -507,7 +535,7 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	  // Temporary stuff - remove Correction call 
 	  Double_t c = 1;
 	  if (fUsePhiAcceptance == kPhiCorrectNch) 
-	    c = AcceptanceCorrection(r,t);
+	    c = fStripAcc[t];
 	  // Double_t c = Correction(d,r,t,eta,lowFlux);
 	  ADD_TIMER(timer,corrTime);
 	  fCorrections->Fill(c);
@@ -865,13 +893,44 @@ AliFMDDensityCalculator::NParticles(Float_t  mult,
   
   AliForwardCorrectionManager&  fcm = AliForwardCorrectionManager::Instance();
   AliFMDCorrELossFit::ELossFit* fit = fcm.GetELossFit()->FindFit(d,r,eta, -1);
+  Int_t                         m   = (fit ? GetMaxWeight(d,r,eta) : 0);
+  return NParticlesFromFit(mult, fit, m, d, r, eta, lowFlux);
+}
+
+//_____________________________________________________________________
+Float_t 
+AliFMDDensityCalculator::NParticlesFromFit(Float_t                       mult, 
+					   AliFMDCorrELossFit::ELossFit* fit,
+					   Int_t                         m,
+					   UShort_t                      d, 
+					   Char_t                        r, 
+					   Float_t                       eta,
+					   Bool_t                        lowFlux) const
+{
+  // 
+  // Get the number of particles corresponding to the signal mult, 
+  // given the energy loss fit and maximum weight at eta
+  // 
+  // Parameters:
+  //    mult     Signal
+  //    fit      Energy loss fit (may be null)
+  //    m        Maximum weight 
+  //    d        Detector
+  //    r        Ring 
+  //    eta      Pseudo-rapidity 
+  //    lowFlux  Low-flux flag 
+  // 
+  // Return:
+  //    The number of particles 
+  //
+  if (lowFlux) return 1;
+  
   if (!fit) { 
     AliWarning(Form("No energy loss fit for FMD%d%c at eta=%f qual=%d", 
 		    d, r, eta, fMinQuality));
     return 0;
   }
   
-  Int_t    m   = GetMaxWeight(d,r,eta); // fit->FindMaxWeight();
   if (m < 1) { 
     AliWarning(Form("No good fits for FMD%d%c at eta=%f", d, r, eta));
     return 0;
@@ -890,6 +949,52 @@ AliFMDDensityCalculator::NParticles(Float_t  mult,
   return ret;
 }
 
+//_____________________________________________________________________
+void
+AliFMDDensityCalculator::FillStripTable(const AliESDFMD& fmd, 
+					UShort_t         d, 
+					Char_t           r, 
+					UShort_t         nt, 
+					Bool_t           lowFlux)
+{
+  // 
+  // Fill the per-strip table of a ring for this event 
+  // 
+  // Parameters:
+  //    fmd      ESD object 
+  //    d        Detector
+  //    r        Ring 
+  //    nt       Number of strips 
+  //    lowFlux  Low-flux flag - no fits needed 
+  //
+  DGUARD(fDebug, 3, "Fill strip table in FMD density calculator");
+  if (fStripEta.GetSize() < nt) { 
+    fStripEta.Set(nt);
+    fStripCut.Set(nt);
+    fStripMaxWeight.Set(nt);
+    fStripAcc.Set(nt);
+    fStripFits.Expand(nt);
+  }
+  const AliFMDCorrELossFit* cor = 0;
+  if (!lowFlux) cor = AliForwardCorrectionManager::Instance().GetELossFit();
+
+  for (UShort_t t = 0; t < nt; t++) { 
+    // The ESD eta only depends on the strip number 
+    Double_t eta      = fmd.Eta(d,r,0,t);
+    // Fit look-ups are done with a single precision eta, as in NParticles 
+    Float_t  feta     = eta;
+    AliFMDCorrELossFit::ELossFit* fit = 0;
+    if (cor) fit = cor->FindFit(d,r,feta, -1);
+    fStripEta[t]       = eta;
+    fStripCut[t]       = (eta != AliESDFMD::kInvalidEta ? 
+			  GetMultCut(d, r, eta, false) : 1024);
+    fStripMaxWeight[t] = (fit ? GetMaxWeight(d,r,feta) : 0);
+    fStripAcc[t]       = (fUsePhiAcceptance != kPhiNoCorrect ? 
+			  AcceptanceCorrection(r,t) : 1);
+    fStripFits.AddAt(fit, t);
+  }
+}
+
 //_____________________________________________________________________
 Float_t 
 AliFMDDensityCalculator::Correction(UShort_t d, 
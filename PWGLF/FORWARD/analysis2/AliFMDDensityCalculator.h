@@ -16,9 +16,13 @@
 #include <TNamed.h>
 #include <TList.h>
 #include <TArrayI.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
+#include <TObjArray.h>
 #include <TVector3.h>
 #include "AliForwardUtil.h"
 #include "AliFMDMultCuts.h"
+#include "AliFMDCorrELossFit.h"
 #include "AliPoissonCalculator.h"
 class AliESDFMD;
 class TH2D;
@@ -336,6 +340,44 @@ protected:
 			     Char_t   r, 
 			     Float_t  eta, 
 			     Bool_t   lowFlux) const;
+  /** 
+   * Get the number of particles corresponding to the signal mult,
+   * given the energy loss fit and maximum weight already looked up
+   * (see FillStripTable)
+   * 
+   * @param mult      Signal
+   * @param fit       Energy loss fit at @a eta (may be null)
+   * @param maxWeight Maximum weight at @a eta 
+   * @param d         Detector
+   * @param r         Ring 
+   * @param eta       Pseudo-rapidity 
+   * @param lowFlux   Low-flux flag 
+   * 
+   * @return The number of particles 
+   */
+  Float_t NParticlesFromFit(Float_t                       mult, 
+			    AliFMDCorrELossFit::ELossFit* fit,
+			    Int_t                         maxWeight,
+			    UShort_t                      d, 
+			    Char_t                        r, 
+			    Float_t                       eta, 
+			    Bool_t                        lowFlux) const;
+  /** 
+   * Fill the per-strip table of a ring for this event: the strip
+   * @f$\eta@f$, the multiplicity cut, the energy loss fit, the
+   * maximum weight, and the acceptance correction.  The
+   * pseudo-rapidity stored in the ESD only depends on the strip
+   * (not on the sector), so these are looked up once per strip
+   * instead of once per sector and strip.
+   * 
+   * @param fmd      ESD object 
+   * @param d        Detector
+   * @param r        Ring
+   * @param nt       Number of strips 
+   * @param lowFlux  Low-flux flag (no fits needed)
+   */
+  void FillStripTable(const AliESDFMD& fmd, UShort_t d, Char_t r, 
+		      UShort_t nt, Bool_t lowFlux);
   /** 
    * Get the inverse correction factor.  This consist of
    * 
@@ -504,8 +546,13 @@ protected:
   TProfile*              fHTiming;
   Double_t               fMaxOutliers; // Maximum ratio of outlier bins 
   Double_t               fOutlierCut;  // Maximum relative diviation 
+  TArrayD                fStripEta;       //! Strip eta of current ring
+  TArrayD                fStripCut;       //! Strip mult. cut of current ring
+  TArrayI                fStripMaxWeight; //! Strip max weight of current ring
+  TArrayF                fStripAcc;       //! Strip acceptance of current ring
+  TObjArray              fStripFits;      //! Strip ELoss fits of current ring
 
-  ClassDef(AliFMDDensityCalculator,16); // Calculate Nch density 
+  ClassDef(AliFMDDensityCalculator,17); // Calculate Nch density 
 };
 
 #endif
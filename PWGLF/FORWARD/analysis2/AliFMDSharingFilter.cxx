@@ -65,7 +65,12 @@ AliFMDSharingFilter::AliFMDSharingFilter()
     fUseSimpleMerging(false),
     fThreeStripSharing(true),
     fMergingDisabled(false),
-    fIgnoreESDForAngleCorrection(false)
+    fIgnoreESDForAngleCorrection(false),
+    fStripEta(),
+    fStripLowCut(),
+    fStripHighCut(),
+    fStripAngle(),
+    fSectorSignal()
 {
   // 
   // Default Constructor - do not use 
@@ -89,7 +94,12 @@ AliFMDSharingFilter::AliFMDSharingFilter(const char* title)
     fUseSimpleMerging(false),
     fThreeStripSharing(true),
     fMergingDisabled(false),
-    fIgnoreESDForAngleCorrection(false)
+    fIgnoreESDForAngleCorrection(false),
+    fStripEta(),
+    fStripLowCut(),
+    fStripHighCut(),
+    fStripAngle(),
+    fSectorSignal()
 {
   // 
   // Constructor 
@@ -215,6 +225,15 @@ AliFMDSharingFilter::Filter(const AliESDFMD& input,
   Int_t nDouble    = 0;
   Int_t nTriple    = 0;
 
+  // Whether to angle correct (1), de-correct (-1), or take the
+  // signals as is (0) - see SignalInStrip
+  Int_t angleMode = 0;
+  if (!(fCorrectAngles && 
+	(fIgnoreESDForAngleCorrection || input.IsAngleCorrected())) && 
+      !(!fCorrectAngles && 
+	!fIgnoreESDForAngleCorrection && !input.IsAngleCorrected()))
+    angleMode = (fCorrectAngles ? 1 : -1);
+
   for(UShort_t d = 1; d <= 3; d++) {
     Int_t nRings = (d == 1 ? 1 : 2);
     for (UShort_t q = 0; q < nRings; q++) {
@@ -222,8 +241,11 @@ AliFMDSharingFilter::Filter(const AliESDFMD& input,
       UShort_t    nsec   = (q == 0 ?  20 :  40);
       UShort_t    nstr   = (q == 0 ? 512 : 256);
       RingHistos* histos = GetRingHistos(d, r);
+      FillStripTable(input, d, r, nstr);
       
       for(UShort_t s = 0; s < nsec;  s++) {	
+	ReadSector(input, d, r, s, nstr, angleMode);
+	const Float_t* signals = fSectorSignal.GetArray();
 	// `used' flags if the _current_ strip was used by _previous_ 
 	// iteration. 
 	Bool_t   used            = kFALSE;
@@ -241,15 +263,16 @@ AliFMDSharingFilter::Filter(const AliESDFMD& input,
 	  // nDistanceAfter++;
 
 	  output.SetMultiplicity(d,r,s,t,0.);
-	  Float_t mult         = SignalInStrip(input,d,r,s,t);
-	  Float_t multNext     = (t<nstr-1) ? SignalInStrip(input,d,r,s,t+1) :0;
-	  Float_t multNextNext = (t<nstr-2) ? SignalInStrip(input,d,r,s,t+2) :0;
+	  // Past the last strip, the signals are 0
+	  Float_t mult         = signals[t];
+	  Float_t multNext     = signals[t+1];
+	  Float_t multNextNext = signals[t+2];
 	  if (multNext     ==  AliESDFMD::kInvalidMult) multNext     = 0;
 	  if (multNextNext ==  AliESDFMD::kInvalidMult) multNextNext = 0;
 	  if(!fThreeStripSharing) multNextNext = 0;
 
 	  // Get the pseudo-rapidity 
-	  Double_t eta = input.Eta(d,r,s,t);
+	  Double_t eta = fStripEta[t];
 	  Double_t phi = input.Phi(d,r,s,t) * TMath::Pi() / 180.;
 	  if (s == 0) output.SetEta(d,r,s,t,eta);
 	  
@@ -262,8 +285,8 @@ AliFMDSharingFilter::Filter(const AliESDFMD& input,
 	    mult = AliESDFMD::kInvalidMult;
 	  }
 	  
-	  Double_t lowCut  = GetLowCut(d, r, eta);
-	  Double_t highCut = GetHighCut(d, r, eta, false);
+	  Double_t lowCut  = fStripLowCut[t];
+	  Double_t highCut = fStripHighCut[t];
 	  if (mult != AliESDFMD::kInvalidMult && mult > lowCut) {
 	    // Always fill the ESD sum histogram 
 	    histos->fSumESD->Fill(eta, phi, mult);
@@ -405,7 +428,7 @@ AliFMDSharingFilter::Filter(const AliESDFMD& input,
 	  } // if (!fMergingDisabled)
 
 	  if (!fCorrectAngles)
-	    mergedEnergy = AngleCorrect(mergedEnergy, eta);
+	    mergedEnergy *= fStripAngle[t]; // AngleCorrect(mergedEnergy, eta)
 	  // if (mergedEnergy > 0) histos->Incr();
 	  
 	  if (t != 0) 
@@ -470,6 +493,73 @@ AliFMDSharingFilter::SignalInStrip(const AliESDFMD& input,
   return mult;
 }
 
+//_____________________________________________________________________
+void
+AliFMDSharingFilter::FillStripTable(const AliESDFMD& input, 
+				    UShort_t         d,
+				    Char_t           r,
+				    UShort_t         nstr)
+{
+  // 
+  // Fill the per-strip table of a ring for this event 
+  // 
+  // Parameters:
+  //    input ESD object
+  //    d     Detector
+  //    r     Ring 
+  //    nstr  Number of strips 
+  //
+  if (fStripEta.GetSize() < nstr) { 
+    fStripEta.Set(nstr);
+    fStripLowCut.Set(nstr);
+    fStripHighCut.Set(nstr);
+    fStripAngle.Set(nstr);
+    fSectorSignal.Set(nstr+2);
+  }
+  for (UShort_t t = 0; t < nstr; t++) { 
+    // The ESD eta only depends on the strip number 
+    Double_t eta    = input.Eta(d,r,0,t);
+    fStripEta[t]     = eta;
+    fStripLowCut[t]  = GetLowCut(d, r, eta);
+    fStripHighCut[t] = GetHighCut(d, r, eta, false);
+    fStripAngle[t]   = AngleCorrect(1, eta);
+  }
+}
+
+//_____________________________________________________________________
+void
+AliFMDSharingFilter::ReadSector(const AliESDFMD& input, 
+				UShort_t         d,
+				Char_t           r,
+				UShort_t         s,
+				UShort_t         nstr, 
+				Int_t            angleMode)
+{
+  // 
+  // Read the signals of a sector, (de-)correcting for the angle as
+  // done by SignalInStrip
+  // 
+  // Parameters:
+  //    input     ESD object
+  //    d         Detector
+  //    r         Ring 
+  //    s         Sector 
+  //    nstr      Number of strips 
+  //    angleMode 0: as is, 1: correct, -1: de-correct 
+  //
+  Float_t* signals = fSectorSignal.GetArray();
+  for (UShort_t t = 0; t < nstr; t++) { 
+    Double_t mult = input.Multiplicity(d,r,s,t);
+    if (angleMode != 0 && mult != AliESDFMD::kInvalidMult && mult != 0) { 
+      if (angleMode > 0) mult *= fStripAngle[t];
+      else               mult /= fStripAngle[t];
+    }
+    signals[t] = mult;
+  }
+  signals[nstr]   = 0;
+  signals[nstr+1] = 0;
+}
+
 namespace {
   Double_t Rng2Cut(UShort_t d, Char_t r, Double_t eta, TH2* h) {
     Double_t ret = 1024;
@@ -19,6 +19,8 @@
 #include <TNamed.h>
 #include <TH2.h>
 #include <TList.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
 #include "AliForwardUtil.h"
 #include "AliFMDMultCuts.h"
 class AliESDFMD;
@@ -233,7 +235,9 @@ protected:
   /** 
    * Copy constructor - not implemented
    */
-  AliFMDSharingFilter(const AliFMDSharingFilter& o) : TNamed(o) {}
+  AliFMDSharingFilter(const AliFMDSharingFilter& o) 
+    : TNamed(o), fStripEta(), fStripLowCut(), fStripHighCut(), 
+      fStripAngle(), fSectorSignal() {}
   /** 
    * Assignment operator  - not implemented
    * 
@@ -359,6 +363,35 @@ protected:
    * @return Angle un-corrected signal 
    */
   Double_t DeAngleCorrect(Double_t mult, Double_t eta) const;
+  /** 
+   * Fill the per-strip table of a ring for this event: the strip
+   * @f$\eta@f$, the low and high cuts, and the angle correction
+   * factor.  The pseudo-rapidity stored in the ESD only depends on
+   * the strip (not on the sector), so these are looked up once per
+   * strip instead of once per sector and strip.
+   * 
+   * @param input Input ESD 
+   * @param d     Detector
+   * @param r     Ring 
+   * @param nstr  Number of strips 
+   */
+  void FillStripTable(const AliESDFMD& input, UShort_t d, Char_t r, 
+		      UShort_t nstr);
+  /** 
+   * Read the signals of a sector once, in the same way as
+   * SignalInStrip, into fSectorSignal.  The array has two extra
+   * strips with no signal at the end, so that the look-ahead of the
+   * merging does not need boundary checks.
+   * 
+   * @param input     Input ESD 
+   * @param d         Detector
+   * @param r         Ring 
+   * @param s         Sector 
+   * @param nstr      Number of strips 
+   * @param angleMode 0: as is, 1: angle correct, -1: angle de-correct
+   */
+  void ReadSector(const AliESDFMD& input, UShort_t d, Char_t r, 
+		  UShort_t s, UShort_t nstr, Int_t angleMode);
   /** 
    * Get the high cut.  The high cut is defined as the 
    * most-probably-value peak found from the energy distributions, minus 
@@ -398,7 +431,12 @@ protected:
   Bool_t   fThreeStripSharing; //In case of simple sharing allow 3 strips
   Bool_t   fMergingDisabled; // If true, do not merge
   Bool_t   fIgnoreESDForAngleCorrection; // Ignore ESD information when angle correcting
-  ClassDef(AliFMDSharingFilter,11); //
+  TArrayD  fStripEta;        //! Strip eta of current ring 
+  TArrayD  fStripLowCut;     //! Strip low cuts of current ring 
+  TArrayD  fStripHighCut;    //! Strip high cuts of current ring 
+  TArrayD  fStripAngle;      //! Strip angle correction factor of current ring 
+  TArrayF  fSectorSignal;    //! Signals of current sector 
+  ClassDef(AliFMDSharingFilter,12); //
 };
 
 #endif
@@ -7,6 +7,8 @@
 // with the "AND", "OR" and "NOT" operators.
 //
 
+#include <TArrayC.h>
+
 #include "AliLog.h"
 
 #include "AliRsnExpression.h"
@@ -27,7 +29,10 @@ AliRsnCutSet::AliRsnCutSet() :
    fIsScheme(kFALSE),
    fExpression(0),
    fMonitors(),
-   fUseMonitor(kFALSE)
+   fUseMonitor(kFALSE),
+   fProgram(),
+   fSharedCutSlot(),
+   fSharedCutStatus(0)
 {
 //
 // Constructor without name (not recommended)
@@ -48,7 +53,10 @@ AliRsnCutSet::AliRsnCutSet(const char *name, RSNTARGET target) :
    fIsScheme(kFALSE),
    fExpression(0),
    fMonitors(),
-   fUseMonitor(kFALSE)
+   fUseMonitor(kFALSE),
+   fProgram(),
+   fSharedCutSlot(),
+   fSharedCutStatus(0)
 {
 //
 // Constructor with argument name (recommended)
@@ -70,7 +78,10 @@ AliRsnCutSet::AliRsnCutSet(const AliRsnCutSet &copy) :
    fIsScheme(copy.fIsScheme),
    fExpression(copy.fExpression),
    fMonitors(copy.fMonitors),
-   fUseMonitor(copy.fUseMonitor)
+   fUseMonitor(copy.fUseMonitor),
+   fProgram(copy.fProgram),
+   fSharedCutSlot(copy.fSharedCutSlot),
+   fSharedCutStatus(0)
 {
 //
 // Copy constructor
@@ -104,6 +115,9 @@ AliRsnCutSet &AliRsnCutSet::operator=(const AliRsnCutSet &copy)
    fExpression = copy.fExpression;
    fMonitors = copy.fMonitors;
    fUseMonitor = copy.fUseMonitor;
+   fProgram = copy.fProgram;
+   fSharedCutSlot = copy.fSharedCutSlot;
+   fSharedCutStatus = 0;
 
    if (fBoolValues) delete [] fBoolValues;
 
@@ -151,6 +165,8 @@ void AliRsnCutSet::AddCut(AliRsnCut *cut)
    AliInfo(Form("====> Adding a new cut: [%s]", cut->GetName()));
    //cut->Print();
    fNumOfCuts++;
+   fProgram.Set(0);
+   fSharedCutSlot.Set(0);
 
    if (fBoolValues) delete [] fBoolValues;
 
@@ -182,21 +198,18 @@ Bool_t AliRsnCutSet::IsSelected(TObject *object)
 {
 //
 // Checks an object according to the cut expression defined here.
+// The scheme is evaluated through its compiled program, so that
+// a cut is checked only when the expression needs its value.
 //
 
-   Int_t i;
-
    if (!fNumOfCuts) return kTRUE;
 
    Bool_t boolReturn = kTRUE;
-   AliRsnCut *cut;
-   for (i = 0; i < fNumOfCuts; i++) {
-      cut = (AliRsnCut *)fCuts.At(i);
-      fBoolValues[i] = cut->IsSelected(object);
+   if (fIsScheme) {
+      if (!fProgram.GetSize()) Compile();
+      boolReturn = EvaluateProgram(object);
    }
 
-   if (fIsScheme) boolReturn = Passed();
-
    // fill monitoring info
    if (boolReturn && fUseMonitor) {
       if (TargetOK(object)) {
@@ -224,6 +237,7 @@ void AliRsnCutSet::SetCutScheme(const char *theValue)
    fCutScheme = theValue;
    SetCutSchemeIndexed(theValue);
    fIsScheme = kTRUE;
+   fProgram.Set(0);
    AliDebug(AliLog::kDebug, "->");
 }
 
@@ -278,6 +292,90 @@ Bool_t AliRsnCutSet::Passed()
    return fExpression->Value(*GetCuts());
 }
 
+//_____________________________________________________________________________
+Bool_t AliRsnCutSet::Compile()
+{
+//
+// Translates the cut scheme into a short-circuit program
+// (see AliRsnExpression::Compile) used by IsSelected().
+//
+
+   AliRsnExpression::fgCutSet = this;
+   if (!fExpression) {
+      fExpression = new AliRsnExpression(fCutSchemeIndexed);
+      AliDebug(AliLog::kDebug, "fExpression was created.");
+   }
+
+   fProgram.Set(0);
+   fExpression->Compile(fProgram);
+
+   Bool_t ok = kTRUE;
+   for (Int_t i = 0; i < fProgram.GetSize(); i += 2) {
+      if (fProgram[i] == AliRsnExpression::kProgLoad && fProgram[i + 1] >= fNumOfCuts) {
+         AliError(Form("Cut scheme '%s' refers to cut #%d, but only %d cuts are defined", fCutScheme.Data(), fProgram[i + 1], fNumOfCuts));
+         fProgram[i + 1] = -1;
+         ok = kFALSE;
+      }
+   }
+
+   AliDebug(AliLog::kDebug, Form("Cut scheme compiled into %d instructions", fProgram.GetSize() / 2));
+   return ok;
+}
+
+//_____________________________________________________________________________
+Bool_t AliRsnCutSet::EvaluateProgram(TObject *object)
+{
+//
+// Runs the compiled cut scheme on an object
+//
+
+   Bool_t result = kFALSE;
+   Int_t ip, arg, n = fProgram.GetSize() / 2;
+   const Int_t *pgm = fProgram.GetArray();
+
+   for (ip = 0; ip < n; ip++) {
+      arg = pgm[2 * ip + 1];
+      switch (pgm[2 * ip]) {
+         case AliRsnExpression::kProgLoad :
+            result = (arg >= 0) ? CutValue(arg, object) : kFALSE;
+            break;
+         case AliRsnExpression::kProgNot :
+            result = !result;
+            break;
+         case AliRsnExpression::kProgJumpIfFalse :
+            if (!result) ip = arg - 1;
+            break;
+         case AliRsnExpression::kProgJumpIfTrue :
+            if (result) ip = arg - 1;
+            break;
+      }
+   }
+
+   return result;
+}
+
+//_____________________________________________________________________________
+Bool_t AliRsnCutSet::CutValue(Int_t i, TObject *object)
+{
+//
+// Result of cut #i on an object.
+// When a shared status array is attached (see AliRsnMiniAnalysisTask),
+// a cut already checked on the same object by another cut set is not re-evaluated.
+//
+
+   AliRsnCut *cut = (AliRsnCut *)fCuts.UncheckedAt(i);
+
+   if (fSharedCutStatus && i < fSharedCutSlot.GetSize()) {
+      Char_t &status = (*fSharedCutStatus)[fSharedCutSlot[i]];
+      if (status < 0) status = cut->IsSelected(object) ? 1 : 0;
+      fBoolValues[i] = (status > 0);
+   } else {
+      fBoolValues[i] = cut->IsSelected(object);
+   }
+
+   return fBoolValues[i];
+}
+
 //_____________________________________________________________________________
 Bool_t AliRsnCutSet::IsValidScheme()
 {
@@ -14,6 +14,7 @@
 
 #include <TNamed.h>
 #include <TObjArray.h>
+#include <TArrayI.h>
 
 #include "AliRsnTarget.h"
 #include "AliRsnListOutput.h"
@@ -23,6 +24,7 @@ class AliRsnDaughter;
 class AliRsnExpression;
 class AliRsnPairParticle;
 class AliRsnEvent;
+class TArrayC;
 
 class AliRsnCutSet : public AliRsnTarget {
 public:
@@ -39,6 +41,7 @@ public:
    void      ShowCuts() const;
    Int_t     GetIndexByCutName(TString s);
    Bool_t    Passed();
+   Bool_t    Compile();
    Bool_t    IsValidScheme();
    TString   ShowCutScheme() const;
    Int_t     TestExpression(TString opt = "short");
@@ -62,8 +65,14 @@ public:
 
    void UseMonitor(Bool_t useMonitor=kTRUE) { fUseMonitor = useMonitor; }
 
+   void SetSharedCutSlots(const TArrayI &slots) { fSharedCutSlot = slots; }
+   void UseSharedCutStatus(TArrayC *status) { fSharedCutStatus = status; }
+
 private:
 
+   Bool_t    CutValue(Int_t i, TObject *object);
+   Bool_t    EvaluateProgram(TObject *object);
+
    TObjArray         fCuts;                  // array of cuts
    Int_t             fNumOfCuts;             // number of cuts
    TString           fCutScheme;             // cut scheme
@@ -76,7 +85,11 @@ private:
    TObjArray         fMonitors;              // array of monitor object
    Bool_t            fUseMonitor;            // flag if monitoring should be used
 
-   ClassDef(AliRsnCutSet, 3)   // ROOT dictionary
+   TArrayI           fProgram;               //! compiled cut scheme (see AliRsnExpression::Compile)
+   TArrayI           fSharedCutSlot;         //! slot of each cut in the shared status array
+   TArrayC          *fSharedCutStatus;       //! results of cuts shared with other cut sets for the current object (-1 = not evaluated)
+
+   ClassDef(AliRsnCutSet, 4)   // ROOT dictionary
 };
 
 #endif
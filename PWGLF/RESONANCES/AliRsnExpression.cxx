@@ -10,6 +10,7 @@
 #include <TString.h>
 #include <TObjString.h>
 #include <TObjArray.h>
+#include <TArrayI.h>
 
 #include "AliLog.h"
 
@@ -153,6 +154,53 @@ TString AliRsnExpression::Unparse() const
    return "(" + fArg1->Unparse() + " " + opVals[fOperator] + " " + fArg2->Unparse() + ")";
 }
 
+//______________________________________________________________________________
+void AliRsnExpression::Compile(TArrayI &program) const
+{
+   // Append to 'program' the instructions which evaluate the expression
+   // with a single result register: each instruction is a pair (op, arg)
+   // and the right argument of '&' and '|' is skipped when the left one
+   // already decides the result, so that cuts are evaluated only if needed.
+
+   Int_t jump;
+   switch (fOperator) {
+
+      case kOpOR :
+      case kOpAND :
+         fArg1->Compile(program);
+         jump = AddInstruction(program, (fOperator == kOpAND) ? kProgJumpIfFalse : kProgJumpIfTrue, 0);
+         fArg2->Compile(program);
+         program[2 * jump + 1] = program.GetSize() / 2;
+         break;
+
+      case kOpNOT :
+         fArg2->Compile(program);
+         AddInstruction(program, kProgNot, 0);
+         break;
+
+      case 0 :
+         // an undefined expression is never passed, as in Value()
+         AddInstruction(program, kProgLoad, fVname.IsNull() ? -1 : fVname.Atoi());
+         break;
+
+      default:
+         AliError("Illegal operator in expression!");
+         AddInstruction(program, kProgLoad, -1);
+   }
+}
+
+//______________________________________________________________________________
+Int_t AliRsnExpression::AddInstruction(TArrayI &program, Int_t op, Int_t arg)
+{
+   // append one instruction to a program and return its index
+
+   Int_t n = program.GetSize();
+   program.Set(n + 2);
+   program[n] = op;
+   program[n + 1] = arg;
+   return n / 2;
+}
+
 //______________________________________________________________________________
 TObjArray *AliRsnExpression::Tokenize(TString str) const
 {
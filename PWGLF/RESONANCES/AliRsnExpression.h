@@ -13,6 +13,7 @@
 #include <TObject.h>
 
 class TObjArray;
+class TArrayI;
 #include "AliRsnCutSet.h"
 class AliRsnVariableExpression;
 
@@ -27,6 +28,14 @@ public:
       kOpNOT      // Unary negation '!'
    };
 
+   // instructions of the compiled form of an expression (see Compile)
+   enum EProgramOp {
+      kProgLoad = 0,    // result = value of cut #arg (kFALSE if arg < 0)
+      kProgNot,         // result = !result
+      kProgJumpIfFalse, // if (!result) go to instruction #arg
+      kProgJumpIfTrue   // if (result) go to instruction #arg
+   };
+
    AliRsnExpression() : fVname(0), fArg1(0), fArg2(0), fOperator(0)  {}
    AliRsnExpression(TString exp);
    virtual    ~AliRsnExpression();
@@ -35,6 +44,7 @@ public:
 
    virtual Bool_t     Value(TObjArray &vars);
    virtual TString     Unparse() const;
+   void                Compile(TArrayI &program) const;
 
    void SetCutSet(AliRsnCutSet *const theValue) { fgCutSet = theValue; }
    AliRsnCutSet *GetCutSet() const { return fgCutSet; }
@@ -52,6 +62,7 @@ private:
    AliRsnExpression(int op, AliRsnExpression *a, AliRsnExpression *b);
 
    TObjArray    *Tokenize(TString str) const;
+   static Int_t                AddInstruction(TArrayI &program, Int_t op, Int_t arg);
    static AliRsnExpression    *Element(TObjArray &st, Int_t &i);
    static AliRsnExpression    *Primary(TObjArray &st, Int_t &i);
    static AliRsnExpression    *Expression(TObjArray &st, Int_t &i);
@@ -100,7 +100,8 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
    fRejectIfNoQuark(kFALSE),
    fMotherAcceptanceCutMinPt(0.0),
    fMotherAcceptanceCutMaxEta(0.9),
-   fKeepMotherInAcceptance(kFALSE) 
+   fKeepMotherInAcceptance(kFALSE),
+   fSharedCutStatus()
 {
 //
 // Dummy constructor ALWAYS needed for I/O.
@@ -156,7 +157,8 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const char *name, Bool_t useMC) :
    fRejectIfNoQuark(kFALSE),
    fMotherAcceptanceCutMinPt(0.0),
    fMotherAcceptanceCutMaxEta(0.9),
-   fKeepMotherInAcceptance(kFALSE)
+   fKeepMotherInAcceptance(kFALSE),
+   fSharedCutStatus()
 {
 //
 // Default constructor.
@@ -217,7 +219,8 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const AliRsnMiniAnalysisTask &cop
    fRejectIfNoQuark(copy.fRejectIfNoQuark),
    fMotherAcceptanceCutMinPt(copy.fMotherAcceptanceCutMinPt),
    fMotherAcceptanceCutMaxEta(copy.fMotherAcceptanceCutMaxEta),
-   fKeepMotherInAcceptance(copy.fKeepMotherInAcceptance)
+   fKeepMotherInAcceptance(copy.fKeepMotherInAcceptance),
+   fSharedCutStatus()
 {
 //
 // Copy constructor.
@@ -397,6 +400,7 @@ void AliRsnMiniAnalysisTask::UserCreateOutputObjects()
    while ((cs = (AliRsnCutSet *) next())) {
       cs->Init(fOutput);
    }
+   ShareTrackCuts();
 
    // create temporary tree for filtered events
    if (fMiniEvent) delete fMiniEvent;
@@ -860,6 +864,36 @@ Char_t AliRsnMiniAnalysisTask::CheckCurrentEvent()
    }
 }
 
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::ShareTrackCuts()
+{
+//
+// Assigns to each distinct AliRsnCut object used in the track cut sets
+// a slot in the per-track status array, so that a cut added to several
+// cut sets is evaluated only once per track in FillMiniEvent().
+//
+
+   TObjArray distinct;
+   Int_t ic, icut, islot, ncuts = fTrackCuts.GetEntries();
+   for (ic = 0; ic < ncuts; ic++) {
+      AliRsnCutSet *cuts = (AliRsnCutSet *)fTrackCuts[ic];
+      TObjArray *list = cuts->GetCuts();
+      TArrayI slots(list->GetEntriesFast());
+      for (icut = 0; icut < list->GetEntriesFast(); icut++) {
+         TObject *cut = list->At(icut);
+         for (islot = 0; islot < distinct.GetEntriesFast(); islot++) {
+            if (distinct.At(islot) == cut) break;
+         }
+         if (islot == distinct.GetEntriesFast()) distinct.AddLast(cut);
+         slots[icut] = islot;
+      }
+      cuts->SetSharedCutSlots(slots);
+   }
+   fSharedCutStatus.Set(distinct.GetEntriesFast());
+
+   AliInfo(Form("%d track cut sets use %d distinct cuts", ncuts, distinct.GetEntriesFast()));
+}
+
 //__________________________________________________________________________________________________
 void AliRsnMiniAnalysisTask::FillMiniEvent(Char_t evType)
 {
@@ -893,6 +927,7 @@ void AliRsnMiniAnalysisTask::FillMiniEvent(Char_t evType)
    Int_t npos = 0, nneg = 0, nneu = 0;
    AliRsnDaughter cursor;
    AliRsnMiniParticle miniParticle;
+   for (ic = 0; ic < ncuts; ic++) ((AliRsnCutSet *)fTrackCuts[ic])->UseSharedCutStatus(&fSharedCutStatus);
    for (ip = 0; ip < npart; ip++) {
       // point cursor to next particle
       fRsnEvent.SetDaughter(cursor, ip);
@@ -900,6 +935,8 @@ void AliRsnMiniAnalysisTask::FillMiniEvent(Char_t evType)
       miniParticle.CopyDaughter(&cursor);
       miniParticle.Index() = ip;
       // switch on the bits corresponding to passed cuts
+      // (cuts shared by several cut sets are checked once per track)
+      fSharedCutStatus.Reset(-1);
       for (ic = 0; ic < ncuts; ic++) {
          AliRsnCutSet *cuts = (AliRsnCutSet *)fTrackCuts[ic];
          if (cuts->IsSelected(&cursor)) miniParticle.SetCutBit(ic);
@@ -912,6 +949,7 @@ void AliRsnMiniAnalysisTask::FillMiniEvent(Char_t evType)
          else nneu++;
       }
    }
+   for (ic = 0; ic < ncuts; ic++) ((AliRsnCutSet *)fTrackCuts[ic])->UseSharedCutStatus(0x0);
 
    // get number of accepted tracks
    AliDebugClass(1, Form("Event %6d: total = %5d, accepted = %4d (pos %4d, neg %4d, neu %4d)", fEvNum, npart, (Int_t)fMiniEvent->Particles().GetEntriesFast(), npos, nneg, nneu));
@@ -14,6 +14,7 @@
 
 #include <TString.h>
 #include <TClonesArray.h>
+#include <TArrayC.h>
 
 #include "AliAnalysisTaskSE.h"
 
@@ -89,6 +90,7 @@ private:
 
    Char_t   CheckCurrentEvent();
    void     FillMiniEvent(Char_t evType);
+   void     ShareTrackCuts();
    Double_t ComputeAngle();
    Double_t ComputeCentrality(Bool_t isESD);
    Double_t ComputeMultiplicity(Bool_t isESD,TString type);
@@ -155,8 +157,9 @@ private:
    Float_t              fMotherAcceptanceCutMinPt;              // cut value to apply when selecting the mothers inside a defined acceptance
    Float_t              fMotherAcceptanceCutMaxEta;             // cut value to apply when selecting the mothers inside a defined acceptance
    Bool_t               fKeepMotherInAcceptance;                // flag to keep also mothers in acceptance
+   TArrayC              fSharedCutStatus;                       //! per-track results of the cuts shared by the track cut sets
 
-   ClassDef(AliRsnMiniAnalysisTask, 13);   // AliRsnMiniAnalysisTask
+   ClassDef(AliRsnMiniAnalysisTask, 14);   // AliRsnMiniAnalysisTask
 };
 
 
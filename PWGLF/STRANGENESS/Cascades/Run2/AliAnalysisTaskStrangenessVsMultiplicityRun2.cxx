@@ -318,7 +318,10 @@ fTreeCascVarMVPileupFlag(kFALSE),
 fTreeCascVarOOBPileupFlag(kFALSE),
 //Histos
 fHistEventCounter(0),
-fHistCentrality(0)
+fHistCentrality(0),
+//Compiled cut matrices
+fNV0CutConfigs(0), fV0CutMatrix(), fV0CosPAParams(), fV0CosPAValues(), fV0CutPass(), fV0CutHistos(),
+fNCascCutConfigs(0), fCascCutMatrix(), fCascCosPAParams(), fCascCosPAValues(), fCascCutPass(), fCascCutHistos()
 //------------------------------------------------
 // Tree Variables
 {
@@ -518,7 +521,10 @@ fTreeCascVarMVPileupFlag(kFALSE),
 fTreeCascVarOOBPileupFlag(kFALSE),
 //Histos
 fHistEventCounter(0),
-fHistCentrality(0)
+fHistCentrality(0),
+//Compiled cut matrices
+fNV0CutConfigs(0), fV0CutMatrix(), fV0CosPAParams(), fV0CosPAValues(), fV0CutPass(), fV0CutHistos(),
+fNCascCutConfigs(0), fCascCutMatrix(), fCascCosPAParams(), fCascCosPAValues(), fCascCutPass(), fCascCutHistos()
 {
 
     //Re-vertex: Will only apply for cascade candidates
@@ -894,6 +900,10 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserCreateOutputObjects()
         fListCascade->SetOwner();
     }
 
+    //Superlight mode: compile the configurations into cut matrices
+    CompileV0Configurations();
+    CompileCascadeConfigurations();
+
     //Regular Output: Slots 1, 2, 3
     PostData(1, fListHist    );
     PostData(2, fListV0      );
@@ -1389,117 +1399,8 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         // Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
-        //Step 1: Sweep members of the output object TList and fill all of them as appropriate
-        Int_t lNumberOfConfigurations = fListV0->GetEntries();
-        //AliWarning(Form("[V0 Analyses] Processing different configurations (%i detected)",lNumberOfConfigurations));
-        TH3F *histoout         = 0x0;
-        AliV0Result *lV0Result = 0x0;
-        for(Int_t lcfg=0; lcfg<lNumberOfConfigurations; lcfg++){
-            lV0Result = (AliV0Result*) fListV0->At(lcfg);
-            histoout  = lV0Result->GetHistogram();
-
-            Float_t lMass = 0;
-            Float_t lRap  = 0;
-            Float_t lPDGMass = -1;
-            Float_t lNegdEdx = 100;
-            Float_t lPosdEdx = 100;
-            Float_t lBaryonMomentum = -0.5;
-
-            //========================================================================
-            //Setting up: Variable V0 CosPA
-            Float_t lV0CosPACut = lV0Result -> GetCutV0CosPA();
-            Float_t lVarV0CosPApar[5];
-            lVarV0CosPApar[0] = lV0Result->GetCutVarV0CosPAExp0Const();
-            lVarV0CosPApar[1] = lV0Result->GetCutVarV0CosPAExp0Slope();
-            lVarV0CosPApar[2] = lV0Result->GetCutVarV0CosPAExp1Const();
-            lVarV0CosPApar[3] = lV0Result->GetCutVarV0CosPAExp1Slope();
-            lVarV0CosPApar[4] = lV0Result->GetCutVarV0CosPAConst();
-            Float_t lVarV0CosPA = TMath::Cos(
-                                             lVarV0CosPApar[0]*TMath::Exp(lVarV0CosPApar[1]*fTreeVariablePt) +
-                                             lVarV0CosPApar[2]*TMath::Exp(lVarV0CosPApar[3]*fTreeVariablePt) +
-                                             lVarV0CosPApar[4]);
-            if( lV0Result->GetCutUseVarV0CosPA() ){
-                //Only use if tighter than the non-variable cut
-                if( lVarV0CosPA > lV0CosPACut ) lV0CosPACut = lVarV0CosPA;
-            }
-            //========================================================================
-
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kK0Short     ){
-                lMass    = fTreeVariableInvMassK0s;
-                lRap     = fTreeVariableRapK0Short;
-                lPDGMass = 0.497;
-                lNegdEdx = fTreeVariableNSigmasNegPion;
-                lPosdEdx = fTreeVariableNSigmasPosPion;
-            }
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kLambda      ){
-                lMass = fTreeVariableInvMassLambda;
-                lRap = fTreeVariableRapLambda;
-                lPDGMass = 1.115683;
-                lNegdEdx = fTreeVariableNSigmasNegPion;
-                lPosdEdx = fTreeVariableNSigmasPosProton;
-                lBaryonMomentum = fTreeVariablePosInnerP;
-            }
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kAntiLambda  ){
-                lMass = fTreeVariableInvMassAntiLambda;
-                lRap = fTreeVariableRapLambda;
-                lPDGMass = 1.115683;
-                lNegdEdx = fTreeVariableNSigmasNegProton;
-                lPosdEdx = fTreeVariableNSigmasPosPion;
-                lBaryonMomentum = fTreeVariableNegInnerP;
-            }
-
-            if (
-                //Check 1: Offline Vertexer
-                lOnFlyStatus == lV0Result->GetUseOnTheFly() &&
-
-                //Check 2: Basic Acceptance cuts
-                lV0Result->GetCutMinEtaTracks() < fTreeVariableNegEta && fTreeVariableNegEta < lV0Result->GetCutMaxEtaTracks() &&
-                lV0Result->GetCutMinEtaTracks() < fTreeVariablePosEta && fTreeVariablePosEta < lV0Result->GetCutMaxEtaTracks() &&
-                lRap > lV0Result->GetCutMinRapidity() &&
-                lRap < lV0Result->GetCutMaxRapidity() &&
-                
-                //Check 3: Topological Variables
-                fTreeVariableV0Radius > lV0Result->GetCutV0Radius() &&
-                fTreeVariableDcaNegToPrimVertex > lV0Result->GetCutDCANegToPV() &&
-                fTreeVariableDcaPosToPrimVertex > lV0Result->GetCutDCAPosToPV() &&
-                fTreeVariableDcaV0Daughters < lV0Result->GetCutDCAV0Daughters() &&
-                fTreeVariableV0CosineOfPointingAngle > lV0CosPACut &&
-                fTreeVariableDistOverTotMom*lPDGMass < lV0Result->GetCutProperLifetime() &&
-                fTreeVariableLeastNbrCrossedRows > lV0Result->GetCutLeastNumberOfCrossedRows() &&
-                fTreeVariableLeastRatioCrossedRowsOverFindable > lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable() &&
-
-                //Check 4: Minimum momentum of baryon daughter
-                ( lV0Result->GetMassHypothesis() == AliV0Result::kK0Short || lBaryonMomentum > lV0Result->GetCutMinBaryonMomentum() ) &&
-
-                //Check 5: TPC dEdx selections
-                TMath::Abs(lNegdEdx)<lV0Result->GetCutTPCdEdx() &&
-                TMath::Abs(lPosdEdx)<lV0Result->GetCutTPCdEdx() &&
-
-                //Check 6: Armenteros-Podolanski space cut (for K0Short analysis)
-                ( ( lV0Result->GetCutArmenteros() == kFALSE || lV0Result->GetMassHypothesis() != AliV0Result::kK0Short ) || ( fTreeVariablePtArmV0>lV0Result->GetCutArmenterosParameter()*TMath::Abs(fTreeVariableAlphaV0) ) ) &&
-
-                //Check 7: kITSrefit track selection if requested
-                (
-                 ( (fTreeVariableNegTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeVariablePosTrackStatus & AliESDtrack::kITSrefit) )
-                 ||
-                 !lV0Result->GetCutUseITSRefitTracks()
-                 )&&
-
-                //Check 8: Max Chi2/Clusters if not absurd
-                ( lV0Result->GetCutMaxChi2PerCluster()>1e+3 ||
-                 fTreeVariableMaxChi2PerCluster < lV0Result->GetCutMaxChi2PerCluster()
-                 ) &&
-                //Check 9: Min Track Length if positive
-                ( lV0Result->GetCutMinTrackLength()<0 || //this is a bit paranoid...
-                 fTreeVariableMinTrackLength > lV0Result->GetCutMinTrackLength()
-                 )
-                )
-            {
-                //This satisfies all my conditionals! Fill histogram
-                histoout -> Fill ( fCentrality, fTreeVariablePt, lMass );
-            }
-        }
+        //Step 1: Evaluate all configurations at once and fill the ones selecting this candidate
+        FillV0Configurations( lOnFlyStatus );
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         // End Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -2126,254 +2027,8 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         // Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
-        //Step 1: Sweep members of the output object TList and fill all of them as appropriate
-        Int_t lNumberOfConfigurationsCascade = fListCascade->GetEntries();
-        //AliWarning(Form("[Cascade Analyses] Processing different configurations (%i detected)",lNumberOfConfigurationsCascade));
-        TH3F *histoout         = 0x0;
-        AliCascadeResult *lCascadeResult = 0x0;
-        for(Int_t lcfg=0; lcfg<lNumberOfConfigurationsCascade; lcfg++){
-            lCascadeResult = (AliCascadeResult*) fListCascade->At(lcfg);
-            histoout  = lCascadeResult->GetHistogram();
-
-            Float_t lMass = 0;
-            Float_t lV0Mass = 0; 
-            Float_t lRap  = 0;
-            Float_t lPDGMass = -1;
-            Float_t lNegdEdx = 100;
-            Float_t lPosdEdx = 100;
-            Float_t lBachdEdx = 100;
-            Short_t  lCharge = -2;
-            Int_t lChargePos =  1;
-            Int_t lChargeNeg = -1;
-            Float_t lprpx, lprpy, lprpz, lpipx, lpipy, lpipz;
-            lpipx = fTreeCascVarBachPx;
-            lpipy = fTreeCascVarBachPy;
-            lpipz = fTreeCascVarBachPz;
-
-            //For parametric V0 Mass selection
-            Float_t lExpV0Mass =
-            fLambdaMassMean[0]+
-            fLambdaMassMean[1]*TMath::Exp(fLambdaMassMean[2]*lV0Pt)+
-            fLambdaMassMean[3]*TMath::Exp(fLambdaMassMean[4]*lV0Pt);
-
-            Float_t lExpV0Sigma =
-            fLambdaMassSigma[0]+fLambdaMassSigma[1]*lV0Pt+
-            fLambdaMassSigma[2]*TMath::Exp(fLambdaMassSigma[3]*lV0Pt);
-            
-            //========================================================================
-            //For 2.76TeV-like parametric V0 CosPA
-            Float_t l276TeVV0CosPA = 0.998;
-            Float_t pThr=1.5;
-            if (lV0TotMomentum<pThr) {
-                //Below the threshold "pThr", try a momentum dependent cos(PA) cut
-                const Double_t bend=0.03; // approximate Xi bending angle
-                const Double_t qt=0.211;  // max Lambda pT in Omega decay
-                const Double_t cpaThr=TMath::Cos(TMath::ATan(qt/pThr) + bend);
-                Double_t
-                cpaCut=(0.998/cpaThr)*TMath::Cos(TMath::ATan(qt/lV0TotMomentum) + bend);
-                l276TeVV0CosPA = cpaCut;
-            }
-            //========================================================================
-            
-            //========================================================================
-            //Setting up: Variable Cascade CosPA
-            Float_t lCascCosPACut = lCascadeResult -> GetCutCascCosPA();
-            Float_t lVarCascCosPApar[5];
-            lVarCascCosPApar[0] = lCascadeResult->GetCutVarCascCosPAExp0Const();
-            lVarCascCosPApar[1] = lCascadeResult->GetCutVarCascCosPAExp0Slope();
-            lVarCascCosPApar[2] = lCascadeResult->GetCutVarCascCosPAExp1Const();
-            lVarCascCosPApar[3] = lCascadeResult->GetCutVarCascCosPAExp1Slope();
-            lVarCascCosPApar[4] = lCascadeResult->GetCutVarCascCosPAConst();
-            Float_t lVarCascCosPA = TMath::Cos(
-                lVarCascCosPApar[0]*TMath::Exp(lVarCascCosPApar[1]*fTreeCascVarPt) +
-                lVarCascCosPApar[2]*TMath::Exp(lVarCascCosPApar[3]*fTreeCascVarPt) +
-                lVarCascCosPApar[4]);
-            if( lCascadeResult->GetCutUseVarCascCosPA() ){
-                //Only use if tighter than the non-variable cut
-                if( lVarCascCosPA > lCascCosPACut ) lCascCosPACut = lVarCascCosPA;
-            }
-            //========================================================================
-
-            //========================================================================
-            //Setting up: Variable V0 CosPA
-            Float_t lV0CosPACut = lCascadeResult -> GetCutV0CosPA();
-            Float_t lVarV0CosPApar[5];
-            lVarV0CosPApar[0] = lCascadeResult->GetCutVarV0CosPAExp0Const();
-            lVarV0CosPApar[1] = lCascadeResult->GetCutVarV0CosPAExp0Slope();
-            lVarV0CosPApar[2] = lCascadeResult->GetCutVarV0CosPAExp1Const();
-            lVarV0CosPApar[3] = lCascadeResult->GetCutVarV0CosPAExp1Slope();
-            lVarV0CosPApar[4] = lCascadeResult->GetCutVarV0CosPAConst();
-            Float_t lVarV0CosPA = TMath::Cos(
-                                               lVarV0CosPApar[0]*TMath::Exp(lVarV0CosPApar[1]*fTreeCascVarPt) +
-                                               lVarV0CosPApar[2]*TMath::Exp(lVarV0CosPApar[3]*fTreeCascVarPt) +
-                                               lVarV0CosPApar[4]);
-            if( lCascadeResult->GetCutUseVarV0CosPA() ){
-                //Only use if tighter than the non-variable cut
-                if( lVarV0CosPA > lV0CosPACut ) lV0CosPACut = lVarV0CosPA;
-            }
-            //========================================================================
-
-            //========================================================================
-            //Setting up: Variable BB CosPA
-            Float_t lBBCosPACut = lCascadeResult -> GetCutBachBaryonCosPA();
-            Float_t lVarBBCosPApar[5];
-            lVarBBCosPApar[0] = lCascadeResult->GetCutVarBBCosPAExp0Const();
-            lVarBBCosPApar[1] = lCascadeResult->GetCutVarBBCosPAExp0Slope();
-            lVarBBCosPApar[2] = lCascadeResult->GetCutVarBBCosPAExp1Const();
-            lVarBBCosPApar[3] = lCascadeResult->GetCutVarBBCosPAExp1Slope();
-            lVarBBCosPApar[4] = lCascadeResult->GetCutVarBBCosPAConst();
-            Float_t lVarBBCosPA = TMath::Cos(
-                                             lVarBBCosPApar[0]*TMath::Exp(lVarBBCosPApar[1]*fTreeCascVarPt) +
-                                             lVarBBCosPApar[2]*TMath::Exp(lVarBBCosPApar[3]*fTreeCascVarPt) +
-                                             lVarBBCosPApar[4]);
-            if( lCascadeResult->GetCutUseVarBBCosPA() ){
-                //Only use if looser than the non-variable cut (WARNING: BEWARE INVERSE LOGIC)
-                if( lVarBBCosPA > lBBCosPACut ) lBBCosPACut = lVarBBCosPA;
-            }
-            //========================================================================
-
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kXiMinus     ){
-                lCharge  = -1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsXi;
-                lV0Mass  = fTreeCascVarV0MassLambda;
-                lRap     = fTreeCascVarRapXi;
-                lPDGMass = 1.32171;
-                lNegdEdx = fTreeCascVarNegNSigmaPion;
-                lPosdEdx = fTreeCascVarPosNSigmaProton;
-                lBachdEdx= fTreeCascVarBachNSigmaPion;
-                lprpx = fTreeCascVarPosPx;
-                lprpy = fTreeCascVarPosPy;
-                lprpz = fTreeCascVarPosPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kXiPlus      ){
-                lCharge  = +1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsXi;
-                lV0Mass  = fTreeCascVarV0MassAntiLambda;
-                lRap     = fTreeCascVarRapXi;
-                lPDGMass = 1.32171;
-                lNegdEdx = fTreeCascVarNegNSigmaProton;
-                lPosdEdx = fTreeCascVarPosNSigmaPion;
-                lBachdEdx= fTreeCascVarBachNSigmaPion;
-                lprpx = fTreeCascVarNegPx;
-                lprpy = fTreeCascVarNegPy;
-                lprpz = fTreeCascVarNegPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kOmegaMinus     ){
-                lCharge  = -1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsOmega;
-                lV0Mass  = fTreeCascVarV0MassLambda;
-                lRap     = fTreeCascVarRapOmega;
-                lPDGMass = 1.67245;
-                lNegdEdx = fTreeCascVarNegNSigmaPion;
-                lPosdEdx = fTreeCascVarPosNSigmaProton;
-                lBachdEdx= fTreeCascVarBachNSigmaKaon;
-                lprpx = fTreeCascVarPosPx;
-                lprpy = fTreeCascVarPosPy;
-                lprpz = fTreeCascVarPosPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kOmegaPlus      ){
-                lCharge  = +1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsOmega;
-                lV0Mass  = fTreeCascVarV0MassAntiLambda;
-                lRap     = fTreeCascVarRapOmega;
-                lPDGMass = 1.67245;
-                lNegdEdx = fTreeCascVarNegNSigmaProton;
-                lPosdEdx = fTreeCascVarPosNSigmaPion;
-                lBachdEdx= fTreeCascVarBachNSigmaKaon;
-                lprpx = fTreeCascVarNegPx;
-                lprpy = fTreeCascVarNegPy;
-                lprpz = fTreeCascVarNegPz;
-            }
-            
-            if (
-                //Check 1: Charge consistent with expectations
-                fTreeCascVarCharge == lCharge &&
-                
-                //Check 2: Basic Acceptance cuts
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarPosEta && fTreeCascVarPosEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarNegEta && fTreeCascVarNegEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarBachEta && fTreeCascVarBachEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lRap > lCascadeResult->GetCutMinRapidity() &&
-                lRap < lCascadeResult->GetCutMaxRapidity() &&
-                
-                //Check 3: Topological Variables
-                // - V0 Selections
-                fTreeCascVarDCANegToPrimVtx > lCascadeResult->GetCutDCANegToPV() &&
-                fTreeCascVarDCAPosToPrimVtx > lCascadeResult->GetCutDCAPosToPV() &&
-                fTreeCascVarDCAV0Daughters < lCascadeResult->GetCutDCAV0Daughters() &&
-                fTreeCascVarV0CosPointingAngle > lV0CosPACut &&
-                fTreeCascVarV0Radius > lCascadeResult->GetCutV0Radius() &&
-                // - Cascade Selections
-                fTreeCascVarDCAV0ToPrimVtx > lCascadeResult->GetCutDCAV0ToPV() &&
-                TMath::Abs(lV0Mass-1.116) < lCascadeResult->GetCutV0Mass() &&
-                fTreeCascVarDCABachToPrimVtx > lCascadeResult->GetCutDCABachToPV() &&
-                fTreeCascVarDCACascDaughters < lCascadeResult->GetCutDCACascDaughters() &&
-                fTreeCascVarCascCosPointingAngle > lCascCosPACut &&
-                fTreeCascVarCascRadius > lCascadeResult->GetCutCascRadius() &&
-                
-                // - Implementation of a parametric V0 Mass cut if requested
-                (
-                 ( lCascadeResult->GetCutV0MassSigma() > 50 ) || //anything goes
-                 (TMath::Abs( (lV0Mass-lExpV0Mass) / lExpV0Sigma ) < lCascadeResult->GetCutV0MassSigma() )
-                 ) &&
-                
-                // - Miscellaneous
-                fTreeCascVarDistOverTotMom*lPDGMass < lCascadeResult->GetCutProperLifetime() &&
-                fTreeCascVarLeastNbrClusters > lCascadeResult->GetCutLeastNumberOfClusters() &&
-                
-                //Check 4: TPC dEdx selections
-                TMath::Abs(lNegdEdx )<lCascadeResult->GetCutTPCdEdx() &&
-                TMath::Abs(lPosdEdx )<lCascadeResult->GetCutTPCdEdx() &&
-                TMath::Abs(lBachdEdx)<lCascadeResult->GetCutTPCdEdx() &&
-                
-                //Check 5: Xi rejection for Omega analysis
-                ( ( lCascadeResult->GetMassHypothesis() != AliCascadeResult::kOmegaMinus && lCascadeResult->GetMassHypothesis() != AliCascadeResult::kOmegaPlus  ) || ( TMath::Abs( fTreeCascVarMassAsXi - 1.32171 ) > lCascadeResult->GetCutXiRejection() ) ) &&
-                
-                //Check 6: Experimental DCA Bachelor to Baryon cut
-                ( fTreeCascVarDCABachToBaryon > lCascadeResult->GetCutDCABachToBaryon() ) &&
-                
-                //Check 7: Experimental Bach Baryon CosPA
-                ( fTreeCascVarWrongCosPA < lBBCosPACut  ) &&
-                
-                //Check 8: Min/Max V0 Lifetime cut
-                ( ( fTreeCascVarV0Lifetime > lCascadeResult->GetCutMinV0Lifetime() ) &&
-                 ( fTreeCascVarV0Lifetime < lCascadeResult->GetCutMaxV0Lifetime() ||
-                  lCascadeResult->GetCutMaxV0Lifetime() > 1e+3 ) ) &&
-                
-                //Check 9: kITSrefit track selection if requested
-                (
-                 ( (fTreeCascVarPosTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeCascVarNegTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeCascVarBachTrackStatus & AliESDtrack::kITSrefit)
-                  )
-                 ||
-                 !lCascadeResult->GetCutUseITSRefitTracks()
-                 ) &&
-                
-                //Check 10: Max Chi2/Clusters if not absurd
-                ( lCascadeResult->GetCutMaxChi2PerCluster()>1e+3 ||
-                 fTreeCascVarMaxChi2PerCluster < lCascadeResult->GetCutMaxChi2PerCluster()
-                 )&&
-                
-                //Check 11: Min Track Length if positive
-                ( lCascadeResult->GetCutMinTrackLength()<0 || //this is a bit paranoid...
-                 fTreeCascVarMinTrackLength > lCascadeResult->GetCutMinTrackLength()
-                 )&&
-                
-                //Check 12: Check if special V0 CosPA cut used
-                //either don't use the cut at all, or make sure it's above threshold
-                ( lCascadeResult->GetCutUse276TeVV0CosPA()==kFALSE ||
-                 fTreeCascVarV0CosPointingAngle>l276TeVV0CosPA
-                 )
-                ){
-                //This satisfies all my conditionals! Fill histogram
-                histoout -> Fill ( fCentrality, fTreeCascVarPt, lMass );
-            }
-        }
+        //Step 1: Evaluate all configurations at once and fill the ones selecting this candidate
+        FillCascadeConfigurations( lV0Pt, lV0TotMomentum );
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         // End Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -3950,3 +3605,386 @@ AliAnalysisTaskStrangenessVsMultiplicityRun2::FMDhits AliAnalysisTaskStrangeness
     }
     return ret_vector;
 }
+
+//______________________________________________________________________
+Int_t AliAnalysisTaskStrangenessVsMultiplicityRun2::FindOrAddCosPAParameters( std::vector<Float_t> &lTable, const Float_t *lPar )
+{
+    //Return the index of a variable CosPA parametrization in lTable, adding it if needed.
+    //Systematic variations usually share a handful of parametrizations: each distinct one
+    //is evaluated only once per candidate
+    const Int_t lNPar = lTable.size()/5;
+    for(Int_t ipar=0; ipar<lNPar; ipar++){
+        Bool_t lSame = kTRUE;
+        for(Int_t ip=0; ip<5; ip++) if( lTable[5*ipar+ip] != lPar[ip] ) lSame = kFALSE;
+        if( lSame ) return ipar;
+    }
+    for(Int_t ip=0; ip<5; ip++) lTable.push_back( lPar[ip] );
+    return lNPar;
+}
+
+//______________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::CompileV0Configurations()
+{
+    //Copy the cuts of all V0 configurations into a column-major matrix:
+    //column k of configuration i is stored at fV0CutMatrix[k*n+i]
+    const Int_t n = fListV0 ? fListV0->GetEntries() : 0;
+    fNV0CutConfigs = n;
+    fV0CutMatrix.assign( kNV0CutColumns*n, 0. );
+    fV0CosPAParams.clear();
+    fV0CutPass.assign( n, 0 );
+    fV0CutHistos.assign( n, 0x0 );
+    if( !n ) return;
+
+    Double_t *lCut = &fV0CutMatrix[0];
+    Float_t lVarV0CosPApar[5];
+    for(Int_t lcfg=0; lcfg<n; lcfg++){
+        AliV0Result *lV0Result = (AliV0Result*) fListV0->At(lcfg);
+        fV0CutHistos[lcfg] = lV0Result->GetHistogram();
+
+        lCut[kV0ColHypothesis*n+lcfg]              = lV0Result->GetMassHypothesis();
+        lCut[kV0ColOnTheFly*n+lcfg]                = lV0Result->GetUseOnTheFly();
+        lCut[kV0ColMinEta*n+lcfg]                  = lV0Result->GetCutMinEtaTracks();
+        lCut[kV0ColMaxEta*n+lcfg]                  = lV0Result->GetCutMaxEtaTracks();
+        lCut[kV0ColMinRap*n+lcfg]                  = lV0Result->GetCutMinRapidity();
+        lCut[kV0ColMaxRap*n+lcfg]                  = lV0Result->GetCutMaxRapidity();
+        lCut[kV0ColV0Radius*n+lcfg]                = lV0Result->GetCutV0Radius();
+        lCut[kV0ColDCANegToPV*n+lcfg]              = lV0Result->GetCutDCANegToPV();
+        lCut[kV0ColDCAPosToPV*n+lcfg]              = lV0Result->GetCutDCAPosToPV();
+        lCut[kV0ColDCAV0Daughters*n+lcfg]          = lV0Result->GetCutDCAV0Daughters();
+        lCut[kV0ColV0CosPA*n+lcfg]                 = (Float_t) lV0Result->GetCutV0CosPA();
+        lCut[kV0ColProperLifetime*n+lcfg]          = lV0Result->GetCutProperLifetime();
+        lCut[kV0ColCrossedRows*n+lcfg]             = lV0Result->GetCutLeastNumberOfCrossedRows();
+        lCut[kV0ColCrossedRowsOverFindable*n+lcfg] = lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable();
+        lCut[kV0ColMinBaryonMomentum*n+lcfg]       = lV0Result->GetCutMinBaryonMomentum();
+        lCut[kV0ColTPCdEdx*n+lcfg]                 = lV0Result->GetCutTPCdEdx();
+        lCut[kV0ColArmenteros*n+lcfg]              = lV0Result->GetCutArmenteros();
+        lCut[kV0ColArmenterosParameter*n+lcfg]     = lV0Result->GetCutArmenterosParameter();
+        lCut[kV0ColITSRefit*n+lcfg]                = lV0Result->GetCutUseITSRefitTracks();
+        lCut[kV0ColMaxChi2PerCluster*n+lcfg]       = lV0Result->GetCutMaxChi2PerCluster();
+        lCut[kV0ColMinTrackLength*n+lcfg]          = lV0Result->GetCutMinTrackLength();
+
+        //Variable V0 CosPA: index of the parametrization, -1 if not used
+        lCut[kV0ColVarV0CosPA*n+lcfg] = -1;
+        if( lV0Result->GetCutUseVarV0CosPA() ){
+            lVarV0CosPApar[0] = lV0Result->GetCutVarV0CosPAExp0Const();
+            lVarV0CosPApar[1] = lV0Result->GetCutVarV0CosPAExp0Slope();
+            lVarV0CosPApar[2] = lV0Result->GetCutVarV0CosPAExp1Const();
+            lVarV0CosPApar[3] = lV0Result->GetCutVarV0CosPAExp1Slope();
+            lVarV0CosPApar[4] = lV0Result->GetCutVarV0CosPAConst();
+            lCut[kV0ColVarV0CosPA*n+lcfg] = FindOrAddCosPAParameters( fV0CosPAParams, lVarV0CosPApar );
+        }
+    }
+    fV0CosPAValues.assign( fV0CosPAParams.size()/5, 0. );
+    AliInfo(Form("[V0 Analyses] Compiled %i configurations (%i distinct variable CosPA cuts)", n, (Int_t) fV0CosPAValues.size()));
+}
+
+//______________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::CompileCascadeConfigurations()
+{
+    //Copy the cuts of all cascade configurations into a column-major matrix:
+    //column k of configuration i is stored at fCascCutMatrix[k*n+i]
+    const Int_t n = fListCascade ? fListCascade->GetEntries() : 0;
+    fNCascCutConfigs = n;
+    fCascCutMatrix.assign( kNCascCutColumns*n, 0. );
+    fCascCosPAParams.clear();
+    fCascCutPass.assign( n, 0 );
+    fCascCutHistos.assign( n, 0x0 );
+    if( !n ) return;
+
+    Double_t *lCut = &fCascCutMatrix[0];
+    Float_t lVarCosPApar[5];
+    for(Int_t lcfg=0; lcfg<n; lcfg++){
+        AliCascadeResult *lCascadeResult = (AliCascadeResult*) fListCascade->At(lcfg);
+        fCascCutHistos[lcfg] = lCascadeResult->GetHistogram();
+
+        lCut[kCascColHypothesis*n+lcfg]            = lCascadeResult->GetMassHypothesis();
+        lCut[kCascColSwapBachelorCharge*n+lcfg]    = lCascadeResult->GetSwapBachelorCharge();
+        lCut[kCascColMinEta*n+lcfg]                = lCascadeResult->GetCutMinEtaTracks();
+        lCut[kCascColMaxEta*n+lcfg]                = lCascadeResult->GetCutMaxEtaTracks();
+        lCut[kCascColMinRap*n+lcfg]                = lCascadeResult->GetCutMinRapidity();
+        lCut[kCascColMaxRap*n+lcfg]                = lCascadeResult->GetCutMaxRapidity();
+        lCut[kCascColDCANegToPV*n+lcfg]            = lCascadeResult->GetCutDCANegToPV();
+        lCut[kCascColDCAPosToPV*n+lcfg]            = lCascadeResult->GetCutDCAPosToPV();
+        lCut[kCascColDCAV0Daughters*n+lcfg]        = lCascadeResult->GetCutDCAV0Daughters();
+        lCut[kCascColV0CosPA*n+lcfg]               = (Float_t) lCascadeResult->GetCutV0CosPA();
+        lCut[kCascColV0Radius*n+lcfg]              = lCascadeResult->GetCutV0Radius();
+        lCut[kCascColDCAV0ToPV*n+lcfg]             = lCascadeResult->GetCutDCAV0ToPV();
+        lCut[kCascColV0Mass*n+lcfg]                = lCascadeResult->GetCutV0Mass();
+        lCut[kCascColDCABachToPV*n+lcfg]           = lCascadeResult->GetCutDCABachToPV();
+        lCut[kCascColDCACascDaughters*n+lcfg]      = lCascadeResult->GetCutDCACascDaughters();
+        lCut[kCascColCascCosPA*n+lcfg]             = (Float_t) lCascadeResult->GetCutCascCosPA();
+        lCut[kCascColCascRadius*n+lcfg]            = lCascadeResult->GetCutCascRadius();
+        lCut[kCascColV0MassSigma*n+lcfg]           = lCascadeResult->GetCutV0MassSigma();
+        lCut[kCascColProperLifetime*n+lcfg]        = lCascadeResult->GetCutProperLifetime();
+        lCut[kCascColLeastNumberOfClusters*n+lcfg] = lCascadeResult->GetCutLeastNumberOfClusters();
+        lCut[kCascColTPCdEdx*n+lcfg]               = lCascadeResult->GetCutTPCdEdx();
+        lCut[kCascColXiRejection*n+lcfg]           = lCascadeResult->GetCutXiRejection();
+        lCut[kCascColDCABachToBaryon*n+lcfg]       = lCascadeResult->GetCutDCABachToBaryon();
+        lCut[kCascColBBCosPA*n+lcfg]               = (Float_t) lCascadeResult->GetCutBachBaryonCosPA();
+        lCut[kCascColMinV0Lifetime*n+lcfg]         = lCascadeResult->GetCutMinV0Lifetime();
+        lCut[kCascColMaxV0Lifetime*n+lcfg]         = lCascadeResult->GetCutMaxV0Lifetime();
+        lCut[kCascColITSRefit*n+lcfg]              = lCascadeResult->GetCutUseITSRefitTracks();
+        lCut[kCascColMaxChi2PerCluster*n+lcfg]     = lCascadeResult->GetCutMaxChi2PerCluster();
+        lCut[kCascColMinTrackLength*n+lcfg]        = lCascadeResult->GetCutMinTrackLength();
+        lCut[kCascColUse276TeVV0CosPA*n+lcfg]      = lCascadeResult->GetCutUse276TeVV0CosPA();
+
+        //Variable CosPA cuts: index of the parametrization, -1 if not used
+        lCut[kCascColVarCascCosPA*n+lcfg] = -1;
+        if( lCascadeResult->GetCutUseVarCascCosPA() ){
+            lVarCosPApar[0] = lCascadeResult->GetCutVarCascCosPAExp0Const();
+            lVarCosPApar[1] = lCascadeResult->GetCutVarCascCosPAExp0Slope();
+            lVarCosPApar[2] = lCascadeResult->GetCutVarCascCosPAExp1Const();
+            lVarCosPApar[3] = lCascadeResult->GetCutVarCascCosPAExp1Slope();
+            lVarCosPApar[4] = lCascadeResult->GetCutVarCascCosPAConst();
+            lCut[kCascColVarCascCosPA*n+lcfg] = FindOrAddCosPAParameters( fCascCosPAParams, lVarCosPApar );
+        }
+        lCut[kCascColVarV0CosPA*n+lcfg] = -1;
+        if( lCascadeResult->GetCutUseVarV0CosPA() ){
+            lVarCosPApar[0] = lCascadeResult->GetCutVarV0CosPAExp0Const();
+            lVarCosPApar[1] = lCascadeResult->GetCutVarV0CosPAExp0Slope();
+            lVarCosPApar[2] = lCascadeResult->GetCutVarV0CosPAExp1Const();
+            lVarCosPApar[3] = lCascadeResult->GetCutVarV0CosPAExp1Slope();
+            lVarCosPApar[4] = lCascadeResult->GetCutVarV0CosPAConst();
+            lCut[kCascColVarV0CosPA*n+lcfg] = FindOrAddCosPAParameters( fCascCosPAParams, lVarCosPApar );
+        }
+        lCut[kCascColVarBBCosPA*n+lcfg] = -1;
+        if( lCascadeResult->GetCutUseVarBBCosPA() ){
+            lVarCosPApar[0] = lCascadeResult->GetCutVarBBCosPAExp0Const();
+            lVarCosPApar[1] = lCascadeResult->GetCutVarBBCosPAExp0Slope();
+            lVarCosPApar[2] = lCascadeResult->GetCutVarBBCosPAExp1Const();
+            lVarCosPApar[3] = lCascadeResult->GetCutVarBBCosPAExp1Slope();
+            lVarCosPApar[4] = lCascadeResult->GetCutVarBBCosPAConst();
+            lCut[kCascColVarBBCosPA*n+lcfg] = FindOrAddCosPAParameters( fCascCosPAParams, lVarCosPApar );
+        }
+    }
+    fCascCosPAValues.assign( fCascCosPAParams.size()/5, 0. );
+    AliInfo(Form("[Cascade Analyses] Compiled %i configurations (%i distinct variable CosPA cuts)", n, (Int_t) fCascCosPAValues.size()));
+}
+
+//______________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::FillV0Configurations( Int_t lOnFlyStatus )
+{
+    //Evaluate the current V0 candidate against all compiled configurations
+    //and fill the histograms of the configurations selecting it
+    if( !fListV0 ) return;
+    if( fNV0CutConfigs != fListV0->GetEntries() ) CompileV0Configurations();
+    const Int_t n = fNV0CutConfigs;
+    if( !n ) return;
+
+    //Candidate properties under each mass hypothesis (K0Short, Lambda, AntiLambda)
+    const Float_t lHypMass[3]         = { fTreeVariableInvMassK0s, fTreeVariableInvMassLambda, fTreeVariableInvMassAntiLambda };
+    const Float_t lHypRap[3]          = { fTreeVariableRapK0Short, fTreeVariableRapLambda, fTreeVariableRapLambda };
+    const Float_t lHypPDGMass[3]      = { 0.497, 1.115683, 1.115683 };
+    const Float_t lHypNegdEdx[3]      = { fTreeVariableNSigmasNegPion, fTreeVariableNSigmasNegPion, fTreeVariableNSigmasNegProton };
+    const Float_t lHypPosdEdx[3]      = { fTreeVariableNSigmasPosPion, fTreeVariableNSigmasPosProton, fTreeVariableNSigmasPosPion };
+    const Float_t lHypBaryonMomentum[3] = { -0.5, fTreeVariablePosInnerP, fTreeVariableNegInnerP };
+    Float_t lHypProperLifetime[3], lHypMaxdEdx[3];
+    for(Int_t ih=0; ih<3; ih++){
+        lHypProperLifetime[ih] = fTreeVariableDistOverTotMom*lHypPDGMass[ih];
+        lHypMaxdEdx[ih] = TMath::Max( TMath::Abs(lHypNegdEdx[ih]), TMath::Abs(lHypPosdEdx[ih]) );
+    }
+
+    //Variable CosPA cuts: one evaluation per distinct parametrization
+    for(UInt_t ipar=0; ipar<fV0CosPAValues.size(); ipar++){
+        const Float_t *lPar = &fV0CosPAParams[5*ipar];
+        fV0CosPAValues[ipar] = TMath::Cos( lPar[0]*TMath::Exp(lPar[1]*fTreeVariablePt) +
+                                          lPar[2]*TMath::Exp(lPar[3]*fTreeVariablePt) +
+                                          lPar[4]);
+    }
+
+    const Bool_t lITSRefit = ( (fTreeVariableNegTrackStatus & AliESDtrack::kITSrefit) &&
+                               (fTreeVariablePosTrackStatus & AliESDtrack::kITSrefit) );
+    const Float_t lAbsAlpha = TMath::Abs(fTreeVariableAlphaV0);
+
+    const Double_t *lCut = &fV0CutMatrix[0];
+    UChar_t *lPass = &fV0CutPass[0];
+    for(Int_t lcfg=0; lcfg<n; lcfg++){
+        const Int_t lHyp = (Int_t) lCut[kV0ColHypothesis*n+lcfg];
+
+        Float_t lV0CosPACut = lCut[kV0ColV0CosPA*n+lcfg];
+        const Int_t lVar = (Int_t) lCut[kV0ColVarV0CosPA*n+lcfg];
+        //Only use if tighter than the non-variable cut
+        if( lVar >= 0 && fV0CosPAValues[lVar] > lV0CosPACut ) lV0CosPACut = fV0CosPAValues[lVar];
+
+        //Same checks as the configuration-by-configuration selection, combined without branching
+        lPass[lcfg] =
+        //Check 1: Offline Vertexer
+        ( lOnFlyStatus == lCut[kV0ColOnTheFly*n+lcfg] ) &
+        //Check 2: Basic Acceptance cuts
+        ( lCut[kV0ColMinEta*n+lcfg] < fTreeVariableNegEta ) & ( fTreeVariableNegEta < lCut[kV0ColMaxEta*n+lcfg] ) &
+        ( lCut[kV0ColMinEta*n+lcfg] < fTreeVariablePosEta ) & ( fTreeVariablePosEta < lCut[kV0ColMaxEta*n+lcfg] ) &
+        ( lHypRap[lHyp] > lCut[kV0ColMinRap*n+lcfg] ) & ( lHypRap[lHyp] < lCut[kV0ColMaxRap*n+lcfg] ) &
+        //Check 3: Topological Variables
+        ( fTreeVariableV0Radius > lCut[kV0ColV0Radius*n+lcfg] ) &
+        ( fTreeVariableDcaNegToPrimVertex > lCut[kV0ColDCANegToPV*n+lcfg] ) &
+        ( fTreeVariableDcaPosToPrimVertex > lCut[kV0ColDCAPosToPV*n+lcfg] ) &
+        ( fTreeVariableDcaV0Daughters < lCut[kV0ColDCAV0Daughters*n+lcfg] ) &
+        ( fTreeVariableV0CosineOfPointingAngle > lV0CosPACut ) &
+        ( lHypProperLifetime[lHyp] < lCut[kV0ColProperLifetime*n+lcfg] ) &
+        ( fTreeVariableLeastNbrCrossedRows > lCut[kV0ColCrossedRows*n+lcfg] ) &
+        ( fTreeVariableLeastRatioCrossedRowsOverFindable > lCut[kV0ColCrossedRowsOverFindable*n+lcfg] ) &
+        //Check 4: Minimum momentum of baryon daughter
+        ( lHyp == AliV0Result::kK0Short || lHypBaryonMomentum[lHyp] > lCut[kV0ColMinBaryonMomentum*n+lcfg] ) &
+        //Check 5: TPC dEdx selections
+        ( lHypMaxdEdx[lHyp] < lCut[kV0ColTPCdEdx*n+lcfg] ) &
+        //Check 6: Armenteros-Podolanski space cut (for K0Short analysis)
+        ( lCut[kV0ColArmenteros*n+lcfg] == 0 || lHyp != AliV0Result::kK0Short ||
+          fTreeVariablePtArmV0 > lCut[kV0ColArmenterosParameter*n+lcfg]*lAbsAlpha ) &
+        //Check 7: kITSrefit track selection if requested
+        ( lITSRefit || lCut[kV0ColITSRefit*n+lcfg] == 0 ) &
+        //Check 8: Max Chi2/Clusters if not absurd
+        ( lCut[kV0ColMaxChi2PerCluster*n+lcfg] > 1e+3 || fTreeVariableMaxChi2PerCluster < lCut[kV0ColMaxChi2PerCluster*n+lcfg] ) &
+        //Check 9: Min Track Length if positive
+        ( lCut[kV0ColMinTrackLength*n+lcfg] < 0 || fTreeVariableMinTrackLength > lCut[kV0ColMinTrackLength*n+lcfg] );
+    }
+
+    //Fill only the configurations selecting this candidate
+    for(Int_t lcfg=0; lcfg<n; lcfg++){
+        if( !lPass[lcfg] ) continue;
+        fV0CutHistos[lcfg] -> Fill ( fCentrality, fTreeVariablePt, lHypMass[(Int_t) lCut[kV0ColHypothesis*n+lcfg]] );
+    }
+}
+
+//______________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::FillCascadeConfigurations( Float_t lV0Pt, Float_t lV0TotMomentum )
+{
+    //Evaluate the current cascade candidate against all compiled configurations
+    //and fill the histograms of the configurations selecting it
+    if( !fListCascade ) return;
+    if( fNCascCutConfigs != fListCascade->GetEntries() ) CompileCascadeConfigurations();
+    const Int_t n = fNCascCutConfigs;
+    if( !n ) return;
+
+    //Candidate properties under each mass hypothesis (XiMinus, XiPlus, OmegaMinus, OmegaPlus)
+    const Int_t   lHypCharge[4]    = { -1, +1, -1, +1 };
+    const Float_t lHypMass[4]      = { fTreeCascVarMassAsXi, fTreeCascVarMassAsXi, fTreeCascVarMassAsOmega, fTreeCascVarMassAsOmega };
+    const Float_t lHypV0Mass[4]    = { fTreeCascVarV0MassLambda, fTreeCascVarV0MassAntiLambda, fTreeCascVarV0MassLambda, fTreeCascVarV0MassAntiLambda };
+    const Float_t lHypRap[4]       = { fTreeCascVarRapXi, fTreeCascVarRapXi, fTreeCascVarRapOmega, fTreeCascVarRapOmega };
+    const Float_t lHypPDGMass[4]   = { 1.32171, 1.32171, 1.67245, 1.67245 };
+    const Float_t lHypNegdEdx[4]   = { fTreeCascVarNegNSigmaPion, fTreeCascVarNegNSigmaProton, fTreeCascVarNegNSigmaPion, fTreeCascVarNegNSigmaProton };
+    const Float_t lHypPosdEdx[4]   = { fTreeCascVarPosNSigmaProton, fTreeCascVarPosNSigmaPion, fTreeCascVarPosNSigmaProton, fTreeCascVarPosNSigmaPion };
+    const Float_t lHypBachdEdx[4]  = { fTreeCascVarBachNSigmaPion, fTreeCascVarBachNSigmaPion, fTreeCascVarBachNSigmaKaon, fTreeCascVarBachNSigmaKaon };
+
+    //For parametric V0 Mass selection
+    Float_t lExpV0Mass =
+    fLambdaMassMean[0]+
+    fLambdaMassMean[1]*TMath::Exp(fLambdaMassMean[2]*lV0Pt)+
+    fLambdaMassMean[3]*TMath::Exp(fLambdaMassMean[4]*lV0Pt);
+
+    Float_t lExpV0Sigma =
+    fLambdaMassSigma[0]+fLambdaMassSigma[1]*lV0Pt+
+    fLambdaMassSigma[2]*TMath::Exp(fLambdaMassSigma[3]*lV0Pt);
+
+    Double_t lHypV0MassWindow[4];
+    Float_t lHypV0MassNSigma[4], lHypProperLifetime[4], lHypMaxdEdx[4];
+    for(Int_t ih=0; ih<4; ih++){
+        lHypV0MassWindow[ih]   = TMath::Abs(lHypV0Mass[ih]-1.116);
+        lHypV0MassNSigma[ih]   = TMath::Abs( (lHypV0Mass[ih]-lExpV0Mass) / lExpV0Sigma );
+        lHypProperLifetime[ih] = fTreeCascVarDistOverTotMom*lHypPDGMass[ih];
+        lHypMaxdEdx[ih] = TMath::Max( TMath::Abs(lHypBachdEdx[ih]), TMath::Max( TMath::Abs(lHypNegdEdx[ih]), TMath::Abs(lHypPosdEdx[ih]) ) );
+    }
+    const Double_t lXiMassDistance = TMath::Abs( fTreeCascVarMassAsXi - 1.32171 );
+
+    //========================================================================
+    //For 2.76TeV-like parametric V0 CosPA
+    Float_t l276TeVV0CosPA = 0.998;
+    Float_t pThr=1.5;
+    if (lV0TotMomentum<pThr) {
+        //Below the threshold "pThr", try a momentum dependent cos(PA) cut
+        const Double_t bend=0.03; // approximate Xi bending angle
+        const Double_t qt=0.211;  // max Lambda pT in Omega decay
+        const Double_t cpaThr=TMath::Cos(TMath::ATan(qt/pThr) + bend);
+        Double_t
+        cpaCut=(0.998/cpaThr)*TMath::Cos(TMath::ATan(qt/lV0TotMomentum) + bend);
+        l276TeVV0CosPA = cpaCut;
+    }
+    const Bool_t l276TeVV0CosPAPass = fTreeCascVarV0CosPointingAngle>l276TeVV0CosPA;
+    //========================================================================
+
+    //Variable CosPA cuts: one evaluation per distinct parametrization
+    for(UInt_t ipar=0; ipar<fCascCosPAValues.size(); ipar++){
+        const Float_t *lPar = &fCascCosPAParams[5*ipar];
+        fCascCosPAValues[ipar] = TMath::Cos( lPar[0]*TMath::Exp(lPar[1]*fTreeCascVarPt) +
+                                            lPar[2]*TMath::Exp(lPar[3]*fTreeCascVarPt) +
+                                            lPar[4]);
+    }
+
+    const Bool_t lITSRefit = ( (fTreeCascVarPosTrackStatus & AliESDtrack::kITSrefit) &&
+                               (fTreeCascVarNegTrackStatus & AliESDtrack::kITSrefit) &&
+                               (fTreeCascVarBachTrackStatus & AliESDtrack::kITSrefit) );
+
+    const Double_t *lCut = &fCascCutMatrix[0];
+    UChar_t *lPass = &fCascCutPass[0];
+    for(Int_t lcfg=0; lcfg<n; lcfg++){
+        const Int_t lHyp = (Int_t) lCut[kCascColHypothesis*n+lcfg];
+        const Int_t lCharge = lCut[kCascColSwapBachelorCharge*n+lcfg] != 0 ? -lHypCharge[lHyp] : lHypCharge[lHyp];
+
+        //Variable CosPA cuts
+        Float_t lCascCosPACut = lCut[kCascColCascCosPA*n+lcfg];
+        Int_t lVar = (Int_t) lCut[kCascColVarCascCosPA*n+lcfg];
+        //Only use if tighter than the non-variable cut
+        if( lVar >= 0 && fCascCosPAValues[lVar] > lCascCosPACut ) lCascCosPACut = fCascCosPAValues[lVar];
+        Float_t lV0CosPACut = lCut[kCascColV0CosPA*n+lcfg];
+        lVar = (Int_t) lCut[kCascColVarV0CosPA*n+lcfg];
+        //Only use if tighter than the non-variable cut
+        if( lVar >= 0 && fCascCosPAValues[lVar] > lV0CosPACut ) lV0CosPACut = fCascCosPAValues[lVar];
+        Float_t lBBCosPACut = lCut[kCascColBBCosPA*n+lcfg];
+        lVar = (Int_t) lCut[kCascColVarBBCosPA*n+lcfg];
+        //Only use if looser than the non-variable cut (WARNING: BEWARE INVERSE LOGIC)
+        if( lVar >= 0 && fCascCosPAValues[lVar] > lBBCosPACut ) lBBCosPACut = fCascCosPAValues[lVar];
+
+        //Same checks as the configuration-by-configuration selection, combined without branching
+        lPass[lcfg] =
+        //Check 1: Charge consistent with expectations
+        ( fTreeCascVarCharge == lCharge ) &
+        //Check 2: Basic Acceptance cuts
+        ( lCut[kCascColMinEta*n+lcfg] < fTreeCascVarPosEta ) & ( fTreeCascVarPosEta < lCut[kCascColMaxEta*n+lcfg] ) &
+        ( lCut[kCascColMinEta*n+lcfg] < fTreeCascVarNegEta ) & ( fTreeCascVarNegEta < lCut[kCascColMaxEta*n+lcfg] ) &
+        ( lCut[kCascColMinEta*n+lcfg] < fTreeCascVarBachEta ) & ( fTreeCascVarBachEta < lCut[kCascColMaxEta*n+lcfg] ) &
+        ( lHypRap[lHyp] > lCut[kCascColMinRap*n+lcfg] ) & ( lHypRap[lHyp] < lCut[kCascColMaxRap*n+lcfg] ) &
+        //Check 3: Topological Variables
+        // - V0 Selections
+        ( fTreeCascVarDCANegToPrimVtx > lCut[kCascColDCANegToPV*n+lcfg] ) &
+        ( fTreeCascVarDCAPosToPrimVtx > lCut[kCascColDCAPosToPV*n+lcfg] ) &
+        ( fTreeCascVarDCAV0Daughters < lCut[kCascColDCAV0Daughters*n+lcfg] ) &
+        ( fTreeCascVarV0CosPointingAngle > lV0CosPACut ) &
+        ( fTreeCascVarV0Radius > lCut[kCascColV0Radius*n+lcfg] ) &
+        // - Cascade Selections
+        ( fTreeCascVarDCAV0ToPrimVtx > lCut[kCascColDCAV0ToPV*n+lcfg] ) &
+        ( lHypV0MassWindow[lHyp] < lCut[kCascColV0Mass*n+lcfg] ) &
+        ( fTreeCascVarDCABachToPrimVtx > lCut[kCascColDCABachToPV*n+lcfg] ) &
+        ( fTreeCascVarDCACascDaughters < lCut[kCascColDCACascDaughters*n+lcfg] ) &
+        ( fTreeCascVarCascCosPointingAngle > lCascCosPACut ) &
+        ( fTreeCascVarCascRadius > lCut[kCascColCascRadius*n+lcfg] ) &
+        // - Implementation of a parametric V0 Mass cut if requested
+        ( lCut[kCascColV0MassSigma*n+lcfg] > 50 || lHypV0MassNSigma[lHyp] < lCut[kCascColV0MassSigma*n+lcfg] ) &
+        // - Miscellaneous
+        ( lHypProperLifetime[lHyp] < lCut[kCascColProperLifetime*n+lcfg] ) &
+        ( fTreeCascVarLeastNbrClusters > lCut[kCascColLeastNumberOfClusters*n+lcfg] ) &
+        //Check 4: TPC dEdx selections
+        ( lHypMaxdEdx[lHyp] < lCut[kCascColTPCdEdx*n+lcfg] ) &
+        //Check 5: Xi rejection for Omega analysis
+        ( ( lHyp != AliCascadeResult::kOmegaMinus && lHyp != AliCascadeResult::kOmegaPlus ) || lXiMassDistance > lCut[kCascColXiRejection*n+lcfg] ) &
+        //Check 6: Experimental DCA Bachelor to Baryon cut
+        ( fTreeCascVarDCABachToBaryon > lCut[kCascColDCABachToBaryon*n+lcfg] ) &
+        //Check 7: Experimental Bach Baryon CosPA
+        ( fTreeCascVarWrongCosPA < lBBCosPACut ) &
+        //Check 8: Min/Max V0 Lifetime cut
+        ( fTreeCascVarV0Lifetime > lCut[kCascColMinV0Lifetime*n+lcfg] ) &
+        ( fTreeCascVarV0Lifetime < lCut[kCascColMaxV0Lifetime*n+lcfg] || lCut[kCascColMaxV0Lifetime*n+lcfg] > 1e+3 ) &
+        //Check 9: kITSrefit track selection if requested
+        ( lITSRefit || lCut[kCascColITSRefit*n+lcfg] == 0 ) &
+        //Check 10: Max Chi2/Clusters if not absurd
+        ( lCut[kCascColMaxChi2PerCluster*n+lcfg] > 1e+3 || fTreeCascVarMaxChi2PerCluster < lCut[kCascColMaxChi2PerCluster*n+lcfg] ) &
+        //Check 11: Min Track Length if positive
+        ( lCut[kCascColMinTrackLength*n+lcfg] < 0 || fTreeCascVarMinTrackLength > lCut[kCascColMinTrackLength*n+lcfg] ) &
+        //Check 12: Check if special V0 CosPA cut used
+        ( lCut[kCascColUse276TeVV0CosPA*n+lcfg] == 0 || l276TeVV0CosPAPass );
+    }
+
+    //Fill only the configurations selecting this candidate
+    for(Int_t lcfg=0; lcfg<n; lcfg++){
+        if( !lPass[lcfg] ) continue;
+        fCascCutHistos[lcfg] -> Fill ( fCentrality, fTreeCascVarPt, lHypMass[(Int_t) lCut[kCascColHypothesis*n+lcfg]] );
+    }
+}
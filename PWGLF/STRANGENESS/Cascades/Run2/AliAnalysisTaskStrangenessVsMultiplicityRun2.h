@@ -217,6 +217,13 @@ public:
 //---------------------------------------------------------------------------------------
    AliAnalysisTaskStrangenessVsMultiplicityRun2::FMDhits GetFMDhits(AliAODEvent* aodEvent) const;
 //---------------------------------------------------------------------------------------
+    //Superlight mode: configurations compiled into column-major cut matrices
+    void CompileV0Configurations();
+    void CompileCascadeConfigurations();
+    void FillV0Configurations( Int_t lOnFlyStatus );
+    void FillCascadeConfigurations( Float_t lV0Pt, Float_t lV0TotMomentum );
+    static Int_t FindOrAddCosPAParameters( std::vector<Float_t> &lTable, const Float_t *lPar );
+//---------------------------------------------------------------------------------------
 
 
 private:
@@ -470,11 +477,47 @@ private:
     TH1D *fHistEventCounter; //!
     TH1D *fHistCentrality; //!
 
+//===========================================================================================
+//   Superlight mode: compiled cut matrices
+//===========================================================================================
+    //Columns of the cut matrices (one entry per configuration in each column)
+    enum EV0CutColumn {
+        kV0ColHypothesis = 0, kV0ColOnTheFly, kV0ColMinEta, kV0ColMaxEta, kV0ColMinRap, kV0ColMaxRap,
+        kV0ColV0Radius, kV0ColDCANegToPV, kV0ColDCAPosToPV, kV0ColDCAV0Daughters, kV0ColV0CosPA, kV0ColVarV0CosPA,
+        kV0ColProperLifetime, kV0ColCrossedRows, kV0ColCrossedRowsOverFindable, kV0ColMinBaryonMomentum,
+        kV0ColTPCdEdx, kV0ColArmenteros, kV0ColArmenterosParameter, kV0ColITSRefit, kV0ColMaxChi2PerCluster,
+        kV0ColMinTrackLength, kNV0CutColumns
+    };
+    enum ECascadeCutColumn {
+        kCascColHypothesis = 0, kCascColSwapBachelorCharge, kCascColMinEta, kCascColMaxEta, kCascColMinRap, kCascColMaxRap,
+        kCascColDCANegToPV, kCascColDCAPosToPV, kCascColDCAV0Daughters, kCascColV0CosPA, kCascColVarV0CosPA, kCascColV0Radius,
+        kCascColDCAV0ToPV, kCascColV0Mass, kCascColDCABachToPV, kCascColDCACascDaughters, kCascColCascCosPA, kCascColVarCascCosPA,
+        kCascColCascRadius, kCascColV0MassSigma, kCascColProperLifetime, kCascColLeastNumberOfClusters, kCascColTPCdEdx,
+        kCascColXiRejection, kCascColDCABachToBaryon, kCascColBBCosPA, kCascColVarBBCosPA, kCascColMinV0Lifetime,
+        kCascColMaxV0Lifetime, kCascColITSRefit, kCascColMaxChi2PerCluster, kCascColMinTrackLength, kCascColUse276TeVV0CosPA,
+        kNCascCutColumns
+    };
+
+    Int_t fNV0CutConfigs;                     //! number of compiled V0 configurations
+    std::vector<Double_t> fV0CutMatrix;       //! V0 cut values, column-major
+    std::vector<Float_t>  fV0CosPAParams;     //! distinct variable CosPA parametrizations (5 parameters each)
+    std::vector<Float_t>  fV0CosPAValues;     //! variable CosPA cuts for the current candidate
+    std::vector<UChar_t>  fV0CutPass;         //! selection result of the current candidate per configuration
+    std::vector<TH3F*>    fV0CutHistos;       //! output histogram per configuration
+
+    Int_t fNCascCutConfigs;                   //! number of compiled cascade configurations
+    std::vector<Double_t> fCascCutMatrix;     //! cascade cut values, column-major
+    std::vector<Float_t>  fCascCosPAParams;   //! distinct variable CosPA parametrizations (5 parameters each)
+    std::vector<Float_t>  fCascCosPAValues;   //! variable CosPA cuts for the current candidate
+    std::vector<UChar_t>  fCascCutPass;       //! selection result of the current candidate per configuration
+    std::vector<TH3F*>    fCascCutHistos;     //! output histogram per configuration
+
     AliAnalysisTaskStrangenessVsMultiplicityRun2(const AliAnalysisTaskStrangenessVsMultiplicityRun2&);            // not implemented
     AliAnalysisTaskStrangenessVsMultiplicityRun2& operator=(const AliAnalysisTaskStrangenessVsMultiplicityRun2&); // not implemented
 
-    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 2);
+    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 3);
     //1: first implementation
+    //3: compiled cut matrices for the superlight mode
 };
 
 #endif
@@ -134,6 +134,8 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fPtResCentPtTPCITS(0)
   , fCurrentFileName("")
   , fDummyTrack(0)
+  , fNearestIndexEvent(0)
+  , fNearestIndexNTracks(0)
 {
   // Constructor
 
@@ -359,8 +361,6 @@ void AliAnalysisTaskFilteredTree::UserExec(Option_t *)
     AliInfo(Form(" fFriendDownscaling=%f",fFriendDownscaling));
   }
   //
-  //
-  //
   if(fProcessAll) { 
     ProcessAll(fESD,fMC,fESDfriend); // all track stages and MC
   }
@@ -374,6 +374,7 @@ void AliAnalysisTaskFilteredTree::UserExec(Option_t *)
   if (fProcessCosmics) { ProcessCosmics(fESD,fESDfriend); }
   if(fMC) { ProcessMCEff(fESD,fMC,fESDfriend);}
   if (fProcessITSTPCmatchOut) ProcessITSTPCmatchOut(fESD, fESDfriend);
+  fNearestIndexEvent=0;   // the ESD object is reused for the next event
   printf("processed event %d\n", Int_t(Entry()));
 }
 
@@ -2897,6 +2898,85 @@ void AliAnalysisTaskFilteredTree::ProcessTrackMatch(AliESDEvent *const /*esdEven
 */
 }
 
+namespace {
+  // rough cuts of the nearest track search, the cells of the index have at least this size
+  const Double_t kNearestTglCut=0.1;
+  const Double_t kNearestQPtCut=0.4;
+  const Double_t kNearestPhiCut=0.2;
+  const Double_t kNearestTglMax=2.;                                         // |tgl| above in the edge cells
+  const Int_t    kNearestNTglCells=Int_t(2*kNearestTglMax/kNearestTglCut);
+  const Int_t    kNearestNPhiCells=Int_t(TMath::TwoPi()/kNearestPhiCut);
+  const Int_t    kNearestNCells=kNearestNTglCells*kNearestNPhiCells;
+  Int_t NearestTglCell(Double_t tgl){
+    Int_t cell=Int_t(TMath::Floor((tgl+kNearestTglMax)*kNearestNTglCells/(2*kNearestTglMax)));
+    return TMath::Min(TMath::Max(cell,0),kNearestNTglCells-1);
+  }
+  Int_t NearestPhiCell(Double_t phi){
+    Int_t cell=Int_t(TMath::Floor((phi+TMath::Pi())*kNearestNPhiCells/TMath::TwoPi()));
+    return TMath::Min(TMath::Max(cell,0),kNearestNPhiCells-1);
+  }
+}
+
+void AliAnalysisTaskFilteredTree::BuildNearestTrackIndex(AliESDEvent *event){
+  //
+  // Sort the candidates of GetNearestTrack in (tgl,phi) cells, for each track type and parameter type.
+  // The cells are at least as large as the rough cuts, so only the neighbouring cells of a probe track
+  // have to be tested. The track selection, tgl, q/pt and phi of the candidates are evaluated once per event.
+  //
+  Int_t ntracks=event->GetNumberOfTracks();
+  for (Int_t ipar=0; ipar<2; ipar++){
+    fNearestTgl[ipar].Set(ntracks);
+    fNearestQPt[ipar].Set(ntracks);
+    fNearestPhi[ipar].Set(ntracks);
+  }
+  TArrayI trackCell(2*ntracks);
+  TArrayI trackMask(ntracks);         // bit 2*trackType+paramType set if the track is a candidate
+  for (Int_t itrack=0; itrack<ntracks; itrack++){
+    trackMask[itrack]=0;
+    AliESDtrack *ptrack=event->GetTrack(itrack);
+    if (ptrack==NULL) continue;
+    if (ptrack->GetKinkIndex(0)<0) continue;              // skip kink daughters
+    Bool_t types[3];
+    types[0] = (ptrack->IsOn(0x1)==kTRUE && ptrack->IsOn(0x10)==kFALSE);   // tracks without TPC information
+    types[1] = (ptrack->IsOn(0x10)==kTRUE);                                // tracks with   TPC information
+    types[2] = (ptrack->IsOn(0x1)==kTRUE && ptrack->IsOn(0x10)==kTRUE);    // tracks with   TPC+ITS information
+    for (Int_t ipar=0; ipar<2; ipar++){
+      const AliExternalTrackParam * track=(ipar==0) ? ptrack:ptrack->GetInnerParam();
+      if (track==NULL) continue;
+      fNearestTgl[ipar][itrack]=track->GetTgl();
+      fNearestQPt[ipar][itrack]=track->GetSigned1Pt();
+      fNearestPhi[ipar][itrack]=TMath::ATan2(track->Py(),track->Px());
+      trackCell[2*itrack+ipar]=NearestTglCell(fNearestTgl[ipar][itrack])*kNearestNPhiCells+NearestPhiCell(fNearestPhi[ipar][itrack]);
+      for (Int_t itype=0; itype<3; itype++) if (types[itype]) trackMask[itrack]|=1<<(2*itype+ipar);
+    }
+  }
+  //
+  // counting sort of the candidates by cell
+  for (Int_t index=0; index<6; index++){
+    Int_t ipar=index%2;
+    TArrayI &first=fNearestCellFirst[index];
+    TArrayI &tracks=fNearestCellTracks[index];
+    first.Set(kNearestNCells+1);
+    first.Reset();
+    Int_t ncand=0;
+    for (Int_t itrack=0; itrack<ntracks; itrack++){
+      if ((trackMask[itrack]&(1<<index))==0) continue;
+      first[trackCell[2*itrack+ipar]+1]++;
+      ncand++;
+    }
+    for (Int_t icell=0; icell<kNearestNCells; icell++) first[icell+1]+=first[icell];
+    tracks.Set(ncand);
+    for (Int_t itrack=0; itrack<ntracks; itrack++){
+      if ((trackMask[itrack]&(1<<index))==0) continue;
+      tracks[first[trackCell[2*itrack+ipar]]++]=itrack;
+    }
+    for (Int_t icell=kNearestNCells; icell>0; icell--) first[icell]=first[icell-1];
+    first[0]=0;
+  }
+  fNearestIndexEvent=event;
+  fNearestIndexNTracks=ntracks;
+}
+
 Int_t   AliAnalysisTaskFilteredTree::GetNearestTrack(const AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType, AliExternalTrackParam & paramNearest){
   //
   // Find track with closest chi2 distance  (assume all track ae propagated to the DCA)
@@ -2906,52 +2986,56 @@ Int_t   AliAnalysisTaskFilteredTree::GetNearestTrack(const AliExternalTrackParam
   //   paramType = 0 - global track
   //               1 - track at inner wall of TPC
   //
+  // Only the candidates in the (tgl,phi) cells next to the track are tested (see BuildNearestTrackIndex)
   //          
   if (trackMatch==NULL){
     ::Error("AliAnalysisTaskFilteredTree::GetNearestTrack","invalid track pointer");
     return -1;
   }
-  Int_t ntracks=event->GetNumberOfTracks();
-  const Double_t ktglCut=0.1;
-  const Double_t kqptCut=0.4;
-  const Double_t kAlphaCut=0.2;
+  if (trackType<0 || trackType>2 || paramType<0 || paramType>1) return -1;
+  if (event!=fNearestIndexEvent || event->GetNumberOfTracks()!=fNearestIndexNTracks) BuildNearestTrackIndex(event);
+  const Int_t index=2*trackType+paramType;
+  const TArrayI &first=fNearestCellFirst[index];
+  const TArrayI &tracks=fNearestCellTracks[index];
+  const Double_t *tgls=fNearestTgl[paramType].GetArray();
+  const Double_t *qpts=fNearestQPt[paramType].GetArray();
+  const Double_t *phis=fNearestPhi[paramType].GetArray();
+  const Double_t tglMatch=trackMatch->GetTgl();
+  const Double_t qptMatch=trackMatch->GetSigned1Pt();
+  const Double_t phiMatch=TMath::ATan2(trackMatch->Py(),trackMatch->Px());
+  const Int_t tglCell=NearestTglCell(tglMatch);
+  const Int_t phiCell=NearestPhiCell(phiMatch);
   //
   Double_t chi2Min=100000;
   Int_t indexMin=-1;
-  for (Int_t itrack=0; itrack<ntracks; itrack++){
-    if (itrack==indexSkip) continue;
-    AliESDtrack *ptrack=event->GetTrack(itrack);
-    if (ptrack==NULL) continue;
-    if (trackType==0 && (ptrack->IsOn(0x1)==kFALSE || ptrack->IsOn(0x10)==kTRUE))  continue;     // looks for track without TPC information
-    if (trackType==1 && (ptrack->IsOn(0x10)==kFALSE))   continue;                                // looks for tracks with   TPC information
-    if (trackType==2 && (ptrack->IsOn(0x1)==kFALSE || ptrack->IsOn(0x10)==kFALSE)) continue;      // looks for tracks with   TPC+ITS information
-    
-    if (ptrack->GetKinkIndex(0)<0) continue;              // skip kink daughters
-    const AliExternalTrackParam * track=0;                // 
-    if (paramType==0) track=ptrack;                       // Global track         
-    if (paramType==1) track=ptrack->GetInnerParam();      // TPC only track at inner wall of TPC
-    if (track==NULL) {
-      continue;
-    }
-    // first rough cuts
-    // fP3 cut
-    if (TMath::Abs((track->GetTgl()-trackMatch->GetTgl()))>ktglCut) continue; 
-    // fP4 cut 
-    if (TMath::Abs((track->GetSigned1Pt()-trackMatch->GetSigned1Pt()))>kqptCut) continue; 
-    // fAlpha cut
-    //Double_t alphaDist=TMath::Abs((track->GetAlpha()-trackMatch->GetAlpha()));
-    Double_t alphaDist=TMath::Abs(TMath::ATan2(track->Py(),track->Px())-TMath::ATan2(trackMatch->Py(),trackMatch->Py()));
-    if (alphaDist>TMath::Pi()) alphaDist-=TMath::TwoPi();
-    if (alphaDist>kAlphaCut) continue;
-    // calculate and extract track with smallest chi2 distance
-    AliExternalTrackParam param(*track);
-    if (param.Rotate(trackMatch->GetAlpha())==kFALSE) continue;
-    if (param.PropagateTo(trackMatch->GetX(),trackMatch->GetBz())==kFALSE) continue;
-    Double_t chi2=trackMatch->GetPredictedChi2(&param);
-    if (chi2<chi2Min){
-      indexMin=itrack;
-      chi2Min=chi2;
-      paramNearest=param;
+  for (Int_t itgl=TMath::Max(tglCell-1,0); itgl<=TMath::Min(tglCell+1,kNearestNTglCells-1); itgl++){
+    for (Int_t dphi=-1; dphi<=1; dphi++){
+      Int_t icell=itgl*kNearestNPhiCells+(phiCell+dphi+kNearestNPhiCells)%kNearestNPhiCells;
+      for (Int_t ientry=first[icell]; ientry<first[icell+1]; ientry++){
+        Int_t itrack=tracks[ientry];
+        if (itrack==indexSkip) continue;
+        // first rough cuts
+        // fP3 cut
+        if (TMath::Abs(tgls[itrack]-tglMatch)>kNearestTglCut) continue; 
+        // fP4 cut 
+        if (TMath::Abs(qpts[itrack]-qptMatch)>kNearestQPtCut) continue; 
+        // fAlpha cut
+        Double_t alphaDist=TMath::Abs(phis[itrack]-phiMatch);
+        if (alphaDist>TMath::Pi()) alphaDist=TMath::TwoPi()-alphaDist;
+        if (alphaDist>kNearestPhiCut) continue;
+        // calculate and extract track with smallest chi2 distance
+        AliESDtrack *ptrack=event->GetTrack(itrack);
+        const AliExternalTrackParam * track=(paramType==0) ? ptrack:ptrack->GetInnerParam();
+        AliExternalTrackParam param(*track);
+        if (param.Rotate(trackMatch->GetAlpha())==kFALSE) continue;
+        if (param.PropagateTo(trackMatch->GetX(),trackMatch->GetBz())==kFALSE) continue;
+        Double_t chi2=trackMatch->GetPredictedChi2(&param);
+        if (chi2<chi2Min || (chi2==chi2Min && itrack<indexMin)){   // same choice as a scan in track order
+          indexMin=itrack;
+          chi2Min=chi2;
+          paramNearest=param;
+        }
+      }
     }
   }
   return indexMin;
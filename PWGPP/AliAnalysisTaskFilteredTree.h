@@ -31,6 +31,8 @@ class TTreeSRedirector;
 class TParticle;
 class TH3D;
 
+#include <TArrayD.h>
+#include <TArrayI.h>
 #include "AliTriggerAnalysis.h"
 #include "AliAnalysisTaskSE.h"
 
@@ -115,6 +117,7 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
 
   void FillHistograms(AliESDtrack* const ptrack, AliExternalTrackParam* const ptpcInnerC, Double_t centralityF, Double_t chi2TPCInnerC);
   Int_t   GetNearestTrack(const AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType,  AliExternalTrackParam & paramNearest);
+  void    BuildNearestTrackIndex(AliESDEvent *event);
   static void SetDefaultAliasesV0(TTree *treeV0);
   static void SetDefaultAliasesHighPt(TTree *treeV0);
  private:
@@ -169,10 +172,19 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   TH3D* fPtResCentPtTPCITS; //! sigma(pt)/pt vs Cent vs Pt for prim. TPC+ITS tracks
   TObjString fCurrentFileName; // cached value of current file name
   AliESDtrack* fDummyTrack; //! dummy track for tree init
+  //
+  // per event (tgl,phi) cells of the candidates for GetNearestTrack, for each track type (3) and parameter type (2)
+  const AliESDEvent* fNearestIndexEvent;   //! event the index was built for (0 if invalid)
+  Int_t    fNearestIndexNTracks;           //! number of tracks of that event
+  TArrayD  fNearestTgl[2];                 //! tgl of the tracks for global and TPC inner parameters
+  TArrayD  fNearestQPt[2];                 //! q/pt of the tracks
+  TArrayD  fNearestPhi[2];                 //! momentum phi of the tracks
+  TArrayI  fNearestCellFirst[6];           //! first entry of each cell in fNearestCellTracks (nCells+1 entries)
+  TArrayI  fNearestCellTracks[6];          //! candidate track indices ordered by cell
 
   AliAnalysisTaskFilteredTree(const AliAnalysisTaskFilteredTree&); // not implemented
   AliAnalysisTaskFilteredTree& operator=(const AliAnalysisTaskFilteredTree&); // not implemented
-  ClassDef(AliAnalysisTaskFilteredTree, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFilteredTree, 2); // example of analysis
 };
 
 #endif